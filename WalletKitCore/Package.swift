@@ -168,6 +168,9 @@ let package = Package(
             cSettings: [
                 .headerSearchPath("../include"),
                 .headerSearchPath("../src"),
+            ],
+            linkerSettings: [
+                .linkedLibrary("dl", .when(platforms: [.linux])),   // btcSyncReplay's dlsym()
             ]
         ),
 
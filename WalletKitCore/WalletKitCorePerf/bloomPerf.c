@@ -0,0 +1,104 @@
+//
+//  bloomPerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Bloom filter benchmark.  Matches the logsBloom of `count` headers against `addresses` watched
+//  addresses: with the OR and compare of the original bloomFilterMatch(), with bloomFilterMatch()
+//  and with bloomFilterMatchAny() over the whole batch, as BCS does for a batch of headers.  The
+//  first two stop at a header's first matching address.  Results are checked against each other.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ethereum/blockchain/BREthereumBloomFilter.h"
+
+// Bits set in each header's logsBloom; about a quarter of the filter, as in a busy mainnet block
+#define BLOOM_PERF_BITS_PER_HEADER   (600)
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// xorshift64; deterministic, so runs are comparable
+static uint64_t
+bloomPerfRandom (uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+extern int
+runBloomPerf (size_t count, size_t addresses) {
+    BREthereumBloomFilter *filters = calloc (count, sizeof (BREthereumBloomFilter));
+    BREthereumBloomFilter *others  = calloc (addresses, sizeof (BREthereumBloomFilter));
+    uint8_t *matchesOr    = calloc (count, sizeof (uint8_t));
+    uint8_t *matchesOne   = calloc (count, sizeof (uint8_t));
+    uint8_t *matchesBatch = calloc (count, sizeof (uint8_t));
+    uint64_t state = 0x9e3779b97f4a7c15;
+    size_t matched = 0;
+    double beg, timeOr, timeOne, timeBatch;
+    int success = 1;
+
+    for (size_t index = 0; index < count; index++)
+        for (size_t bit = 0; bit < BLOOM_PERF_BITS_PER_HEADER; bit++) {
+            uint64_t b = bloomPerfRandom (&state) % ETHEREUM_BLOOM_FILTER_BITS;
+            filters[index].bytes[b / 8] |= (uint8_t) (1 << (b % 8));
+        }
+
+    for (size_t index = 0; index < addresses; index++) {
+        BREthereumAddress address;
+        for (size_t byte = 0; byte < sizeof (address.bytes); byte++)
+            address.bytes[byte] = (uint8_t) bloomPerfRandom (&state);
+        others[index] = bloomFilterCreateAddress (address);
+    }
+
+    printf ("ETH: Bloom: %zu headers, %zu addresses\n", count, addresses);
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        for (size_t other = 0; other < addresses && !matchesOr[index]; other++)
+            matchesOr[index] = ETHEREUM_BOOLEAN_IS_TRUE (bloomFilterEqual (filters[index],
+                                                                           bloomFilterOr (filters[index], others[other])));
+    timeOr = timeNow () - beg;
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        for (size_t other = 0; other < addresses && !matchesOne[index]; other++)
+            matchesOne[index] = ETHEREUM_BOOLEAN_IS_TRUE (bloomFilterMatch (filters[index], others[other]));
+    timeOne = timeNow () - beg;
+
+    beg = timeNow ();
+    matched = bloomFilterMatchAny (filters, count, others, addresses, matchesBatch);
+    timeBatch = timeNow () - beg;
+
+    if (0 != memcmp (matchesOr, matchesOne,   count) ||
+        0 != memcmp (matchesOr, matchesBatch, count)) {
+        printf ("ETH: Bloom:   match mismatch\n");
+        success = 0;
+    }
+
+    printf ("ETH: Bloom:   %zu headers matched\n", matched);
+    printf ("ETH: Bloom:   or-equal %8.1f ns/header\n", 1e9 * timeOr    / count);
+    printf ("ETH: Bloom:   match    %8.1f ns/header, %5.1fx\n", 1e9 * timeOne   / count, timeOr / timeOne);
+    printf ("ETH: Bloom:   batch    %8.1f ns/header, %5.1fx\n", 1e9 * timeBatch / count, timeOr / timeBatch);
+
+    free (matchesBatch);
+    free (matchesOne);
+    free (matchesOr);
+    free (others);
+    free (filters);
+
+    return success;
+}
@@ -0,0 +1,969 @@
+//
+//  btcSyncReplay.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Bitcoin P2P sync benchmark.  A corpus of merkleblocks and their matched transactions is
+//  recorded once from a real peer (`btc-record`); thereafter (`btc-replay`) an in-process peer
+//  speaking the BTC wire protocol serves that corpus over a loopback socket to a BRPeerManager
+//  and BRWallet performing a full sync.  Replays are offline and repeatable.
+//
+//  Corpus layout (all integers little endian):
+//      "BRSYNC01"
+//      u8 mainnet, u32 height, u8[32] hash, u32 timestamp, u32 target  -- the starting checkpoint
+//      u32 length, char[length] -- the serialized master public key of the wallet
+//      then, until EOF, for each block:
+//          u32 length, u8[length] -- the serialized merkleblock
+//          u32 count, count x { u32 length, u8[length] } -- the block's matched transactions
+//
+//  With glibc, this executable's pthread_mutex_lock(), pthread_mutex_unlock(), malloc(), calloc(),
+//  realloc() and free() wrap libc's, so that a replay reports how long the peer manager and wallet
+//  locks are waited on and held, and how many allocations the sync makes.  The replay peer's
+//  thread stands in for the network and is not counted.  Elsewhere only RSS and page faults are
+//  reported.
+//
+
+#if defined (__linux__)
+#define _GNU_SOURCE     // for RTLD_NEXT
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <signal.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "support/BRArray.h"
+#include "support/BRSet.h"
+#include "support/BRCrypto.h"
+#include "support/BRAddress.h"
+#include "support/BRBIP32Sequence.h"
+#include "bitcoin/BRBloomFilter.h"
+#include "bitcoin/BRChainParams.h"
+#include "bitcoin/BRMerkleBlock.h"
+#include "bitcoin/BRTransaction.h"
+#include "bitcoin/BRPeer.h"
+#include "bitcoin/BRPeerManager.h"
+#include "bitcoin/BRWallet.h"
+
+#define CORPUS_MAGIC                "BRSYNC01"
+#define REPLAY_PROTOCOL_VERSION     70013
+#define REPLAY_HEADERS_COUNT        2000
+#define REPLAY_BLOCKS_COUNT         500
+#define REPLAY_SAMPLE_NANOSECONDS   (1000 * 1000)
+#define REPLAY_TIMEOUT_SECONDS      (30 * 60)
+
+#define INV_BLOCK                   2
+#define INV_FILTERED_BLOCK          3
+#define INV_TYPE_MASK               0x0000ffff // strip the witness flag
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// an IPv4-mapped IPv6 address, as BRPeer expects
+static UInt128
+ipv4Address (in_addr_t addr) {
+    UInt128 address = UINT128_ZERO;
+    address.u16[5] = 0xffff;
+    address.u32[3] = addr;
+    return address;
+}
+
+// MARK: - Instrumentation
+
+#if defined (__GLIBC__)
+#define REPLAY_INSTRUMENTED         1
+
+#include <dlfcn.h>
+
+extern void *__libc_malloc  (size_t size);
+extern void *__libc_calloc  (size_t count, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+extern void  __libc_free    (void *ptr);
+#else
+#define REPLAY_INSTRUMENTED         0
+#endif
+
+typedef struct {
+    pthread_mutex_t *mutex;
+    double locked;                  // when the current holder acquired mutex
+    double waitTotal, waitMax;
+    double holdTotal, holdMax;
+    size_t count;
+} BRReplayLockStats;
+
+typedef struct {
+    size_t allocs, frees, bytes;
+} BRReplayAllocStats;
+
+#define REPLAY_LOCK_MANAGER         0
+#define REPLAY_LOCK_WALLET          1
+
+// Counting is switched on and off only while no thread but the replay peer's is running, so each
+// lock's stats are only ever updated by the thread holding that lock.
+static volatile int replayCounting;
+static BRReplayLockStats replayLocks[2];
+static BRReplayAllocStats replayAllocs;     // updated atomically
+
+#if REPLAY_INSTRUMENTED
+static __thread int replayThreadIgnored;
+static __thread pthread_mutex_t *replayThreadLastLocked;
+
+// libc's, found with dlsym() on first use
+static int (*replayMutexLock)   (pthread_mutex_t *mutex);
+static int (*replayMutexUnlock) (pthread_mutex_t *mutex);
+
+static BRReplayLockStats *
+replayLockStats (pthread_mutex_t *mutex) {
+    if (!replayCounting) return NULL;
+    for (size_t index = 0; index < sizeof (replayLocks) / sizeof (replayLocks[0]); index++)
+        if (mutex == replayLocks[index].mutex) return &replayLocks[index];
+    return NULL;
+}
+
+int
+pthread_mutex_lock (pthread_mutex_t *mutex) {
+    BRReplayLockStats *stats = replayLockStats (mutex);
+
+    if (NULL == replayMutexLock) replayMutexLock = (int (*) (pthread_mutex_t *)) dlsym (RTLD_NEXT, "pthread_mutex_lock");
+
+    replayThreadLastLocked = mutex;
+    if (NULL == stats) return replayMutexLock (mutex);
+
+    double beg = timeNow ();
+    int error = replayMutexLock (mutex);
+
+    if (0 == error) {
+        stats->locked = timeNow ();
+        stats->waitTotal += stats->locked - beg;
+        if (stats->locked - beg > stats->waitMax) stats->waitMax = stats->locked - beg;
+        stats->count += 1;
+    }
+    return error;
+}
+
+int
+pthread_mutex_unlock (pthread_mutex_t *mutex) {
+    BRReplayLockStats *stats = replayLockStats (mutex);
+
+    if (NULL == replayMutexUnlock) replayMutexUnlock = (int (*) (pthread_mutex_t *)) dlsym (RTLD_NEXT, "pthread_mutex_unlock");
+
+    if (NULL != stats) {
+        double hold = timeNow () - stats->locked;
+        stats->holdTotal += hold;
+        if (hold > stats->holdMax) stats->holdMax = hold;
+    }
+    return replayMutexUnlock (mutex);
+}
+
+static void
+replayCountAlloc (size_t size) {
+    if (replayCounting && !replayThreadIgnored) {
+        __atomic_add_fetch (&replayAllocs.allocs, 1,    __ATOMIC_RELAXED);
+        __atomic_add_fetch (&replayAllocs.bytes,  size, __ATOMIC_RELAXED);
+    }
+}
+
+void *
+malloc (size_t size) {
+    replayCountAlloc (size);
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t count, size_t size) {
+    replayCountAlloc (count * size);
+    return __libc_calloc (count, size);
+}
+
+void *
+realloc (void *ptr, size_t size) {
+    replayCountAlloc (size);
+    return __libc_realloc (ptr, size);
+}
+
+void
+free (void *ptr) {
+    if (NULL != ptr && replayCounting && !replayThreadIgnored)
+        __atomic_add_fetch (&replayAllocs.frees, 1, __ATOMIC_RELAXED);
+    __libc_free (ptr);
+}
+#endif
+
+// The locks are private to BRPeerManager and BRWallet; each is found as the mutex its accessor
+// locks.  Called before counting starts.
+static pthread_mutex_t *
+replayManagerLock (BRPeerManager *manager) {
+#if REPLAY_INSTRUMENTED
+    replayThreadLastLocked = NULL;
+    BRPeerManagerLastBlockHeight (manager);
+    return replayThreadLastLocked;
+#else
+    return NULL;
+#endif
+}
+
+static pthread_mutex_t *
+replayWalletLock (BRWallet *wallet) {
+#if REPLAY_INSTRUMENTED
+    replayThreadLastLocked = NULL;
+    BRWalletBalance (wallet);
+    return replayThreadLastLocked;
+#else
+    return NULL;
+#endif
+}
+
+static void
+replayCountingStart (pthread_mutex_t *managerLock, pthread_mutex_t *walletLock) {
+    memset (replayLocks, 0, sizeof (replayLocks));
+    memset (&replayAllocs, 0, sizeof (replayAllocs));
+    replayLocks[REPLAY_LOCK_MANAGER].mutex = managerLock;
+    replayLocks[REPLAY_LOCK_WALLET].mutex  = walletLock;
+    replayCounting = 1;
+}
+
+static void
+replayCountingStop (void) {
+    replayCounting = 0;
+}
+
+static void
+replayLockStatsPrint (const char *name, const BRReplayLockStats *stats) {
+    size_t count = (stats->count ? stats->count : 1);
+
+    printf ("BTC: Replay:   %s lock: %zu locks, wait mean %.2f us, max %.1f us; hold mean %.2f us, max %.1f us, total %.3f s\n",
+            name, stats->count,
+            1e6 * stats->waitTotal / count, 1e6 * stats->waitMax,
+            1e6 * stats->holdTotal / count, 1e6 * stats->holdMax, stats->holdTotal);
+}
+
+// MARK: - Corpus
+
+typedef struct {
+    uint8_t *bytes;     // serialized merkleblock
+    size_t bytesLen;
+    BRMerkleBlock *block;
+    size_t txBeg;       // index into corpus transactions
+    size_t txCount;
+} BRReplayBlock;
+
+typedef struct {
+    uint8_t *bytes;
+    size_t bytesLen;
+} BRReplayTransaction;
+
+typedef struct {
+    int mainnet;
+    BRCheckPoint checkpoint;
+    char *masterPubKey;
+    BRReplayBlock *blocks;
+    BRReplayTransaction *transactions;
+    BRSet *blockSet;    // BRMerkleBlock *, block->height is the index into blocks
+} BRReplayCorpus;
+
+static int
+corpusReadU32 (FILE *file, uint32_t *value) {
+    uint8_t buf[sizeof (uint32_t)];
+    if (1 != fread (buf, sizeof (buf), 1, file)) return 0;
+    *value = UInt32GetLE (buf);
+    return 1;
+}
+
+static void
+corpusWriteU32 (FILE *file, uint32_t value) {
+    uint8_t buf[sizeof (uint32_t)];
+    UInt32SetLE (buf, value);
+    fwrite (buf, sizeof (buf), 1, file);
+}
+
+static uint8_t *
+corpusReadBytes (FILE *file, size_t *bytesLen) {
+    uint32_t len;
+    uint8_t *bytes;
+
+    if (!corpusReadU32 (file, &len) || NULL == (bytes = malloc (len > 0 ? len : 1))) return NULL;
+    if (len > 0 && 1 != fread (bytes, len, 1, file)) { free (bytes); return NULL; }
+
+    *bytesLen = len;
+    return bytes;
+}
+
+static void
+corpusWriteBytes (FILE *file, const uint8_t *bytes, size_t bytesLen) {
+    corpusWriteU32 (file, (uint32_t) bytesLen);
+    if (bytesLen > 0) fwrite (bytes, bytesLen, 1, file);
+}
+
+static void
+corpusFree (BRReplayCorpus *corpus) {
+    for (size_t index = 0; index < array_count (corpus->blocks); index++) {
+        free (corpus->blocks[index].bytes);
+        BRMerkleBlockFree (corpus->blocks[index].block);
+    }
+    for (size_t index = 0; index < array_count (corpus->transactions); index++)
+        free (corpus->transactions[index].bytes);
+
+    if (NULL != corpus->blockSet) BRSetFree (corpus->blockSet);
+    if (NULL != corpus->blocks) array_free (corpus->blocks);
+    if (NULL != corpus->transactions) array_free (corpus->transactions);
+    free (corpus->masterPubKey);
+    free (corpus);
+}
+
+static BRReplayCorpus *
+corpusLoad (const char *path) {
+    FILE *file = fopen (path, "rb");
+    if (NULL == file) { fprintf (stderr, "BTC: Replay: can't open corpus: %s\n", path); return NULL; }
+
+    BRReplayCorpus *corpus = calloc (1, sizeof (BRReplayCorpus));
+    char magic[sizeof (CORPUS_MAGIC) - 1];
+    uint8_t mainnet, hash[sizeof (UInt256)];
+    size_t mpkLen;
+    int valid = (1 == fread (magic, sizeof (magic), 1, file) &&
+                 0  == memcmp (magic, CORPUS_MAGIC, sizeof (magic)) &&
+                 1  == fread (&mainnet, sizeof (mainnet), 1, file) &&
+                 corpusReadU32 (file, &corpus->checkpoint.height) &&
+                 1  == fread (hash, sizeof (hash), 1, file) &&
+                 corpusReadU32 (file, &corpus->checkpoint.timestamp) &&
+                 corpusReadU32 (file, &corpus->checkpoint.target) &&
+                 NULL != (corpus->masterPubKey = (char *) corpusReadBytes (file, &mpkLen)));
+
+    if (valid) {
+        corpus->mainnet = mainnet;
+        corpus->checkpoint.hash = UInt256Get (hash);
+        corpus->masterPubKey = realloc (corpus->masterPubKey, mpkLen + 1);
+        corpus->masterPubKey[mpkLen] = '\0';
+    }
+
+    array_new (corpus->blocks, 10000);
+    array_new (corpus->transactions, 1000);
+    corpus->blockSet = BRSetNew (BRMerkleBlockHash, BRMerkleBlockEq, 10000);
+
+    while (valid) {
+        BRReplayBlock block = { NULL, 0, NULL, array_count (corpus->transactions), 0 };
+        uint32_t txCount;
+
+        if (NULL == (block.bytes = corpusReadBytes (file, &block.bytesLen))) break; // EOF
+
+        block.block = BRMerkleBlockParse (block.bytes, block.bytesLen);
+        valid = (NULL != block.block && corpusReadU32 (file, &txCount));
+
+        for (uint32_t index = 0; valid && index < txCount; index++) {
+            BRReplayTransaction transaction;
+
+            transaction.bytes = corpusReadBytes (file, &transaction.bytesLen);
+            valid = (NULL != transaction.bytes);
+            if (!valid) break;
+
+            array_add (corpus->transactions, transaction);
+            block.txCount++;
+        }
+
+        if (valid) {
+            block.block->height = (uint32_t) array_count (corpus->blocks);
+            array_add (corpus->blocks, block);
+            BRSetAdd (corpus->blockSet, block.block);
+        }
+        else {
+            free (block.bytes);
+            if (NULL != block.block) BRMerkleBlockFree (block.block);
+        }
+    }
+
+    fclose (file);
+
+    if (!valid || 0 == array_count (corpus->blocks)) {
+        fprintf (stderr, "BTC: Replay: malformed corpus: %s\n", path);
+        corpusFree (corpus);
+        return NULL;
+    }
+
+    return corpus;
+}
+
+// MARK: - Wire Protocol
+
+static int
+socketReadAll (int socket, uint8_t *buf, size_t bufLen) {
+    while (bufLen > 0) {
+        ssize_t n = read (socket, buf, bufLen);
+        if (n <= 0) return 0;
+        buf += n; bufLen -= n;
+    }
+    return 1;
+}
+
+static int
+socketWriteAll (int socket, const uint8_t *buf, size_t bufLen) {
+    while (bufLen > 0) {
+        ssize_t n = write (socket, buf, bufLen);
+        if (n <= 0) return 0;
+        buf += n; bufLen -= n;
+    }
+    return 1;
+}
+
+static int
+wireSendMessage (int socket, uint32_t magicNumber, const char *type, const uint8_t *msg, size_t msgLen) {
+    uint8_t header[24] = { 0 };
+    UInt256 hash;
+
+    BRSHA256_2 (&hash, msg, msgLen);
+    UInt32SetLE (&header[0], magicNumber);
+    strncpy ((char *) &header[4], type, 12);
+    UInt32SetLE (&header[16], (uint32_t) msgLen);
+    memcpy (&header[20], hash.u8, sizeof (uint32_t));
+
+    return socketWriteAll (socket, header, sizeof (header)) && socketWriteAll (socket, msg, msgLen);
+}
+
+// returns the payload of the next message, which must be freed, or NULL if the connection closed
+static uint8_t *
+wireReadMessage (int socket, uint32_t magicNumber, char type[13], size_t *msgLen) {
+    uint8_t header[24], *msg;
+
+    if (!socketReadAll (socket, header, sizeof (header)) || UInt32GetLE (&header[0]) != magicNumber) return NULL;
+
+    memcpy (type, &header[4], 12);
+    type[12] = '\0';
+    *msgLen = UInt32GetLE (&header[16]);
+
+    msg = malloc (*msgLen > 0 ? *msgLen : 1);
+    if (!socketReadAll (socket, msg, *msgLen)) { free (msg); return NULL; }
+    return msg;
+}
+
+// MARK: - Replay Peer
+
+typedef struct {
+    BRReplayCorpus *corpus;
+    uint32_t magicNumber;
+    int listenSocket;
+    volatile int clientSocket;
+    volatile int stopped;
+    uint16_t port;
+    pthread_t thread;
+} BRReplayPeer;
+
+// index in corpus->blocks of the block following the first locator found, or 0
+static size_t
+replayPeerLocate (BRReplayPeer *peer, const uint8_t *msg, size_t msgLen) {
+    size_t off = sizeof (uint32_t), len = 0;
+    size_t count = (size_t) BRVarInt (&msg[off], (off <= msgLen ? msgLen - off : 0), &len);
+    UInt256 checkpointHash = UInt256Reverse (peer->corpus->checkpoint.hash);
+    BRMerkleBlock key;
+
+    off += len;
+
+    for (size_t index = 0; index < count && off + sizeof (UInt256) <= msgLen; index++, off += sizeof (UInt256)) {
+        key.blockHash = UInt256Get (&msg[off]);
+        if (UInt256Eq (key.blockHash, checkpointHash)) return 0;
+
+        BRMerkleBlock *block = BRSetGet (peer->corpus->blockSet, &key);
+        if (NULL != block) return block->height + 1;
+    }
+
+    return 0;
+}
+
+static void
+replayPeerSendVersion (BRReplayPeer *peer, int socket) {
+    uint8_t msg[128];
+    size_t off = 0;
+    uint64_t services = SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM | SERVICES_NODE_WITNESS;
+    const char *agent = "/replay:1.0/";
+
+    UInt32SetLE (&msg[off], REPLAY_PROTOCOL_VERSION);              off += sizeof (uint32_t);
+    UInt64SetLE (&msg[off], services);                             off += sizeof (uint64_t);
+    UInt64SetLE (&msg[off], (uint64_t) time (NULL));               off += sizeof (uint64_t);
+    memset (&msg[off], 0, 2 * (sizeof (uint64_t) + sizeof (UInt128) + sizeof (uint16_t)));
+    off += 2 * (sizeof (uint64_t) + sizeof (UInt128) + sizeof (uint16_t));  // recv and from addresses
+    UInt64SetLE (&msg[off], 0x5245504c4159ULL);                    off += sizeof (uint64_t); // nonce
+    off += BRVarIntSet (&msg[off], sizeof (msg) - off, strlen (agent));
+    memcpy (&msg[off], agent, strlen (agent));                     off += strlen (agent);
+    UInt32SetLE (&msg[off], peer->corpus->checkpoint.height + (uint32_t) array_count (peer->corpus->blocks));
+    off += sizeof (uint32_t);
+    msg[off++] = 0; // don't relay transactions until a filter is loaded
+
+    wireSendMessage (socket, peer->magicNumber, MSG_VERSION, msg, off);
+}
+
+static void
+replayPeerSendHeaders (BRReplayPeer *peer, int socket, size_t start) {
+    size_t count = array_count (peer->corpus->blocks) - start;
+    if (count > REPLAY_HEADERS_COUNT) count = REPLAY_HEADERS_COUNT;
+
+    uint8_t *msg = malloc (BRVarIntSize (count) + 81 * count);
+    size_t off = BRVarIntSet (msg, BRVarIntSize (count), count);
+
+    for (size_t index = start; index < start + count; index++) {
+        memcpy (&msg[off], peer->corpus->blocks[index].bytes, 80);
+        msg[off + 80] = 0; // tx count
+        off += 81;
+    }
+
+    wireSendMessage (socket, peer->magicNumber, MSG_HEADERS, msg, off);
+    free (msg);
+}
+
+static void
+replayPeerSendInv (BRReplayPeer *peer, int socket, size_t start) {
+    size_t count = array_count (peer->corpus->blocks) - start;
+    if (count > REPLAY_BLOCKS_COUNT) count = REPLAY_BLOCKS_COUNT;
+
+    uint8_t *msg = malloc (BRVarIntSize (count) + 36 * count);
+    size_t off = BRVarIntSet (msg, BRVarIntSize (count), count);
+
+    for (size_t index = start; index < start + count; index++) {
+        UInt32SetLE (&msg[off], INV_BLOCK);
+        UInt256Set (&msg[off + sizeof (uint32_t)], peer->corpus->blocks[index].block->blockHash);
+        off += 36;
+    }
+
+    wireSendMessage (socket, peer->magicNumber, MSG_INV, msg, off);
+    free (msg);
+}
+
+static void
+replayPeerHandleGetdata (BRReplayPeer *peer, int socket, const uint8_t *msg, size_t msgLen) {
+    size_t off = 0, count = (size_t) BRVarInt (msg, msgLen, &off), notfoundCount = 0;
+    uint8_t *notfound = malloc (BRVarIntSize (count) + 36 * count);
+    size_t notfoundOff = BRVarIntSize (count);
+    BRMerkleBlock key;
+
+    for (size_t index = 0; index < count && off + 36 <= msgLen; index++, off += 36) {
+        uint32_t type = UInt32GetLE (&msg[off]) & INV_TYPE_MASK;
+        BRMerkleBlock *block = NULL;
+
+        if (INV_FILTERED_BLOCK == type) {
+            key.blockHash = UInt256Get (&msg[off + sizeof (uint32_t)]);
+            block = BRSetGet (peer->corpus->blockSet, &key);
+        }
+
+        if (NULL != block) {
+            BRReplayBlock *replay = &peer->corpus->blocks[block->height];
+
+            wireSendMessage (socket, peer->magicNumber, MSG_MERKLEBLOCK, replay->bytes, replay->bytesLen);
+            for (size_t txIndex = replay->txBeg; txIndex < replay->txBeg + replay->txCount; txIndex++)
+                wireSendMessage (socket, peer->magicNumber, MSG_TX,
+                                 peer->corpus->transactions[txIndex].bytes,
+                                 peer->corpus->transactions[txIndex].bytesLen);
+        }
+        else {
+            // transactions are only served as part of their block, as by a full node
+            memcpy (&notfound[notfoundOff], &msg[off], 36);
+            notfoundOff += 36;
+            notfoundCount++;
+        }
+    }
+
+    if (notfoundCount > 0) {
+        size_t len = BRVarIntSize (notfoundCount);
+        memmove (&notfound[len], &notfound[BRVarIntSize (count)], 36 * notfoundCount);
+        BRVarIntSet (notfound, len, notfoundCount);
+        wireSendMessage (socket, peer->magicNumber, MSG_NOTFOUND, notfound, len + 36 * notfoundCount);
+    }
+
+    free (notfound);
+}
+
+static void
+replayPeerServe (BRReplayPeer *peer, int socket) {
+    char type[13];
+    size_t msgLen;
+    uint8_t *msg;
+
+    replayPeerSendVersion (peer, socket);
+
+    while (!peer->stopped && NULL != (msg = wireReadMessage (socket, peer->magicNumber, type, &msgLen))) {
+        if      (0 == strcmp (type, MSG_VERSION))
+            wireSendMessage (socket, peer->magicNumber, MSG_VERACK, NULL, 0);
+
+        else if (0 == strcmp (type, MSG_PING))
+            wireSendMessage (socket, peer->magicNumber, MSG_PONG, msg, msgLen);
+
+        else if (0 == strcmp (type, MSG_GETHEADERS))
+            replayPeerSendHeaders (peer, socket, replayPeerLocate (peer, msg, msgLen));
+
+        else if (0 == strcmp (type, MSG_GETBLOCKS))
+            replayPeerSendInv (peer, socket, replayPeerLocate (peer, msg, msgLen));
+
+        else if (0 == strcmp (type, MSG_GETDATA))
+            replayPeerHandleGetdata (peer, socket, msg, msgLen);
+
+        // verack, filterload, mempool, getaddr, etc. need no reply
+
+        free (msg);
+    }
+}
+
+static void *
+replayPeerThread (void *arg) {
+    BRReplayPeer *peer = arg;
+
+#if REPLAY_INSTRUMENTED
+    replayThreadIgnored = 1;
+#endif
+
+    while (!peer->stopped) {
+        int socket = accept (peer->listenSocket, NULL, NULL);
+        if (socket < 0) break;
+
+        peer->clientSocket = socket;
+        replayPeerServe (peer, socket);
+        peer->clientSocket = -1;
+        close (socket);
+    }
+
+    return NULL;
+}
+
+static BRReplayPeer *
+replayPeerCreate (BRReplayCorpus *corpus, uint32_t magicNumber) {
+    BRReplayPeer *peer = calloc (1, sizeof (BRReplayPeer));
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof (addr);
+
+    peer->corpus = corpus;
+    peer->magicNumber = magicNumber;
+    peer->clientSocket = -1;
+    peer->listenSocket = socket (AF_INET, SOCK_STREAM, 0);
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    addr.sin_port = 0; // any free port
+
+    if (peer->listenSocket < 0 ||
+        0 != bind (peer->listenSocket, (struct sockaddr *) &addr, sizeof (addr)) ||
+        0 != listen (peer->listenSocket, 4) ||
+        0 != getsockname (peer->listenSocket, (struct sockaddr *) &addr, &addrLen) ||
+        0 != pthread_create (&peer->thread, NULL, replayPeerThread, peer)) {
+        fprintf (stderr, "BTC: Replay: can't start peer: %s\n", strerror (errno));
+        if (peer->listenSocket >= 0) close (peer->listenSocket);
+        free (peer);
+        return NULL;
+    }
+
+    peer->port = ntohs (addr.sin_port);
+    return peer;
+}
+
+static void
+replayPeerRelease (BRReplayPeer *peer) {
+    int clientSocket = peer->clientSocket, wakeSocket = socket (AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+
+    peer->stopped = 1;
+    if (clientSocket >= 0) shutdown (clientSocket, SHUT_RDWR);
+
+    // a connection, rather than shutdown(), reliably wakes a thread blocked in accept()
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    addr.sin_port = htons (peer->port);
+    if (wakeSocket >= 0) connect (wakeSocket, (struct sockaddr *) &addr, sizeof (addr));
+
+    pthread_join (peer->thread, NULL);
+    if (wakeSocket >= 0) close (wakeSocket);
+    close (peer->listenSocket);
+    free (peer);
+}
+
+// MARK: - Replay
+
+static void
+replaySampleRusage (long *maxRSSKiB, long *minorFaults, long *majorFaults) {
+    struct rusage usage;
+    getrusage (RUSAGE_SELF, &usage);
+#if defined (__APPLE__)
+    *maxRSSKiB = usage.ru_maxrss / 1024;  // bytes
+#else
+    *maxRSSKiB = usage.ru_maxrss;         // kilobytes
+#endif
+    *minorFaults = usage.ru_minflt;
+    *majorFaults = usage.ru_majflt;
+}
+
+static int
+replayRun (BRReplayCorpus *corpus, unsigned int run) {
+    static const char * const noDNSSeeds[] = { NULL };
+
+    BRChainParams params = *BRChainParamsGetBitcoin (corpus->mainnet);
+    BRReplayPeer *peer = replayPeerCreate (corpus, params.magicNumber);
+    if (NULL == peer) return 0;
+
+    // the sync starts at the corpus checkpoint and is only ever served by the replay peer
+    params.dnsSeeds = noDNSSeeds;
+    params.standardPort = peer->port;
+    params.checkpoints = &corpus->checkpoint;
+    params.checkpointsCount = 1;
+
+    uint32_t tipHeight = corpus->checkpoint.height + (uint32_t) array_count (corpus->blocks);
+    BRWallet *wallet = BRWalletNew (params.addrParams, NULL, 0, BRBIP32ParseMasterPubKey (corpus->masterPubKey));
+    BRPeerManager *manager = BRPeerManagerNew (&params, wallet, corpus->checkpoint.timestamp, NULL, 0, NULL, 0);
+    struct timespec sample = { 0, REPLAY_SAMPLE_NANOSECONDS };
+    long maxRSSKiB, minorFaultsBeg, minorFaults, majorFaultsBeg, majorFaults;
+    uint32_t height = 0;
+
+    BRPeerManagerSetFixedPeer (manager, ipv4Address (htonl (INADDR_LOOPBACK)), peer->port);
+    replaySampleRusage (&maxRSSKiB, &minorFaultsBeg, &majorFaultsBeg);
+    replayCountingStart (replayManagerLock (manager), replayWalletLock (wallet));
+
+    double beg = timeNow (), end = beg;
+    BRPeerManagerConnect (manager);
+
+    // poll, as a UI thread would
+    while (height < tipHeight && end - beg < REPLAY_TIMEOUT_SECONDS) {
+        nanosleep (&sample, NULL);
+        height = BRPeerManagerLastBlockHeight (manager);
+        BRWalletBalance (wallet);
+        end = timeNow ();
+    }
+
+    replaySampleRusage (&maxRSSKiB, &minorFaults, &majorFaults);
+
+    // the peer manager's threads have exited once it disconnects
+    BRPeerManagerDisconnect (manager);
+    replayCountingStop ();
+
+    size_t blockCount = array_count (corpus->blocks);
+    size_t txCount    = array_count (corpus->transactions);
+    size_t walletTxCount = BRWalletTransactions (wallet, NULL, 0);
+    double elapsed = end - beg;
+
+    printf ("BTC: Replay: run %u: %s at height %u of %u\n", run,
+            (height >= tipHeight ? "synced" : "TIMED OUT"), height, tipHeight);
+    printf ("BTC: Replay:   %zu blocks, %zu transactions (%zu in wallet) in %.3f s\n",
+            blockCount, txCount, walletTxCount, elapsed);
+    printf ("BTC: Replay:   blocks/s: %.1f, transactions/s: %.1f\n",
+            blockCount / elapsed, txCount / elapsed);
+    printf ("BTC: Replay:   peak RSS: %ld KiB, page faults: %ld minor, %ld major\n",
+            maxRSSKiB, minorFaults - minorFaultsBeg, majorFaults - majorFaultsBeg);
+
+    if (REPLAY_INSTRUMENTED) {
+        // from connecting to disconnecting, so a little past the sync
+        printf ("BTC: Replay:   allocations: %zu (%.1f per block), %zu KiB requested, %zu frees\n",
+                replayAllocs.allocs, (double) replayAllocs.allocs / blockCount,
+                replayAllocs.bytes / 1024, replayAllocs.frees);
+        replayLockStatsPrint ("manager", &replayLocks[REPLAY_LOCK_MANAGER]);
+        replayLockStatsPrint ("wallet ", &replayLocks[REPLAY_LOCK_WALLET]);
+    }
+    else printf ("BTC: Replay:   lock and allocation statistics need glibc\n");
+
+    BRPeerManagerFree (manager);
+    BRWalletFree (wallet);
+    replayPeerRelease (peer);
+
+    return height >= tipHeight;
+}
+
+extern int
+runBitcoinSyncReplay (const char *corpusPath, unsigned int runs) {
+    BRReplayCorpus *corpus = corpusLoad (corpusPath);
+    int success = (NULL != corpus);
+
+    signal (SIGPIPE, SIG_IGN); // the replay peer writes to sockets the peer manager may have closed
+
+    if (success)
+        printf ("BTC: Replay: corpus %s: %zu blocks from height %u, %zu transactions\n", corpusPath,
+                array_count (corpus->blocks), corpus->checkpoint.height, array_count (corpus->transactions));
+
+    for (unsigned int run = 1; success && run <= runs; run++)
+        success = replayRun (corpus, run);
+
+    if (NULL != corpus) corpusFree (corpus);
+    return success;
+}
+
+// MARK: - Record
+
+typedef struct {
+    FILE *file;
+    BRPeer *peer;
+    BRWallet *wallet;
+    UInt256 checkpointHash;
+    uint32_t checkpointHeight;
+    BRTransaction **transactions;   // relayed ahead of the block that matched them
+    size_t blockCount, blockLimit, txCount;
+    int done;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BRRecordContext;
+
+static void
+recordConnected (void *info) {
+    BRRecordContext *context = info;
+    size_t addrsCount = BRWalletAllAddrs (context->wallet, NULL, 0);
+    BRAddress *addrs = calloc (addrsCount, sizeof (BRAddress));
+    UInt160 hash;
+
+    addrsCount = BRWalletAllAddrs (context->wallet, addrs, addrsCount);
+
+    // match the filter the peer manager would load; BLOOM_UPDATE_ALL has the node track spends of matched outputs
+    BRBloomFilter *filter = BRBloomFilterNew (BLOOM_REDUCED_FALSEPOSITIVE_RATE, addrsCount + 100,
+                                              (uint32_t) BRPeerHash (context->peer), BLOOM_UPDATE_ALL);
+    for (size_t index = 0; index < addrsCount; index++)
+        if (BRAddressHash160 (&hash, BRWalletGetAddressParams (context->wallet), addrs[index].s))
+            BRBloomFilterInsertData (filter, hash.u8, sizeof (hash));
+    free (addrs);
+
+    uint8_t data[BRBloomFilterSerialize (filter, NULL, 0)];
+    size_t len = BRBloomFilterSerialize (filter, data, sizeof (data));
+
+    BRPeerSendFilterload (context->peer, data, len);
+    BRBloomFilterFree (filter);
+
+    // blocks are recorded from the checkpoint, so at most the peer's blocks after it are available
+    uint32_t lastBlock = BRPeerLastBlock (context->peer);
+    size_t blocksAvailable = (lastBlock > context->checkpointHeight ? lastBlock - context->checkpointHeight : 0);
+
+    if (0 == context->blockLimit || context->blockLimit > blocksAvailable)
+        context->blockLimit = blocksAvailable;
+
+    if (0 == context->blockLimit) BRPeerDisconnect (context->peer);
+    else BRPeerSendGetblocks (context->peer, &context->checkpointHash, 1, UINT256_ZERO);
+}
+
+static void
+recordDisconnected (void *info, int error) {
+    BRRecordContext *context = info;
+
+    if (error) fprintf (stderr, "BTC: Record: disconnected: %s\n", strerror (error));
+    pthread_mutex_lock (&context->lock);
+    context->done = 1;
+    pthread_cond_signal (&context->cond);
+    pthread_mutex_unlock (&context->lock);
+}
+
+static void
+recordRelayedTx (void *info, BRTransaction *tx) {
+    BRRecordContext *context = info;
+    array_add (context->transactions, tx);
+}
+
+static void
+recordRelayedBlock (void *info, BRMerkleBlock *block) {
+    BRRecordContext *context = info;
+    uint8_t *bytes = malloc (BRMerkleBlockSerialize (block, NULL, 0));
+    size_t bytesLen = BRMerkleBlockSerialize (block, bytes, BRMerkleBlockSerialize (block, NULL, 0));
+    size_t txCount = 0;
+
+    for (size_t index = 0; index < array_count (context->transactions); index++)
+        if (BRMerkleBlockContainsTxHash (block, context->transactions[index]->txHash)) txCount++;
+
+    corpusWriteBytes (context->file, bytes, bytesLen);
+    corpusWriteU32 (context->file, (uint32_t) txCount);
+    free (bytes);
+
+    for (size_t index = array_count (context->transactions); index > 0; index--) {
+        BRTransaction *tx = context->transactions[index - 1];
+        if (!BRMerkleBlockContainsTxHash (block, tx->txHash)) continue;
+
+        uint8_t txBytes[BRTransactionSerialize (tx, NULL, 0)];
+        corpusWriteBytes (context->file, txBytes, BRTransactionSerialize (tx, txBytes, sizeof (txBytes)));
+
+        array_rm (context->transactions, index - 1);
+        BRTransactionFree (tx);
+        context->txCount++;
+    }
+
+    BRMerkleBlockFree (block);
+
+    if (++context->blockCount % 1000 == 0)
+        printf ("BTC: Record: %zu blocks, %zu transactions\n", context->blockCount, context->txCount);
+    if (context->blockCount >= context->blockLimit)
+        BRPeerDisconnect (context->peer);
+}
+
+extern int
+runBitcoinSyncRecord (const char *corpusPath,
+                      const char *host,
+                      int mainnet,
+                      const char *masterPubKey,
+                      uint32_t checkpointHeight,
+                      size_t blockLimit) {
+    const BRChainParams *params = BRChainParamsGetBitcoin (mainnet);
+    const BRCheckPoint *checkpoint = BRChainParamsGetCheckpointBeforeBlockNumber (params, checkpointHeight + 1);
+    struct addrinfo hints = { 0 }, *servinfo = NULL;
+
+    hints.ai_family = AF_INET; // BRPeer only relays IPv4 addresses for now
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (NULL == checkpoint || 0 != getaddrinfo (host, NULL, &hints, &servinfo) || NULL == servinfo) {
+        fprintf (stderr, "BTC: Record: no checkpoint at or before %u, or can't resolve %s\n", checkpointHeight, host);
+        return 0;
+    }
+
+    BRRecordContext context = { NULL };
+    context.file = fopen (corpusPath, "wb");
+    if (NULL == context.file) { freeaddrinfo (servinfo); return 0; }
+
+    context.wallet = BRWalletNew (params->addrParams, NULL, 0, BRBIP32ParseMasterPubKey (masterPubKey));
+    context.checkpointHash = UInt256Reverse (checkpoint->hash);
+    context.checkpointHeight = checkpoint->height;
+    context.blockLimit = blockLimit;
+    array_new (context.transactions, 100);
+    pthread_mutex_init (&context.lock, NULL);
+    pthread_cond_init (&context.cond, NULL);
+
+    // the wallet has no transactions yet, so include plenty of addresses in the filter up front
+    BRWalletUnusedAddrs (context.wallet, NULL, 10 * SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED, SEQUENCE_EXTERNAL_CHAIN);
+    BRWalletUnusedAddrs (context.wallet, NULL, 10 * SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED, SEQUENCE_INTERNAL_CHAIN);
+
+    uint8_t hash[sizeof (UInt256)], flag = mainnet ? 1 : 0;
+    UInt256Set (hash, checkpoint->hash);
+    fwrite (CORPUS_MAGIC, sizeof (CORPUS_MAGIC) - 1, 1, context.file);
+    fwrite (&flag, sizeof (flag), 1, context.file);
+    corpusWriteU32 (context.file, checkpoint->height);
+    fwrite (hash, sizeof (hash), 1, context.file);
+    corpusWriteU32 (context.file, checkpoint->timestamp);
+    corpusWriteU32 (context.file, checkpoint->target);
+    corpusWriteBytes (context.file, (const uint8_t *) masterPubKey, strlen (masterPubKey));
+
+    context.peer = BRPeerNew (params->magicNumber);
+    context.peer->address = ipv4Address (((struct sockaddr_in *) servinfo->ai_addr)->sin_addr.s_addr);
+    context.peer->port = params->standardPort;
+    freeaddrinfo (servinfo);
+
+    BRPeerSetCallbacks (context.peer, &context, recordConnected, recordDisconnected, NULL, recordRelayedTx,
+                        NULL, NULL, recordRelayedBlock, NULL, NULL, NULL, NULL, NULL);
+    BRPeerConnect (context.peer);
+
+    pthread_mutex_lock (&context.lock);
+    while (!context.done) pthread_cond_wait (&context.cond, &context.lock);
+    pthread_mutex_unlock (&context.lock);
+
+    printf ("BTC: Record: %s: %zu blocks from height %u, %zu transactions\n", corpusPath,
+            context.blockCount, checkpoint->height, context.txCount);
+
+    for (size_t index = 0; index < array_count (context.transactions); index++)
+        BRTransactionFree (context.transactions[index]);
+    array_free (context.transactions);
+
+    BRPeerFree (context.peer);
+    BRWalletFree (context.wallet);
+    pthread_cond_destroy (&context.cond);
+    pthread_mutex_destroy (&context.lock);
+    fclose (context.file);
+
+    return context.blockCount > 0;
+}
@@ -0,0 +1,260 @@
+//
+//  btcTxPerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Bitcoin transaction allocation benchmark.  Loads `count` serialized transactions, a mix of
+//  P2PKH and P2WPKH spends as from a wallet's store, with BRTransactionParse() into compact
+//  transactions.  Then copies them with the per-field allocation of the original
+//  BRTransactionCopy() and with BRTransactionCopy(), and frees each set.  Reports the time and the
+//  growth in peak RSS of each.  Results are checked against each other.
+//
+//  Every set stays allocated until all are loaded so that the peak RSS grows by each set's size.
+//  The time to free depends on the state of the heap; the sets are freed in the reverse order of
+//  their allocation.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "bitcoin/BRTransaction.h"
+
+#define TX_PERF_BUFFER_SIZE   (4096)
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long
+txPerfMaxRSSKiB (void) {
+    struct rusage usage;
+    getrusage (RUSAGE_SELF, &usage);
+#if defined (__APPLE__)
+    return usage.ru_maxrss / 1024;  // bytes
+#else
+    return usage.ru_maxrss;         // kilobytes
+#endif
+}
+
+// xorshift64; deterministic, so runs are comparable
+static uint64_t
+txPerfRandom (uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void
+txPerfRandomBytes (uint64_t *state, uint8_t *bytes, size_t bytesCount) {
+    for (size_t index = 0; index < bytesCount; index++)
+        bytes[index] = (uint8_t) txPerfRandom (state);
+}
+
+// A DER signature and compressed public key, as pushed by a P2PKH scriptSig or as the items of a
+// P2WPKH witness
+static size_t
+txPerfSignature (uint64_t *state, uint8_t *script) {
+    size_t off = 0;
+
+    script[off++] = 72;
+    txPerfRandomBytes (state, &script[off], 72);
+    script[off] = 0x30;                     // not a valid scriptPubKey
+    off += 72;
+    script[off++] = 33;
+    txPerfRandomBytes (state, &script[off], 33);
+    script[off] = 0x02;
+    off += 33;
+
+    return off;
+}
+
+static BRTransaction *
+txPerfCreate (uint64_t *state) {
+    BRTransaction *tx = BRTransactionNew ();
+    int isWitness = (0 == txPerfRandom (state) % 3);
+    size_t inCount  = 1 + txPerfRandom (state) % 3;
+    uint8_t script[128];
+    size_t scriptLen;
+
+    tx->version  = 2;
+    tx->lockTime = 0;
+
+    for (size_t index = 0; index < inCount; index++) {
+        UInt256 hash;
+        txPerfRandomBytes (state, hash.u8, sizeof (hash.u8));
+        scriptLen = txPerfSignature (state, script);
+
+        BRTransactionAddInput (tx, hash, (uint32_t) (txPerfRandom (state) % 4), 0, NULL, 0,
+                               (isWitness ? NULL : script), (isWitness ? 0 : scriptLen),
+                               (isWitness ? script : NULL), (isWitness ? scriptLen : 0),
+                               TXIN_SEQUENCE);
+    }
+
+    for (size_t index = 0; index < 2; index++) {
+        if (isWitness) {                    // P2WPKH: OP_0 <20 bytes>
+            script[0] = 0x00; script[1] = 20;
+            txPerfRandomBytes (state, &script[2], 20);
+            scriptLen = 22;
+        }
+        else {                              // P2PKH: OP_DUP OP_HASH160 <20 bytes> OP_EQUALVERIFY OP_CHECKSIG
+            script[0] = 0x76; script[1] = 0xa9; script[2] = 20;
+            txPerfRandomBytes (state, &script[3], 20);
+            script[23] = 0x88; script[24] = 0xac;
+            scriptLen = 25;
+        }
+        BRTransactionAddOutput (tx, 1000 + txPerfRandom (state) % 100000000, script, scriptLen);
+    }
+
+    return tx;
+}
+
+// As the original BRTransactionCopy(): each array and each script, signature and witness is
+// allocated on its own.
+static BRTransaction *
+txPerfCopyPerField (const BRTransaction *tx) {
+    BRTransaction *cpy = BRTransactionNew ();
+    BRTxInput *inputs = cpy->inputs;
+    BRTxOutput *outputs = cpy->outputs;
+
+    *cpy = *tx;
+    cpy->inputs = inputs;
+    cpy->outputs = outputs;
+    cpy->inCount = cpy->outCount = 0;
+
+    for (size_t i = 0; i < tx->inCount; i++)
+        BRTransactionAddInput (cpy, tx->inputs[i].txHash, tx->inputs[i].index, tx->inputs[i].amount,
+                               tx->inputs[i].script, tx->inputs[i].scriptLen,
+                               tx->inputs[i].signature, tx->inputs[i].sigLen,
+                               tx->inputs[i].witness, tx->inputs[i].witLen, tx->inputs[i].sequence);
+
+    for (size_t i = 0; i < tx->outCount; i++)
+        BRTransactionAddOutput (cpy, tx->outputs[i].amount, tx->outputs[i].script, tx->outputs[i].scriptLen);
+
+    return cpy;
+}
+
+static int
+txPerfEqual (const BRTransaction *tx1, const BRTransaction *tx2) {
+    if (!BRTransactionEq (tx1, tx2) || tx1->version != tx2->version || tx1->lockTime != tx2->lockTime ||
+        tx1->inCount != tx2->inCount || tx1->outCount != tx2->outCount) return 0;
+
+    for (size_t i = 0; i < tx1->inCount; i++) {
+        const BRTxInput *in1 = &tx1->inputs[i], *in2 = &tx2->inputs[i];
+        if (!UInt256Eq (in1->txHash, in2->txHash) || in1->index != in2->index || in1->sequence != in2->sequence ||
+            in1->sigLen != in2->sigLen || in1->witLen != in2->witLen ||
+            (in1->sigLen > 0 && 0 != memcmp (in1->signature, in2->signature, in1->sigLen)) ||
+            (in1->witLen > 0 && 0 != memcmp (in1->witness,   in2->witness,   in1->witLen))) return 0;
+    }
+
+    for (size_t i = 0; i < tx1->outCount; i++) {
+        const BRTxOutput *out1 = &tx1->outputs[i], *out2 = &tx2->outputs[i];
+        if (out1->amount != out2->amount || out1->scriptLen != out2->scriptLen ||
+            0 != memcmp (out1->script, out2->script, out1->scriptLen)) return 0;
+    }
+
+    return 1;
+}
+
+static double
+txPerfFree (BRTransaction **txs, size_t count) {
+    double beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        BRTransactionFree (txs[index]);
+    return timeNow () - beg;
+}
+
+extern int
+runBitcoinTxPerf (size_t count) {
+    uint8_t **bufs = calloc (count, sizeof (uint8_t *));
+    size_t *bufsLen = calloc (count, sizeof (size_t));
+    BRTransaction **txsParsed   = calloc (count, sizeof (BRTransaction *));
+    BRTransaction **txsPerField = calloc (count, sizeof (BRTransaction *));
+    BRTransaction **txsCompact  = calloc (count, sizeof (BRTransaction *));
+    uint64_t state = 0x9e3779b97f4a7c15;
+    double beg, timeParse, timePerField, timeCompact;
+    long rss, rssParse, rssPerField, rssCompact;
+    int success = 1;
+
+    for (size_t index = 0; index < count; index++) {
+        uint8_t buf[TX_PERF_BUFFER_SIZE];
+        BRTransaction *tx = txPerfCreate (&state);
+
+        bufsLen[index] = BRTransactionSerialize (tx, buf, sizeof (buf));
+        bufs[index] = malloc (bufsLen[index]);
+        memcpy (bufs[index], buf, bufsLen[index]);
+        BRTransactionFree (tx);
+    }
+
+    printf ("BTC: Tx: %zu transactions\n", count);
+
+    rss = txPerfMaxRSSKiB ();
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        txsParsed[index] = BRTransactionParse (bufs[index], bufsLen[index]);
+    timeParse = timeNow () - beg;
+    rssParse = txPerfMaxRSSKiB () - rss;
+
+    rss = txPerfMaxRSSKiB ();
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        txsPerField[index] = txPerfCopyPerField (txsParsed[index]);
+    timePerField = timeNow () - beg;
+    rssPerField = txPerfMaxRSSKiB () - rss;
+
+    rss = txPerfMaxRSSKiB ();
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        txsCompact[index] = BRTransactionCopy (txsParsed[index]);
+    timeCompact = timeNow () - beg;
+    rssCompact = txPerfMaxRSSKiB () - rss;
+
+    for (size_t index = 0; index < count; index++) {
+        uint8_t buf[TX_PERF_BUFFER_SIZE];
+        if (NULL == txsParsed[index] ||
+            bufsLen[index] != BRTransactionSerialize (txsParsed[index], buf, sizeof (buf)) ||
+            0 != memcmp (buf, bufs[index], bufsLen[index]) ||
+            !txPerfEqual (txsParsed[index], txsPerField[index]) ||
+            !txPerfEqual (txsParsed[index], txsCompact[index])) {
+            printf ("BTC: Tx:   transaction mismatch at %zu\n", index);
+            success = 0;
+            break;
+        }
+    }
+
+    printf ("BTC: Tx:   parse              %8.1f ns/tx, RSS +%ld KiB\n", 1e9 * timeParse / count, rssParse);
+    printf ("BTC: Tx:   copy, per-field    %8.1f ns/tx, RSS +%ld KiB\n", 1e9 * timePerField / count, rssPerField);
+    printf ("BTC: Tx:   copy, compact      %8.1f ns/tx, RSS +%ld KiB, %5.1fx\n",
+            1e9 * timeCompact / count, rssCompact, timePerField / timeCompact);
+
+    // Free in the reverse order of allocation; freeing next to freed memory costs more with glibc.
+    double timeFreeCompact  = txPerfFree (txsCompact,  count);
+    double timeFreePerField = txPerfFree (txsPerField, count);
+    txPerfFree (txsParsed, count);
+
+    printf ("BTC: Tx:   free, per-field    %8.1f ns/tx\n", 1e9 * timeFreePerField / count);
+    printf ("BTC: Tx:   free, compact      %8.1f ns/tx, %5.1fx\n",
+            1e9 * timeFreeCompact / count, timeFreePerField / timeFreeCompact);
+
+    for (size_t index = 0; index < count; index++)
+        free (bufs[index]);
+
+    free (txsCompact);
+    free (txsPerField);
+    free (txsParsed);
+    free (bufsLen);
+    free (bufs);
+
+    return success;
+}
@@ -0,0 +1,219 @@
+//
+//  btcValidatePerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Bitcoin block validation benchmark; the chain-independent checks of a sync.  Validates `count`
+//  headers, as from headers messages of 2000, one at a time as the original BRPeer did and in
+//  groups spread across threads as BRPeer now does.  Then validates merkleblocks of `leaves`
+//  matched transactions, whose merkle root BRMerkleBlockIsValid() hashes across threads for wide
+//  tree levels, against a merkle root hashed on one thread.  Results are checked against each other.
+//
+//  The headers are not mined, so each fails the proof-of-work check; that check costs the same.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "support/BROSCompat.h"
+#include "support/BRCrypto.h"
+#include "bitcoin/BRMerkleBlock.h"
+
+#define VALIDATE_PERF_HEADERS_PER_MESSAGE   (2000)
+#define VALIDATE_PERF_HEADERS_PER_GROUP     (8)     // as BRPeer's HEADERS_PER_GROUP
+#define VALIDATE_PERF_HEADERS_PER_THREAD    (500)   // as BRPeer's HEADERS_PER_THREAD
+#define VALIDATE_PERF_MERKLE_RUNS           (20)
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// xorshift64; deterministic, so runs are comparable
+static uint64_t
+validatePerfRandom (uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+typedef struct {
+    const uint8_t *msg;
+    size_t count;
+    BRMerkleBlock **blocks;
+    int *valid;
+    uint32_t now;
+} ValidatePerfHeadersBatch;
+
+// As BRPeer's _BRPeerParseHeaders()
+static void
+validatePerfParseHeaders (void *info, size_t index) {
+    ValidatePerfHeadersBatch *batch = info;
+    size_t i = index * VALIDATE_PERF_HEADERS_PER_GROUP, end = i + VALIDATE_PERF_HEADERS_PER_GROUP;
+
+    if (end > batch->count) end = batch->count;
+
+    BRMerkleBlockParseHeaders (&batch->blocks[i], &batch->msg[81 * i], end - i);
+
+    for (; i < end; i++)
+        batch->valid[i] = (batch->blocks[i] && BRMerkleBlockIsValid (batch->blocks[i], batch->now));
+}
+
+static int
+validatePerfHeaders (size_t count, uint32_t now, uint64_t *state) {
+    uint8_t *msg = calloc (count, 81);
+    BRMerkleBlock **blocks = calloc (count, sizeof (BRMerkleBlock *));
+    int *validSerial = calloc (count, sizeof (int));
+    int *validBatch  = calloc (count, sizeof (int));
+    double beg, timeSerial, timeBatch;
+    int success = 1;
+
+    for (size_t index = 0; index < count; index++) {
+        uint8_t *header = &msg[81 * index];
+        for (size_t byte = 0; byte < 68; byte++)
+            header[byte] = (uint8_t) validatePerfRandom (state);
+        UInt32SetLE (&header[68], now - (uint32_t) (600 * (count - index)));    // timestamp
+        UInt32SetLE (&header[72], 0x1d00ffff);                                  // target
+        UInt32SetLE (&header[76], (uint32_t) validatePerfRandom (state));       // nonce
+    }
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) {
+        BRMerkleBlock *block = BRMerkleBlockParse (&msg[81 * index], 81);
+        validSerial[index] = (NULL != block && BRMerkleBlockIsValid (block, now));
+        if (NULL != block) BRMerkleBlockFree (block);
+    }
+    timeSerial = timeNow () - beg;
+
+    beg = timeNow ();
+    for (size_t offset = 0; offset < count; offset += VALIDATE_PERF_HEADERS_PER_MESSAGE) {
+        size_t messageCount = (count - offset < VALIDATE_PERF_HEADERS_PER_MESSAGE
+                               ? count - offset
+                               : VALIDATE_PERF_HEADERS_PER_MESSAGE);
+        ValidatePerfHeadersBatch batch = { &msg[81 * offset], messageCount, &blocks[offset], &validBatch[offset], now };
+        size_t threadCount = messageCount / VALIDATE_PERF_HEADERS_PER_THREAD;
+
+        if (threadCount > processor_count_brd ()) threadCount = processor_count_brd ();
+        if (threadCount < 1) threadCount = 1;
+        pthread_apply_brd ((messageCount + VALIDATE_PERF_HEADERS_PER_GROUP - 1) / VALIDATE_PERF_HEADERS_PER_GROUP,
+                           (unsigned int) threadCount, &batch, validatePerfParseHeaders);
+    }
+    timeBatch = timeNow () - beg;
+
+    for (size_t index = 0; index < count; index++) {
+        if (validSerial[index] != validBatch[index] || NULL == blocks[index]) success = 0;
+        if (NULL != blocks[index]) BRMerkleBlockFree (blocks[index]);
+    }
+    if (!success) printf ("BTC: Validate:   header mismatch\n");
+
+    printf ("BTC: Validate: %zu headers\n", count);
+    printf ("BTC: Validate:   serial   %8.1f ns/header, %9.0f headers/s\n", 1e9 * timeSerial / count, count / timeSerial);
+    printf ("BTC: Validate:   threaded %8.1f ns/header, %9.0f headers/s, %5.1fx\n",
+            1e9 * timeBatch / count, count / timeBatch, timeSerial / timeBatch);
+
+    free (validBatch);
+    free (validSerial);
+    free (blocks);
+    free (msg);
+
+    return success;
+}
+
+// The merkle root of `leaves` hashes, one level at a time on one thread; the last hash of an odd
+// level is paired with itself.
+static UInt256
+validatePerfMerkleRoot (const UInt256 *leaves, size_t count) {
+    UInt256 *level = malloc (count * sizeof (UInt256));
+    UInt256 *pairs = malloc ((count + 1) * sizeof (UInt256));
+    memcpy (level, leaves, count * sizeof (UInt256));
+
+    while (count > 1) {
+        size_t pairsCount = (count + 1) / 2;
+        memcpy (pairs, level, count * sizeof (UInt256));
+        if (count % 2) pairs[count] = pairs[count - 1];
+
+        BRSHA256_2Batch (level, pairs, 2 * sizeof (UInt256), 2 * sizeof (UInt256), pairsCount);
+        count = pairsCount;
+    }
+
+    UInt256 root = level[0];
+    free (pairs);
+    free (level);
+    return root;
+}
+
+static int
+validatePerfMerkleBlock (size_t leaves, uint32_t now, uint64_t *state) {
+    UInt256 *hashes = malloc (leaves * sizeof (UInt256));
+    double beg, timeSerial, timeBlock;
+    int success = 1;
+
+    for (size_t index = 0; index < leaves; index++)
+        for (size_t word = 0; word < 4; word++)
+            hashes[index].u64[word] = validatePerfRandom (state);
+
+    // Every transaction matched; every flag bit is set, so the partial tree is the full tree.
+    size_t flagsLen = (2 * leaves + 7) / 8;
+    uint8_t *flags = malloc (flagsLen);
+    memset (flags, 0xff, flagsLen);
+
+    UInt256 root = UINT256_ZERO;
+
+    beg = timeNow ();
+    for (size_t run = 0; run < VALIDATE_PERF_MERKLE_RUNS; run++)
+        root = validatePerfMerkleRoot (hashes, leaves);
+    timeSerial = (timeNow () - beg) / VALIDATE_PERF_MERKLE_RUNS;
+
+    BRMerkleBlock *block = BRMerkleBlockNew ();
+    block->merkleRoot = root;
+    block->timestamp  = now;
+    block->target     = 0x1d00ffff;
+    block->totalTx    = (uint32_t) leaves;
+    block->blockHash  = UINT256_ZERO;       // meets any target
+    BRMerkleBlockSetTxHashes (block, hashes, leaves, flags, flagsLen);
+    block->hashesCount = leaves;
+    block->flagsLen    = flagsLen;
+
+    beg = timeNow ();
+    for (size_t run = 0; run < VALIDATE_PERF_MERKLE_RUNS; run++)
+        success &= BRMerkleBlockIsValid (block, now);
+    timeBlock = (timeNow () - beg) / VALIDATE_PERF_MERKLE_RUNS;
+
+    if (!success) printf ("BTC: Validate:   merkle root mismatch\n");
+
+    printf ("BTC: Validate: merkleblock of %zu transactions\n", leaves);
+    printf ("BTC: Validate:   one thread   %8.1f us/block\n", 1e6 * timeSerial);
+    printf ("BTC: Validate:   merkleblock  %8.1f us/block, %5.1fx\n", 1e6 * timeBlock, timeSerial / timeBlock);
+
+    BRMerkleBlockFree (block);
+    free (flags);
+    free (hashes);
+
+    return success;
+}
+
+extern int
+runBitcoinValidatePerf (size_t count, size_t leaves) {
+    uint64_t state = 0x9e3779b97f4a7c15;
+    uint32_t now = (uint32_t) time (NULL);
+    int success = 1;
+
+    printf ("BTC: Validate: %u processors\n", processor_count_brd ());
+
+    success &= validatePerfHeaders (count, now, &state);
+
+    for (size_t size = 1024; size < leaves; size *= 4)
+        success &= validatePerfMerkleBlock (size, now, &state);
+    success &= validatePerfMerkleBlock (leaves, now, &state);
+
+    return success;
+}
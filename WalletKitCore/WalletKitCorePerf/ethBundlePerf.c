@@ -0,0 +1,199 @@
+//
+//  ethBundlePerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  ERC20 transfer bundle benchmark.  Extracts the values of `count` ERC20 transfer bundles, as
+//  ETH recovery does for each bundle: with the per-field parsing of the original recovery, with
+//  cryptoClientTransferBundleExtractETH() on string bundles and on binary bundles.  Results are
+//  checked against each other.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "support/util/BRHex.h"
+#include "ethereum/util/BRUtilMath.h"
+#include "crypto/BRCryptoClientP.h"
+#include "crypto/handlers/eth/BRCryptoETH.h"
+
+#define ETH_BUNDLE_PERF_ATTRIBUTES   (4)
+
+static const char *ethBundlePerfKeys[ETH_BUNDLE_PERF_ATTRIBUTES] = { "gasLimit", "gasUsed", "gasPrice", "nonce" };
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// xorshift64; deterministic, so runs are comparable
+static uint64_t
+ethBundlePerfRandom (uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void
+ethBundlePerfRandomBytes (uint64_t *state, uint8_t *bytes, size_t bytesCount) {
+    for (size_t index = 0; index < bytesCount; index++)
+        bytes[index] = (uint8_t) ethBundlePerfRandom (state);
+}
+
+static void
+ethBundlePerfEncode (char *string, const uint8_t *bytes, size_t bytesCount) {
+    string[0] = '0'; string[1] = 'x';
+    hexEncode (&string[2], 2 * bytesCount + 1, bytes, bytesCount);
+}
+
+// As the original recovery: each attribute is looked up, and the source address is parsed twice.
+static const char *
+ethBundlePerfLookup (const char *key, BRCryptoClientTransferBundle bundle) {
+    for (size_t index = 0; index < bundle->attributesCount; index++)
+        if (0 == strcasecmp (key, bundle->attributeKeys[index]))
+            return bundle->attributeVals[index];
+    return NULL;
+}
+
+static void
+ethBundlePerfExtractOriginal (BRCryptoClientTransferBundle bundle,
+                              BRCryptoTransferBundleETH *values) {
+    BRCoreParseStatus status;
+    values->amount   = uint256CreateParse (bundle->amount, 0, &status);
+    values->gasLimit = strtoull (ethBundlePerfLookup ("gasLimit", bundle), NULL, 0);
+    values->gasUsed  = strtoull (ethBundlePerfLookup ("gasUsed",  bundle), NULL, 0);
+    values->gasPrice = uint256CreateParse (ethBundlePerfLookup ("gasPrice", bundle), 0, &status);
+    values->nonce    = strtoull (ethBundlePerfLookup ("nonce",    bundle), NULL, 0);
+
+    values->hash = ethHashCreate (bundle->hash);
+
+    values->sourceIsValid = ETHEREUM_BOOLEAN_IS_TRUE (ethAddressValidateString (bundle->from));
+    values->targetIsValid = ETHEREUM_BOOLEAN_IS_TRUE (ethAddressValidateString (bundle->to));
+    values->source = ethAddressCreate (bundle->from);
+    values->target = ethAddressCreate (bundle->to);
+    values->source = ethAddressCreate (bundle->from);      // again, to check if we pay the fee
+}
+
+static int
+ethBundlePerfEqual (const BRCryptoTransferBundleETH *v1,
+                    const BRCryptoTransferBundleETH *v2) {
+    return (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (v1->hash, v2->hash)) &&
+            ETHEREUM_BOOLEAN_IS_TRUE (ethAddressEqual (v1->source, v2->source)) &&
+            ETHEREUM_BOOLEAN_IS_TRUE (ethAddressEqual (v1->target, v2->target)) &&
+            v1->sourceIsValid == v2->sourceIsValid &&
+            v1->targetIsValid == v2->targetIsValid &&
+            UInt256Eq (v1->amount,   v2->amount) &&
+            UInt256Eq (v1->gasPrice, v2->gasPrice) &&
+            v1->gasLimit == v2->gasLimit &&
+            v1->gasUsed  == v2->gasUsed  &&
+            v1->nonce    == v2->nonce);
+}
+
+extern int
+runEthBundlePerf (size_t count) {
+    BRCryptoClientTransferBundle *bundlesString = calloc (count, sizeof (BRCryptoClientTransferBundle));
+    BRCryptoClientTransferBundle *bundlesBinary = calloc (count, sizeof (BRCryptoClientTransferBundle));
+    BRCryptoTransferBundleETH *valuesOriginal = calloc (count, sizeof (BRCryptoTransferBundleETH));
+    BRCryptoTransferBundleETH *valuesString   = calloc (count, sizeof (BRCryptoTransferBundleETH));
+    BRCryptoTransferBundleETH *valuesBinary   = calloc (count, sizeof (BRCryptoTransferBundleETH));
+    uint64_t state = 0x9e3779b97f4a7c15;
+    double beg, timeOriginal, timeString, timeBinary;
+    int success = 1;
+
+    const char *currency = "ethereum-mainnet:0x558ec3152e2eb2174905cd19aea4e34a23de9ad6";
+
+    for (size_t index = 0; index < count; index++) {
+        BRCryptoClientTransferBundleBinary binary;
+        memset (&binary, 0, sizeof (binary));
+        ethBundlePerfRandomBytes (&state, binary.hash.data,      sizeof (binary.hash.data));
+        ethBundlePerfRandomBytes (&state, binary.blockHash.data, sizeof (binary.blockHash.data));
+        ethBundlePerfRandomBytes (&state, binary.from, sizeof (binary.from));
+        ethBundlePerfRandomBytes (&state, binary.to,   sizeof (binary.to));
+
+        // Amounts are decimal strings, as from the BRD endpoint; up to 80 bits.
+        UInt256 value = UINT256_ZERO;
+        value.u64[0] = ethBundlePerfRandom (&state);
+        value.u64[1] = ethBundlePerfRandom (&state) & 0xffff;
+        for (size_t byte = 0; byte < 32; byte++)
+            binary.amount.data[31 - byte] = value.u8[byte];
+        char *amount = uint256CoerceString (value, 10);
+
+        char hash[67], blockHash[67], from[43], to[43];
+        ethBundlePerfEncode (hash,      binary.hash.data,      sizeof (binary.hash.data));
+        ethBundlePerfEncode (blockHash, binary.blockHash.data, sizeof (binary.blockHash.data));
+        ethBundlePerfEncode (from, binary.from, sizeof (binary.from));
+        ethBundlePerfEncode (to,   binary.to,   sizeof (binary.to));
+
+        char gasUsed[24], nonce[24];
+        sprintf (gasUsed, "%u", 21000 + (unsigned) (ethBundlePerfRandom (&state) % 40000));
+        sprintf (nonce,   "%zu", index);
+        const char *vals[ETH_BUNDLE_PERF_ATTRIBUTES] = { "65000", gasUsed, "20000000000", nonce };
+
+        bundlesString[index] =
+        cryptoClientTransferBundleCreate (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                          "erc20:uids", hash, "erc20:identifier", from, to, amount,
+                                          currency, NULL,
+                                          1588000000, 10000000 + index, 10, 3, blockHash,
+                                          ETH_BUNDLE_PERF_ATTRIBUTES, ethBundlePerfKeys, vals);
+
+        bundlesBinary[index] =
+        cryptoClientTransferBundleCreateBinary (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                                "erc20:uids", "erc20:identifier", currency,
+                                                &binary,
+                                                1588000000, 10000000 + index, 10, 3,
+                                                ETH_BUNDLE_PERF_ATTRIBUTES, ethBundlePerfKeys, vals);
+        free (amount);
+    }
+
+    printf ("ETH: Bundle: %zu ERC20 transfers\n", count);
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        ethBundlePerfExtractOriginal (bundlesString[index], &valuesOriginal[index]);
+    timeOriginal = timeNow () - beg;
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        success &= !cryptoClientTransferBundleExtractETH (bundlesString[index], &valuesString[index]);
+    timeString = timeNow () - beg;
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        success &= !cryptoClientTransferBundleExtractETH (bundlesBinary[index], &valuesBinary[index]);
+    timeBinary = timeNow () - beg;
+
+    for (size_t index = 0; index < count; index++)
+        if (!ethBundlePerfEqual (&valuesOriginal[index], &valuesString[index]) ||
+            !ethBundlePerfEqual (&valuesOriginal[index], &valuesBinary[index])) {
+            printf ("ETH: Bundle:   values mismatch at %zu\n", index);
+            success = 0;
+            break;
+        }
+
+    printf ("ETH: Bundle:   original %8.1f ns/bundle\n", 1e9 * timeOriginal / count);
+    printf ("ETH: Bundle:   string   %8.1f ns/bundle, %5.1fx\n", 1e9 * timeString / count, timeOriginal / timeString);
+    printf ("ETH: Bundle:   binary   %8.1f ns/bundle, %5.1fx\n", 1e9 * timeBinary / count, timeOriginal / timeBinary);
+
+    for (size_t index = 0; index < count; index++) {
+        cryptoClientTransferBundleRelease (bundlesBinary[index]);
+        cryptoClientTransferBundleRelease (bundlesString[index]);
+    }
+
+    free (valuesBinary);
+    free (valuesString);
+    free (valuesOriginal);
+    free (bundlesBinary);
+    free (bundlesString);
+
+    return success;
+}
@@ -0,0 +1,142 @@
+//
+//  hashPerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Hash benchmark.  Times double-SHA256 of `count` 80 byte block headers, packed as in a headers
+//  message, one at a time and then batched, with each available SHA-256 kernel; and then one-shot
+//  SHA-256 throughput over a large buffer.  Then times Keccak256 of `count` transaction-sized
+//  messages, one at a time and then batched, with and without the vector kernel.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "support/BRCrypto.h"
+
+#define HASH_PERF_BUFFER_SIZE    (1024 * 1024)
+#define HASH_PERF_MESSAGE_SIZE   (110)     // a typical signed ETH transfer
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static struct {
+    unsigned kernels;
+    const char *name;
+} hashPerfKernels[] = {
+    { 0,                "scalar" },
+    { BR_SHA256_LANES4, "lanes4" },
+    { BR_SHA256_AVX2,   "avx2"   },
+    { BR_SHA256_SHANI,  "sha-ni" },
+};
+
+extern int
+runHashPerf (size_t count) {
+    unsigned available = BRSHA256Kernels();
+    unsigned keccakAvailable = BRKeccakKernels();
+    uint8_t *headers = malloc (81 * count);
+    uint8_t *hashes  = malloc (32 * count);
+    uint8_t *buffer  = malloc (HASH_PERF_BUFFER_SIZE);
+    uint8_t *check   = malloc (32 * count);
+    double beg, single, batch, bulk;
+    int success = 1;
+
+    for (size_t index = 0; index < 81 * count; index++) headers[index] = (uint8_t) (index * 7 + 3);
+    for (size_t index = 0; index < HASH_PERF_BUFFER_SIZE; index++) buffer[index] = (uint8_t) (index * 13 + 5);
+
+    printf ("BTC: Hash: %zu headers\n", count);
+
+    for (size_t k = 0; k < sizeof (hashPerfKernels) / sizeof (hashPerfKernels[0]); k++) {
+        unsigned kernels = hashPerfKernels[k].kernels;
+        if (kernels != 0 && 0 == (available & kernels)) continue;
+
+        BRSHA256SetKernels (kernels);
+
+        beg = timeNow ();
+        for (size_t index = 0; index < count; index++)
+            BRSHA256_2 (&hashes[32 * index], &headers[81 * index], 80);
+        single = timeNow () - beg;
+
+        if (0 == kernels) memcpy (check, hashes, 32 * count);
+
+        beg = timeNow ();
+        BRSHA256_2Batch (hashes, headers, 80, 81, count);
+        batch = timeNow () - beg;
+
+        if (0 != memcmp (check, hashes, 32 * count)) {
+            printf ("BTC: Hash:   %s: batch mismatch\n", hashPerfKernels[k].name);
+            success = 0;
+        }
+
+        beg = timeNow ();
+        BRSHA256 (hashes, buffer, HASH_PERF_BUFFER_SIZE);
+        bulk = timeNow () - beg;
+
+        printf ("BTC: Hash:   %-6s: sha256d %8.1f ns/header, batch %8.1f ns/header, sha256 %8.1f MB/s\n",
+                hashPerfKernels[k].name,
+                1e9 * single / count,
+                1e9 * batch / count,
+                HASH_PERF_BUFFER_SIZE / bulk / 1e6);
+    }
+
+    BRSHA256SetKernels (~0u);
+
+    // Keccak256, over messages of `count` transactions
+    const void **messages = calloc (count, sizeof (void *));
+    size_t *messagesSize  = calloc (count, sizeof (size_t));
+
+    for (size_t index = 0; index < count; index++) {
+        messages[index]     = &buffer[(index * HASH_PERF_MESSAGE_SIZE) % (HASH_PERF_BUFFER_SIZE - HASH_PERF_MESSAGE_SIZE)];
+        messagesSize[index] = HASH_PERF_MESSAGE_SIZE;
+    }
+
+    printf ("ETH: Hash: %zu transactions\n", count);
+
+    for (unsigned kernels = 0; kernels <= BR_KECCAK_AVX2; kernels++) {
+        if (kernels != 0 && 0 == (keccakAvailable & kernels)) continue;
+
+        BRKeccakSetKernels (kernels);
+
+        beg = timeNow ();
+        for (size_t index = 0; index < count; index++)
+            BRKeccak256 (&hashes[32 * index], messages[index], messagesSize[index]);
+        single = timeNow () - beg;
+
+        if (0 == kernels) memcpy (check, hashes, 32 * count);
+
+        beg = timeNow ();
+        BRKeccak256Batch (hashes, messages, messagesSize, count);
+        batch = timeNow () - beg;
+
+        if (0 != memcmp (check, hashes, 32 * count)) {
+            printf ("ETH: Hash:   %s: batch mismatch\n", (kernels ? "avx2" : "scalar"));
+            success = 0;
+        }
+
+        printf ("ETH: Hash:   %-6s: keccak256 %8.1f ns/tx, batch %8.1f ns/tx\n",
+                (kernels ? "avx2" : "scalar"),
+                1e9 * single / count,
+                1e9 * batch / count);
+    }
+
+    BRKeccakSetKernels (~0u);
+
+    free (messagesSize);
+    free (messages);
+    free (check);
+    free (buffer);
+    free (hashes);
+    free (headers);
+
+    return success;
+}
@@ -0,0 +1,117 @@
+//
+//  keyPerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Signature benchmark.  Signs `count` digests with distinct keys, then times DER verification and
+//  compact (BTC message) recovery, one at a time and then batched, and reports signatures per
+//  second.  Batches are checked against the single item results.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "support/BRCrypto.h"
+#include "support/BRKey.h"
+#include "support/BROSCompat.h"
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+keyPerfReport (const char *name, size_t count, double single, double batch, int match) {
+    printf ("BTC: Key:   %-9s: %8.0f sig/s, batch %8.0f sig/s%s\n",
+            name,
+            count / single,
+            count / batch,
+            (match ? "" : " (batch mismatch)"));
+}
+
+extern int
+runKeyPerf (size_t count) {
+    BRKey *keys      = calloc (count, sizeof (BRKey));
+    BRKey *recovered = calloc (count, sizeof (BRKey));
+    UInt256 *mds     = calloc (count, sizeof (UInt256));
+    uint8_t *sigs    = calloc (count, 73);
+    uint8_t *compactSigs  = calloc (count, 65);
+    const void **sigPtrs          = calloc (count, sizeof (void *));
+    const void **compactSigPtrs   = calloc (count, sizeof (void *));
+    size_t *sigLens  = calloc (count, sizeof (size_t));
+    int *results     = calloc (count, sizeof (int));
+    int *checks      = calloc (count, sizeof (int));
+    double beg, single, batch;
+    int success = 1, match;
+
+    for (size_t index = 0; index < count; index++) {
+        UInt256 secret;
+        BRSHA256 (&secret, &index, sizeof (index));
+        BRKeySetSecret (&keys[index], &secret, 1);
+        BRSHA256 (&mds[index], &secret, sizeof (secret));
+
+        sigLens[index] = BRKeySign (&keys[index], &sigs[73 * index], 73, mds[index]);
+        BRKeyCompactSign (&keys[index], &compactSigs[65 * index], 65, mds[index]);
+        BRKeyPubKey (&keys[index], NULL, 0);
+
+        sigPtrs[index]         = &sigs[73 * index];
+        compactSigPtrs[index]  = &compactSigs[65 * index];
+    }
+
+    printf ("BTC: Key: %zu signatures, %u processors\n", count, processor_count_brd ());
+
+    // DER verify
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        checks[index] = BRKeyVerify (&keys[index], mds[index], sigPtrs[index], sigLens[index]);
+    single = timeNow () - beg;
+
+    beg = timeNow ();
+    BRKeyVerifyBatch (results, keys, mds, sigPtrs, sigLens, count);
+    batch = timeNow () - beg;
+
+    match = (0 == memcmp (results, checks, count * sizeof (int)));
+    for (size_t index = 0; index < count; index++) match &= checks[index];
+    keyPerfReport ("verify", count, single, batch, match);
+    success &= match;
+
+    // compact recovery
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++)
+        checks[index] = BRKeyRecoverPubKey (&recovered[index], mds[index], compactSigPtrs[index], 65);
+    single = timeNow () - beg;
+
+    memset (recovered, 0, count * sizeof (BRKey));
+    beg = timeNow ();
+    BRKeyRecoverPubKeyBatch (results, recovered, mds, compactSigPtrs, count);
+    batch = timeNow () - beg;
+
+    match = (0 == memcmp (results, checks, count * sizeof (int)));
+    for (size_t index = 0; index < count; index++)
+        match &= (checks[index] && 0 == memcmp (recovered[index].pubKey, keys[index].pubKey, 33));
+    keyPerfReport ("recover", count, single, batch, match);
+    success &= match;
+
+    for (size_t index = 0; index < count; index++) BRKeyClean (&keys[index]);
+
+    free (checks);
+    free (results);
+    free (sigLens);
+    free (compactSigPtrs);
+    free (sigPtrs);
+    free (compactSigs);
+    free (sigs);
+    free (mds);
+    free (recovered);
+    free (keys);
+
+    return success;
+}
@@ -10,12 +10,50 @@
 //
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include "support/BROSCompat.h"
 #include "support/BRBIP39WordsEn.h"
 #include "ethereum/blockchain/BREthereumAccount.h"
 #include "test.h"  // runSyncTest
 
+extern int
+runBitcoinSyncRecord (const char *corpusPath,
+                      const char *host,
+                      int mainnet,
+                      const char *masterPubKey,
+                      uint32_t checkpointHeight,
+                      size_t blockLimit);
+
+extern int
+runBitcoinSyncReplay (const char *corpusPath,
+                      unsigned int runs);
+
+extern int
+runBitcoinValidatePerf (size_t count, size_t leaves);
+
+extern int
+runBitcoinTxPerf (size_t count);
+
+extern int
+runUInt256Perf (size_t count);
+
+extern int
+runProofOfWorkPerf (size_t count);
+
+extern int
+runHashPerf (size_t count);
+
+extern int
+runKeyPerf (size_t count);
+
+extern int
+runBloomPerf (size_t count, size_t addresses);
+
+extern int
+runEthBundlePerf (size_t count);
+
 #if defined (NEVER_EWM)
 extern BREthereumClient
 runEWM_createClient (void);
@@ -83,6 +121,50 @@ runSyncMany (BREthereumNetwork newtork,
 #endif
 
 int main(int argc, const char * argv[]) {
+    // btc-record <corpus> <host> <mainnet> <masterPubKey> <checkpointHeight> <blockCount>
+    if (argc == 8 && 0 == strcmp (argv[1], "btc-record"))
+        return runBitcoinSyncRecord (argv[2], argv[3], atoi (argv[4]), argv[5],
+                                     (uint32_t) strtoul (argv[6], NULL, 10),
+                                     (size_t) strtoul (argv[7], NULL, 10)) ? 0 : 1;
+
+    // btc-replay <corpus> [runs]
+    if (argc >= 3 && 0 == strcmp (argv[1], "btc-replay"))
+        return runBitcoinSyncReplay (argv[2], (argc > 3 ? (unsigned int) atoi (argv[3]) : 3)) ? 0 : 1;
+
+    // btc-validate [count] [leaves]
+    if (argc >= 2 && 0 == strcmp (argv[1], "btc-validate"))
+        return runBitcoinValidatePerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 200000,
+                                       argc > 3 ? (size_t) strtoul (argv[3], NULL, 10) : 65536) ? 0 : 1;
+
+    // btc-tx [count]
+    if (argc >= 2 && 0 == strcmp (argv[1], "btc-tx"))
+        return runBitcoinTxPerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 100000) ? 0 : 1;
+
+    // uint256 [count]
+    if (argc >= 2 && 0 == strcmp (argv[1], "uint256"))
+        return runUInt256Perf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 1000000) ? 0 : 1;
+
+    // pow [count]
+    if (argc >= 2 && 0 == strcmp (argv[1], "pow"))
+        return runProofOfWorkPerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 1000) ? 0 : 1;
+
+    // hash [count]
+    if (argc >= 2 && 0 == strcmp (argv[1], "hash"))
+        return runHashPerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 100000) ? 0 : 1;
+
+    // key [count]
+    if (argc >= 2 && 0 == strcmp (argv[1], "key"))
+        return runKeyPerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 10000) ? 0 : 1;
+
+    // bloom [count] [addresses]
+    if (argc >= 2 && 0 == strcmp (argv[1], "bloom"))
+        return runBloomPerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 50000,
+                             argc > 3 ? (size_t) strtoul (argv[3], NULL, 10) : 20) ? 0 : 1;
+
+    // eth-bundle [count]
+    if (argc >= 2 && 0 == strcmp (argv[1], "eth-bundle"))
+        return runEthBundlePerf (argc > 2 ? (size_t) strtoul (argv[2], NULL, 10) : 100000) ? 0 : 1;
+
     BRCryptoSyncMode mode = CRYPTO_SYNC_MODE_API_WITH_P2P_SEND;
 
     const char *paperKey = (argc > 1 ? argv[1] : "0xa9de3dbd7d561e67527bc1ecb025c59d53b9f7ef");
@@ -0,0 +1,109 @@
+//
+//  powPerf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  Ethash benchmark.  Times the generation of one epoch's cache, in memory and then stored to
+//  (and reloaded from) a temporary directory, and then the light verification of a mainnet header
+//  `count` times.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "support/util/BRHex.h"
+#include "ethereum/blockchain/BREthereumBlock.h"
+
+// Mainnet block 4,000,001; epoch 133
+#define POW_PERF_HEADER_RLP "f9020ea0b8a3f7f5cfc1748f91a684f20fe89031202cbadcd15078c49b85ec2a57f43853a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d4934794ea674fdde714fd979de3edf0f56aa9716b898ec8a07b01440ffe0282749577cf99f6c90aa39e496af23bbdc64ab57a3f0d1bf8a467a0ab330290ef6907c3e411691347a3ba6933482354e48dc46738f2226aab0d848ca03db9076bd070e771806d05df3bfe7d83aae07fc94e35310ea304509f57fb27acb90100000000000000000000000000000000000000000004000000000000000000000000000000000000000000000000800000280000000000000000000000000000000000000000000000000000000000000000010000000000000000000000000400000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000020000000000000000000080000000000000000000000000000000000000000000000000000041000000000000000000000000000004000000000000000000000008703e5d1c1e295f1833d090183666c488305282e84596297a38d65746865726d696e652d657536a04db91248cc4af54907e32cc5c160eeb7d5813cce11c87bbc85a0dc6db2b65419885d345a1001da875e"
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static BREthereumBlockHeader
+createHeader (const char *rlp) {
+    BRRlpData data;
+    data.bytes = hexDecodeCreate (&data.bytesCount, rlp, strlen (rlp));
+
+    BRRlpCoder coder = rlpCoderCreate ();
+    BRRlpItem item = rlpDataGetItem (coder, data);
+    BREthereumBlockHeader header = blockHeaderRlpDecode (item, RLP_TYPE_NETWORK, coder);
+
+    rlpItemRelease (coder, item);
+    rlpCoderRelease (coder);
+    rlpDataRelease (data);
+
+    return header;
+}
+
+extern int
+runProofOfWorkPerf (size_t count) {
+    BREthereumBlockHeader header = createHeader (POW_PERF_HEADER_RLP);
+
+    char path[] = "/tmp/powPerfXXXXXX";
+    if (NULL == mkdtemp (path)) return 0;
+
+    double beg, memory, stored, loaded, verify;
+    UInt256 n;
+    BREthereumHash m;
+
+    printf ("ETH: PoW: block %llu\n", (unsigned long long) blockHeaderGetNumber (header));
+
+    // Generate, in memory only
+    BREthereumProofOfWork pow = proofOfWorkCreate (NULL);
+    beg = timeNow ();
+    proofOfWorkGenerate (pow, header);
+    memory = timeNow () - beg;
+    proofOfWorkRelease (pow);
+
+    // Generate and store; then reload
+    pow = proofOfWorkCreate (path);
+    beg = timeNow ();
+    proofOfWorkGenerate (pow, header);
+    stored = timeNow () - beg;
+    proofOfWorkRelease (pow);
+
+    pow = proofOfWorkCreate (path);
+    beg = timeNow ();
+    proofOfWorkGenerate (pow, header);
+    loaded = timeNow () - beg;
+
+    proofOfWorkSetHead (pow, blockHeaderGetNumber (header));
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) {
+        BREthereumProofOfWorkResult result = proofOfWorkCompute (pow, header, &n, &m);
+        assert (PROOF_OF_WORK_COMPUTED == result);
+        assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (m, blockHeaderGetMixHash (header))));
+    }
+    verify = timeNow () - beg;
+
+    printf ("ETH: PoW:   cache generate: %8.3f s\n", memory);
+    printf ("ETH: PoW:   cache store:    %8.3f s\n", stored);
+    printf ("ETH: PoW:   cache load:     %8.3f s\n", loaded);
+    printf ("ETH: PoW:   verify:         %8.3f ms/header (%zu headers)\n", 1e3 * verify / count, count);
+
+    proofOfWorkRelease (pow);
+
+    // The store holds the one 'ethash-<epoch>' file
+    char filename[sizeof (path) + 32];
+    sprintf (filename, "%s/ethash-%llu", path, (unsigned long long) (blockHeaderGetNumber (header) / 30000));
+    unlink (filename);
+    rmdir (path);
+
+    blockHeaderRelease (header);
+
+    return 1;
+}
@@ -0,0 +1,222 @@
+//
+//  uint256Perf.c
+//  CorePerf
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  UInt256 arithmetic benchmark.  Compares the 64-bit limb kernels in BRUtilMath against the
+//  prior 32-bit limb implementations, kept here as `ref*` functions, on `count` random values:
+//  amounts of about 10^18 to 10^27 (as for ETH and token amounts in WEI) and full 256-bit values.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "support/BROSCompat.h"
+#include "ethereum/util/BRUtil.h"
+
+#define AS_UINT64(x)  ((uint64_t) (x))
+
+static double
+timeNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// MARK: - Reference (32-bit limb) Implementations
+
+static UInt512
+refMul (const UInt256 x, const UInt256 y) {
+    UInt512 z = UINT512_ZERO;
+    size_t count = sizeof (UInt256) / sizeof(uint32_t);
+    for (size_t xi = 0; xi < count; xi++) {
+        uint64_t carry = 0;
+        if (x.u32[xi] == 0) continue;
+        for (size_t yi = 0; yi < count; yi++) {
+            uint64_t total = z.u32[yi + xi] + carry + AS_UINT64 (y.u32[yi]) * AS_UINT64 (x.u32[xi]);
+            carry = total >> 32;
+            z.u32[yi + xi] = (uint32_t) total;
+        }
+        z.u32[xi + count] += carry;
+    }
+    return z;
+}
+
+static UInt256
+refMul_Overflow (UInt256 x, UInt256 y, int *overflow) {
+    return uint256Coerce (refMul (x, y), overflow);
+}
+
+static UInt256
+refDiv_Small (UInt256 x, uint32_t y, uint32_t *rem) {
+    UInt256 z = UINT256_ZERO;
+    uint64_t remainder = 0;
+    for (int i = 7; i >= 0; i--) {
+        uint64_t value = AS_UINT64(x.u32[i]) + remainder * (AS_UINT64(1) << 32);
+        z.u32[i] = (uint32_t) (value / y);
+        remainder = value % y;
+    }
+    *rem = (uint32_t) remainder;
+    return z;
+}
+
+static char *
+refCoerceStringDecimal (UInt256 x) {
+    if (uint256EQL (x, UINT256_ZERO)) return strdup ("0");
+
+    char r[257];
+    memset (r, 0, 257);
+    int i;
+    for (i = 0; i < 256 && !uint256EQL(x, UINT256_ZERO); i++) {
+        uint32_t rem;
+        x = refDiv_Small (x, 10, &rem);
+        r[i] = '0' + rem;
+    }
+
+    char *t = calloc (1 + i, 1);
+    for (int j = 0; j < i; j++)
+        t[i - j - 1] = r[j];
+    return t;
+}
+
+static UInt256
+refParseUInt64 (const char *string) {
+    char number[20], *numberEnd;
+    strncpy (number, string, 19);
+    number[19] = '\0';
+    return uint256Create (strtoull (number, &numberEnd, 10));
+}
+
+static UInt256
+refParseDecimal (const char *string, int *overflow) {
+    while ('0' == *string) string++;
+
+    // As `uint256CreateParse()` validates the digits
+    size_t length = strlen (string);
+    UInt256 value = UINT256_ZERO;
+
+    *overflow = 0;
+    if (length != strspn (string, "0123456789")) return UINT256_ZERO;
+
+    for (size_t index = 0; index < length; index += 19) {
+        if (0 == index) value = refParseUInt64 (string);
+        else {
+            int scalingDigits = (int) (length - index >= 19 ? 19 : length - index);
+
+            uint64_t power = 1;
+            while (scalingDigits-- > 0) power *= 10;
+
+            int scaleOverflow, addOverflow;
+            value = refMul_Overflow (value, uint256Create (power), &scaleOverflow);
+            value = uint256Add_Overflow (value, refParseUInt64 (&string[index]), &addOverflow);
+            if (scaleOverflow || addOverflow) { *overflow = 1; return UINT256_ZERO; }
+        }
+    }
+    return value;
+}
+
+// MARK: - Benchmark
+
+static UInt256
+randomUInt256 (int isAmount) {
+    UInt256 value = UINT256_ZERO;
+    if (isAmount) {
+        // About 10^18 to 10^27; under 2^90
+        arc4random_buf_brd (value.u8, 12);
+        value.u32[2] &= 0x3ffffff;
+    }
+    else arc4random_buf_brd (value.u8, sizeof (value.u8));
+    return value;
+}
+
+static void
+runUInt256PerfFor (size_t count, int isAmount) {
+    UInt256 *xs = calloc (count, sizeof (UInt256));
+    UInt256 *ys = calloc (count, sizeof (UInt256));
+    char   **ss = calloc (count, sizeof (char *));
+
+    for (size_t index = 0; index < count; index++) {
+        xs[index] = randomUInt256 (isAmount);
+        ys[index] = (isAmount ? uint256Create (arc4random_uniform_brd (1000000000)) : randomUInt256 (0));
+        ss[index] = uint256CoerceString (xs[index], 10);
+    }
+
+    // The implementations must agree
+    for (size_t index = 0; index < count && index < 1000; index++) {
+        int o1, o2;
+        UInt256 m1 = uint256Mul_Overflow (xs[index], ys[index], &o1);
+        UInt256 m2 = refMul_Overflow     (xs[index], ys[index], &o2);
+        assert (o1 == o2 && uint256EQL (m1, m2));
+
+        UInt512 f1 = uint256Mul (xs[index], ys[index]);
+        UInt512 f2 = refMul     (xs[index], ys[index]);
+        assert (0 == memcmp (f1.u8, f2.u8, sizeof (f1.u8)));
+
+        char *s2 = refCoerceStringDecimal (xs[index]);
+        assert (0 == strcmp (ss[index], s2));
+        free (s2);
+
+        BRCoreParseStatus status;
+        UInt256 p1 = uint256CreateParse (ss[index], 10, &status);
+        UInt256 p2 = refParseDecimal    (ss[index], &o2);
+        assert (CORE_PARSE_OK == status && !o2 && uint256EQL (p1, p2) && uint256EQL (p1, xs[index]));
+    }
+
+    double beg, now, ref;
+    volatile uint64_t sink = 0;
+    int overflow;
+
+    printf ("MTH: UInt256: %zu %s values\n", count, (isAmount ? "amount" : "256-bit"));
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) sink += uint256Mul_Overflow (xs[index], ys[index], &overflow).u64[0];
+    now = timeNow () - beg;
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) sink += refMul_Overflow (xs[index], ys[index], &overflow).u64[0];
+    ref = timeNow () - beg;
+    printf ("MTH: UInt256:   mul overflow: %7.1f ns, ref %7.1f ns (x%.1f)\n", 1e9 * now / count, 1e9 * ref / count, ref / now);
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) sink += uint256Mul (xs[index], ys[index]).u64[0];
+    now = timeNow () - beg;
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) sink += refMul (xs[index], ys[index]).u64[0];
+    ref = timeNow () - beg;
+    printf ("MTH: UInt256:   mul:          %7.1f ns, ref %7.1f ns (x%.1f)\n", 1e9 * now / count, 1e9 * ref / count, ref / now);
+
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) { char *s = uint256CoerceString (xs[index], 10); sink += s[0]; free (s); }
+    now = timeNow () - beg;
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) { char *s = refCoerceStringDecimal (xs[index]); sink += s[0]; free (s); }
+    ref = timeNow () - beg;
+    printf ("MTH: UInt256:   to decimal:   %7.1f ns, ref %7.1f ns (x%.1f)\n", 1e9 * now / count, 1e9 * ref / count, ref / now);
+
+    BRCoreParseStatus status;
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) sink += uint256CreateParse (ss[index], 10, &status).u64[0];
+    now = timeNow () - beg;
+    beg = timeNow ();
+    for (size_t index = 0; index < count; index++) sink += refParseDecimal (ss[index], &overflow).u64[0];
+    ref = timeNow () - beg;
+    printf ("MTH: UInt256:   from decimal: %7.1f ns, ref %7.1f ns (x%.1f)\n", 1e9 * now / count, 1e9 * ref / count, ref / now);
+
+    for (size_t index = 0; index < count; index++) free (ss[index]);
+    free (ss);
+    free (ys);
+    free (xs);
+}
+
+extern int
+runUInt256Perf (size_t count) {
+    runUInt256PerfFor (count, 1);
+    runUInt256PerfFor (count, 0);
+    return 1;
+}
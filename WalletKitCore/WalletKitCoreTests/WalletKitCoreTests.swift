@@ -181,6 +181,10 @@ final class WalletKitCoreTests: XCTestCase {
         runContractTests()
     }
 
+    func testNodeETH () {
+        runNodeTests()
+    }
+
     func testBasicsETH () {
         runTests (0)
     }
@@ -33,6 +33,7 @@
 #include "support/BRBech32.h"
 #include "support/BRBIP39Mnemonic.h"
 #include "support/BRBIP39WordsEn.h"
+#include "support/BROSCompat.h"
 
 #include "bcash/BRBCashParams.h"
 #include "bcash/BRBCashAddr.h"
@@ -789,6 +790,144 @@ int BRHashTests()
                     "\x82\x27\x3b\x7b\xfa\xd8\x04\x5d\x85\xa4\x70", *(UInt256 *)md))
         r = 0, fprintf(stderr, "***FAILED*** %s: Keccak-256() test 1\n", __func__);
 
+    // test keccak-512
+    
+    s = "";
+    BRKeccak512(md, s, strlen(s));
+    if (! UInt512Eq(*(UInt512 *)"\x0e\xab\x42\xde\x4c\x3c\xeb\x92\x35\xfc\x91\xac\xff\xe7\x46\xb2\x9c\x29\xa8\xc3"
+                    "\x66\xb7\xc6\x0e\x4e\x67\xc4\x66\xf3\x6a\x43\x04\xc0\x0f\xa9\xca\xf9\xd8\x79\x76\xba"
+                    "\x46\x9b\xcb\xe0\x67\x13\xb4\x35\xf0\x91\xef\x27\x69\xfb\x16\x0c\xda\xb3\x3d\x36\x70\x68\x0e", *(UInt512 *)md))
+        r = 0, fprintf(stderr, "***FAILED*** %s: Keccak-512() test 1\n", __func__);
+
+    // test incremental hashing, fed in uneven fragments, against the one-shot hashes
+
+    uint8_t data[300], md1[64], md2[64];
+    size_t i, j, n, lens[] = { 0, 1, 55, 56, 63, 64, 65, 71, 72, 111, 112, 127, 128, 129, 135, 136, 137, 300 };
+
+    for (i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i*7 + 3);
+
+    for (i = 0; i < sizeof(lens)/sizeof(*lens); i++) {
+        BRSHA1Context sha1; BRSHA256Context sha224, sha256; BRSHA512Context sha384, sha512;
+        BRRMD160Context rmd160; BRMD5Context md5; BRKeccakContext sha3, k256, k512;
+
+        BRSHA1Init(&sha1), BRSHA224Init(&sha224), BRSHA256Init(&sha256), BRSHA384Init(&sha384);
+        BRSHA512Init(&sha512), BRRMD160Init(&rmd160), BRMD5Init(&md5);
+        BRSHA3_256Init(&sha3), BRKeccak256Init(&k256), BRKeccak512Init(&k512);
+
+        for (j = 0; j < lens[i]; j += n) {
+            n = (j % 3 == 0) ? 1 : j % 67 + 1;
+            if (n > lens[i] - j) n = lens[i] - j;
+            BRSHA1Update(&sha1, &data[j], n), BRSHA256Update(&sha224, &data[j], n);
+            BRSHA256Update(&sha256, &data[j], n), BRSHA512Update(&sha384, &data[j], n);
+            BRSHA512Update(&sha512, &data[j], n), BRRMD160Update(&rmd160, &data[j], n), BRMD5Update(&md5, &data[j], n);
+            BRKeccakUpdate(&sha3, &data[j], n), BRKeccakUpdate(&k256, &data[j], n), BRKeccakUpdate(&k512, &data[j], n);
+        }
+
+        BRSHA1(md1, data, lens[i]), BRSHA1Final(md2, &sha1);
+        if (memcmp(md1, md2, 20) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA1Update() test %zu\n", __func__, i);
+
+        BRSHA224(md1, data, lens[i]), BRSHA224Final(md2, &sha224);
+        if (memcmp(md1, md2, 28) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA224Update() test %zu\n", __func__, i);
+
+        BRSHA256(md1, data, lens[i]), BRSHA256Final(md2, &sha256);
+        if (memcmp(md1, md2, 32) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA256Update() test %zu\n", __func__, i);
+
+        BRSHA384(md1, data, lens[i]), BRSHA384Final(md2, &sha384);
+        if (memcmp(md1, md2, 48) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA384Update() test %zu\n", __func__, i);
+
+        BRSHA512(md1, data, lens[i]), BRSHA512Final(md2, &sha512);
+        if (memcmp(md1, md2, 64) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA512Update() test %zu\n", __func__, i);
+
+        BRRMD160(md1, data, lens[i]), BRRMD160Final(md2, &rmd160);
+        if (memcmp(md1, md2, 20) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: RMD160Update() test %zu\n", __func__, i);
+
+        BRMD5(md1, data, lens[i]), BRMD5Final(md2, &md5);
+        if (memcmp(md1, md2, 16) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: MD5Update() test %zu\n", __func__, i);
+
+        BRSHA3_256(md1, data, lens[i]), BRKeccakFinal(md2, &sha3);
+        if (memcmp(md1, md2, 32) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA3Update() test %zu\n", __func__, i);
+
+        BRKeccak256(md1, data, lens[i]), BRKeccakFinal(md2, &k256);
+        if (memcmp(md1, md2, 32) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: Keccak256Update() test %zu\n", __func__, i);
+
+        BRKeccak512(md1, data, lens[i]), BRKeccakFinal(md2, &k512);
+        if (memcmp(md1, md2, 64) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: Keccak512Update() test %zu\n", __func__, i);
+    }
+
+    // a copied context continues from the shared midstate
+
+    BRSHA256Context ctx, ctx2;
+
+    BRSHA256Init(&ctx);
+    BRSHA256Update(&ctx, data, 100);
+    ctx2 = ctx;
+    BRSHA256Update(&ctx, &data[100], 200);
+    BRSHA256Final(md2, &ctx);
+    BRSHA256(md1, data, 300);
+    if (memcmp(md1, md2, 32) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA256Update() clone test 1\n", __func__);
+    BRSHA256Update(&ctx2, &data[100], 20);
+    BRSHA256Final(md2, &ctx2);
+    BRSHA256(md1, data, 120);
+    if (memcmp(md1, md2, 32) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA256Update() clone test 2\n", __func__);
+
+    // test batch sha-256 with each kernel against the one-shot hashes
+
+    unsigned kernels[] = { 0, BR_SHA256_SHANI, BR_SHA256_AVX2, BR_SHA256_LANES4, ~0u };
+    size_t batchLens[] = { 0, 1, 55, 56, 64, 80, 119, 120 };
+    uint8_t msgs[11*121], mds[11*32];
+
+    for (i = 0; i < sizeof(msgs); i++) msgs[i] = (uint8_t)(i*13 + 5);
+
+    for (i = 0; i < sizeof(kernels)/sizeof(*kernels); i++) {
+        BRSHA256SetKernels(kernels[i]);
+
+        for (j = 0; j < sizeof(batchLens)/sizeof(*batchLens); j++) {
+            BRSHA256Batch(mds, msgs, batchLens[j], batchLens[j] + 1, 11);
+
+            for (n = 0; n < 11; n++) {
+                BRSHA256(md1, &msgs[n*(batchLens[j] + 1)], batchLens[j]);
+                if (memcmp(md1, &mds[n*32], 32) != 0)
+                    r = 0, fprintf(stderr, "***FAILED*** %s: SHA256Batch() test %zu-%zu-%zu\n", __func__, i, j, n);
+            }
+
+            BRSHA256_2Batch(mds, msgs, batchLens[j], batchLens[j] + 1, 11);
+
+            for (n = 0; n < 11; n++) {
+                BRSHA256_2(md1, &msgs[n*(batchLens[j] + 1)], batchLens[j]);
+                if (memcmp(md1, &mds[n*32], 32) != 0)
+                    r = 0, fprintf(stderr, "***FAILED*** %s: SHA256_2Batch() test %zu-%zu-%zu\n", __func__, i, j, n);
+            }
+        }
+
+        BRSHA256(md1, msgs, sizeof(msgs)), BRSHA256SetKernels(0), BRSHA256(md2, msgs, sizeof(msgs));
+        if (memcmp(md1, md2, 32) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: SHA256() kernel test %zu\n", __func__, i);
+    }
+
+    BRSHA256SetKernels(~0u);
+
+    // test batch keccak-256, with and without the vector kernel, against the one-shot hashes
+
+    const void *kmsgs[11];
+    size_t kmsgLens[11];
+
+    for (i = 0, j = 0; i < 11; j += kmsgLens[i], i++) kmsgs[i] = &msgs[j], kmsgLens[i] = (i*i*17) % 200;
+
+    for (i = 0; i < 2; i++) {
+        BRKeccakSetKernels(i ? ~0u : 0);
+
+        for (n = 0; n <= 11; n += 4) {
+            BRKeccak256Batch(mds, kmsgs, kmsgLens, 11 - n);
+
+            for (j = 0; j < 11 - n; j++) {
+                BRKeccak256(md1, kmsgs[j], kmsgLens[j]);
+                if (memcmp(md1, &mds[j*32], 32) != 0)
+                    r = 0, fprintf(stderr, "***FAILED*** %s: Keccak256Batch() test %zu-%zu-%zu\n", __func__, i, n, j);
+            }
+        }
+    }
+
+    BRKeccakSetKernels(~0u);
+
     // test murmurHash3-x86_32
     
     if (BRMurmur3_32("", 0, 0) != 0)
@@ -1768,7 +1907,70 @@ int BRKeyTests()
     
     if (pkLen5 != pkLen || memcmp(pubKey, pubKey5, pkLen) != 0)
         r = 0, fprintf(stderr, "***FAILED*** %s: BRPubKeyRecover() test 3\n", __func__);
-    
+
+    // batch verification and recovery, enough items to spread over threads, with every 7th digest altered
+    BRKey keys[200], recovered[200];
+    UInt256 mds[200], secret = UINT256_ZERO;
+    uint8_t sigs[200][73], compactSigs[200][65];
+    const void *sigPtrs[200], *compactSigPtrs[200];
+    size_t sigLens[200], i, verified = 0;
+    int results[200];
+
+    for (i = 0; i < 200; i++) {
+        secret.u8[31] = (uint8_t)(i + 1);
+        BRKeySetSecret(&keys[i], &secret, i % 2);
+        BRSHA256(&mds[i], &i, sizeof(i));
+        sigLens[i] = BRKeySign(&keys[i], sigs[i], sizeof(sigs[i]), mds[i]);
+        BRKeyCompactSign(&keys[i], compactSigs[i], sizeof(compactSigs[i]), mds[i]);
+        sigPtrs[i] = sigs[i];
+        compactSigPtrs[i] = compactSigs[i];
+        if (i % 7 == 0) mds[i].u8[0] ^= 1;
+        else verified++;
+    }
+
+    if (BRKeyVerifyBatch(results, keys, mds, sigPtrs, sigLens, 200) != verified)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeyVerifyBatch() test 1\n", __func__);
+
+    for (i = 0; i < 200; i++) {
+        if (results[i] != BRKeyVerify(&keys[i], mds[i], sigs[i], sigLens[i])) break;
+    }
+
+    if (i < 200) r = 0, fprintf(stderr, "***FAILED*** %s: BRKeyVerifyBatch() test 2\n", __func__);
+
+    BRKeyRecoverPubKeyBatch(results, recovered, mds, compactSigPtrs, 200);
+
+    for (i = 0; i < 200; i++) {
+        pkLen = BRKeyPubKey(&keys[i], pubKey, sizeof(pubKey));
+        if (! results[i] || ! BRKeyRecoverPubKey(&key2, mds[i], compactSigs[i], 65) ||
+            BRKeyPubKey(&recovered[i], NULL, 0) != BRKeyPubKey(&key2, NULL, 0) ||
+            memcmp(recovered[i].pubKey, key2.pubKey, BRKeyPubKey(&key2, NULL, 0)) != 0) break;
+        if ((BRKeyPubKey(&recovered[i], NULL, 0) == pkLen && memcmp(recovered[i].pubKey, pubKey, pkLen) == 0) !=
+            (i % 7 != 0)) break;
+    }
+
+    if (i < 200) r = 0, fprintf(stderr, "***FAILED*** %s: BRKeyRecoverPubKeyBatch() test\n", __func__);
+
+    // JOSE batch, signed over the digests before they were altered
+    uint8_t joseSigs[200][64];
+    const void *joseSigPtrs[200];
+
+    for (i = 0; i < 200; i++) {
+        UInt256 md = mds[i];
+
+        if (i % 7 == 0) md.u8[0] ^= 1;
+        BRKeySignJOSE(&keys[i], joseSigs[i], sizeof(joseSigs[i]), md);
+        joseSigPtrs[i] = joseSigs[i];
+    }
+
+    if (BRKeyVerifyJOSEBatch(results, keys, mds, joseSigPtrs, 200) != verified)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeyVerifyJOSEBatch() test 1\n", __func__);
+
+    for (i = 0; i < 200; i++) {
+        if (results[i] != BRKeyVerifyJOSE(&keys[i], mds[i], joseSigs[i], 64)) break;
+    }
+
+    if (i < 200) r = 0, fprintf(stderr, "***FAILED*** %s: BRKeyVerifyJOSEBatch() test 2\n", __func__);
+
     // paper wallet key pair
     BRKeyGenerateRandom (&key, 1);
     
@@ -1792,6 +1994,55 @@ int BRBIP38KeyTests()
     
     printf("\n");
 
+    // scrypt, rfc 7914 section 12 test vectors, with each kernel, and in scratch memory for 1 to 3 lanes
+    UInt512 dk;
+    
+    for (unsigned k = 0; k < 2; k++) {
+        BRScryptSetKernels((k == 0) ? 0 : ~0u);
+        
+        BRScrypt(&dk, sizeof(dk), "password", 8, "NaCl", 4, 1024, 8, 16);
+        if (! UInt512Eq(*(UInt512 *)"\xfd\xba\xbe\x1c\x9d\x34\x72\x00\x78\x56\xe7\x19\x0d\x01\xe9\xfe\x7c\x6a\xd7\xcb\xc8\x23"
+                                   "\x78\x30\xe7\x73\x76\x63\x4b\x37\x31\x62\x2e\xaf\x30\xd9\x2e\x22\xa3\x88\x6f\xf1\x09\x27"
+                                   "\x9d\x98\x30\xda\xc7\x27\xaf\xb9\x4a\x83\xee\x6d\x83\x60\xcb\xdf\xa2\xcc\x06\x40",
+                        dk)) r = 0, fprintf(stderr, "***FAILED*** %s: BRScrypt() test 1, kernels %x\n", __func__, BRScryptKernels());
+        
+        BRScrypt(&dk, sizeof(dk), "pleaseletmein", 13, "SodiumChloride", 14, 16384, 8, 1);
+        if (! UInt512Eq(*(UInt512 *)"\x70\x23\xbd\xcb\x3a\xfd\x73\x48\x46\x1c\x06\xcd\x81\xfd\x38\xeb\xfd\xa8\xfb\xba\x90\x4f"
+                                   "\x8e\x3e\xa9\xb5\x43\xf6\x54\x5d\xa1\xf2\xd5\x43\x29\x55\x61\x3f\x0f\xcf\x62\xd4\x97\x05"
+                                   "\x24\x2a\x9a\xf9\xe6\x1e\x85\xdc\x0d\x65\x1e\x40\xdf\xcf\x01\x7b\x45\x57\x58\x87",
+                        dk)) r = 0, fprintf(stderr, "***FAILED*** %s: BRScrypt() test 2, kernels %x\n", __func__, BRScryptKernels());
+        
+        for (unsigned lanes = 1; lanes <= 3; lanes++) {
+            size_t scratchLen = BRScryptScratchSize(1024, 8, lanes);
+            uint8_t *scratch = malloc(scratchLen);
+            
+            BRScryptWithScratch(&dk, sizeof(dk), "password", 8, "NaCl", 4, 1024, 8, 16, scratch, scratchLen);
+            if (! UInt512Eq(*(UInt512 *)"\xfd\xba\xbe\x1c\x9d\x34\x72\x00\x78\x56\xe7\x19\x0d\x01\xe9\xfe\x7c\x6a\xd7\xcb\xc8\x23"
+                                       "\x78\x30\xe7\x73\x76\x63\x4b\x37\x31\x62\x2e\xaf\x30\xd9\x2e\x22\xa3\x88\x6f\xf1\x09\x27"
+                                       "\x9d\x98\x30\xda\xc7\x27\xaf\xb9\x4a\x83\xee\x6d\x83\x60\xcb\xdf\xa2\xcc\x06\x40",
+                            dk)) r = 0, fprintf(stderr, "***FAILED*** %s: BRScryptWithScratch() test %u\n", __func__, lanes);
+            
+            for (size_t i = 0; i < scratchLen; i++) {
+                if (scratch[i] != 0) { r = 0, fprintf(stderr, "***FAILED*** %s: BRScryptWithScratch() clean\n", __func__); break; }
+            }
+            
+            free(scratch);
+        }
+    }
+    
+    BRScryptSetKernels(~0u);
+
+    // bip38 scrypt runs one lane, the memory it always took, unless allowed more
+    unsigned processors = processor_count_brd();
+
+    if (BRScryptLanes(16384, 8, 8) != 1) r = 0, fprintf(stderr, "***FAILED*** %s: BRScryptLanes() test 1\n", __func__);
+    BRScryptSetParallelMemory(BRScryptScratchSize(16384, 8, 3));
+    if (BRScryptLanes(16384, 8, 8) != ((processors < 3) ? processors : 3))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRScryptLanes() test 2\n", __func__);
+    BRScryptSetParallelMemory(BR_SCRYPT_PARALLEL_MEM);
+    if (BRScryptLanes(1024, 1, 8) != ((processors < 8) ? processors : 8))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRScryptLanes() test 3\n", __func__);
+
     // non EC multiplied, uncompressed
     if (! BRKeySetPrivKey(&key, BRMainNetParams->addrParams, "5KN7MzqK5wt2TP1fQCYyHBtDrXdJuXbUzm4A9rKAteGu3Qi5CVR") ||
         ! BRKeyBIP38Key(&key, bip38Key, sizeof(bip38Key), "TestingOneTwoThree", BRMainNetParams->addrParams) ||
@@ -1886,6 +2137,29 @@ int BRBIP38KeyTests()
     if (BRKeySetBIP38Key(&key, "6PRW5o9FLp4gJDDVqJQKJFTpMvdsSGJxMYHtHaQBF3ooa8mwD69bapcDQn", "foobar", BRMainNetParams->addrParams))
         r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38Key() test 10\n", __func__);
 
+    // one decryption, checked against several address params, with reused scratch memory
+    BRAddressParams params[] = { BRTestNetParams->addrParams, BRMainNetParams->addrParams };
+    size_t scratchLen = BRBIP38ScratchSize();
+    void *scratch = malloc(scratchLen);
+    
+    if (BRKeySetBIP38KeyWithParams(&key, "6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg", "TestingOneTwoThree",
+                                   params, 2, scratch, scratchLen) != 2 ||
+        ! BRKeyPrivKey(&key, privKey, sizeof(privKey), BRMainNetParams->addrParams) ||
+        strncmp(privKey, "5KN7MzqK5wt2TP1fQCYyHBtDrXdJuXbUzm4A9rKAteGu3Qi5CVR", sizeof(privKey)) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38KeyWithParams() test 1\n", __func__);
+    
+    if (BRKeySetBIP38KeyWithParams(&key, "6PfQu77ygVyJLZjfvMLyhLMQbYnu5uguoJJ4kMCLqWwPEdfpwANVS76gTX", "TestingOneTwoThree",
+                                   params, 2, scratch, scratchLen) != 2 ||
+        ! BRKeyPrivKey(&key, privKey, sizeof(privKey), BRMainNetParams->addrParams) ||
+        strncmp(privKey, "5K4caxezwjGCGfnoPTZ8tMcJBLB7Jvyjv4xxeacadhq8nLisLR2", sizeof(privKey)) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38KeyWithParams() test 2\n", __func__);
+    
+    if (BRKeySetBIP38KeyWithParams(&key, "6PRW5o9FLp4gJDDVqJQKJFTpMvdsSGJxMYHtHaQBF3ooa8mwD69bapcDQn", "foobar",
+                                   params, 2, scratch, scratchLen) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38KeyWithParams() test 3\n", __func__);
+    
+    free(scratch);
+
     printf("                                    ");
     return r;
 }
@@ -1987,6 +2261,27 @@ int BRAddressTests()
     if (! BRAddressEq(&addr7, &addr8))
         r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAddressFromWitness() test 2", __func__);
 
+    BRAddressParams params[] = { BITCOIN_ADDRESS_PARAMS, BITCOIN_ADDRESS_PARAMS, BITCOIN_TEST_ADDRESS_PARAMS };
+    UInt160 hashes[70];
+    BRAddress batch[70], single;
+
+    params[1].bech32Prefix = NULL; // legacy base58check addresses
+
+    for (size_t i = 0; i < 70; i++) {
+        for (size_t j = 0; j < sizeof(UInt160); j++) hashes[i].u8[j] = (j < i % 4) ? 0 : (uint8_t)(i*31 + j*7);
+    }
+
+    for (size_t i = 0; i < sizeof(params)/sizeof(*params); i++) {
+        if (BRAddressFromHash160Batch(batch, params[i], hashes, 70) != 70)
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAddressFromHash160Batch() test %zu", __func__, i);
+
+        for (size_t j = 0; j < 70; j++) {
+            BRAddressFromHash160(single.s, sizeof(single), params[i], &hashes[j]);
+            if (! BRAddressEq(&batch[j], &single))
+                r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAddressFromHash160Batch() test %zu-%zu", __func__, i, j);
+        }
+    }
+
     if (! r) fprintf(stderr, "\n                                    ");
     return r;
 }
@@ -2134,6 +2429,15 @@ int BRBIP39MnemonicTests()
                     "\xf4\x76\xc4\x5c\x88\x25\x32\x76\xd9\xfd\x0d\xf6\xef\x48\x60\x9e\x8b\xb7\xdc\xa8"))
         r = 0, fprintf(stderr, "***FAILED*** %s: BRBIP39DeriveKey() test 8\n", __func__);
 
+    uint8_t dk1[100], dk2[100];
+    char pw[strlen(phrase) + strlen(phrase2) + 1];
+
+    // multi-block output, and a password longer than the hmac block size
+    strcpy(pw, phrase), strcat(pw, phrase2);
+    BRPBKDF2(dk1, sizeof(dk1), BRSHA512, 64, pw, strlen(pw), phrase3, strlen(phrase3), 3);
+    BRPBKDF2SHA512(dk2, sizeof(dk2), pw, strlen(pw), phrase3, strlen(phrase3), 3);
+    if (memcmp(dk1, dk2, sizeof(dk1)) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: BRPBKDF2SHA512() test 1\n", __func__);
+
     return r;
 }
 
@@ -2177,6 +2481,38 @@ int BRBIP32SequenceTests()
                     uint256("7b6a7dd645507d775215a9035be06700e1ed8c541da9351b4bd14bd50ab61428")))
         r = 0, fprintf(stderr, "***FAILED*** %s: BRBIP32PubKey() test\n", __func__);
 
+    BRECPoint pubKeys[100];
+    clock_t t;
+    size_t i;
+
+    if (BRBIP32PubKeyList(pubKeys, 100, mpk, SEQUENCE_EXTERNAL_CHAIN, 0) != 100 ||
+        memcmp(pubKeys[0].p, pubKey, sizeof(pubKey)) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRBIP32PubKeyList() test 1\n", __func__);
+
+    for (i = 0; i < 100; i++) {
+        BRBIP32PubKey(pubKey, sizeof(pubKey), mpk, SEQUENCE_EXTERNAL_CHAIN, (uint32_t)i);
+        if (memcmp(pubKeys[i].p, pubKey, sizeof(pubKey)) != 0) break;
+    }
+
+    if (i < 100) r = 0, fprintf(stderr, "***FAILED*** %s: BRBIP32PubKeyList() test 2\n", __func__);
+
+    // crosses into hardened indexes, which leave the chain key as BRBIP32PubKey() does
+    BRBIP32PubKeyList(pubKeys, 100, mpk, SEQUENCE_INTERNAL_CHAIN, 0x7fffffce);
+
+    for (i = 0; i < 100; i++) {
+        BRBIP32PubKey(pubKey, sizeof(pubKey), mpk, SEQUENCE_INTERNAL_CHAIN, 0x7fffffce + (uint32_t)i);
+        if (memcmp(pubKeys[i].p, pubKey, sizeof(pubKey)) != 0) break;
+    }
+
+    if (i < 100) r = 0, fprintf(stderr, "***FAILED*** %s: BRBIP32PubKeyList() test 3\n", __func__);
+
+    t = clock();
+    for (i = 0; i < 1000; i++) BRBIP32PubKey(pubKey, sizeof(pubKey), mpk, SEQUENCE_EXTERNAL_CHAIN, (uint32_t)i);
+    printf("BRBIP32PubKey() x1000: %.1fms\n", (double)(clock() - t)*1000.0/CLOCKS_PER_SEC);
+    t = clock();
+    for (i = 0; i < 1000; i += 100) BRBIP32PubKeyList(pubKeys, 100, mpk, SEQUENCE_EXTERNAL_CHAIN, (uint32_t)i);
+    printf("BRBIP32PubKeyList() x1000: %.1fms\n", (double)(clock() - t)*1000.0/CLOCKS_PER_SEC);
+
     UInt512 dk;
     BRAddress addr;
 
@@ -2485,6 +2821,16 @@ int BRTransactionTests()
     tgt = BRTransactionCopy(src);
     if (! BRTransactionEqual(tgt, src))
         r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionCopy() test 3", __func__);
+
+    // parsed and copied transactions are compact, but must still be mutable
+    BRTransactionAddOutput(tgt, 1000000, script, scriptLen);
+    BRTransactionAddInput(tgt, inHash, 1, 1, script, scriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTxOutputSetScript(&tgt->outputs[0], wscript, wscriptLen);
+    if (tgt->inCount != src->inCount + 1 || tgt->outCount != src->outCount + 1 ||
+        tgt->outputs[0].scriptLen != wscriptLen || memcmp(tgt->outputs[0].script, wscript, wscriptLen) != 0 ||
+        tgt->inputs[0].sigLen != src->inputs[0].sigLen ||
+        memcmp(tgt->inputs[0].signature, src->inputs[0].signature, src->inputs[0].sigLen) != 0)
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionCopy() test 4", __func__);
     BRTransactionFree(tgt);
     BRTransactionFree(src);
 
@@ -2649,7 +2995,14 @@ int BRWalletTests()
     if (tx) tx->timestamp = 1, BRWalletRegisterTransaction(w, tx);
     if (tx && BRWalletBalance(w) + BRWalletFeeForTx(w, tx) != SATOSHIS/2)
         r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 5\n", __func__);
-    
+
+    // repeat queries hit the wallet's cached amounts for registered transactions
+    for (int i = 0; tx && i < 2; i++) {
+        if (BRWalletAmountSentByTx(w, tx) != SATOSHIS ||
+            BRWalletAmountReceivedFromTx(w, tx) + BRWalletFeeForTx(w, tx) != SATOSHIS/2)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletAmountSentByTx() test %d\n", __func__, i + 1);
+    }
+
     if (BRWalletTransactions(w, NULL, 0) != 2)
         r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletTransactions() test 3\n", __func__);
     
@@ -2723,6 +3076,113 @@ int BRWalletTests()
     return r;
 }
 
+// returns true if the wallet's amounts for tx match those computed for an unregistered copy, which are never cached
+static int _BRWalletTxAmountsAreFresh(BRWallet *w, const BRTransaction *tx)
+{
+    BRTransaction *cpy = BRTransactionCopy(tx);
+    int r = (BRWalletAmountReceivedFromTx(w, tx) == BRWalletAmountReceivedFromTx(w, cpy) &&
+             BRWalletAmountSentByTx(w, tx) == BRWalletAmountSentByTx(w, cpy) &&
+             BRWalletFeeForTx(w, tx) == BRWalletFeeForTx(w, cpy));
+
+    BRTransactionFree(cpy);
+    return r;
+}
+
+int BRWalletTxAmountsTests()
+{
+    int r = 1;
+    const char *phrase = "a random seed";
+    UInt512 seed;
+
+    BRBIP39DeriveKey(&seed, phrase, NULL);
+
+    BRMasterPubKey mpk = BRBIP32MasterPubKey(&seed, sizeof(seed));
+    BRWallet *w = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+    UInt256 secret = uint256("0000000000000000000000000000000000000000000000000000000000000001"),
+            inHash = uint256("0000000000000000000000000000000000000000000000000000000000000001"), otherHash;
+    BRKey k;
+    BRAddress addr, recvAddr = BRWalletReceiveAddress(w);
+    BRTransaction *fund, *spend, *other, *child;
+
+    BRKeySetSecret(&k, &secret, 1);
+    BRKeyAddress(&k, addr.s, sizeof(addr), BRMainNetParams->addrParams);
+
+    uint8_t inScript[BRAddressScriptPubKey(NULL, 0, BRMainNetParams->addrParams, addr.s)];
+    size_t inScriptLen = BRAddressScriptPubKey(inScript, sizeof(inScript), BRMainNetParams->addrParams, addr.s);
+    uint8_t outScript[BRAddressScriptPubKey(NULL, 0, BRMainNetParams->addrParams, recvAddr.s)];
+    size_t outScriptLen = BRAddressScriptPubKey(outScript, sizeof(outScript), BRMainNetParams->addrParams, recvAddr.s);
+
+    fund = BRTransactionNew();
+    BRTransactionAddInput(fund, inHash, 0, 1, inScript, inScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(fund, SATOSHIS, outScript, outScriptLen);
+    BRTransactionSign(fund, 0, &k, 1);
+
+    spend = BRTransactionNew();
+    BRTransactionAddInput(spend, fund->txHash, 0, SATOSHIS, outScript, outScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(spend, SATOSHIS/4, inScript, inScriptLen);
+    BRTransactionAddOutput(spend, SATOSHIS/2, outScript, outScriptLen);
+    BRWalletSignTransaction(w, spend, 0x00, &seed, sizeof(seed));
+
+    // a wallet tx spending an output of a tx the wallet doesn't have yet sends nothing and has no known fee
+    BRWalletRegisterTransaction(w, spend);
+    if (BRWalletAmountReceivedFromTx(w, spend) != SATOSHIS/2 || BRWalletAmountSentByTx(w, spend) != 0 ||
+        BRWalletFeeForTx(w, spend) != UINT64_MAX || ! _BRWalletTxAmountsAreFresh(w, spend))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 1\n", __func__);
+
+    // registering the spent tx changes the cached amounts of the tx spending it
+    BRWalletRegisterTransaction(w, fund);
+    if (BRWalletAmountReceivedFromTx(w, spend) != SATOSHIS/2 || BRWalletAmountSentByTx(w, spend) != SATOSHIS ||
+        BRWalletFeeForTx(w, spend) != SATOSHIS/4 || ! _BRWalletTxAmountsAreFresh(w, spend))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 2\n", __func__);
+
+    if (BRWalletAmountReceivedFromTx(w, fund) != SATOSHIS || BRWalletAmountSentByTx(w, fund) != 0 ||
+        ! _BRWalletTxAmountsAreFresh(w, fund))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 3\n", __func__);
+
+    // confirming wallet txs changes no amounts
+    UInt256 hashes[] = { fund->txHash, spend->txHash };
+    BRWalletUpdateTransactions(w, hashes, 2, 1000, 1);
+    if (BRWalletAmountSentByTx(w, spend) != SATOSHIS || BRWalletFeeForTx(w, spend) != SATOSHIS/4 ||
+        ! _BRWalletTxAmountsAreFresh(w, spend) || ! _BRWalletTxAmountsAreFresh(w, fund))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletUpdateTransactions() test 1\n", __func__);
+
+    // an unconfirmed non-wallet tx is kept for the fee of a wallet tx spending it...
+    other = BRTransactionNew();
+    BRTransactionAddInput(other, inHash, 1, 1, inScript, inScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(other, SATOSHIS, inScript, inScriptLen);
+    BRTransactionSign(other, 0, &k, 1);
+    otherHash = other->txHash;
+
+    child = BRTransactionNew();
+    BRTransactionAddInput(child, otherHash, 0, SATOSHIS, inScript, inScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(child, SATOSHIS/2, outScript, outScriptLen);
+    BRTransactionSign(child, 0, &k, 1);
+
+    BRWalletRegisterTransaction(w, child);
+    if (BRWalletAmountReceivedFromTx(w, child) != SATOSHIS/2 || BRWalletFeeForTx(w, child) != UINT64_MAX ||
+        ! _BRWalletTxAmountsAreFresh(w, child))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 4\n", __func__);
+
+    if (BRWalletRegisterTransaction(w, other) || BRWalletAmountReceivedFromTx(w, child) != SATOSHIS/2 ||
+        BRWalletFeeForTx(w, child) != SATOSHIS/2 || ! _BRWalletTxAmountsAreFresh(w, child))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 5\n", __func__);
+
+    // ...until it's confirmed, when it's removed and freed, and the fee is no longer known
+    BRWalletUpdateTransactions(w, &otherHash, 1, 1001, 2);
+    if (BRWalletTransactionForHash(w, otherHash) != NULL || BRWalletAmountReceivedFromTx(w, child) != SATOSHIS/2 ||
+        BRWalletFeeForTx(w, child) != UINT64_MAX || ! _BRWalletTxAmountsAreFresh(w, child))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletUpdateTransactions() test 2\n", __func__);
+
+    // removing the funding tx, and with it the tx spending it, leaves every tx's amounts correct
+    BRWalletRemoveTransaction(w, fund->txHash);
+    if (BRWalletTransactions(w, NULL, 0) != 1 || ! _BRWalletTxAmountsAreFresh(w, fund) ||
+        ! _BRWalletTxAmountsAreFresh(w, spend) || ! _BRWalletTxAmountsAreFresh(w, child))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRemoveTransaction() test\n", __func__);
+
+    BRWalletFree(w);
+    return r;
+}
+
 int BRBloomFilterTests()
 {
     int r = 1;
@@ -3401,6 +3861,8 @@ int BRRunTests()
     printf("%s\n", (BRTransactionTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRWalletTests...                    ");
     printf("%s\n", (BRWalletTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRWalletTxAmountsTests...           ");
+    printf("%s\n", (BRWalletTxAmountsTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRBloomFilterTests...               ");
     printf("%s\n", (BRBloomFilterTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRMerkleBlockTests...               ");
@@ -18,6 +18,10 @@
 
 #include "BRCryptoAmount.h"
 #include "BRCryptoWallet.h"
+#include "BRCryptoSigner.h"
+#include "BRCryptoHasher.h"
+#include "crypto/BRCryptoClientP.h"
+#include "crypto/BRCryptoKeyP.h"
 #include "crypto/BRCryptoNetworkP.h"
 #include "crypto/BRCryptoTransferP.h"
 #include "crypto/BRCryptoWalletP.h"
@@ -31,6 +35,7 @@
 #include "bitcoin/BRWallet.h"
 
 #include "crypto/handlers/btc/BRCryptoBTC.h"
+#include "crypto/handlers/eth/BRCryptoETH.h"
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -309,6 +314,602 @@ runCryptoTransferTests (void) {
     transferTestsAddress();
 }
 
+///
+/// Mark: BRCryptoClient Tests
+///
+
+static BRCryptoClientTransferBundle
+clientTestsTransferBundleRlpRoundTrip (BRCryptoClientTransferBundle bundle) {
+    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpItem  item  = cryptoClientTransferBundleRlpEncode (bundle, coder);
+    BRRlpData  data  = rlpItemGetData (coder, item);
+    rlpItemRelease (coder, item);
+
+    item = rlpDataGetItem (coder, data);
+    BRCryptoClientTransferBundle decoded = cryptoClientTransferBundleRlpDecode (item, coder);
+    rlpItemRelease (coder, item);
+    rlpCoderRelease (coder);
+    free (data.bytes);
+
+    return decoded;
+}
+
+// Decode a binary bundle encoded with the given hash and address lengths, fee count and format.
+static BRCryptoClientTransferBundle
+clientTestsTransferBundleBinaryRlpDecode (size_t hashCount,
+                                          size_t addressCount,
+                                          size_t feeCount,
+                                          uint64_t format) {
+    uint8_t bytes[64] = { 0 };
+
+    BRRlpCoder coder = rlpCoderCreate();
+
+    BRRlpItem feeItems[2];
+    for (size_t index = 0; index < feeCount; index++)
+        feeItems[index] = rlpEncodeUInt256 (coder, UINT256_ZERO, 0);
+
+    BRRlpItem item = rlpEncodeList (coder, 16,
+                                    rlpEncodeUInt64 (coder, CRYPTO_TRANSFER_STATE_INCLUDED, 0),
+                                    rlpEncodeString (coder, "eth:uids"),
+                                    rlpEncodeBytes  (coder, bytes, hashCount),
+                                    rlpEncodeString (coder, "eth:identifier"),
+                                    rlpEncodeBytes  (coder, bytes, addressCount),
+                                    rlpEncodeBytes  (coder, bytes, 20),
+                                    rlpEncodeUInt256 (coder, UINT256_ZERO, 0),
+                                    rlpEncodeString (coder, "ethereum-mainnet:__native__"),
+                                    rlpEncodeListItems (coder, feeItems, feeCount),
+                                    rlpEncodeUInt64 (coder, 1588000000, 0),
+                                    rlpEncodeUInt64 (coder, 10000000,   0),
+                                    rlpEncodeUInt64 (coder, 10,         0),
+                                    rlpEncodeUInt64 (coder, 3,          0),
+                                    rlpEncodeBytes  (coder, bytes, hashCount),
+                                    rlpEncodeListItems (coder, NULL, 0),
+                                    rlpEncodeUInt64 (coder, format, 0));
+    BRRlpData data = rlpItemGetData (coder, item);
+    rlpItemRelease (coder, item);
+
+    item = rlpDataGetItem (coder, data);
+    BRCryptoClientTransferBundle decoded = cryptoClientTransferBundleRlpDecode (item, coder);
+    rlpItemRelease (coder, item);
+    rlpCoderRelease (coder);
+    free (data.bytes);
+
+    return decoded;
+}
+
+static void
+clientTestsTransferBundleBinaryMalformed (void) {
+    BRCryptoClientTransferBundle decoded = clientTestsTransferBundleBinaryRlpDecode (32, 20, 1, 1);
+    assert (NULL != decoded && decoded->isBinary && decoded->binary.hasFee);
+    cryptoClientTransferBundleRelease (decoded);
+
+    // Bad hash and address lengths, too many fees and an unknown format all fail.
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (31, 20, 0, 1));
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (33, 20, 0, 1));
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (0,  20, 0, 1));
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (32, 19, 0, 1));
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (32, 64, 0, 1));
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (32, 20, 2, 1));
+    assert (NULL == clientTestsTransferBundleBinaryRlpDecode (32, 20, 0, 2));
+
+    // As does a bundle of neither 15 nor 16 items.
+    BRRlpCoder coder = rlpCoderCreate();
+    for (size_t itemsCount = 0; itemsCount <= 17; itemsCount += (13 == itemsCount ? 3 : 1)) {
+        BRRlpItem items[17];
+        for (size_t index = 0; index < itemsCount; index++)
+            items[index] = rlpEncodeUInt64 (coder, index, 0);
+
+        BRRlpItem item = rlpEncodeListItems (coder, items, itemsCount);
+        assert (NULL == cryptoClientTransferBundleRlpDecode (item, coder));
+        rlpItemRelease (coder, item);
+    }
+    rlpCoderRelease (coder);
+}
+
+static void
+clientTestsTransferBundleBinary (void) {
+    const char *keys[] = { "gasLimit", "gasUsed", "gasPrice", "nonce" };
+    const char *vals[] = { "21000",    "21000",   "2000000000", "7" };
+
+    BRCryptoClientTransferBundleBinary binary;
+    memset (&binary, 0, sizeof (binary));
+    for (size_t index = 0; index < sizeof (binary.hash.data); index++) {
+        binary.hash.data[index]      = (uint8_t) index;
+        binary.blockHash.data[index] = (uint8_t) (0xff - index);
+    }
+    memset (binary.from, 0x11, sizeof (binary.from));
+    memset (binary.to,   0x22, sizeof (binary.to));
+    binary.amount.data[31] = 0x01; binary.amount.data[23] = 0x02;   // 2 * 2^64 + 1
+    binary.hasFee = CRYPTO_FALSE;
+
+    BRCryptoClientTransferBundle bundle =
+    cryptoClientTransferBundleCreateBinary (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                            "eth:uids", "eth:identifier", "ethereum-mainnet:__native__",
+                                            &binary,
+                                            1588000000, 10000000, 10, 3,
+                                            4, keys, vals);
+
+    assert (bundle->isBinary);
+    assert (NULL == bundle->hash && NULL == bundle->from && NULL == bundle->amount);
+    assert (1 == bundle->binary.amount.u64[0] && 2 == bundle->binary.amount.u64[1]);
+    assert (0 == bundle->binary.amount.u64[2] && 0 == bundle->binary.amount.u64[3]);
+
+    BRCryptoClientTransferBundle decoded = clientTestsTransferBundleRlpRoundTrip (bundle);
+
+    assert (decoded->isBinary);
+    assert (0 == strcmp (bundle->uids,       decoded->uids));
+    assert (0 == strcmp (bundle->identifier, decoded->identifier));
+    assert (0 == strcmp (bundle->currency,   decoded->currency));
+    assert (0 == memcmp (&bundle->binary.hash,      &decoded->binary.hash,      sizeof (BRCryptoData32)));
+    assert (0 == memcmp (&bundle->binary.blockHash, &decoded->binary.blockHash, sizeof (BRCryptoData32)));
+    assert (0 == memcmp (bundle->binary.from, decoded->binary.from, sizeof (bundle->binary.from)));
+    assert (0 == memcmp (bundle->binary.to,   decoded->binary.to,   sizeof (bundle->binary.to)));
+    assert (UInt256Eq (bundle->binary.amount, decoded->binary.amount));
+    assert (!decoded->binary.hasFee);
+    assert (bundle->blockNumber == decoded->blockNumber);
+    assert (bundle->blockTransactionIndex == decoded->blockTransactionIndex);
+    assert (4 == decoded->attributesCount);
+    assert (0 == strcmp ("nonce", decoded->attributeKeys[3]) && 0 == strcmp ("7", decoded->attributeVals[3]));
+    cryptoClientTransferBundleRelease (decoded);
+
+    // With a fee of zero, distinct from no fee
+    bundle->binary.hasFee = true;
+    decoded = clientTestsTransferBundleRlpRoundTrip (bundle);
+    assert (decoded->binary.hasFee && UInt256Eq (UINT256_ZERO, decoded->binary.fee));
+    cryptoClientTransferBundleRelease (decoded);
+
+    cryptoClientTransferBundleRelease (bundle);
+
+    // A string bundle still decodes as a string bundle
+    bundle = cryptoClientTransferBundleCreate (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                               "eth:uids", "0xab", "0xab", "0x11", "0x22", "1",
+                                               "ethereum-mainnet:__native__", NULL,
+                                               1588000000, 10000000, 10, 3, "0xcd",
+                                               0, NULL, NULL);
+    decoded = clientTestsTransferBundleRlpRoundTrip (bundle);
+    assert (!decoded->isBinary);
+    assert (0 == strcmp ("0xab", decoded->hash) && 0 == strcmp ("1", decoded->amount));
+    assert (NULL == decoded->fee);
+    cryptoClientTransferBundleRelease (decoded);
+    cryptoClientTransferBundleRelease (bundle);
+}
+
+static void
+clientTestsTransferBundleExtractETH (void) {
+    const char *keys[] = { "gasLimit", "GasUsed", "gasPrice", "nonce", "nonce" };
+    const char *vals[] = { "60000",    "52000",   "2000000000", "7",   "8" };
+
+    BRCryptoClientTransferBundleBinary binary;
+    memset (&binary, 0, sizeof (binary));
+    for (size_t index = 0; index < sizeof (binary.hash.data); index++)
+        binary.hash.data[index] = (uint8_t) index;
+    memset (binary.from, 0x11, sizeof (binary.from));
+    memset (binary.to,   0x22, sizeof (binary.to));
+    binary.amount.data[31] = 0x01; binary.amount.data[23] = 0x02;   // 2 * 2^64 + 1
+
+    const char *currency = "ethereum-mainnet:0x558ec3152e2eb2174905cd19aea4e34a23de9ad6";
+
+    BRCryptoClientTransferBundle bundleBinary =
+    cryptoClientTransferBundleCreateBinary (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                            "erc20:uids", "erc20:identifier", currency,
+                                            &binary,
+                                            1588000000, 10000000, 10, 3,
+                                            5, keys, vals);
+
+    // The same ERC20 transfer, as strings
+    BRCryptoClientTransferBundle bundleString =
+    cryptoClientTransferBundleCreate (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                      "erc20:uids",
+                                      "0x000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+                                      "erc20:identifier",
+                                      "0x1111111111111111111111111111111111111111",
+                                      "0x2222222222222222222222222222222222222222",
+                                      "36893488147419103233",
+                                      currency, NULL,
+                                      1588000000, 10000000, 10, 3,
+                                      "0xffeeddccbbaa99887766554433221100ffeeddccbbaa99887766554433221100",
+                                      5, keys, vals);
+
+    BRCryptoTransferBundleETH valuesBinary, valuesString;
+    assert (!cryptoClientTransferBundleExtractETH (bundleBinary, &valuesBinary));
+    assert (!cryptoClientTransferBundleExtractETH (bundleString, &valuesString));
+
+    assert (0 == memcmp (binary.hash.data, valuesBinary.hash.bytes, sizeof (binary.hash.data)));
+    assert (0 == memcmp (binary.from, valuesBinary.source.bytes, sizeof (binary.from)));
+    assert (0 == memcmp (binary.to,   valuesBinary.target.bytes, sizeof (binary.to)));
+    assert (valuesBinary.sourceIsValid && valuesBinary.targetIsValid);
+    assert (1 == valuesBinary.amount.u64[0] && 2 == valuesBinary.amount.u64[1]);
+
+    // Attribute keys are case-insensitive; the first of a repeated key is used
+    assert (60000 == valuesBinary.gasLimit && 52000 == valuesBinary.gasUsed && 7 == valuesBinary.nonce);
+    assert (UInt256Eq (uint256Create (2000000000), valuesBinary.gasPrice));
+
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual    (valuesBinary.hash,   valuesString.hash)));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethAddressEqual (valuesBinary.source, valuesString.source)));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethAddressEqual (valuesBinary.target, valuesString.target)));
+    assert (valuesString.sourceIsValid && valuesString.targetIsValid);
+    assert (UInt256Eq (valuesBinary.amount,   valuesString.amount));
+    assert (UInt256Eq (valuesBinary.gasPrice, valuesString.gasPrice));
+    assert (valuesBinary.gasLimit == valuesString.gasLimit);
+    assert (valuesBinary.gasUsed  == valuesString.gasUsed);
+    assert (valuesBinary.nonce    == valuesString.nonce);
+
+    cryptoClientTransferBundleRelease (bundleString);
+    cryptoClientTransferBundleRelease (bundleBinary);
+
+    // A contract creation has no target; that is not an error
+    bundleString =
+    cryptoClientTransferBundleCreate (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                      "eth:uids",
+                                      "0x000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+                                      "eth:identifier",
+                                      "0x1111111111111111111111111111111111111111",
+                                      "",
+                                      "0",
+                                      "ethereum-mainnet:__native__", NULL,
+                                      1588000000, 10000000, 10, 3,
+                                      "0xffeeddccbbaa99887766554433221100ffeeddccbbaa99887766554433221100",
+                                      4, keys, vals);
+    assert (!cryptoClientTransferBundleExtractETH (bundleString, &valuesString));
+    assert (valuesString.sourceIsValid && !valuesString.targetIsValid);
+    cryptoClientTransferBundleRelease (bundleString);
+
+    // A missing attribute is an error
+    bundleString =
+    cryptoClientTransferBundleCreate (CRYPTO_TRANSFER_STATE_INCLUDED,
+                                      "eth:uids",
+                                      "0x000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+                                      "eth:identifier",
+                                      "0x1111111111111111111111111111111111111111",
+                                      "0x2222222222222222222222222222222222222222",
+                                      "1",
+                                      "ethereum-mainnet:__native__", NULL,
+                                      1588000000, 10000000, 10, 3,
+                                      "0xffeeddccbbaa99887766554433221100ffeeddccbbaa99887766554433221100",
+                                      3, keys, vals);
+    assert (cryptoClientTransferBundleExtractETH (bundleString, &valuesString));
+    cryptoClientTransferBundleRelease (bundleString);
+}
+
+static void
+runCryptoClientTests (void) {
+    clientTestsTransferBundleBinary();
+    clientTestsTransferBundleBinaryMalformed();
+    clientTestsTransferBundleExtractETH();
+}
+
+///
+/// Mark: BRCryptoKey Tests
+///
+
+#define KEY_TESTS_ASYNC_COUNT       (3)
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    size_t count;
+    size_t order[KEY_TESTS_ASYNC_COUNT];
+    BRCryptoKey keys[KEY_TESTS_ASYNC_COUNT];
+} KeyTestsAsyncState;
+
+typedef struct {
+    KeyTestsAsyncState *state;
+    size_t index;
+} KeyTestsAsyncContext;
+
+static void
+keyTestsAsyncCallback (BRCryptoKeyCreateContext context,
+                       OwnershipGiven BRCryptoKey key) {
+    KeyTestsAsyncContext *asyncContext = context;
+    KeyTestsAsyncState   *state        = asyncContext->state;
+
+    pthread_mutex_lock (&state->lock);
+    assert (state->count < KEY_TESTS_ASYNC_COUNT);
+    state->order[state->count++]     = asyncContext->index;
+    state->keys[asyncContext->index] = key;
+    pthread_cond_signal (&state->cond);
+    pthread_mutex_unlock (&state->lock);
+}
+
+static void
+keyTestsAsyncWait (KeyTestsAsyncState *state, size_t count) {
+    pthread_mutex_lock (&state->lock);
+    while (state->count < count)
+        pthread_cond_wait (&state->cond, &state->lock);
+    pthread_mutex_unlock (&state->lock);
+}
+
+static void
+keyTestsProtectedPrivateAsync (void) {
+    // BIP38 test vectors; the second with the wrong passphrase
+    const char *protectedKeys[KEY_TESTS_ASYNC_COUNT] = {
+        "6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg",
+        "6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq",
+        "6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq"
+    };
+    const char *passphrases[KEY_TESTS_ASYNC_COUNT] = {
+        "TestingOneTwoThree",
+        "TestingOneTwoThree",
+        "Satoshi"
+    };
+    const char *privateKeys[KEY_TESTS_ASYNC_COUNT] = {
+        "5KN7MzqK5wt2TP1fQCYyHBtDrXdJuXbUzm4A9rKAteGu3Qi5CVR",
+        NULL,
+        "5HtasZ6ofTHP6HCwTqTkLDuLQisYPah7aUnSKfC7h4hMUVw2gi5"
+    };
+
+    KeyTestsAsyncState state;
+    memset (&state, 0, sizeof (state));
+    pthread_mutex_init (&state.lock, NULL);
+    pthread_cond_init  (&state.cond, NULL);
+
+    KeyTestsAsyncContext contexts[KEY_TESTS_ASYNC_COUNT];
+
+    // Not a BIP38 key; never queued
+    assert (CRYPTO_FALSE == cryptoKeyCreateFromStringProtectedPrivateAsync (privateKeys[0], passphrases[0],
+                                                                            &contexts[0], keyTestsAsyncCallback));
+
+    // Queue all three before the first completes
+    for (size_t index = 0; index < KEY_TESTS_ASYNC_COUNT; index++) {
+        contexts[index] = (KeyTestsAsyncContext) { &state, index };
+        assert (CRYPTO_TRUE == cryptoKeyCreateFromStringProtectedPrivateAsync (protectedKeys[index], passphrases[index],
+                                                                               &contexts[index], keyTestsAsyncCallback));
+    }
+
+    keyTestsAsyncWait (&state, KEY_TESTS_ASYNC_COUNT);
+
+    for (size_t index = 0; index < KEY_TESTS_ASYNC_COUNT; index++) {
+        // Callbacks are in the order queued
+        assert (index == state.order[index]);
+
+        if (NULL == privateKeys[index])
+            assert (NULL == state.keys[index]);
+        else {
+            BRCryptoKey key = cryptoKeyCreateFromStringPrivate (privateKeys[index]);
+            assert (NULL != state.keys[index]);
+            assert (cryptoKeySecretMatch (key, state.keys[index]));
+
+            // The same as the synchronous decryption
+            BRCryptoKey syncKey = cryptoKeyCreateFromStringProtectedPrivate (protectedKeys[index], passphrases[index]);
+            assert (NULL != syncKey && cryptoKeySecretMatch (syncKey, state.keys[index]));
+
+            cryptoKeyGive (syncKey);
+            cryptoKeyGive (key);
+            cryptoKeyGive (state.keys[index]);
+        }
+    }
+
+    pthread_cond_destroy  (&state.cond);
+    pthread_mutex_destroy (&state.lock);
+}
+
+static void
+runCryptoKeyTests (void) {
+    keyTestsProtectedPrivateAsync ();
+}
+
+///
+/// Mark: BRCryptoSigner Tests
+///
+
+#define SIGNER_TESTS_BATCH_COUNT        (200)
+
+// Check the batch calls against the single calls, with every 7th digest altered and every 11th
+// signature truncated.  Every 13th key is made uncompressed after signing; that changes no result.
+static void
+signerTestsBatch (BRCryptoSignerType type) {
+    BRCryptoSigner signer = cryptoSignerCreate (type);
+
+    BRCryptoKey keys[SIGNER_TESTS_BATCH_COUNT];
+    BRCryptoKey recoveredKeys[SIGNER_TESTS_BATCH_COUNT];
+    uint8_t digestBytes[SIGNER_TESTS_BATCH_COUNT][32];
+    uint8_t signatureBytes[SIGNER_TESTS_BATCH_COUNT][73];
+    const uint8_t *digests[SIGNER_TESTS_BATCH_COUNT];
+    const uint8_t *signatures[SIGNER_TESTS_BATCH_COUNT];
+    size_t signatureLens[SIGNER_TESTS_BATCH_COUNT];
+    BRCryptoBoolean results[SIGNER_TESTS_BATCH_COUNT];
+
+    for (size_t index = 0; index < SIGNER_TESTS_BATCH_COUNT; index++) {
+        BRCryptoSecret secret;
+        memset (secret.data, 0, sizeof (secret.data));
+        secret.data[31] = (uint8_t) (index + 1);
+
+        keys[index] = cryptoKeyCreateFromSecret (secret);
+        BRSHA256 (digestBytes[index], &index, sizeof (index));
+
+        signatureLens[index] = cryptoSignerSignLength (signer, keys[index], digestBytes[index], 32);
+        assert (signatureLens[index] <= sizeof (signatureBytes[index]));
+        assert (CRYPTO_TRUE == cryptoSignerSign (signer, keys[index],
+                                                 signatureBytes[index], signatureLens[index],
+                                                 digestBytes[index], 32));
+
+        if (0 == index % 7)  digestBytes[index][0] ^= 1;
+        if (0 == index % 11) signatureLens[index] -= 1;
+        if (0 == index % 13) cryptoKeyProvidePublicKey (keys[index], 1, 0);
+
+        digests[index]    = digestBytes[index];
+        signatures[index] = signatureBytes[index];
+    }
+
+    size_t verified = cryptoSignerVerifyBatch (signer, keys, digests, signatures, signatureLens, results, SIGNER_TESTS_BATCH_COUNT);
+    size_t recovered = cryptoSignerRecoverBatch (signer, recoveredKeys, digests, signatures, signatureLens, SIGNER_TESTS_BATCH_COUNT);
+
+    size_t verifiedSingle  = 0;
+    size_t recoveredSingle = 0;
+
+    for (size_t index = 0; index < SIGNER_TESTS_BATCH_COUNT; index++) {
+        BRKey  *core   = cryptoKeyGetCore (keys[index]);
+        UInt256 digest = UInt256Get (digests[index]);
+        size_t  length = signatureLens[index];
+
+        // The single calls assert on bad lengths; those items fail in a batch
+        BRCryptoKey recoveredKey = (CRYPTO_SIGNER_COMPACT == type && 65 == length
+                                    ? cryptoSignerRecover (signer, digests[index], 32, signatures[index], length)
+                                    : NULL);
+
+        int isVerified = 0;
+        switch (type) {
+            case CRYPTO_SIGNER_BASIC_DER:
+                isVerified = BRKeyVerify (core, digest, signatures[index], length);
+                break;
+            case CRYPTO_SIGNER_BASIC_JOSE:
+                isVerified = (64 == length && BRKeyVerifyJOSE (core, digest, signatures[index], length));
+                break;
+            case CRYPTO_SIGNER_COMPACT:
+                isVerified = (NULL != recoveredKey && cryptoKeyPublicMatch (recoveredKey, keys[index]));
+                break;
+        }
+
+        assert (AS_CRYPTO_BOOLEAN (isVerified) == results[index]);
+        assert (isVerified == (0 != index % 7 && 0 != index % 11));
+        if (isVerified) verifiedSingle += 1;
+
+        assert ((NULL == recoveredKey) == (NULL == recoveredKeys[index]));
+        if (NULL != recoveredKey) {
+            assert (cryptoKeyPublicMatch (recoveredKey, recoveredKeys[index]));
+            recoveredSingle += 1;
+
+            cryptoKeyGive (recoveredKey);
+            cryptoKeyGive (recoveredKeys[index]);
+        }
+
+        cryptoKeyGive (keys[index]);
+    }
+
+    assert (verified  == verifiedSingle);
+    assert (recovered == recoveredSingle);
+
+    cryptoSignerGive (signer);
+}
+
+static void
+runCryptoSignerTests (void) {
+    signerTestsBatch (CRYPTO_SIGNER_BASIC_DER);
+    signerTestsBatch (CRYPTO_SIGNER_BASIC_JOSE);
+    signerTestsBatch (CRYPTO_SIGNER_COMPACT);
+}
+
+///
+/// Mark: BRCryptoHasher Tests
+///
+
+#define HASHER_TESTS_MESSAGE_LENGTH     (700)
+#define HASHER_TESTS_MAXIMUM_LENGTH     (64)
+
+// Fragment sizes, cycled, for feeding a message to cryptoHasherUpdate(); includes empty fragments
+// and fragments either side of the 64, 128 and 136 byte block sizes.
+static const size_t hasherTestsFragments[] = { 0, 1, 0, 63, 64, 65, 0, 3, 127, 128, 129, 0, 135, 136, 137, 5 };
+
+static void
+hasherTestsUpdate (BRCryptoHasher hasher,
+                   const uint8_t *message,
+                   size_t messageLen,
+                   size_t fragment) {
+    size_t offset = 0;
+
+    do {
+        size_t fragmentLen = hasherTestsFragments[fragment++ % (sizeof (hasherTestsFragments) / sizeof (size_t))];
+        if (fragmentLen > messageLen - offset) fragmentLen = messageLen - offset;
+
+        assert (CRYPTO_TRUE == cryptoHasherUpdate (hasher, (0 == fragmentLen ? NULL : &message[offset]), fragmentLen));
+        offset += fragmentLen;
+    } while (offset < messageLen);
+}
+
+// Check the incremental hash of fragmented messages, of cloned and of reused hashers against the
+// one-shot hash.
+static void
+hasherTestsIncremental (BRCryptoHasherType type) {
+    BRCryptoHasher hasher = cryptoHasherCreate (type);
+    size_t length = cryptoHasherLength (hasher);
+    assert (0 < length && length <= HASHER_TESTS_MAXIMUM_LENGTH);
+
+    uint8_t message[HASHER_TESTS_MESSAGE_LENGTH];
+    for (size_t index = 0; index < sizeof (message); index++)
+        message[index] = (uint8_t) (7 * index + 3);
+
+    uint8_t expected[HASHER_TESTS_MAXIMUM_LENGTH];
+    uint8_t actual[HASHER_TESTS_MAXIMUM_LENGTH];
+
+    // The empty message, with and without an empty update
+    assert (CRYPTO_TRUE == cryptoHasherHash (hasher, expected, length, NULL, 0));
+    assert (CRYPTO_TRUE == cryptoHasherFinalize (hasher, actual, length));
+    assert (0 == memcmp (expected, actual, length));
+    assert (CRYPTO_TRUE == cryptoHasherUpdate (hasher, NULL, 0));
+    assert (CRYPTO_TRUE == cryptoHasherFinalize (hasher, actual, length));
+    assert (0 == memcmp (expected, actual, length));
+
+    // Every message length in [0, 300) and some longer, each fragmented differently; the hasher is
+    // reused after each finalize.
+    for (size_t messageLen = 0; messageLen <= sizeof (message); messageLen += (messageLen < 300 ? 1 : 100)) {
+        assert (CRYPTO_TRUE == cryptoHasherHash (hasher, expected, length, message, messageLen));
+
+        hasherTestsUpdate (hasher, message, messageLen, messageLen);
+        assert (CRYPTO_TRUE == cryptoHasherFinalize (hasher, actual, length));
+        assert (0 == memcmp (expected, actual, length));
+    }
+
+    // A one-shot hash in the middle of an update leaves the incremental state alone.
+    assert (CRYPTO_TRUE == cryptoHasherHash (hasher, expected, length, message, sizeof (message)));
+    hasherTestsUpdate (hasher, message, 200, 0);
+    assert (CRYPTO_TRUE == cryptoHasherHash (hasher, actual, length, message, 10));
+    hasherTestsUpdate (hasher, &message[200], sizeof (message) - 200, 5);
+    assert (CRYPTO_TRUE == cryptoHasherFinalize (hasher, actual, length));
+    assert (0 == memcmp (expected, actual, length));
+
+    // A clone mid-stream continues from the common prefix; the clone and the original are then
+    // independent, and each may be reused.
+    uint8_t suffix[HASHER_TESTS_MESSAGE_LENGTH];
+    memcpy (suffix, message, sizeof (suffix));
+    for (size_t index = 150; index < sizeof (suffix); index++)
+        suffix[index] ^= 0x5a;
+
+    for (size_t prefixLen = 0; prefixLen <= 150; prefixLen += 50) {
+        uint8_t expectedSuffix[HASHER_TESTS_MAXIMUM_LENGTH];
+        assert (CRYPTO_TRUE == cryptoHasherHash (hasher, expectedSuffix, length, suffix, sizeof (suffix)));
+
+        hasherTestsUpdate (hasher, message, prefixLen, 3);
+        BRCryptoHasher clone = cryptoHasherClone (hasher);
+
+        hasherTestsUpdate (clone,  &suffix[prefixLen],  sizeof (suffix)  - prefixLen, 7);
+        hasherTestsUpdate (hasher, &message[prefixLen], sizeof (message) - prefixLen, 1);
+
+        assert (CRYPTO_TRUE == cryptoHasherFinalize (hasher, actual, length));
+        assert (0 == memcmp (expected, actual, length));
+
+        assert (CRYPTO_TRUE == cryptoHasherFinalize (clone, actual, length));
+        assert (0 == memcmp (expectedSuffix, actual, length));
+
+        hasherTestsUpdate (clone, message, sizeof (message), 11);
+        assert (CRYPTO_TRUE == cryptoHasherFinalize (clone, actual, length));
+        assert (0 == memcmp (expected, actual, length));
+
+        cryptoHasherGive (clone);
+    }
+
+    cryptoHasherGive (hasher);
+}
+
+static void
+runCryptoHasherTests (void) {
+    BRCryptoHasherType types[] = {
+        CRYPTO_HASHER_SHA1,
+        CRYPTO_HASHER_SHA224,
+        CRYPTO_HASHER_SHA256,
+        CRYPTO_HASHER_SHA256_2,
+        CRYPTO_HASHER_SHA384,
+        CRYPTO_HASHER_SHA512,
+        CRYPTO_HASHER_SHA3,
+        CRYPTO_HASHER_RMD160,
+        CRYPTO_HASHER_HASH160,
+        CRYPTO_HASHER_KECCAK256,
+        CRYPTO_HASHER_MD5
+    };
+
+    for (size_t index = 0; index < sizeof (types) / sizeof (BRCryptoHasherType); index++)
+        hasherTestsIncremental (types[index]);
+}
+
 ///
 /// Mark: BRCryptoWalletManager Tests
 ///
@@ -1618,5 +2219,9 @@ extern void
 runCryptoTests (void) {
     runCryptoAmountTests ();
     runCryptoTransferTests();
+    runCryptoClientTests();
+    runCryptoKeyTests();
+    runCryptoSignerTests();
+    runCryptoHasherTests();
     return;
 }
@@ -562,6 +562,7 @@ int main(int argc, const char *argv[]) {
     runEventTests();
     runBcTests();
     runContractTests();
+    runNodeTests();
     runEWMTests(NODE_PAPER_KEY, "/tmp");
     runTests(0);
 }
@@ -11,13 +11,16 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include "ethereum/blockchain/BREthereumBlockChain.h"
+#include "ethereum/bcs/BREthereumBCSPrivate.h"
 
 //
 // Bloom Test
 //
-#define BLOOM_ADDR_1 "095e7baea6a6c7c4c2dfeb977efac326af552d87"
-#define BLOOM_ADDR_2 "0000000000000000000000000000000000000000"  // topic
+#define BLOOM_ADDR_1 "0x095e7baea6a6c7c4c2dfeb977efac326af552d87"
+#define BLOOM_ADDR_2 "0x0000000000000000000000000000000000000000"  // topic
 #define BLOOM_ADDR_1_OR_2_RESULT "00000000000000001000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000020000000000000000000800000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000004000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000020000000000040000000000000000000000000000000000000000000000000000000"
 extern void
 runBloomTests (void) {
@@ -35,8 +38,24 @@ runBloomTests (void) {
 
     assert (ETHEREUM_BOOLEAN_IS_TRUE(bloomFilterMatch(filter, filter1)));
     assert (ETHEREUM_BOOLEAN_IS_TRUE(bloomFilterMatch(filter, filter2)));
-    assert (ETHEREUM_BOOLEAN_IS_FALSE(bloomFilterMatch(filter, bloomFilterCreateAddress(ethAddressCreate("195e7baea6a6c7c4c2dfeb977efac326af552d87")))));
+    assert (ETHEREUM_BOOLEAN_IS_FALSE(bloomFilterMatch(filter, bloomFilterCreateAddress(ethAddressCreate("0x195e7baea6a6c7c4c2dfeb977efac326af552d87")))));
 
+    // Batch: each of `filters` against any of `others`
+    BREthereumBloomFilter filters[4] = { filter, filter1, filter2, bloomFilterCreateEmpty() };
+    BREthereumBloomFilter others[2]  = { bloomFilterCreateAddress(ethAddressCreate("0x195e7baea6a6c7c4c2dfeb977efac326af552d87")), filter2 };
+    uint8_t matches[4];
+
+    assert (2 == bloomFilterMatchAny (filters, 4, others, 2, matches));
+    assert (1 == matches[0] && 0 == matches[1] && 1 == matches[2] && 0 == matches[3]);
+
+    assert (0 == bloomFilterMatchAny (filters, 4, others, 1, matches));
+    assert (0 == matches[0] && 0 == matches[1] && 0 == matches[2] && 0 == matches[3]);
+
+    assert (0 == bloomFilterMatchAny (filters, 4, others, 0, matches));
+    assert (0 == matches[0] && 0 == matches[1] && 0 == matches[2] && 0 == matches[3]);
+
+    // An empty `other` matches everything
+    assert (4 == bloomFilterMatchAny (filters, 4, &filters[3], 1, matches));
 }
 
 #define BLOCK_HEADER_0_RLP "f9020ca00000000000000000000000000000000000000000000000000000000000000000a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a0d7f8974fb5ac78d9ac099b9ad5018bedc2ce0a72dad1827a1709da30580f0544a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000850400000000008213880000a011bbe8db4e347b4e8c937c1c8370e4b5ed33adb3db69cbdb7a38e1e50b1b82faa0000000000000000000000000000000000000000000000000000000000000000042"
@@ -130,7 +149,49 @@ runBlockHeaderTests (void) {
                                                               header_0,
                                                               NULL)));
 
+    // Proof of Work; without the chain head, the PoW is not verified
+    BREthereumProofOfWork pow = proofOfWorkCreate (NULL);
+    UInt256 powN;
+    BREthereumHash powM;
+
+    assert (PROOF_OF_WORK_UNAVAILABLE == proofOfWorkCompute (pow, header_4000001, &powN, &powM));
+    assert (BLOCK_HEADER_INVALID == blockHeaderValidate (header_4000001,
+                                                         header_4000000,
+                                                         0,
+                                                         header_0,
+                                                         pow));
+
+    // With the chain head but without the epoch's cache, the PoW is pending
+    proofOfWorkSetHead (pow, 4000000);
+    assert (PROOF_OF_WORK_PENDING == proofOfWorkCompute (pow, header_4000001, &powN, &powM));
+    assert (BLOCK_HEADER_PENDING == blockHeaderValidate (header_4000001,
+                                                         header_4000000,
+                                                         0,
+                                                         header_0,
+                                                         pow));
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (blockHeaderIsValid (header_4000001,
+                                                           header_4000000,
+                                                           0,
+                                                           header_0,
+                                                           pow)));
+
+    proofOfWorkGenerate (pow, header_4000001);
+
+    // An epoch far from the head's is not verified, even with its cache.
+    proofOfWorkSetHead (pow, 100000000);
+    assert (PROOF_OF_WORK_UNAVAILABLE == proofOfWorkCompute (pow, header_4000001, &powN, &powM));
+
+    proofOfWorkSetHead (pow, 4000000);
+    assert (PROOF_OF_WORK_COMPUTED == proofOfWorkCompute (pow, header_4000001, &powN, &powM));
+    assert (!UInt256Eq (UINT256_ZERO, powN));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (blockHeaderGetMixHash (header_4000001), powM)));
 
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (blockHeaderIsValid (header_4000001,
+                                                          header_4000000,
+                                                          0,
+                                                          header_0,
+                                                          pow)));
+    proofOfWorkRelease (pow);
 }
 
 //
@@ -470,6 +531,115 @@ runTransactionReceiptTests (void) {
 }
 
 
+//
+// Header Store
+//
+#define HEADER_STORE_PATH       "/tmp/testHeaderStore"
+
+static void
+testHeaderStoreGet (BREthereumBCSHeaderStore store,
+                    BREthereumBlockHeader header,
+                    UInt256 totalDifficulty) {
+    UInt256 storedTotalDifficulty;
+    BREthereumBlockHeader storedHeader = bcsHeaderStoreGet (store, blockHeaderGetNumber (header), &storedTotalDifficulty);
+
+    assert (NULL != storedHeader);
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (blockHeaderGetHash (header),
+                                                    blockHeaderGetHash (storedHeader))));
+    assert (uint256EQL (totalDifficulty, storedTotalDifficulty));
+
+    blockHeaderRelease (storedHeader);
+}
+
+static void
+runHeaderStoreTests (void) {
+    printf ("==== Header Store\n");
+
+    // Start over
+    unlink (HEADER_STORE_PATH "/headers");
+    unlink (HEADER_STORE_PATH "/index");
+
+    BREthereumBlockHeader header_4000000 = testGetBlockHeader(BLOCK_HEADER_4000000_RLP);
+    BREthereumBlockHeader header_4000001 = testGetBlockHeader(BLOCK_HEADER_4000001_RLP);
+
+    UInt256 totalDifficulty_4000000 = uint256Create (4000000);
+    UInt256 totalDifficulty_4000001 = uint256Create (4000001);
+
+    // The testnet checkpoint is at genesis; the store's base is zero.
+    BREthereumBCSHeaderStore store = bcsHeaderStoreCreate (HEADER_STORE_PATH, ethNetworkTestnet);
+    assert (NULL != store);
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStoreIsEmpty (store)));
+    assert (0 == bcsHeaderStoreGetNumberBase (store));
+    assert (NULL == bcsHeaderStoreGet (store, 4000000, NULL));
+
+    // Round trip
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStorePut (store, header_4000000, totalDifficulty_4000000)));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStorePut (store, header_4000001, totalDifficulty_4000001)));
+
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (bcsHeaderStoreIsEmpty (store)));
+    assert (4000001 == bcsHeaderStoreGetNumberHead (store));
+
+    testHeaderStoreGet (store, header_4000000, totalDifficulty_4000000);
+    testHeaderStoreGet (store, header_4000001, totalDifficulty_4000001);
+
+    // A gap and beyond the head
+    assert (NULL == bcsHeaderStoreGet (store, 3999999, NULL));
+    assert (NULL == bcsHeaderStoreGet (store, 4000002, NULL));
+
+    bcsHeaderStoreRelease (store);
+
+    // Restart, after a torn write past the committed 'headers'
+    int headersFile = open (HEADER_STORE_PATH "/headers", O_WRONLY | O_APPEND);
+    assert (-1 != headersFile);
+    assert (4 == write (headersFile, "torn", 4));
+    close (headersFile);
+
+    store = bcsHeaderStoreCreate (HEADER_STORE_PATH, ethNetworkTestnet);
+    assert (NULL != store);
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (bcsHeaderStoreIsEmpty (store)));
+    assert (4000001 == bcsHeaderStoreGetNumberHead (store));
+
+    testHeaderStoreGet (store, header_4000000, totalDifficulty_4000000);
+    testHeaderStoreGet (store, header_4000001, totalDifficulty_4000001);
+
+    // Put again replaces, and survives a restart
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStorePut (store, header_4000001, totalDifficulty_4000000)));
+    testHeaderStoreGet (store, header_4000001, totalDifficulty_4000000);
+    bcsHeaderStoreRelease (store);
+
+    store = bcsHeaderStoreCreate (HEADER_STORE_PATH, ethNetworkTestnet);
+    assert (NULL != store);
+    assert (4000001 == bcsHeaderStoreGetNumberHead (store));
+    testHeaderStoreGet (store, header_4000000, totalDifficulty_4000000);
+    testHeaderStoreGet (store, header_4000001, totalDifficulty_4000000);
+    bcsHeaderStoreRelease (store);
+
+    // Another network starts over
+    store = bcsHeaderStoreCreate (HEADER_STORE_PATH, ethNetworkRinkeby);
+    assert (NULL != store);
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStoreIsEmpty (store)));
+    assert (NULL == bcsHeaderStoreGet (store, 4000000, NULL));
+    bcsHeaderStoreRelease (store);
+
+    // Mainnet's base is its latest checkpoint; earlier headers are not stored.
+    unlink (HEADER_STORE_PATH "/headers");
+    unlink (HEADER_STORE_PATH "/index");
+
+    store = bcsHeaderStoreCreate (HEADER_STORE_PATH, ethNetworkMainnet);
+    assert (NULL != store);
+    assert (bcsHeaderStoreGetNumberBase (store) > 4000001);
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (bcsHeaderStorePut (store, header_4000001, totalDifficulty_4000001)));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStoreIsEmpty (store)));
+    bcsHeaderStoreRelease (store);
+
+    unlink (HEADER_STORE_PATH "/headers");
+    unlink (HEADER_STORE_PATH "/index");
+    rmdir  (HEADER_STORE_PATH);
+
+    blockHeaderRelease (header_4000001);
+    blockHeaderRelease (header_4000000);
+}
+
 static void
 runBlockTests (void) {
     runBlockTest0();
@@ -483,6 +653,7 @@ runBcTests (void) {
 //    runBloomTests();
     runBlockHeaderTests ();
     runBlockTests();
+    runHeaderStoreTests();
     runLogTests();
     runAccountStateTests();
     runTransactionStatusTests();
@@ -0,0 +1,210 @@
+//
+//  testLES.c
+//  CoreTests
+//
+//  Copyright © 2026 Breadwallet AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/socket.h>
+#include "ethereum/les/BREthereumLESBase.h"
+#include "ethereum/les/BREthereumNode.h"
+
+#define NODE_TEST_NODES      (3)
+#define NODE_TEST_IN_FLIGHT  (8)    // as NODE_PROVISIONS_IN_FLIGHT_LIMIT
+
+static BREthereumNodeEndpoint
+nodeTestCreateEndpoint (uint16_t port) {
+    BREthereumDISNeighbor dis;
+    memset (&dis, 0, sizeof (dis));
+
+    dis.node.domain = AF_INET;
+    dis.node.addr.ipv4[0] = 127;
+    dis.node.addr.ipv4[3] = 1;
+    dis.node.portUDP = port;
+    dis.node.portTCP = port;
+    dis.key.pubKey[0] = 0x04;
+    dis.key.pubKey[1] = (uint8_t) port;
+
+    return nodeEndpointCreate (dis);
+}
+
+static BREthereumNode
+nodeTestCreate (BREthereumNodeEndpoint local, uint16_t port) {
+    return nodeCreate (NODE_PRIORITY_DIS, ethNetworkMainnet, local, nodeTestCreateEndpoint (port),
+                       NULL, NULL, NULL, NULL, NULL, ETHEREUM_BOOLEAN_TRUE);
+}
+
+// A provision of one GetBlockHeaders message, costing `baseCost + limit * reqCost`
+static BREthereumProvision
+nodeTestCreateProvision (size_t identifier, uint32_t limit) {
+    return (BREthereumProvision) {
+        identifier,
+        PROVISION_BLOCK_HEADERS,
+        { .headers = { 1000000, 0, limit, ETHEREUM_BOOLEAN_FALSE, NULL }}
+    };
+}
+
+static void
+nodeTestReleaseProvisions (BRArrayOf(BREthereumProvision) provisions) {
+    for (size_t index = 0; index < array_count (provisions); index++)
+        provisionRelease (&provisions[index], ETHEREUM_BOOLEAN_TRUE);
+    array_free (provisions);
+}
+
+static void
+runNodeCreditsTests (BREthereumNodeEndpoint local) {
+    printf ("==== Node Credits\n");
+
+    BREthereumNode node = nodeTestCreate (local, 30303);
+
+    // BL of 1000, MRR of 10 per millisecond; we start with a full buffer.
+    nodeSetStatusForTest (node, 1000, 10, 50, 10, 1000);
+    assert (1000 == nodeGetCreditsAvailableForTest (node, 1000));
+
+    // Recharge, from the last reported credits, is capped at BL
+    nodeAnswerProvisionForTest (node, 0, 100, 1000);
+    assert ( 100 == nodeGetCreditsAvailableForTest (node, 1000));
+    assert ( 600 == nodeGetCreditsAvailableForTest (node, 1050));
+    assert ( 990 == nodeGetCreditsAvailableForTest (node, 1089));
+    assert (1000 == nodeGetCreditsAvailableForTest (node, 1090));
+    assert (1000 == nodeGetCreditsAvailableForTest (node, 1000000));
+    assert (1000 == nodeGetCreditsAvailableForTest (node, UINT64_MAX));
+    assert ( 100 == nodeGetCreditsAvailableForTest (node, 500));        // before the report
+
+    // Reported credits above BL are capped at BL
+    nodeAnswerProvisionForTest (node, 0, 5000, 2000);
+    assert (1000 == nodeGetCreditsAvailableForTest (node, 2000));
+
+    // Sending holds credits pending; answering releases them.  Each message costs 50 + 10 * 10.
+    nodeHandleProvision (node, nodeTestCreateProvision (0, 10));
+    nodeHandleProvision (node, nodeTestCreateProvision (1, 10));
+
+    uint64_t message0 = nodeSendProvisionForTest (node, 2000);
+    uint64_t message1 = nodeSendProvisionForTest (node, 2000);
+    assert (UINT64_MAX != message0 && UINT64_MAX != message1 && message0 != message1);
+    assert (300 == nodeGetCreditsPendingForTest (node));
+    assert (700 == nodeGetCreditsAvailableForTest (node, 2000));
+    assert (UINT64_MAX == nodeSendProvisionForTest (node, 2000));       // nothing left to send
+
+    nodeAnswerProvisionForTest (node, message0, 850, 2000);
+    assert (150 == nodeGetCreditsPendingForTest (node));
+    assert (700 == nodeGetCreditsAvailableForTest (node, 2000));
+
+    nodeAnswerProvisionForTest (node, message0, 850, 2000);             // again; nothing more
+    assert (150 == nodeGetCreditsPendingForTest (node));
+
+    nodeAnswerProvisionForTest (node, message1, 700, 2000);
+    assert (  0 == nodeGetCreditsPendingForTest (node));
+    assert (700 == nodeGetCreditsAvailableForTest (node, 2000));
+    assert (1000 == nodeGetCreditsAvailableForTest (node, 2030));
+
+    nodeTestReleaseProvisions (nodeUnhandleProvisions (node));
+
+    // Unhandling provisions releases their pending credits
+    nodeHandleProvision (node, nodeTestCreateProvision (2, 10));
+    nodeHandleProvision (node, nodeTestCreateProvision (3, 10));
+    assert (UINT64_MAX != nodeSendProvisionForTest (node, 3000));
+    assert (UINT64_MAX != nodeSendProvisionForTest (node, 3000));
+    assert (300 == nodeGetCreditsPendingForTest (node));
+
+    nodeTestReleaseProvisions (nodeUnhandleProvisions (node));
+    assert (   0 == nodeGetCreditsPendingForTest (node));
+    assert (1000 == nodeGetCreditsAvailableForTest (node, 3000));
+
+    // A message costing more than BL is sent with a full buffer and nothing pending, but only then.
+    // Each message costs 50 + 100 * 10.
+    assert ( nodeHasCreditsForTest (node, 1050, 3000));
+    nodeHandleProvision (node, nodeTestCreateProvision (4, 100));
+    nodeHandleProvision (node, nodeTestCreateProvision (5, 100));
+
+    uint64_t message4 = nodeSendProvisionForTest (node, 3000);
+    assert (UINT64_MAX != message4);
+    assert (1050 == nodeGetCreditsPendingForTest (node));
+    assert (   0 == nodeGetCreditsAvailableForTest (node, 3000));
+    assert (!nodeHasCreditsForTest (node, 1050, 3000));
+    assert (UINT64_MAX == nodeSendProvisionForTest (node, 3000));
+
+    // Answered with an empty buffer; the next waits to recharge to BL.
+    nodeAnswerProvisionForTest (node, message4, 0, 3000);
+    assert (0 == nodeGetCreditsPendingForTest (node));
+    assert (!nodeHasCreditsForTest (node, 1050, 3099));
+    assert (UINT64_MAX == nodeSendProvisionForTest (node, 3099));
+    assert ( nodeHasCreditsForTest (node, 1050, 3100));
+    assert (UINT64_MAX != nodeSendProvisionForTest (node, 3100));
+
+    nodeTestReleaseProvisions (nodeUnhandleProvisions (node));
+
+    // Without flow control any message is sent
+    nodeSetStatusForTest (node, 0, 0, 50, 10, 4000);
+    assert (UINT64_MAX == nodeGetCreditsAvailableForTest (node, 4000));
+    assert (nodeHasCreditsForTest (node, UINT64_MAX, 4000));
+
+    nodeRelease (node);
+}
+
+static void
+runNodeSelectTests (BREthereumNodeEndpoint local) {
+    printf ("==== Node Select\n");
+
+    BREthereumNode nodes[NODE_TEST_NODES];
+    size_t counts[NODE_TEST_NODES];
+
+    // No connected nodes, none selected.
+    for (size_t index = 0; index < NODE_TEST_NODES; index++) {
+        nodes[index] = nodeTestCreate (local, (uint16_t) (30303 + index));
+        counts[index] = 0;
+    }
+    assert (NULL == nodeSelectForProvision (nodes, NODE_TEST_NODES));
+
+    for (size_t index = 0; index < NODE_TEST_NODES; index++)
+        nodeSetStatusForTest (nodes[index], 0, 0, 0, 0, 0);
+
+    // Provisions spread evenly across the nodes, up to each node's limit in flight
+    size_t identifier = 0;
+    for (; identifier < NODE_TEST_NODES * NODE_TEST_IN_FLIGHT; identifier++) {
+        BREthereumNode node = nodeSelectForProvision (nodes, NODE_TEST_NODES);
+        assert (NULL != node);
+
+        for (size_t index = 0; index < NODE_TEST_NODES; index++)
+            if (node == nodes[index]) {
+                counts[index]++;
+                // No node is more than one provision ahead of another
+                for (size_t other = 0; other < NODE_TEST_NODES; other++)
+                    assert (counts[index] <= counts[other] + 1);
+            }
+
+        nodeHandleProvision (node, nodeTestCreateProvision (identifier, 10));
+    }
+
+    for (size_t index = 0; index < NODE_TEST_NODES; index++)
+        assert (NODE_TEST_IN_FLIGHT == counts[index]);
+
+    // Every node is busy; none selected until one completes its provisions.
+    assert (NULL == nodeSelectForProvision (nodes, NODE_TEST_NODES));
+
+    nodeTestReleaseProvisions (nodeUnhandleProvisions (nodes[1]));
+    assert (nodes[1] == nodeSelectForProvision (nodes, NODE_TEST_NODES));
+
+    // Only connected nodes are selected
+    nodeTestReleaseProvisions (nodeUnhandleProvisions (nodes[0]));
+    nodeDisconnect (nodes[1], NODE_ROUTE_TCP, (BREthereumNodeState) { NODE_AVAILABLE }, ETHEREUM_BOOLEAN_FALSE);
+    assert (nodes[0] == nodeSelectForProvision (nodes, NODE_TEST_NODES));
+
+    for (size_t index = 0; index < NODE_TEST_NODES; index++)
+        nodeRelease (nodes[index]);
+}
+
+extern void
+runNodeTests (void) {
+    BREthereumNodeEndpoint local = nodeTestCreateEndpoint (30000);
+
+    runNodeCreditsTests (local);
+    runNodeSelectTests  (local);
+
+    nodeEndpointRelease (local);
+}
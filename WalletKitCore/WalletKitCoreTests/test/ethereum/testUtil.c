@@ -155,6 +155,32 @@ runMathMulTests () {
             && UINT32_MAX == z.u32[14]
             && UINT32_MAX == z.u32[15]);
 
+    // Overflow checked; no UInt512 intermediate
+    int overflow;
+    UInt256 r;
+    UInt256 x2to127 = { .u64 = { 0, ((uint64_t) 1) << 63, 0, 0 }};
+    UInt256 x2to128 = { .u64 = { 0, 0, 1, 0 }};
+
+    r = uint256Mul_Overflow (xMax, xOne, &overflow);
+    assert (!overflow && uint256EQL (r, xMax));
+
+    r = uint256Mul_Overflow (xMax, xTwo, &overflow);
+    assert (overflow && uint256EQL (r, UINT256_ZERO));
+
+    r = uint256Mul_Overflow (x2to127, xTwo, &overflow);
+    assert (!overflow && uint256EQL (r, x2to128));
+
+    r = uint256Mul_Overflow (x2to128, x2to128, &overflow);
+    assert (overflow);
+
+    r = uint256Mul_Overflow (x7atOne, xOne, &overflow);
+    assert (!overflow && uint256EQL (r, x7atOne));
+
+    r = uint256Mul_Overflow (x7atOne, x2to32, &overflow);
+    assert (overflow);
+
+    r = uint256Mul_Overflow (x0atMax, x0atMax, &overflow);
+    assert (!overflow && r.u64[0] == UINT32_MAX * (uint64_t) UINT32_MAX && 0 == r.u64[1]);
 }
 
 static void
@@ -231,6 +257,19 @@ runMathDivTests () {
             && a.u64[1] == 0
             && a.u64[2] == 0
             && a.u64[3] == 0);
+
+    // 10^21 / 10^19
+    uint64_t rem64;
+    a = uint256Div_Small64 (r, 10000000000000000000u, &rem64);
+    assert (0 == rem64 && a.u64[0] == 100 && a.u64[1] == 0);
+
+    // (2^256 - 1) / (2^64 - 1) = 1 + 2^64 + 2^128 + 2^192
+    UInt256 xMax = { .u64 = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX }};
+    a = uint256Div_Small64 (xMax, UINT64_MAX, &rem64);
+    assert (0 == rem64 && 1 == a.u64[0] && 1 == a.u64[1] && 1 == a.u64[2] && 1 == a.u64[3]);
+
+    a = uint256Div_Small64 (xMax, 10, &rem64);
+    assert (5 == rem64);
 }
 
 static void
@@ -294,6 +333,22 @@ runMathCoerceTests () {
     gs = uint256CoerceStringPrefaced (g, 16, "0x");
     assert (0 == strcmp (gs, "0xa"));
     free ((char *) gs);
+
+    // Decimal digits in chunks of 19; check at and around the chunk boundaries
+    UInt256 h = uint256Create (10000000000000000000u);
+    const char *hs = uint256CoerceString (h, 10);
+    assert (0 == strcmp (hs, "10000000000000000000"));
+    free ((char *) hs);
+
+    h = uint256Create (9999999999999999999u);
+    hs = uint256CoerceString (h, 10);
+    assert (0 == strcmp (hs, "9999999999999999999"));
+    free ((char *) hs);
+
+    UInt256 xMax = { .u64 = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX }};
+    hs = uint256CoerceString (xMax, 10);
+    assert (0 == strcmp (hs, "115792089237316195423570985008687907853269984665640564039457584007913129639935"));
+    free ((char *) hs);
 }
 
 static void
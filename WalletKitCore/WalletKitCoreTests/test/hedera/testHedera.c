@@ -24,6 +24,7 @@
 
 #include "hedera/BRHederaTransaction.h"
 #include "hedera/BRHederaAccount.h"
+#include "ed25519/ed25519.h"
 
 static int debug_log = 0;
 
@@ -615,6 +616,87 @@ static void txIDTests() {
     assert(!success);
 }
 
+#define ED25519_TEST_COUNT 256
+
+static double
+ed25519TestNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Signs transaction-body sized messages with distinct keys, checks batch verification against single
+// verification (all valid, then with some corrupted), and reports sign and verify times per signature.
+static void ed25519Tests() {
+    static uint8_t publicKeys[ED25519_TEST_COUNT][32], privateKeys[ED25519_TEST_COUNT][64];
+    static uint8_t signatures[ED25519_TEST_COUNT][64], messages[ED25519_TEST_COUNT][120];
+    const unsigned char *signaturePtrs[ED25519_TEST_COUNT], *messagePtrs[ED25519_TEST_COUNT], *publicKeyPtrs[ED25519_TEST_COUNT];
+    size_t messageLens[ED25519_TEST_COUNT];
+    int valid[ED25519_TEST_COUNT];
+    uint8_t seed[32], temp[32];
+    double beg, keypairSign, expandSign, single, batch;
+
+    for (size_t i = 0; i < ED25519_TEST_COUNT; i++) {
+        for (size_t j = 0; j < sizeof (seed); j++) seed[j] = (uint8_t) (i * 31 + j);
+        for (size_t j = 0; j < sizeof (messages[i]); j++) messages[i][j] = (uint8_t) (i * 7 + j * 3);
+
+        ed25519_create_keypair (publicKeys[i], privateKeys[i], seed);
+        signaturePtrs[i] = signatures[i];
+        messagePtrs[i]   = messages[i];
+        publicKeyPtrs[i] = publicKeys[i];
+        messageLens[i]   = 60 + i % 60;
+    }
+
+    // signing as before, re-creating the keypair from the seed for every signature
+    beg = ed25519TestNow ();
+    for (size_t i = 0; i < ED25519_TEST_COUNT; i++) {
+        for (size_t j = 0; j < sizeof (seed); j++) seed[j] = (uint8_t) (i * 31 + j);
+        ed25519_create_keypair (temp, privateKeys[i], seed);
+        ed25519_sign (signatures[i], messages[i], messageLens[i], publicKeys[i], privateKeys[i]);
+    }
+    keypairSign = ed25519TestNow () - beg;
+
+    // signing with only the secret expanded, as hederaTransactionSignTransaction() now does
+    beg = ed25519TestNow ();
+    for (size_t i = 0; i < ED25519_TEST_COUNT; i++) {
+        uint8_t signature[64];
+        for (size_t j = 0; j < sizeof (seed); j++) seed[j] = (uint8_t) (i * 31 + j);
+        ed25519_expand_seed (privateKeys[i], seed);
+        ed25519_sign (signature, messages[i], messageLens[i], publicKeys[i], privateKeys[i]);
+        assert (0 == memcmp (signature, signatures[i], sizeof (signature)));
+    }
+    expandSign = ed25519TestNow () - beg;
+
+    beg = ed25519TestNow ();
+    for (size_t i = 0; i < ED25519_TEST_COUNT; i++)
+        assert (1 == ed25519_verify (signatures[i], messages[i], messageLens[i], publicKeys[i]));
+    single = ed25519TestNow () - beg;
+
+    beg = ed25519TestNow ();
+    assert (1 == ed25519_verify_batch (signaturePtrs, messagePtrs, messageLens, publicKeyPtrs, ED25519_TEST_COUNT, valid));
+    batch = ed25519TestNow () - beg;
+
+    for (size_t i = 0; i < ED25519_TEST_COUNT; i++) assert (1 == valid[i]);
+
+    printf ("ed25519: sign %.1f us (keypair) %.1f us (expanded), verify %.1f us, batch verify %.1f us\n",
+            1e6 * keypairSign / ED25519_TEST_COUNT,
+            1e6 * expandSign  / ED25519_TEST_COUNT,
+            1e6 * single      / ED25519_TEST_COUNT,
+            1e6 * batch       / ED25519_TEST_COUNT);
+
+    // corrupt an R, an S and a message; the batch fails and each item matches ed25519_verify()
+    signatures[3][5]  ^= 0x01;
+    signatures[77][40] ^= 0x01;
+    messages[200][0]  ^= 0x01;
+
+    assert (0 == ed25519_verify_batch (signaturePtrs, messagePtrs, messageLens, publicKeyPtrs, ED25519_TEST_COUNT, valid));
+
+    for (size_t i = 0; i < ED25519_TEST_COUNT; i++) {
+        assert (valid[i] == ed25519_verify (signatures[i], messages[i], messageLens[i], publicKeys[i]));
+        assert (valid[i] == (3 != i && 77 != i && 200 != i));
+    }
+}
+
 extern void
 runHederaTest (void /* ... */) {
     printf("Running hedera unit tests...\n");
@@ -623,4 +705,5 @@ runHederaTest (void /* ... */) {
     wallet_tests();
     transaction_tests();
     txIDTests();
+    ed25519Tests();
 }
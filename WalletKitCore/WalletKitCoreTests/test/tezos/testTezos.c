@@ -26,6 +26,8 @@
 #include "tezos/BRTezosTransfer.h"
 #include "tezos/BRTezosAccount.h"
 #include "tezos/BRTezosEncoder.h"
+#include "ed25519/ed25519.h"
+#include "blake2/blake2b.h"
 
 static int debug_log = 0;
 
@@ -237,6 +239,43 @@ void testUnknownAddress() {
     assert(NULL == tezosAddressCreateFromString("unknown", true));
 }
 
+static void
+testBlake2b() {
+    // RFC 7693, Appendix A
+    uint8_t md[64];
+    char hex[129] = {0};
+    blake2b(md, sizeof(md), NULL, 0, "abc", 3);
+    bin2HexString(md, sizeof(md), hex);
+    assert (0 == strcasecmp("ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+                            "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923", hex));
+
+    // each available simd kernel against the reference code, hashing in uneven fragments
+    uint8_t data[1031], key[64], expected[64];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 131 + 7);
+    for (size_t i = 0; i < sizeof(key); i++) key[i] = (uint8_t)(0xa5 ^ i);
+
+    unsigned kernels[] = { BLAKE2B_SSE41, BLAKE2B_AVX2 };
+    for (size_t len = 0; len <= sizeof(data); len += 103) {
+        for (size_t keyLen = 0; keyLen <= sizeof(key); keyLen += 32) {
+            blake2b_set_kernels(0);
+            blake2b(expected, sizeof(expected), key, keyLen, data, len);
+
+            for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+                blake2b_set_kernels(kernels[k]);
+
+                blake2b_ctx ctx;
+                blake2b_init(&ctx, sizeof(md), key, keyLen);
+                for (size_t off = 0, frag = 1; off < len; off += frag, frag = frag * 3 + 1) {
+                    blake2b_update(&ctx, &data[off], (frag < len - off ? frag : len - off));
+                }
+                blake2b_final(&ctx, md);
+                assert (0 == memcmp(md, expected, sizeof(md)));
+            }
+        }
+    }
+    blake2b_set_kernels(~0u);
+}
+
 // MARK: - Transaction Tests
 
 
@@ -466,6 +505,30 @@ testBatchOperationSerialize() {
     bin2HexString(unsignedBytes.bytes, unsignedBytes.size, serializedHex);
     assert (0 == strcasecmp("f3b761a633b2b0cc9d2edbb09cda4800818f893b3d6567b09a818f1a5f685fb86b004cdee21a9180f80956ab8d27fb6abdbd89934052949a0303d84fac0200efc82a1445744a87fec55fce35e1b7ec80f9bbed9df2a03bcdde1a346f3d42946c004cdee21a9180f80956ab8d27fb6abdbd89934052949a0303d84fac0280c2d72f0000d2e495a7ab40156d0a7c35b73d2530a3470fc87000", serializedHex));
 
+    // hashed while encoding, with and without the signing watermark
+    uint8_t watermark[] = { TEZOS_WATERMARK_OPERATION };
+    uint8_t hash[32], expected[32];
+    blake2b_ctx hashers[2];
+    blake2b_init(&hashers[0], sizeof(hash), NULL, 0);
+    blake2b_init(&hashers[1], sizeof(hash), NULL, 0);
+    blake2b_update(&hashers[0], watermark, sizeof(watermark));
+
+    BRCryptoData hashedBytes = tezosSerializeOperationListHashed(opList, opCount, lastBlockHash, hashers, 2);
+    assert (hashedBytes.size == unsignedBytes.size && 0 == memcmp(hashedBytes.bytes, unsignedBytes.bytes, hashedBytes.size));
+
+    blake2b_final(&hashers[1], hash);
+    blake2b(expected, sizeof(expected), NULL, 0, unsignedBytes.bytes, unsignedBytes.size);
+    assert (0 == memcmp(hash, expected, sizeof(hash)));
+
+    BRCryptoData watermarked = cryptoDataNew(1 + unsignedBytes.size);
+    watermarked.bytes[0] = TEZOS_WATERMARK_OPERATION;
+    memcpy(&watermarked.bytes[1], unsignedBytes.bytes, unsignedBytes.size);
+    blake2b_final(&hashers[0], hash);
+    blake2b(expected, sizeof(expected), NULL, 0, watermarked.bytes, watermarked.size);
+    assert (0 == memcmp(hash, expected, sizeof(hash)));
+
+    cryptoDataFree(watermarked);
+    cryptoDataFree(hashedBytes);
     tezosTransferFree(transfer);
     tezosTransactionFree(reveal);
     cryptoDataFree(unsignedBytes);
@@ -573,10 +636,72 @@ testTransactionSignWithReveal() {
 
 // MARK: -
 
+#define SIGN_TEST_COUNT 64
+
+static double
+testNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Signs operation-sized messages with the account, then verifies the signatures against the
+// account's public key one at a time and as a batch; reports the time per signature for each.
+static void
+testSignDataBatchVerify() {
+    BRTezosAccount account = makeAccount(testAccount1);
+    UInt512 seed = getSeed(testAccount1);
+    BRKey publicKey = tezosAccountGetPublicKey(account);
+    BRCryptoData signatures[SIGN_TEST_COUNT];
+    uint8_t messages[SIGN_TEST_COUNT][1 + 96], hashes[SIGN_TEST_COUNT][32];
+    const unsigned char *signaturePtrs[SIGN_TEST_COUNT], *hashPtrs[SIGN_TEST_COUNT], *publicKeyPtrs[SIGN_TEST_COUNT];
+    size_t hashLens[SIGN_TEST_COUNT];
+    int valid[SIGN_TEST_COUNT];
+    double beg, sign, single, batch;
+
+    beg = testNow();
+    for (size_t i = 0; i < SIGN_TEST_COUNT; i++) {
+        messages[i][0] = 0x03; // watermark, as added by tezosAccountSignData()
+        for (size_t j = 1; j < sizeof(messages[i]); j++) messages[i][j] = (uint8_t)(i * 5 + j);
+
+        BRCryptoData data = { &messages[i][1], sizeof(messages[i]) - 1 };
+        signatures[i] = tezosAccountSignData(account, data, seed);
+    }
+    sign = testNow() - beg;
+
+    for (size_t i = 0; i < SIGN_TEST_COUNT; i++) {
+        blake2b(hashes[i], sizeof(hashes[i]), NULL, 0, messages[i], sizeof(messages[i]));
+        signaturePtrs[i] = signatures[i].bytes;
+        hashPtrs[i] = hashes[i];
+        publicKeyPtrs[i] = publicKey.pubKey;
+        hashLens[i] = sizeof(hashes[i]);
+    }
+
+    beg = testNow();
+    for (size_t i = 0; i < SIGN_TEST_COUNT; i++)
+        assert(1 == ed25519_verify(signaturePtrs[i], hashPtrs[i], hashLens[i], publicKeyPtrs[i]));
+    single = testNow() - beg;
+
+    beg = testNow();
+    assert(1 == ed25519_verify_batch(signaturePtrs, hashPtrs, hashLens, publicKeyPtrs, SIGN_TEST_COUNT, valid));
+    batch = testNow() - beg;
+
+    printf("tezos: sign %.1f us, verify %.1f us, batch verify %.1f us\n",
+           1e6 * sign / SIGN_TEST_COUNT, 1e6 * single / SIGN_TEST_COUNT, 1e6 * batch / SIGN_TEST_COUNT);
+
+    hashes[10][0] ^= 0x01;
+    assert(0 == ed25519_verify_batch(signaturePtrs, hashPtrs, hashLens, publicKeyPtrs, SIGN_TEST_COUNT, valid));
+    for (size_t i = 0; i < SIGN_TEST_COUNT; i++) assert(valid[i] == (10 != i));
+
+    for (size_t i = 0; i < SIGN_TEST_COUNT; i++) cryptoDataFree(signatures[i]);
+    tezosAccountFree(account);
+}
+
 static void
 tezosAccountTests() {
     testCreateTezosAccountWithSeed();
     testCreateTezosAccountWithSerializedAccount();
+    testSignDataBatchVerify();
 }
 
 static void
@@ -605,6 +730,7 @@ tezosWalletTests() {
 static void
 tezosEncoderTests() {
     testEncodeZarith();
+    testBlake2b();
 }
 
 // MARK: -
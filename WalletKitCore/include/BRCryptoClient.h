@@ -103,6 +103,39 @@ cryptoClientTransferBundleCreate (BRCryptoTransferStateType status,
                                   OwnershipKept const char **attributeKeys,
                                   OwnershipKept const char **attributeVals);
 
+/// The fixed-width binary values of a transfer bundle.  Hashes are 32 bytes and addresses are
+/// 20 bytes, as for ETH and ERC20 transfers.  The `amount` and `fee` are 256-bit unsigned
+/// integers, big-endian.
+typedef struct {
+    BRCryptoData32 hash;
+    uint8_t from[20];
+    uint8_t to[20];
+    BRCryptoData32 amount;
+    BRCryptoData32 fee;
+    BRCryptoBoolean hasFee;
+    BRCryptoData32 blockHash;
+} BRCryptoClientTransferBundleBinary;
+
+/**
+ * Create a transfer bundle from binary values, avoiding the formatting and re-parsing of
+ * hashes, addresses and amounts required by `cryptoClientTransferBundleCreate()`.  The bundle
+ * is saved in binary form.  Only ETH wallet managers recover transfers from binary bundles;
+ * announcing a binary bundle to any other wallet manager fails the announcement.
+ */
+extern BRCryptoClientTransferBundle
+cryptoClientTransferBundleCreateBinary (BRCryptoTransferStateType status,
+                                        OwnershipKept const char *uids,
+                                        OwnershipKept const char *identifier,
+                                        OwnershipKept const char *currency,
+                                        OwnershipKept const BRCryptoClientTransferBundleBinary *binary,
+                                        BRCryptoTimestamp blockTimestamp,
+                                        BRCryptoBlockNumber blockNumber,
+                                        BRCryptoBlockNumber blockConfirmations,
+                                        uint64_t blockTransactionIndex,
+                                        size_t attributesCount,
+                                        OwnershipKept const char **attributeKeys,
+                                        OwnershipKept const char **attributeVals);
+
 extern void
 cryptoClientTransferBundleRelease (BRCryptoClientTransferBundle bundle);
 
@@ -46,6 +46,26 @@ extern "C" {
                       const uint8_t *src,
                       size_t srcLen);
 
+    /// Incremental hashing.  Feed the message to `cryptoHasherUpdate()` in one or more fragments,
+    /// then `cryptoHasherFinalize()` writes the hash of the concatenated fragments into `dst` and
+    /// resets the hasher for the next message.  The result is identical to `cryptoHasherHash()`
+    /// on the full message.  A hasher holds the incremental state, so concurrent updates of one
+    /// hasher from multiple threads are not supported; `cryptoHasherHash()` does not touch it.
+    extern BRCryptoBoolean
+    cryptoHasherUpdate (BRCryptoHasher hasher,
+                        const uint8_t *src,
+                        size_t srcLen);
+
+    extern BRCryptoBoolean
+    cryptoHasherFinalize (BRCryptoHasher hasher,
+                          uint8_t *dst,
+                          size_t dstLen);
+
+    /// Create a new hasher with a copy of `hasher`'s incremental state, such as a midstate over a
+    /// common prefix, so that each copy can then be updated and finalized independently.
+    extern BRCryptoHasher
+    cryptoHasherClone (BRCryptoHasher hasher);
+
     DECLARE_CRYPTO_GIVE_TAKE (BRCryptoHasher, cryptoHasher);
 
 #ifdef __cplusplus
@@ -43,6 +43,27 @@ extern "C" {
     extern BRCryptoKey
     cryptoKeyCreateFromStringProtectedPrivate (const char *privateKey, const char * passphrase);
 
+    typedef void *BRCryptoKeyCreateContext;
+
+    typedef void
+    (*BRCryptoKeyCreateCallback) (BRCryptoKeyCreateContext context,
+                                  OwnershipGiven BRCryptoKey key);
+
+    /**
+     * Decrypt `privateKey`, as cryptoKeyCreateFromStringProtectedPrivate(), but on a thread of its
+     * own so that the seconds of scrypt do not block the caller.  Requests are decrypted one at a
+     * time, in order; `callback` is invoked on that thread with the key, or NULL if `passphrase` is
+     * incorrect.
+     *
+     * @return CRYPTO_TRUE if queued; otherwise, `privateKey` is not a BIP38 key or no thread could
+     * be started, and `callback` will not be invoked.
+     */
+    extern BRCryptoBoolean
+    cryptoKeyCreateFromStringProtectedPrivateAsync (const char *privateKey,
+                                                    const char * passphrase,
+                                                    BRCryptoKeyCreateContext context,
+                                                    BRCryptoKeyCreateCallback callback);
+
     extern BRCryptoKey
     cryptoKeyCreateFromStringPrivate (const char *string);
 
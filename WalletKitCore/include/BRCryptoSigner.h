@@ -50,6 +50,36 @@ extern "C" {
                          const uint8_t *signature,
                          size_t signatureLen);
 
+    /**
+     * Verify `count` signatures, each of a 32 byte digest, against the corresponding keys, and fill
+     * in `results`.  A COMPACT signature verifies if the key it recovers matches the given key.
+     * Work is spread over threads for large counts.
+     *
+     * @return the number of signatures verified
+     */
+    extern size_t
+    cryptoSignerVerifyBatch (BRCryptoSigner signer,
+                             BRCryptoKey *keys,
+                             const uint8_t **digests,
+                             const uint8_t **signatures,
+                             const size_t *signatureLens,
+                             BRCryptoBoolean *results,
+                             size_t count);
+
+    /**
+     * Recover the keys for `count` signatures, each of a 32 byte digest, as with cryptoSignerRecover(),
+     * filling in `keys` with a new key, or NULL on failure.  Work is spread over threads for large counts.
+     *
+     * @return the number of keys recovered
+     */
+    extern size_t
+    cryptoSignerRecoverBatch (BRCryptoSigner signer,
+                              BRCryptoKey *keys,
+                              const uint8_t **digests,
+                              const uint8_t **signatures,
+                              const size_t *signatureLens,
+                              size_t count);
+
     DECLARE_CRYPTO_GIVE_TAKE (BRCryptoSigner, cryptoSigner);
 
 #ifdef __cplusplus
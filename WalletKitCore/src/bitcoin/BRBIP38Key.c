@@ -47,13 +47,24 @@
 // BIP38 is a method for encrypting private keys with a passphrase
 // https://github.com/bitcoin/bips/blob/master/bip-0038.mediawiki
 
-static UInt256 _BRBIP38DerivePassfactor(uint8_t flag, const uint8_t *entropy, const char *passphrase)
+// scrypt in the caller's scratch memory if there is enough of it, otherwise in memory of its own
+static void _BRBIP38Scrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                           unsigned n, unsigned r, unsigned p, void *scratch, size_t scratchLen)
+{
+    if (scratch && scratchLen >= BRScryptScratchSize(n, r, 1)) {
+        BRScryptWithScratch(dk, dkLen, pw, pwLen, salt, saltLen, n, r, p, scratch, scratchLen);
+    }
+    else BRScrypt(dk, dkLen, pw, pwLen, salt, saltLen, n, r, p);
+}
+
+static UInt256 _BRBIP38DerivePassfactor(uint8_t flag, const uint8_t *entropy, const char *passphrase, void *scratch,
+                                        size_t scratchLen)
 {
     size_t len = strlen(passphrase);
     UInt256 prefactor, passfactor;
     
-    BRScrypt(&prefactor, sizeof(prefactor), passphrase, len, entropy, (flag & BIP38_LOTSEQUENCE_FLAG) ? 4 : 8,
-             BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P);
+    _BRBIP38Scrypt(&prefactor, sizeof(prefactor), passphrase, len, entropy, (flag & BIP38_LOTSEQUENCE_FLAG) ? 4 : 8,
+                   BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P, scratch, scratchLen);
     
     if (flag & BIP38_LOTSEQUENCE_FLAG) { // passfactor = SHA256(SHA256(prefactor + entropy))
         uint8_t d[sizeof(prefactor) + sizeof(uint64_t)];
@@ -70,15 +81,16 @@ static UInt256 _BRBIP38DerivePassfactor(uint8_t flag, const uint8_t *entropy, co
     return passfactor;
 }
 
-static UInt512 _BRBIP38DeriveKey(BRECPoint passpoint, const uint8_t *addresshash, const uint8_t *entropy)
+static UInt512 _BRBIP38DeriveKey(BRECPoint passpoint, const uint8_t *addresshash, const uint8_t *entropy, void *scratch,
+                                 size_t scratchLen)
 {
     UInt512 dk;
     uint8_t salt[sizeof(uint32_t) + sizeof(uint64_t)];
     
     memcpy(salt, addresshash, sizeof(uint32_t));
     memcpy(&salt[sizeof(uint32_t)], entropy, sizeof(uint64_t)); // salt = addresshash + entropy
-    BRScrypt(&dk, sizeof(dk), &passpoint, sizeof(passpoint), salt, sizeof(salt), BIP38_SCRYPT_EC_N, BIP38_SCRYPT_EC_R,
-             BIP38_SCRYPT_EC_P);
+    _BRBIP38Scrypt(&dk, sizeof(dk), &passpoint, sizeof(passpoint), salt, sizeof(salt), BIP38_SCRYPT_EC_N,
+                   BIP38_SCRYPT_EC_R, BIP38_SCRYPT_EC_P, scratch, scratchLen);
     mem_clean(salt, sizeof(salt));
     return dk;
 }
@@ -104,16 +116,29 @@ int BRBIP38KeyIsValid(const char *bip38Key)
     else return 0; // invalid prefix
 }
 
+size_t BRBIP38ScratchSize(void)
+{
+    return BRScryptScratchSize(BIP38_SCRYPT_N, BIP38_SCRYPT_R, BRScryptLanes(BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P));
+}
+
 // decrypts a BIP38 key using the given passphrase and returns false if passphrase is incorrect
 // passphrase must be unicode NFC normalized: http://www.unicode.org/reports/tr15/#Norm_Forms
 int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params)
 {
-    int r = 1;
+    return (BRKeySetBIP38KeyWithParams(key, bip38Key, passphrase, &params, 1, NULL, 0) != 0);
+}
+
+// decrypts a BIP38 key once, and checks the result against each of the address params in turn
+size_t BRKeySetBIP38KeyWithParams(BRKey *key, const char *bip38Key, const char *passphrase,
+                                  const BRAddressParams params[], size_t paramsCount, void *scratch, size_t scratchLen)
+{
+    size_t r = 0;
     uint8_t data[39];
     
     assert(key != NULL);
     assert(bip38Key != NULL);
     assert(passphrase != NULL);
+    assert(params != NULL || paramsCount == 0);
     
     if (BRBase58CheckDecode(data, sizeof(data), bip38Key) != 39) return 0; // invalid length
     
@@ -129,8 +154,8 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
         // data = prefix + flag + addresshash + encrypted1 + encrypted2
         UInt128 encrypted1 = UInt128Get(&data[7]), encrypted2 = UInt128Get(&data[23]);
 
-        BRScrypt(&derived, sizeof(derived), passphrase, pwLen, addresshash, sizeof(uint32_t),
-                 BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P);
+        _BRBIP38Scrypt(&derived, sizeof(derived), passphrase, pwLen, addresshash, sizeof(uint32_t),
+                       BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P, scratch, scratchLen);
         derived1 = *(UInt256 *)&derived, derived2 = *(UInt256 *)&derived.u8[sizeof(UInt256)];
         var_clean(&derived);
         
@@ -148,12 +173,12 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
         // data = prefix + flag + addresshash + entropy + encrypted1[0...7] + encrypted2
         const uint8_t *entropy = &data[7];
         UInt128 encrypted1 = UINT128_ZERO, encrypted2 = UInt128Get(&data[23]);
-        UInt256 passfactor = _BRBIP38DerivePassfactor(flag, entropy, passphrase), factorb;
+        UInt256 passfactor = _BRBIP38DerivePassfactor(flag, entropy, passphrase, scratch, scratchLen), factorb;
         BRECPoint passpoint;
         uint64_t seedb[3];
         
         BRSecp256k1PointGen(&passpoint, &passfactor); // passpoint = G*passfactor
-        derived = _BRBIP38DeriveKey(passpoint, addresshash, entropy);
+        derived = _BRBIP38DeriveKey(passpoint, addresshash, entropy, scratch, scratchLen);
         var_clean(&passpoint);
         derived1 = *(UInt256 *)&derived, derived2 = *(UInt256 *)&derived.u8[sizeof(UInt256)];
         var_clean(&derived);
@@ -180,9 +205,13 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
     
     BRKeySetSecret(key, &secret, flag & BIP38_COMPRESSED_FLAG);
     var_clean(&secret);
-    BRKeyLegacyAddr(key, address.s, sizeof(address), params);
-    BRSHA256_2(&hash, address.s, strlen(address.s));
-    if (! address.s[0] || memcmp(&hash, addresshash, sizeof(uint32_t)) != 0) r = 0;
+    
+    for (size_t i = 0; r == 0 && i < paramsCount; i++) {
+        BRKeyLegacyAddr(key, address.s, sizeof(address), params[i]);
+        BRSHA256_2(&hash, address.s, strlen(address.s));
+        if (address.s[0] && memcmp(&hash, addresshash, sizeof(uint32_t)) == 0) r = i + 1;
+    }
+    
     return r;
 }
 
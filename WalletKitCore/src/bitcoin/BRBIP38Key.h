@@ -40,6 +40,15 @@ int BRBIP38KeyIsValid(const char *bip38Key);
 // passphrase must be unicode NFC normalized: http://www.unicode.org/reports/tr15/#Norm_Forms
 int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params);
 
+// decrypts a BIP38 key once and checks it against each of paramsCount address params in order, returning the index of
+// the first that matches plus one, or 0 if the passphrase is incorrect (for all of them)
+// scratch, if not NULL, is reused scrypt memory of scratchLen bytes, with BRBIP38ScratchSize() giving full parallelism
+size_t BRKeySetBIP38KeyWithParams(BRKey *key, const char *bip38Key, const char *passphrase,
+                                  const BRAddressParams params[], size_t paramsCount, void *scratch, size_t scratchLen);
+
+// bytes of scrypt scratch memory to decrypt BIP38 keys, mixing in parallel as BRScrypt() would
+size_t BRBIP38ScratchSize(void);
+
 // generates an "intermediate code" for an EC multiply mode key
 // salt should be 64bits of random data
 // passphrase must be unicode NFC normalized
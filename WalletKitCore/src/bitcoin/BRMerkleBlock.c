@@ -26,6 +26,7 @@
 #include "support/BRBase.h"
 #include "support/BRCrypto.h"
 #include "support/BRAddress.h"
+#include "support/BROSCompat.h"
 #include <stdlib.h>
 #include <inttypes.h>
 #include <limits.h>
@@ -34,6 +35,8 @@
 
 #define MAX_PROOF_OF_WORK 0x1d00ffff    // highest value for difficulty target (higher values are less difficult)
 #define TARGET_TIMESPAN   (14*24*60*60) // the targeted timespan between difficulty target adjustments
+#define PAIRS_PER_GROUP   64            // merkle branch pairs hashed together by a merkle root thread
+#define PAIRS_PER_THREAD  2048          // minimum number of branch pairs in a tree level worth handing to a thread
 
 inline static int _ceil_log2(int x)
 {
@@ -97,9 +100,8 @@ BRMerkleBlock *BRMerkleBlockCopy(const BRMerkleBlock *block)
     return cpy;
 }
 
-// buf must contain either a serialized merkleblock or header
-// returns a merkle block struct that must be freed by calling BRMerkleBlockFree()
-BRMerkleBlock *BRMerkleBlockParse(const uint8_t *buf, size_t bufLen)
+// parses a serialized merkleblock or header, leaving blockHash unset
+static BRMerkleBlock *_BRMerkleBlockParse(const uint8_t *buf, size_t bufLen)
 {
     BRMerkleBlock *block = (buf && 80 <= bufLen) ? BRMerkleBlockNew() : NULL;
     size_t off = 0, len = 0;
@@ -136,8 +138,6 @@ BRMerkleBlock *BRMerkleBlockParse(const uint8_t *buf, size_t bufLen)
             if (block->flags) memcpy(block->flags, &buf[off], len);
             off += len;
         }
-        
-        BRSHA256_2(&block->blockHash, buf, 80);
 
         if (off > bufLen) {
             BRMerkleBlockFree(block);
@@ -148,6 +148,38 @@ BRMerkleBlock *BRMerkleBlockParse(const uint8_t *buf, size_t bufLen)
     return block;
 }
 
+// buf must contain either a serialized merkleblock or header
+// returns a merkle block struct that must be freed by calling BRMerkleBlockFree()
+BRMerkleBlock *BRMerkleBlockParse(const uint8_t *buf, size_t bufLen)
+{
+    BRMerkleBlock *block = _BRMerkleBlockParse(buf, bufLen);
+    
+    if (block) BRSHA256_2(&block->blockHash, buf, 80);
+    return block;
+}
+
+// parses count headers from a headers message, each 80 bytes followed by a tx count (81 bytes), into blocks
+// the block hashes are calculated together with BRSHA256_2Batch(), up to 8 at a time
+// blocks that are returned must be freed by calling BRMerkleBlockFree()
+void BRMerkleBlockParseHeaders(BRMerkleBlock *blocks[], const uint8_t *buf, size_t count)
+{
+    UInt256 hashes[8];
+    size_t i, j, n;
+    
+    assert(blocks != NULL || count == 0);
+    assert(buf != NULL || count == 0);
+    
+    for (i = 0; i < count; i += n) {
+        n = (count - i < 8) ? count - i : 8;
+        BRSHA256_2Batch(hashes, &buf[i*81], 80, 81, n);
+        
+        for (j = 0; j < n; j++) {
+            blocks[i + j] = _BRMerkleBlockParse(&buf[(i + j)*81], 81);
+            if (blocks[i + j]) blocks[i + j]->blockHash = hashes[j];
+        }
+    }
+}
+
 // returns number of bytes written to buf, or total bufLen needed if buf is NULL (block->height is not serialized)
 size_t BRMerkleBlockSerialize(const BRMerkleBlock *block, uint8_t *buf, size_t bufLen)
 {
@@ -242,31 +274,112 @@ void BRMerkleBlockSetTxHashes(BRMerkleBlock *block, const UInt256 hashes[], size
     if (block->flags) memcpy(block->flags, flags, flagsLen);
 }
 
-// recursively walks the merkle tree to calculate the merkle root
-// NOTE: this merkle tree design has a security vulnerability (CVE-2012-2459), which can be defended against by
-// considering the merkle root invalid if there are duplicate hashes in any rows with an even number of elements
-static UInt256 _BRMerkleBlockRootR(const BRMerkleBlock *block, size_t *hashIdx, size_t *flagIdx, int depth)
+typedef struct {
+    int depth;
+    size_t left, right; // child node indexes, SIZE_MAX for a leaf or missing node
+    UInt256 md;
+} BRMerkleNode;
+
+// recursively walks the merkle tree in the same order as the hashes and flags, recording each node's children or
+// leaf hash, and returns the index of the node
+static size_t _BRMerkleBlockNodesR(const BRMerkleBlock *block, BRMerkleNode *nodes, size_t *count, size_t *hashIdx,
+                                   size_t *flagIdx, int depth)
 {
+    size_t i = (*count)++;
     uint8_t flag;
-    UInt256 hashes[2], md = UINT256_ZERO;
+
+    nodes[i].depth = depth, nodes[i].left = nodes[i].right = SIZE_MAX, nodes[i].md = UINT256_ZERO;
 
     if (*flagIdx/8 < block->flagsLen && *hashIdx < block->hashesCount) {
         flag = (block->flags[*flagIdx/8] & (1 << (*flagIdx % 8)));
         (*flagIdx)++;
 
         if (flag && depth != _ceil_log2(block->totalTx)) {
-            hashes[0] = _BRMerkleBlockRootR(block, hashIdx, flagIdx, depth + 1); // left branch
-            hashes[1] = _BRMerkleBlockRootR(block, hashIdx, flagIdx, depth + 1); // right branch
+            nodes[i].left = _BRMerkleBlockNodesR(block, nodes, count, hashIdx, flagIdx, depth + 1); // left branch
+            nodes[i].right = _BRMerkleBlockNodesR(block, nodes, count, hashIdx, flagIdx, depth + 1); // right branch
+        }
+        else nodes[i].md = block->hashes[(*hashIdx)++]; // leaf
+    }
+
+    return i;
+}
+
+typedef struct {
+    const UInt256 *pairs;
+    UInt256 *mds;
+    size_t count;
+} BRMerkleLevelBatch;
+
+// double-sha256 hashes the group of PAIRS_PER_GROUP branch pairs at index in a merkle tree level
+static void _BRMerkleBlockHashPairs(void *info, size_t index)
+{
+    BRMerkleLevelBatch *batch = info;
+    size_t i = index*PAIRS_PER_GROUP, n = (batch->count - i < PAIRS_PER_GROUP) ? batch->count - i : PAIRS_PER_GROUP;
+
+    BRSHA256_2Batch(&batch->mds[i], &batch->pairs[i*2], sizeof(UInt256)*2, sizeof(UInt256)*2, n);
+}
+
+// calculates the merkle root one tree level at a time, deepest first, double-sha256 hashing all the branch pairs of a
+// level together with BRSHA256_2Batch(), spread across threads for a level of PAIRS_PER_THREAD or more pairs
+// NOTE: this merkle tree design has a security vulnerability (CVE-2012-2459), which can be defended against by
+// considering the merkle root invalid if there are duplicate hashes in any rows with an even number of elements
+static UInt256 _BRMerkleBlockRoot(const BRMerkleBlock *block)
+{
+    size_t i, j, max, count = 0, hashIdx = 0, flagIdx = 0;
+    BRMerkleNode *nodes;
+    UInt256 *pairs, *mds, md = UINT256_ZERO;
+    size_t *idxs;
+    int depth, r = 1;
+
+    if (block->flagsLen == 0 || block->hashesCount == 0) return md;
+    // every branch node has two children, and every leaf either uses a hash or, once hashes or flags run out, is one
+    // of at most depth + 1 empty nodes, so there are at most 2*(hashesCount + depth) + 1 nodes - and never more than
+    // the flag bits allow
+    max = 2*(block->hashesCount + _ceil_log2(block->totalTx)) + 1;
+    if (block->flagsLen*8*2 + 1 < max) max = block->flagsLen*8*2 + 1;
+    nodes = malloc(max*sizeof(*nodes));
+    if (! nodes) return md;
+    _BRMerkleBlockNodesR(block, nodes, &count, &hashIdx, &flagIdx, 0);
+    assert(count <= max);
+    pairs = malloc(count*(sizeof(*pairs)*3 + sizeof(*idxs)));
+
+    if (! pairs) {
+        free(nodes);
+        return md;
+    }
+
+    mds = &pairs[count*2];
+    idxs = (size_t *)&mds[count];
+
+    for (depth = _ceil_log2(block->totalTx) - 1; r && depth >= 0; depth--) {
+        for (i = 0, j = 0; r && i < count; i++) {
+            if (nodes[i].depth != depth || nodes[i].left == SIZE_MAX) continue;
+            pairs[j*2] = nodes[nodes[i].left].md;
+            pairs[j*2 + 1] = nodes[nodes[i].right].md;
 
-            if (! UInt256IsZero(hashes[0]) && ! UInt256Eq(hashes[0], hashes[1])) {
-                if (UInt256IsZero(hashes[1])) hashes[1] = hashes[0]; // if right branch is missing, dup left branch
-                BRSHA256_2(&md, hashes, sizeof(hashes));
+            if (UInt256IsZero(pairs[j*2]) || UInt256Eq(pairs[j*2], pairs[j*2 + 1])) {
+                r = 0; // defend against (CVE-2012-2459)
             }
-            else *hashIdx = SIZE_MAX; // defend against (CVE-2012-2459)
+            else if (UInt256IsZero(pairs[j*2 + 1])) pairs[j*2 + 1] = pairs[j*2]; // if right branch is missing, dup left
+
+            idxs[j++] = i;
+        }
+
+        if (r && j >= 2*PAIRS_PER_THREAD && processor_count_brd() > 1) {
+            BRMerkleLevelBatch batch = { pairs, mds, j };
+            size_t threadCount = j/PAIRS_PER_THREAD;
+
+            if (threadCount > processor_count_brd()) threadCount = processor_count_brd();
+            pthread_apply_brd((j + PAIRS_PER_GROUP - 1)/PAIRS_PER_GROUP, (unsigned int)threadCount, &batch,
+                              _BRMerkleBlockHashPairs);
         }
-        else md = block->hashes[(*hashIdx)++]; // leaf
+        else if (r) BRSHA256_2Batch(mds, pairs, sizeof(UInt256)*2, sizeof(UInt256)*2, j);
+        for (i = 0; r && i < j; i++) nodes[idxs[i]].md = mds[i];
     }
-    
+
+    if (r) md = nodes[0].md;
+    free(pairs);
+    free(nodes);
     return md;
 }
 
@@ -280,8 +393,7 @@ int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime)
     // target is in "compact" format, where the most significant byte is the size of the value in bytes, next
     // bit is the sign, and the last 23 bits is the value after having been right shifted by (size - 3)*8 bits
     const uint32_t size = block->target >> 24, target = block->target & 0x007fffff;
-    size_t hashIdx = 0, flagIdx = 0;
-    UInt256 merkleRoot = _BRMerkleBlockRootR(block, &hashIdx, &flagIdx, 0), t = UINT256_ZERO;
+    UInt256 merkleRoot = _BRMerkleBlockRoot(block), t = UINT256_ZERO;
     int r = 1;
     
     // check if merkle root is correct
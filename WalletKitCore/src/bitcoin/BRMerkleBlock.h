@@ -66,6 +66,11 @@ BRMerkleBlock *BRMerkleBlockCopy(const BRMerkleBlock *block);
 // returns a merkle block struct that must be freed by calling BRMerkleBlockFree()
 BRMerkleBlock *BRMerkleBlockParse(const uint8_t *buf, size_t bufLen);
 
+// parses count headers from a headers message, each 80 bytes followed by a tx count (81 bytes), into blocks
+// block hashes are calculated a batch at a time with BRSHA256_2Batch()
+// blocks that are returned must be freed by calling BRMerkleBlockFree()
+void BRMerkleBlockParseHeaders(BRMerkleBlock *blocks[], const uint8_t *buf, size_t count);
+
 // returns number of bytes written to buf, or total bufLen needed if buf is NULL (block->height is not serialized)
 size_t BRMerkleBlockSerialize(const BRMerkleBlock *block, uint8_t *buf, size_t bufLen);
 
@@ -54,6 +54,9 @@
 #define CONNECT_TIMEOUT    3.0
 #define MESSAGE_TIMEOUT    10.0
 #define WITNESS_FLAG       0x40000000
+#define RECV_BUFFER_LENGTH 0x40000  // room for a full headers message, or several merkleblock/tx messages
+#define HEADERS_PER_THREAD 500      // minimum number of headers worth handing to a validation thread
+#define HEADERS_PER_GROUP  8        // headers parsed and hashed together by a validation thread
 
 #define PTHREAD_STACK_SIZE  (512 * 1024)
 
@@ -456,6 +459,29 @@ static int _BRPeerAcceptTxMessage(BRPeer *peer, const uint8_t *msg, size_t msgLe
     return r;
 }
 
+typedef struct {
+    const uint8_t *msg;
+    size_t count;
+    BRMerkleBlock **blocks;
+    int *valid;
+    uint32_t now;
+} BRPeerHeadersBatch;
+
+// parses and validates the group of HEADERS_PER_GROUP headers at index in a headers message
+static void _BRPeerParseHeaders(void *info, size_t index)
+{
+    BRPeerHeadersBatch *batch = info;
+    size_t i = index*HEADERS_PER_GROUP, end = i + HEADERS_PER_GROUP;
+
+    if (end > batch->count) end = batch->count;
+
+    BRMerkleBlockParseHeaders(&batch->blocks[i], &batch->msg[81*i], end - i);
+    
+    for (; i < end; i++) {
+        batch->valid[i] = (batch->blocks[i] && BRMerkleBlockIsValid(batch->blocks[i], batch->now));
+    }
+}
+
 static int _BRPeerAcceptHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen)
 {
     BRPeerContext *ctx = (BRPeerContext *)peer;
@@ -495,14 +521,31 @@ static int _BRPeerAcceptHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t
             }
             else BRPeerSendGetheaders(peer, locators, 2, UINT256_ZERO);
 
-            for (size_t i = 0; r && i < count; i++) {
-                BRMerkleBlock *block = BRMerkleBlockParse(&msg[off + 81*i], 81);
-                
-                if (! block) {
+            // hashing and proof-of-work checks don't depend on the chain, so do them for the whole batch up front,
+            // spread across threads, and only hand valid headers to relayedBlock() for linking
+            BRMerkleBlock **blocks = calloc(count, sizeof(*blocks));
+            int *valid = calloc(count, sizeof(*valid));
+            BRPeerHeadersBatch batch = { &msg[off], count, blocks, valid, (uint32_t)now };
+            size_t threadCount = count/HEADERS_PER_THREAD;
+
+            // pthread_apply_brd() takes a threadCount of 0 as one thread per processor
+            if (threadCount > processor_count_brd()) threadCount = processor_count_brd();
+            if (threadCount < 1) threadCount = 1;
+            assert((blocks != NULL && valid != NULL) || count == 0);
+            pthread_apply_brd((count + HEADERS_PER_GROUP - 1)/HEADERS_PER_GROUP, (unsigned int)threadCount,
+                              &batch, _BRPeerParseHeaders);
+
+            for (size_t i = 0; i < count; i++) {
+                BRMerkleBlock *block = blocks[i];
+
+                if (! r) {
+                    if (block) BRMerkleBlockFree(block);
+                }
+                else if (! block) {
                     peer_log(peer, "malformed headers message with length: %zu", msgLen);
                     r = 0;
                 }
-                else if (! BRMerkleBlockIsValid(block, (uint32_t)now)) {
+                else if (! valid[i]) {
                     peer_log(peer, "invalid block header: %s", u256hex(block->blockHash));
                     BRMerkleBlockFree(block);
                     r = 0;
@@ -512,6 +555,9 @@ static int _BRPeerAcceptHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t
                 }
                 else BRMerkleBlockFree(block);
             }
+
+            if (blocks) free(blocks);
+            if (valid) free(valid);
         }
         else {
             peer_log(peer, "non-standard headers message, %zu is fewer header(s) than expected", count);
@@ -944,6 +990,21 @@ static int _BRPeerOpenSocket(BRPeer *peer, int domain, double timeout, int *erro
     return r;
 }
 
+// returns the offset of the first possible magic number in buf[off..end), or end if there is none; a magic number
+// split by the end of the buffer is kept so the rest of it can be read
+static size_t _BRPeerFindMagicNumber(const uint8_t *buf, size_t off, size_t end, uint32_t magicNumber)
+{
+    const uint8_t *p;
+
+    while (off < end && (p = memchr(&buf[off], (int)(magicNumber & 0xff), end - off)) != NULL) {
+        off = (size_t)(p - buf);
+        if (end - off < sizeof(uint32_t) || UInt32GetLE(p) == magicNumber) return off;
+        off++;
+    }
+
+    return end;
+}
+
 static int _peerCheckAndGetSocket (BRPeerContext *ctx, int *socket) {
     int exists;
 
@@ -1000,26 +1061,98 @@ static void *_peerThreadRoutine(void *arg)
 
     if (_BRPeerOpenSocket(peer, PF_INET6, CONNECT_TIMEOUT, &error)) {
         struct timeval tv;
-        double time = 0, msgTimeout;
-        uint8_t header[HEADER_LENGTH], *payload = malloc(0x1000);
-        size_t len = 0, payloadLen = 0x1000;
+        double time = 0, msgTimeout = DBL_MAX;
+        uint8_t *buf = malloc(RECV_BUFFER_LENGTH);
+        size_t bufLen = RECV_BUFFER_LENGTH, off = 0, end = 0; // unconsumed bytes are buf[off..end)
         ssize_t n = 0;
 
-        assert(payload != NULL);
+        assert(buf != NULL);
         gettimeofday(&tv, NULL);
         ctx->startTime = tv.tv_sec + (double)tv.tv_usec/1000000;
         BRPeerSendVersionMessage(peer);
 
         while (_peerCheckAndGetSocket(ctx, &socket) && ! error) {
-            len = 0;
-
-            while (socket >= 0 && ! error && len < HEADER_LENGTH) {
-                n = read(socket, &header[len], sizeof(header) - len);
-                if (n > 0) len += (size_t) n;
-                if (n == 0) error = ECONNRESET;
-                if (n < 0 && errno != EWOULDBLOCK) error = errno;
-                gettimeofday(&tv, NULL);
-                time = tv.tv_sec + (double)tv.tv_usec/1000000;
+            // drop anything that can't be the start of a message
+            if (end - off >= sizeof(uint32_t) && UInt32GetLE(&buf[off]) != ctx->magicNumber) {
+                off = _BRPeerFindMagicNumber(buf, off, end, ctx->magicNumber);
+            }
+
+            if (end - off >= HEADER_LENGTH) {
+                const uint8_t *header = &buf[off];
+                const char *type = (const char *)(&header[4]);
+                uint32_t msgLen = UInt32GetLE(&header[16]);
+                uint32_t checksum = UInt32GetLE(&header[20]);
+                UInt256 hash;
+
+                if (header[15] != 0) { // verify header type field is NULL terminated
+                    peer_log(peer, "malformed message header: type not NULL terminated");
+                    error = EPROTO;
+                    continue;
+                }
+                else if (msgLen > MAX_MSG_LENGTH) { // check message length
+                    peer_log(peer, "error reading %s, message length %"PRIu32" is too long", type, msgLen);
+                    error = EPROTO;
+                    continue;
+                }
+                else if (end - off - HEADER_LENGTH >= msgLen) { // the whole message is buffered, accept it in place
+                    const uint8_t *payload = &header[HEADER_LENGTH];
+
+                    off += HEADER_LENGTH + msgLen;
+                    msgTimeout = DBL_MAX;
+                    BRSHA256_2(&hash, payload, msgLen);
+
+                    if (UInt32GetLE(&hash) != checksum) { // verify checksum
+                        peer_log(peer, "error reading %s, invalid checksum %x, expected %x, payload length:%"PRIu32
+                                 ", SHA256_2:%s", type, UInt32GetLE(&hash), checksum, msgLen, u256hex(hash));
+                        error = EPROTO;
+                    }
+                    else if (! _BRPeerAcceptMessage(peer, payload, msgLen, type)) error = EPROTO;
+
+                    continue;
+                }
+                else if (HEADER_LENGTH + msgLen > bufLen) { // grow to fit an oversized message
+                    memmove(buf, &buf[off], end - off);
+                    end -= off;
+                    off = 0;
+                    buf = realloc(buf, (bufLen = HEADER_LENGTH + msgLen));
+                    assert(buf != NULL);
+                }
+
+                if (msgTimeout == DBL_MAX) { // start timing the remainder of this message
+                    gettimeofday(&tv, NULL);
+                    msgTimeout = tv.tv_sec + (double)tv.tv_usec/1000000 + MESSAGE_TIMEOUT;
+                }
+            }
+
+            // make room at the end of the buffer for the next read, only moving the unconsumed bytes
+            if (off == end) {
+                off = end = 0;
+
+                if (bufLen > RECV_BUFFER_LENGTH) { // return to the default size after an oversized message
+                    free(buf);
+                    buf = malloc((bufLen = RECV_BUFFER_LENGTH));
+                    assert(buf != NULL);
+                }
+            }
+            else if (end == bufLen) {
+                memmove(buf, &buf[off], end - off);
+                end -= off;
+                off = 0;
+            }
+
+            // a single read picks up the rest of the current message along with any that follow it
+            n = (socket >= 0) ? read(socket, &buf[end], bufLen - end) : -1;
+            if (n > 0) end += (size_t) n;
+            if (n == 0) error = ECONNRESET;
+            if (n < 0 && socket >= 0 && errno != EWOULDBLOCK) error = errno;
+            gettimeofday(&tv, NULL);
+            time = tv.tv_sec + (double)tv.tv_usec/1000000;
+
+            if (msgTimeout != DBL_MAX) { // waiting on the remainder of a message
+                if (n > 0) msgTimeout = time + MESSAGE_TIMEOUT;
+                if (! error && time >= msgTimeout) error = ETIMEDOUT;
+            }
+            else {
                 if (! error && time >= _peerGetDisconnectTime(ctx)) error = ETIMEDOUT;
 
                 if (! error && time >= _peerGetMempoolTime(ctx)) {
@@ -1031,68 +1164,12 @@ static void *_peerThreadRoutine(void *arg)
                     ctx->mempoolTime = DBL_MAX;
                     pthread_mutex_unlock(&ctx->lock);
                 }
-
-                while (sizeof(uint32_t) <= len && UInt32GetLE(header) != ctx->magicNumber) {
-                    memmove(header, &header[1], --len); // consume one byte at a time until we find the magic number
-                }
-
-                socket = _peerGetSocket(ctx);
-            }
-            
-            if (error) {
-                peer_log(peer, "%s", strerror(error));
-            }
-            else if (header[15] != 0) { // verify header type field is NULL terminated
-                peer_log(peer, "malformed message header: type not NULL terminated");
-                error = EPROTO;
-            }
-            else if (len == HEADER_LENGTH) {
-                const char *type = (const char *)(&header[4]);
-                uint32_t msgLen = UInt32GetLE(&header[16]);
-                uint32_t checksum = UInt32GetLE(&header[20]);
-                UInt256 hash;
-                
-                if (msgLen > MAX_MSG_LENGTH) { // check message length
-                    peer_log(peer, "error reading %s, message length %"PRIu32" is too long", type, msgLen);
-                    error = EPROTO;
-                }
-                else {
-                    if (msgLen > payloadLen) payload = realloc(payload, (payloadLen = msgLen));
-                    assert(payload != NULL);
-                    len = 0;
-                    socket = _peerGetSocket(ctx);
-                    msgTimeout = time + MESSAGE_TIMEOUT;
-                    
-                    while (socket >= 0 && ! error && len < msgLen) {
-                        n = read(socket, &payload[len], msgLen - len);
-                        if (n > 0) len += (size_t) n;
-                        if (n == 0) error = ECONNRESET;
-                        if (n < 0 && errno != EWOULDBLOCK) error = errno;
-                        gettimeofday(&tv, NULL);
-                        time = tv.tv_sec + (double)tv.tv_usec/1000000;
-                        if (n > 0) msgTimeout = time + MESSAGE_TIMEOUT;
-                        if (! error && time >= msgTimeout) error = ETIMEDOUT;
-                        socket = _peerGetSocket(ctx);
-                    }
-                    
-                    if (error) {
-                        peer_log(peer, "%s", strerror(error));
-                    }
-                    else if (len == msgLen) {
-                        BRSHA256_2(&hash, payload, msgLen);
-                        
-                        if (UInt32GetLE(&hash) != checksum) { // verify checksum
-                            peer_log(peer, "error reading %s, invalid checksum %x, expected %x, payload length:%"PRIu32
-                                     ", SHA256_2:%s", type, UInt32GetLE(&hash), checksum, msgLen, u256hex(hash));
-                            error = EPROTO;
-                        }
-                        else if (! _BRPeerAcceptMessage(peer, payload, msgLen, type)) error = EPROTO;
-                    }
-                }
             }
+
+            if (error) peer_log(peer, "%s", strerror(error));
         }
         
-        free(payload);
+        free(buf);
     }
 
     pthread_mutex_lock(&ctx->lock);
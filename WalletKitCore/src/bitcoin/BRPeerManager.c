@@ -1158,6 +1158,7 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
     size_t i, j, fpCount = 0, saveCount = 0;
     BRMerkleBlock orphan, *b, *b2, *prev, *next = NULL;
     uint32_t txTime = 0;
+    int isDownloadPeer;
 
     if (NULL == peer || NULL == manager) {
         _peerRelayedBlockFailed (block, peer, "missed 'peer' or 'manager'");
@@ -1186,6 +1187,16 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
     assert(txHashes != NULL);
     txCount = BRMerkleBlockTxHashes(block, txHashes, txCount);
 
+    pthread_mutex_lock(&manager->lock);
+    isDownloadPeer = (peer == manager->downloadPeer);
+    pthread_mutex_unlock(&manager->lock);
+
+    // only the download peer's blocks are tracked for the false positive rate; wallet tx are not false-positives, and
+    // the wallet has its own lock, so count them before taking the manager lock for the block
+    for (i = 0; isDownloadPeer && block->totalTx > 0 && i < txCount; i++) {
+        if (! BRWalletTransactionForHash(manager->wallet, txHashes[i])) fpCount++;
+    }
+
     pthread_mutex_lock(&manager->lock);
     prev = BRSetGet(manager->blocks, &block->prevBlock);
 
@@ -1195,11 +1206,7 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
     }
     
     // track the observed bloom filter false positive rate using a low pass filter to smooth out variance
-    if (peer == manager->downloadPeer && block->totalTx > 0) {
-        for (i = 0; i < txCount; i++) { // wallet tx are not false-positives
-            if (! BRWalletTransactionForHash(manager->wallet, txHashes[i])) fpCount++;
-        }
-        
+    if (isDownloadPeer && peer == manager->downloadPeer && block->totalTx > 0) {
         // moving average number of tx-per-block
         manager->averageTxPerBlock = manager->averageTxPerBlock*0.999 + block->totalTx*0.001;
         
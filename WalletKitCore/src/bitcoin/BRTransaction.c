@@ -36,6 +36,70 @@
 #define SIGHASH_ANYONECANPAY 0x80 // let other people add inputs, I don't care where the rest of the bitcoins come from
 #define SIGHASH_FORKID       0x40 // use BIP143 digest method (for b-cash/b-gold signatures)
 
+// Transactions created by BRTransactionParse() and BRTransactionCopy() are compact: the struct, its inputs and outputs,
+// and every script, signature and witness live in a single allocation. Each of those is laid out as a BRArray whose
+// capacity is TX_POOLED, so the setters and BRTransactionFree() know not to free them individually. Transactions
+// created by BRTransactionNew() use separately allocated, growable arrays, and the two kinds mix freely.
+#define TX_POOLED            SIZE_MAX
+
+#define _BRTxIsPooled(array) (array_capacity(array) == TX_POOLED)
+
+// frees script, signature or witness data unless it's part of a compact transaction
+static void _BRTxDataFree(uint8_t *data)
+{
+    if (data && ! _BRTxIsPooled(data)) array_free(data);
+}
+
+// bytes taken from a compact transaction's allocation by an array holding len bytes of items
+inline static size_t _BRTxPoolSize(size_t len)
+{
+    return (sizeof(size_t)*2 + len + 7) & ~(size_t)7; // keep 8 byte alignment for the uint64_t fields that follow
+}
+
+// lays out an array of count items at *pool, advancing *pool past it
+static void *_BRTxPoolArray(uint8_t **pool, size_t count, size_t itemSize)
+{
+    size_t *array = (size_t *)*pool;
+
+    array[0] = TX_POOLED;
+    array[1] = count;
+    *pool += _BRTxPoolSize(count*itemSize);
+    return &array[2];
+}
+
+// copies len bytes of data into the next array at *pool and returns it; if *pool is NULL, just adds the bytes needed
+// to *poolLen so an allocation can be sized before it's filled in
+static uint8_t *_BRTxPoolData(uint8_t **pool, size_t *poolLen, const uint8_t *data, size_t len)
+{
+    uint8_t *array = NULL;
+
+    if (*pool) {
+        array = _BRTxPoolArray(pool, len, sizeof(*array));
+        if (len > 0) memcpy(array, data, len);
+    }
+
+    *poolLen += _BRTxPoolSize(len);
+    return array;
+}
+
+// allocates a zeroed compact transaction with room for inCount inputs, outCount outputs and poolLen bytes of pooled
+// data, setting *pool to where that data goes
+static BRTransaction *_BRTransactionCompactNew(size_t inCount, size_t outCount, size_t poolLen, uint8_t **pool)
+{
+    size_t txLen = (sizeof(BRTransaction) + 7) & ~(size_t)7;
+    uint8_t *buf = calloc(1, txLen + _BRTxPoolSize(inCount*sizeof(BRTxInput)) +
+                          _BRTxPoolSize(outCount*sizeof(BRTxOutput)) + poolLen);
+    BRTransaction *tx = (BRTransaction *)buf;
+
+    assert(buf != NULL);
+    *pool = &buf[txLen];
+    tx->inputs = _BRTxPoolArray(pool, inCount, sizeof(BRTxInput));
+    tx->inCount = inCount;
+    tx->outputs = _BRTxPoolArray(pool, outCount, sizeof(BRTxOutput));
+    tx->outCount = outCount;
+    return tx;
+}
+
 size_t BRTxInputAddress(const BRTxInput *input, char *address, size_t addrLen, BRAddressParams params)
 {
     size_t r = BRAddressFromScriptPubKey(address, addrLen, params, input->script, input->scriptLen);
@@ -49,7 +113,7 @@ void BRTxInputSetAddress(BRTxInput *input, BRAddressParams params, const char *a
 {
     assert(input != NULL);
     assert(address == NULL || BRAddressIsValid(params, address));
-    if (input->script) array_free(input->script);
+    _BRTxDataFree(input->script);
     input->script = NULL;
     input->scriptLen = 0;
 
@@ -65,7 +129,7 @@ void BRTxInputSetScript(BRTxInput *input, const uint8_t *script, size_t scriptLe
 {
     assert(input != NULL);
     assert(script != NULL || scriptLen == 0);
-    if (input->script) array_free(input->script);
+    _BRTxDataFree(input->script);
     input->script = NULL;
     input->scriptLen = 0;
     
@@ -80,7 +144,7 @@ void BRTxInputSetSignature(BRTxInput *input, const uint8_t *signature, size_t si
 {
     assert(input != NULL);
     assert(signature != NULL || sigLen == 0);
-    if (input->signature) array_free(input->signature);
+    _BRTxDataFree(input->signature);
     input->signature = NULL;
     input->sigLen = 0;
     
@@ -95,7 +159,7 @@ void BRTxInputSetWitness(BRTxInput *input, const uint8_t *witness, size_t witLen
 {
     assert(input != NULL);
     assert(witness != NULL || witLen == 0);
-    if (input->witness) array_free(input->witness);
+    _BRTxDataFree(input->witness);
     input->witness = NULL;
     input->witLen = 0;
     
@@ -139,7 +203,7 @@ void BRTxOutputSetAddress(BRTxOutput *output, BRAddressParams params, const char
 {
     assert(output != NULL);
     assert(address == NULL || BRAddressIsValid(params, address));
-    if (output->script) array_free(output->script);
+    _BRTxDataFree(output->script);
     output->script = NULL;
     output->scriptLen = 0;
 
@@ -154,7 +218,7 @@ void BRTxOutputSetAddress(BRTxOutput *output, BRAddressParams params, const char
 void BRTxOutputSetScript(BRTxOutput *output, const uint8_t *script, size_t scriptLen)
 {
     assert(output != NULL);
-    if (output->script) array_free(output->script);
+    _BRTxDataFree(output->script);
     output->script = NULL;
     output->scriptLen = 0;
 
@@ -193,6 +257,8 @@ static size_t _BRTransactionWitnessData(const BRTransaction *tx, uint8_t *data,
     BRTxInput input;
     int anyoneCanPay = (hashType & SIGHASH_ANYONECANPAY), sigHash = (hashType & 0x1f);
     size_t i, off = 0;
+    BRSHA256Context ctx;
+    uint8_t buf[sizeof(UInt256) + sizeof(uint32_t)];
     uint8_t scriptCode[] = { OP_DUP, OP_HASH160, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                              0, 0, 0, 0, 0, 0, 0, 0, 0, OP_EQUALVERIFY, OP_CHECKSIG };
 
@@ -201,24 +267,35 @@ static size_t _BRTransactionWitnessData(const BRTransaction *tx, uint8_t *data,
     off += sizeof(uint32_t);
     
     if (! anyoneCanPay) {
-        uint8_t buf[(sizeof(UInt256) + sizeof(uint32_t))*tx->inCount];
-        
-        for (i = 0; i < tx->inCount; i++) {
-            UInt256Set(&buf[(sizeof(UInt256) + sizeof(uint32_t))*i], tx->inputs[i].txHash);
-            UInt32SetLE(&buf[(sizeof(UInt256) + sizeof(uint32_t))*i + sizeof(UInt256)], tx->inputs[i].index);
+        if (data && off + sizeof(UInt256) <= dataLen) { // inputs hash, streamed one outpoint at a time
+            BRSHA256Init(&ctx);
+            
+            for (i = 0; i < tx->inCount; i++) {
+                UInt256Set(buf, tx->inputs[i].txHash);
+                UInt32SetLE(&buf[sizeof(UInt256)], tx->inputs[i].index);
+                BRSHA256Update(&ctx, buf, sizeof(UInt256) + sizeof(uint32_t));
+            }
+            
+            BRSHA256Final(&data[off], &ctx);
+            BRSHA256(&data[off], &data[off], sizeof(UInt256));
         }
-        
-        if (data && off + sizeof(UInt256) <= dataLen) BRSHA256_2(&data[off], buf, sizeof(buf)); // inputs hash
     }
     else if (data && off + sizeof(UInt256) <= dataLen) UInt256Set(&data[off], UINT256_ZERO); // anyone-can-pay
     
     off += sizeof(UInt256);
     
     if (! anyoneCanPay && sigHash != SIGHASH_SINGLE && sigHash != SIGHASH_NONE) {
-        uint8_t buf[sizeof(uint32_t)*tx->inCount];
-        
-        for (i = 0; i < tx->inCount; i++) UInt32SetLE(&buf[sizeof(uint32_t)*i], tx->inputs[i].sequence);
-        if (data && off + sizeof(UInt256) <= dataLen) BRSHA256_2(&data[off], buf, sizeof(buf)); // sequence hash
+        if (data && off + sizeof(UInt256) <= dataLen) { // sequence hash
+            BRSHA256Init(&ctx);
+            
+            for (i = 0; i < tx->inCount; i++) {
+                UInt32SetLE(buf, tx->inputs[i].sequence);
+                BRSHA256Update(&ctx, buf, sizeof(uint32_t));
+            }
+            
+            BRSHA256Final(&data[off], &ctx);
+            BRSHA256(&data[off], &data[off], sizeof(UInt256));
+        }
     }
     else if (data && off + sizeof(UInt256) <= dataLen) UInt256Set(&data[off], UINT256_ZERO);
     
@@ -236,12 +313,19 @@ static size_t _BRTransactionWitnessData(const BRTransaction *tx, uint8_t *data,
     off += _BRTxInputData(&input, (data ? &data[off] : NULL), (off <= dataLen ? dataLen - off : 0));
     
     if (sigHash != SIGHASH_SINGLE && sigHash != SIGHASH_NONE) {
-        size_t bufLen = _BRTransactionOutputData(tx, NULL, 0, SIZE_MAX);
-        uint8_t _buf[0x1000], *buf = (bufLen <= 0x1000) ? _buf : malloc(bufLen);
-        
-        bufLen = _BRTransactionOutputData(tx, buf, bufLen, SIZE_MAX);
-        if (data && off + sizeof(UInt256) <= dataLen) BRSHA256_2(&data[off], buf, bufLen); // SIGHASH_ALL outputs hash
-        if (buf != _buf) free(buf);
+        if (data && off + sizeof(UInt256) <= dataLen) { // SIGHASH_ALL outputs hash
+            BRSHA256Init(&ctx);
+            
+            for (i = 0; i < tx->outCount; i++) {
+                UInt64SetLE(buf, tx->outputs[i].amount);
+                BRSHA256Update(&ctx, buf, sizeof(uint64_t) + BRVarIntSet(&buf[sizeof(uint64_t)], 9,
+                                                                          tx->outputs[i].scriptLen));
+                BRSHA256Update(&ctx, tx->outputs[i].script, tx->outputs[i].scriptLen);
+            }
+            
+            BRSHA256Final(&data[off], &ctx);
+            BRSHA256(&data[off], &data[off], sizeof(UInt256));
+        }
     }
     else if (sigHash == SIGHASH_SINGLE && index < tx->outCount) {
         uint8_t buf[_BRTransactionOutputData(tx, NULL, 0, index)];
@@ -368,44 +452,57 @@ BRTransaction *BRTransactionNew(void)
 // returns a deep copy of tx and that must be freed by calling BRTransactionFree()
 BRTransaction *BRTransactionCopy(const BRTransaction *tx)
 {
-    BRTransaction *cpy = BRTransactionNew();
-    BRTxInput *inputs = cpy->inputs;
-    BRTxOutput *outputs = cpy->outputs;
+    BRTransaction *cpy;
+    uint8_t *pool = NULL;
+    size_t i, poolLen = 0;
     
     assert(tx != NULL);
-    *cpy = *tx;
-    cpy->inputs = inputs;
-    cpy->outputs = outputs;
-    cpy->inCount = cpy->outCount = 0;
 
-    for (size_t i = 0; i < tx->inCount; i++) {
-        BRTransactionAddInput(cpy, tx->inputs[i].txHash, tx->inputs[i].index, tx->inputs[i].amount,
-                              tx->inputs[i].script, tx->inputs[i].scriptLen,
-                              tx->inputs[i].signature, tx->inputs[i].sigLen,
-                              tx->inputs[i].witness, tx->inputs[i].witLen, tx->inputs[i].sequence);
+    for (i = 0; i < tx->inCount; i++) { // size the copy's allocation
+        if (tx->inputs[i].script) _BRTxPoolData(&pool, &poolLen, NULL, tx->inputs[i].scriptLen);
+        if (tx->inputs[i].signature) _BRTxPoolData(&pool, &poolLen, NULL, tx->inputs[i].sigLen);
+        if (tx->inputs[i].witness) _BRTxPoolData(&pool, &poolLen, NULL, tx->inputs[i].witLen);
+    }
+
+    for (i = 0; i < tx->outCount; i++) {
+        if (tx->outputs[i].script) _BRTxPoolData(&pool, &poolLen, NULL, tx->outputs[i].scriptLen);
+    }
+
+    cpy = _BRTransactionCompactNew(tx->inCount, tx->outCount, poolLen, &pool);
+    *cpy = (BRTransaction) { tx->txHash, tx->wtxHash, tx->version, cpy->inputs, cpy->inCount, cpy->outputs,
+                             cpy->outCount, tx->lockTime, tx->blockHeight, tx->timestamp };
+
+    for (i = 0; i < tx->inCount; i++) {
+        BRTxInput *input = &cpy->inputs[i];
+
+        *input = tx->inputs[i];
+        if (input->script) input->script = _BRTxPoolData(&pool, &poolLen, input->script, input->scriptLen);
+        if (input->signature) input->signature = _BRTxPoolData(&pool, &poolLen, input->signature, input->sigLen);
+        if (input->witness) input->witness = _BRTxPoolData(&pool, &poolLen, input->witness, input->witLen);
     }
     
-    for (size_t i = 0; i < tx->outCount; i++) {
-        BRTransactionAddOutput(cpy, tx->outputs[i].amount, tx->outputs[i].script, tx->outputs[i].scriptLen);
+    for (i = 0; i < tx->outCount; i++) {
+        BRTxOutput *output = &cpy->outputs[i];
+
+        *output = tx->outputs[i];
+        if (output->script) output->script = _BRTxPoolData(&pool, &poolLen, output->script, output->scriptLen);
     }
 
     return cpy;
 }
 
-// buf must contain a serialized tx
-// retruns a transaction that must be freed by calling BRTransactionFree()
-BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
+// parses buf into tx, returning the number of bytes read, which is greater than bufLen if buf is truncated or malformed
+// if pool is NULL, only the input and output counts and the pooled data length are determined, so the compact
+// transaction can be allocated before being filled in by a second pass
+static size_t _BRTransactionParseR(BRTransaction *tx, const uint8_t *buf, size_t bufLen, uint8_t *pool,
+                                   size_t *poolLen, size_t *witnessOff, int *isSigned)
 {
-    assert(buf != NULL || bufLen == 0);
-    if (! buf) return NULL;
-    
-    int isSigned = 1, witnessFlag = 0;
-    uint8_t *sBuf;
-    size_t i, j, off = 0, witnessOff = 0, sLen = 0, len = 0, count;
-    BRTransaction *tx = BRTransactionNew();
-    BRTxInput *input;
-    BRTxOutput *output;
-    
+    int witnessFlag = 0;
+    size_t i, j, off = 0, sLen = 0, len = 0, count;
+    BRTxInput *input, scratchInput;
+    BRTxOutput *output, scratchOutput;
+
+    *isSigned = 1;
     tx->version = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
     off += sizeof(uint32_t);
     tx->inCount = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
@@ -417,10 +514,8 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
         off += len;
     }
 
-    array_set_count(tx->inputs, tx->inCount);
-    
     for (i = 0; off <= bufLen && i < tx->inCount; i++) {
-        input = &tx->inputs[i];
+        input = (pool) ? &tx->inputs[i] : &scratchInput;
         input->txHash = (off + sizeof(UInt256) <= bufLen) ? UInt256Get(&buf[off]) : UINT256_ZERO;
         off += sizeof(UInt256);
         input->index = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
@@ -429,35 +524,43 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
         off += len;
         
         if (off + sLen <= bufLen && BRScriptPubKeyIsValid(&buf[off], sLen)) {
-            BRTxInputSetScript(input, &buf[off], sLen);
+            input->script = _BRTxPoolData(&pool, poolLen, &buf[off], sLen);
+            input->scriptLen = sLen;
             input->amount = (off + sLen + sizeof(uint64_t) <= bufLen) ? UInt64GetLE(&buf[off + sLen]) : 0;
             off += sizeof(uint64_t);
-            isSigned = 0;
+            *isSigned = 0;
+        }
+        else if (off + sLen <= bufLen) {
+            input->signature = _BRTxPoolData(&pool, poolLen, &buf[off], sLen);
+            input->sigLen = sLen;
         }
-        else if (off + sLen <= bufLen) BRTxInputSetSignature(input, &buf[off], sLen);
         
         off += sLen;
-        if (! witnessFlag) BRTxInputSetWitness(input, &buf[off], 0); // set witness to empty byte array
+        if (! witnessFlag) input->witness = _BRTxPoolData(&pool, poolLen, NULL, 0); // set witness to empty byte array
         input->sequence = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
         off += sizeof(uint32_t);
     }
     
     tx->outCount = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
     off += len;
-    array_set_count(tx->outputs, tx->outCount);
     
     for (i = 0; off <= bufLen && i < tx->outCount; i++) {
-        output = &tx->outputs[i];
+        output = (pool) ? &tx->outputs[i] : &scratchOutput;
         output->amount = (off + sizeof(uint64_t) <= bufLen) ? UInt64GetLE(&buf[off]) : 0;
         off += sizeof(uint64_t);
         sLen = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
         off += len;
-        if (off + sLen <= bufLen) BRTxOutputSetScript(output, &buf[off], sLen);
+
+        if (off + sLen <= bufLen) {
+            output->script = _BRTxPoolData(&pool, poolLen, &buf[off], sLen);
+            output->scriptLen = sLen;
+        }
+
         off += sLen;
     }
     
-    for (i = 0, witnessOff = off; witnessFlag && off <= bufLen && i < tx->inCount; i++) {
-        input = &tx->inputs[i];
+    for (i = 0, *witnessOff = off; witnessFlag && off <= bufLen && i < tx->inCount; i++) {
+        input = (pool) ? &tx->inputs[i] : &scratchInput;
         count = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
         off += len;
         
@@ -466,25 +569,55 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
             sLen += len;
         }
         
-        if (off + sLen <= bufLen) BRTxInputSetWitness(input, &buf[off], sLen);
+        if (off + sLen <= bufLen) {
+            input->witness = _BRTxPoolData(&pool, poolLen, &buf[off], sLen);
+            input->witLen = sLen;
+        }
+
         off += sLen;
     }
     
     tx->lockTime = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
     off += sizeof(uint32_t);
+    if (! witnessFlag) *witnessOff = 0;
+    return off;
+}
+
+// buf must contain a serialized tx
+// retruns a transaction that must be freed by calling BRTransactionFree()
+BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
+{
+    assert(buf != NULL || bufLen == 0);
+    if (! buf) return NULL;
     
-    if (tx->inCount == 0 || off > bufLen) {
-        BRTransactionFree(tx);
-        tx = NULL;
-    }
-    else if (isSigned && witnessFlag) {
+    int isSigned = 1;
+    uint8_t *pool = NULL;
+    size_t off, witnessOff = 0, poolLen = 0;
+    BRTransaction layout, *tx = NULL;
+
+    // the first pass only sizes the compact transaction, the second fills it in
+    off = _BRTransactionParseR(&layout, buf, bufLen, NULL, &poolLen, &witnessOff, &isSigned);
+    if (layout.inCount == 0 || off > bufLen || layout.inCount > bufLen || layout.outCount > bufLen) return NULL;
+
+    tx = _BRTransactionCompactNew(layout.inCount, layout.outCount, poolLen, &pool);
+    poolLen = 0;
+    off = _BRTransactionParseR(tx, buf, bufLen, pool, &poolLen, &witnessOff, &isSigned);
+    tx->blockHeight = TX_UNCONFIRMED;
+
+    if (isSigned && witnessOff > 0) {
+        BRSHA256Context ctx;
+        uint8_t u32[sizeof(uint32_t)];
+
+        // txHash excludes the marker, flag and witnesses: version || inputs and outputs || lockTime
         BRSHA256_2(&tx->wtxHash, buf, off);
-        sBuf = malloc((witnessOff - 2) + sizeof(uint32_t));
-        UInt32SetLE(sBuf, tx->version);
-        memcpy(&sBuf[sizeof(uint32_t)], &buf[sizeof(uint32_t) + 2], witnessOff - (sizeof(uint32_t) + 2));
-        UInt32SetLE(&sBuf[witnessOff - 2], tx->lockTime);
-        BRSHA256_2(&tx->txHash, sBuf, (witnessOff - 2) + sizeof(uint32_t));
-        free(sBuf);
+        BRSHA256Init(&ctx);
+        UInt32SetLE(u32, tx->version);
+        BRSHA256Update(&ctx, u32, sizeof(u32));
+        BRSHA256Update(&ctx, &buf[sizeof(uint32_t) + 2], witnessOff - (sizeof(uint32_t) + 2));
+        UInt32SetLE(u32, tx->lockTime);
+        BRSHA256Update(&ctx, u32, sizeof(u32));
+        BRSHA256Final(&tx->txHash, &ctx);
+        BRSHA256(&tx->txHash, &tx->txHash, sizeof(UInt256));
     }
     else if (isSigned) {
         BRSHA256_2(&tx->txHash, buf, off);
@@ -518,6 +651,14 @@ void BRTransactionAddInput(BRTransaction *tx, UInt256 txHash, uint32_t index, ui
         if (script) BRTxInputSetScript(&input, script, scriptLen);
         if (signature) BRTxInputSetSignature(&input, signature, sigLen);
         if (witness) BRTxInputSetWitness(&input, witness, witLen);
+        
+        if (_BRTxIsPooled(tx->inputs)) { // a compact tx's inputs can't grow in place
+            BRTxInput *inputs = tx->inputs;
+            
+            array_new(tx->inputs, tx->inCount + 1);
+            array_add_array(tx->inputs, inputs, tx->inCount);
+        }
+        
         array_add(tx->inputs, input);
         tx->inCount = array_count(tx->inputs);
     }
@@ -533,6 +674,14 @@ void BRTransactionAddOutput(BRTransaction *tx, uint64_t amount, const uint8_t *s
     
     if (tx) {
         BRTxOutputSetScript(&output, script, scriptLen);
+        
+        if (_BRTxIsPooled(tx->outputs)) { // a compact tx's outputs can't grow in place
+            BRTxOutput *outputs = tx->outputs;
+            
+            array_new(tx->outputs, tx->outCount + 1);
+            array_add_array(tx->outputs, outputs, tx->outCount);
+        }
+        
         array_add(tx->outputs, output);
         tx->outCount = array_count(tx->outputs);
     }
@@ -742,8 +891,8 @@ void BRTransactionFree(BRTransaction *tx)
             BRTxOutputSetScript(&tx->outputs[i], NULL, 0);
         }
 
-        array_free(tx->outputs);
-        array_free(tx->inputs);
-        free(tx);
+        if (! _BRTxIsPooled(tx->outputs)) array_free(tx->outputs);
+        if (! _BRTxIsPooled(tx->inputs)) array_free(tx->inputs);
+        free(tx); // for a compact tx, this also frees its inputs, outputs and pooled data
     }
 }
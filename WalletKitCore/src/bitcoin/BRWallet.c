@@ -33,6 +33,8 @@
 #include <pthread.h>
 #include <assert.h>
 
+#define UNUSED_ADDRS_BATCH 64 // public keys derived at a time by BRWalletUnusedAddrs()
+
 inline static size_t _pkhHash(const void *pkh)
 {
     return (size_t)UInt32GetLE(pkh);
@@ -66,6 +68,14 @@ inline static size_t _txChainIndex(const BRTransaction *tx, const UInt160 *chain
     return (size_t) -1;
 }
 
+// amounts a registered transaction sends to and receives from the wallet, cached until the wallet's address or
+// transaction sets change, so repeated balance and history queries don't rescan its inputs and outputs
+typedef struct {
+    UInt256 txHash; // must be first, entries are hashed and compared with BRTransactionHash() and BRTransactionEq()
+    uint64_t received, sent, fee;
+    size_t epoch;
+} BRWalletTxAmounts;
+
 struct BRWalletStruct {
     uint64_t balance, totalSent, totalReceived, feePerKb, *balanceHist;
     uint32_t blockHeight;
@@ -74,7 +84,8 @@ struct BRWalletStruct {
     BRMasterPubKey masterPubKey;
     BRAddressParams addrParams;
     UInt160 *internalChain, *externalChain;
-    BRSet *allTx, *invalidTx, *pendingTx, *spentOutputs, *usedPKH, *allPKH;
+    BRSet *allTx, *invalidTx, *pendingTx, *spentOutputs, *usedPKH, *allPKH, *txAmounts;
+    size_t epoch; // incremented whenever allTx or allPKH changes, invalidating txAmounts
     void *callbackInfo;
     void (*balanceChanged)(void *info, uint64_t balance);
     void (*txAdded)(void *info, BRTransaction *tx);
@@ -161,6 +172,79 @@ static int _BRWalletContainsTx(BRWallet *wallet, const BRTransaction *tx)
     return r;
 }
 
+static void _BRWalletComputeTxAmounts(BRWallet *wallet, const BRTransaction *tx, BRWalletTxAmounts *amounts)
+{
+    const uint8_t *pkh;
+
+    amounts->received = amounts->sent = amounts->fee = 0;
+
+    // TODO: don't include outputs below TX_MIN_OUTPUT_AMOUNT
+    for (size_t i = 0; i < tx->outCount; i++) {
+        pkh = BRScriptPKH(tx->outputs[i].script, tx->outputs[i].scriptLen);
+        if (pkh && BRSetContains(wallet->allPKH, pkh)) amounts->received += tx->outputs[i].amount;
+    }
+
+    for (size_t i = 0; i < tx->inCount; i++) {
+        BRTransaction *t = BRSetGet(wallet->allTx, &tx->inputs[i].txHash);
+        uint32_t n = tx->inputs[i].index;
+
+        if (t && n < t->outCount) {
+            pkh = BRScriptPKH(t->outputs[n].script, t->outputs[n].scriptLen);
+            if (pkh && BRSetContains(wallet->allPKH, pkh)) amounts->sent += t->outputs[n].amount;
+            if (amounts->fee != UINT64_MAX) amounts->fee += t->outputs[n].amount;
+        }
+        else amounts->fee = UINT64_MAX;
+    }
+
+    for (size_t i = 0; i < tx->outCount && amounts->fee != UINT64_MAX; i++) {
+        amounts->fee -= tx->outputs[i].amount;
+    }
+}
+
+// returns the cached amounts for tx if it's registered in the wallet, otherwise computes them into buf
+static const BRWalletTxAmounts *_BRWalletTxAmounts(BRWallet *wallet, const BRTransaction *tx, BRWalletTxAmounts *buf)
+{
+    BRWalletTxAmounts *amounts = NULL;
+
+    if (BRSetGet(wallet->allTx, tx) == tx) { // unsigned transactions all share a zero txHash, so match the pointer
+        amounts = BRSetGet(wallet->txAmounts, tx);
+
+        if (! amounts) {
+            amounts = calloc(1, sizeof(*amounts));
+            assert(amounts != NULL);
+            amounts->txHash = tx->txHash;
+            amounts->epoch = wallet->epoch - 1;
+            BRSetAdd(wallet->txAmounts, amounts);
+        }
+
+        if (amounts->epoch != wallet->epoch) {
+            _BRWalletComputeTxAmounts(wallet, tx, amounts);
+            amounts->epoch = wallet->epoch;
+        }
+    }
+    else _BRWalletComputeTxAmounts(wallet, tx, (amounts = buf));
+
+    return amounts;
+}
+
+// returns the chain and index of the wallet address with the given pubkey hash, or NULL if it's not in the wallet
+static const UInt160 *_BRWalletPKHPath(BRWallet *wallet, const uint8_t *pkh, uint32_t *chain, uint32_t *index)
+{
+    const UInt160 *walletPKH = (pkh) ? BRSetGet(wallet->allPKH, pkh) : NULL;
+
+    // allPKH entries point into internalChain and externalChain, so the index is the entry's offset
+    if (walletPKH >= wallet->internalChain && walletPKH < wallet->internalChain + array_count(wallet->internalChain)) {
+        *chain = SEQUENCE_INTERNAL_CHAIN, *index = (uint32_t)(walletPKH - wallet->internalChain);
+    }
+    else if (walletPKH >= wallet->externalChain &&
+             walletPKH < wallet->externalChain + array_count(wallet->externalChain)) {
+        *chain = SEQUENCE_EXTERNAL_CHAIN, *index = (uint32_t)(walletPKH - wallet->externalChain);
+    }
+    else walletPKH = NULL;
+
+    return walletPKH;
+}
+
 static void _BRWalletUpdateBalance(BRWallet *wallet)
 {
     int isInvalid, isPending;
@@ -281,6 +365,7 @@ BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[],
     wallet->spentOutputs = BRSetNew(BRUTXOHash, BRUTXOEq, txCount + 100);
     wallet->usedPKH = BRSetNew(_pkhHash, _pkhEq, txCount + 100);
     wallet->allPKH = BRSetNew(_pkhHash, _pkhEq, txCount + 100);
+    wallet->txAmounts = BRSetNew(BRTransactionHash, BRTransactionEq, txCount + 100);
     pthread_mutex_init(&wallet->lock, NULL);
 
     for (size_t i = 0; transactions && i < txCount; i++) {
@@ -355,22 +440,26 @@ size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimi
     while (i > 0 && ! BRSetContains(wallet->usedPKH, &chain[i - 1])) i--;
     
     while (i + gapLimit > count) { // generate new addresses up to gapLimit
-        BRKey key;
-        uint8_t pubKey[BRBIP32PubKey(NULL, 0, wallet->masterPubKey, internal, count)];
-        size_t len = BRBIP32PubKey(pubKey, sizeof(pubKey), wallet->masterPubKey, internal, (uint32_t)count);
-        
-        if (! BRKeySetPubKey(&key, pubKey, len)) break;
-        array_add(chain, BRKeyHash160(&key));
-        count++;
-        if (BRSetContains(wallet->usedPKH, &chain[array_count(chain) - 1])) i = count;
-    }
-
-    if (addrs && i + gapLimit <= count) {
-        for (j = 0; j < gapLimit; j++) {
-            BRAddressFromHash160(addrs[j].s, sizeof(*addrs), wallet->addrParams, &chain[i + j]);
+        size_t k, n = i + gapLimit - count;
+        BRECPoint pubKeys[UNUSED_ADDRS_BATCH];
+        UInt160 hash;
+
+        // derive the shortfall in fixed size chunks, no more than gapLimit past the last used address found so far
+        if (n > UNUSED_ADDRS_BATCH) n = UNUSED_ADDRS_BATCH;
+        if (BRBIP32PubKeyList(pubKeys, n, wallet->masterPubKey, internal, (uint32_t)count) < n) break;
+
+        for (k = 0; k < n; k++) {
+            BRHash160(&hash, &pubKeys[k], sizeof(pubKeys[k]));
+            array_add(chain, hash);
+            count++;
+            if (BRSetContains(wallet->usedPKH, &chain[array_count(chain) - 1])) i = count;
         }
     }
+
+    if (addrs && i + gapLimit <= count) j = BRAddressFromHash160Batch(addrs, wallet->addrParams, &chain[i], gapLimit);
     
+    if (count > startCount) wallet->epoch++;
+
     // was chain moved to a new memory location?
     if (chain == origChain) {
         for (i = startCount; i < count; i++) {
@@ -548,23 +637,19 @@ BRAddress BRWalletAddressToLegacy (BRWallet *wallet, BRAddress *addrPtr) {
 // returns the number addresses written, or total number available if addrs is NULL
 size_t BRWalletAllAddrs(BRWallet *wallet, BRAddress addrs[], size_t addrsCount)
 {
-    size_t i, internalCount = 0, externalCount = 0;
+    size_t internalCount = 0, externalCount = 0;
     
     assert(wallet != NULL);
     pthread_mutex_lock(&wallet->lock);
     internalCount = (! addrs || array_count(wallet->internalChain) < addrsCount) ?
                     array_count(wallet->internalChain) : addrsCount;
 
-    for (i = 0; addrs && i < internalCount; i++) {
-        BRAddressFromHash160(addrs[i].s, sizeof(*addrs), wallet->addrParams, &wallet->internalChain[i]);
-    }
+    if (addrs) BRAddressFromHash160Batch(addrs, wallet->addrParams, wallet->internalChain, internalCount);
 
     externalCount = (! addrs || array_count(wallet->externalChain) < addrsCount - internalCount) ?
                     array_count(wallet->externalChain) : addrsCount - internalCount;
 
-    for (i = 0; addrs && i < externalCount; i++) {
-        BRAddressFromHash160(addrs[internalCount + i].s, sizeof(*addrs), wallet->addrParams, &wallet->externalChain[i]);
-    }
+    if (addrs) BRAddressFromHash160Batch(&addrs[internalCount], wallet->addrParams, wallet->externalChain, externalCount);
 
     pthread_mutex_unlock(&wallet->lock);
     return internalCount + externalCount;
@@ -731,7 +816,7 @@ BRTransaction *BRWalletCreateTxForOutputsWithFeePerKb(BRWallet *wallet, uint64_t
 // returns true if all inputs were signed, or false if there was an error or not all inputs were able to be signed
 int BRWalletSignTransaction(BRWallet *wallet, BRTransaction *tx, uint8_t forkId, const void *seed, size_t seedLen)
 {
-    uint32_t j, internalIdx[tx->inCount], externalIdx[tx->inCount];
+    uint32_t chain, index, internalIdx[tx->inCount], externalIdx[tx->inCount];
     size_t i, internalCount = 0, externalCount = 0;
     int r = 0;
     
@@ -742,13 +827,9 @@ int BRWalletSignTransaction(BRWallet *wallet, BRTransaction *tx, uint8_t forkId,
     for (i = 0; tx && i < tx->inCount; i++) {
         const uint8_t *pkh = BRScriptPKH(tx->inputs[i].script, tx->inputs[i].scriptLen);
         
-        for (j = (uint32_t)array_count(wallet->internalChain); pkh && j > 0; j--) {
-            if (UInt160Eq(UInt160Get(pkh), wallet->internalChain[j - 1])) internalIdx[internalCount++] = j - 1;
-        }
-
-        for (j = (uint32_t)array_count(wallet->externalChain); pkh && j > 0; j--) {
-            if (UInt160Eq(UInt160Get(pkh), wallet->externalChain[j - 1])) externalIdx[externalCount++] = j - 1;
-        }
+        if (! _BRWalletPKHPath(wallet, pkh, &chain, &index)) continue;
+        if (chain == SEQUENCE_INTERNAL_CHAIN) internalIdx[internalCount++] = index;
+        if (chain == SEQUENCE_EXTERNAL_CHAIN) externalIdx[externalCount++] = index;
     }
 
     pthread_mutex_unlock(&wallet->lock);
@@ -798,13 +879,14 @@ int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx)
                 // TODO: handle tx replacement with input sequence numbers
                 //       (for now, replacements appear invalid until confirmation)
                 BRSetAdd(wallet->allTx, tx);
+                wallet->epoch++;
                 _BRWalletInsertTx(wallet, tx);
                 _BRWalletUpdateBalance(wallet);
                 wasAdded = 1;
             }
             else { // keep track of unconfirmed non-wallet tx for invalid tx checks and child-pays-for-parent fees
                    // BUG: limit total non-wallet unconfirmed tx to avoid memory exhaustion attack
-                if (tx->blockHeight == TX_UNCONFIRMED) BRSetAdd(wallet->allTx, tx);
+                if (tx->blockHeight == TX_UNCONFIRMED) BRSetAdd(wallet->allTx, tx), wallet->epoch++;
                 r = 0;
                 // BUG: XXX memory leak if tx is not added to wallet->allTx, and we can't just free it
             }
@@ -1089,6 +1171,8 @@ void BRWalletUpdateTransactions(BRWallet *wallet, const UInt256 txHashes[], size
         }
         else if (blockHeight != TX_UNCONFIRMED) { // remove and free confirmed non-wallet tx
             BRSetRemove(wallet->allTx, tx);
+            free(BRSetRemove(wallet->txAmounts, tx));
+            wallet->epoch++;
             BRTransactionFree(tx);
         }
     }
@@ -1128,19 +1212,13 @@ void BRWalletSetTxUnconfirmedAfter(BRWallet *wallet, uint32_t blockHeight)
 // returns the amount received by the wallet from the transaction (total outputs to change and/or receive addresses)
 uint64_t BRWalletAmountReceivedFromTx(BRWallet *wallet, const BRTransaction *tx)
 {
+    BRWalletTxAmounts buf;
     uint64_t amount = 0;
-    const uint8_t *pkh;
     
     assert(wallet != NULL);
     assert(tx != NULL);
     pthread_mutex_lock(&wallet->lock);
-    
-    // TODO: don't include outputs below TX_MIN_OUTPUT_AMOUNT
-    for (size_t i = 0; tx && i < tx->outCount; i++) {
-        pkh = BRScriptPKH(tx->outputs[i].script, tx->outputs[i].scriptLen);
-        if (pkh && BRSetContains(wallet->allPKH, pkh)) amount += tx->outputs[i].amount;
-    }
-    
+    if (tx) amount = _BRWalletTxAmounts(wallet, tx, &buf)->received;
     pthread_mutex_unlock(&wallet->lock);
     return amount;
 }
@@ -1148,23 +1226,13 @@ uint64_t BRWalletAmountReceivedFromTx(BRWallet *wallet, const BRTransaction *tx)
 // returns the amount sent from the wallet by the trasaction (total wallet outputs consumed, change and fee included)
 uint64_t BRWalletAmountSentByTx(BRWallet *wallet, const BRTransaction *tx)
 {
+    BRWalletTxAmounts buf;
     uint64_t amount = 0;
     
     assert(wallet != NULL);
     assert(tx != NULL);
     pthread_mutex_lock(&wallet->lock);
-    
-    for (size_t i = 0; tx && i < tx->inCount; i++) {
-        BRTransaction *t = BRSetGet(wallet->allTx, &tx->inputs[i].txHash);
-        uint32_t n = tx->inputs[i].index;
-        const uint8_t *pkh;
-
-        if (t && n < t->outCount) {
-            pkh = BRScriptPKH(t->outputs[n].script, t->outputs[n].scriptLen);
-            if (pkh && BRSetContains(wallet->allPKH, pkh)) amount += t->outputs[n].amount;
-        }
-    }
-    
+    if (tx) amount = _BRWalletTxAmounts(wallet, tx, &buf)->sent;
     pthread_mutex_unlock(&wallet->lock);
     return amount;
 }
@@ -1172,28 +1240,14 @@ uint64_t BRWalletAmountSentByTx(BRWallet *wallet, const BRTransaction *tx)
 // returns the fee for the given transaction if all its inputs are from wallet transactions, UINT64_MAX otherwise
 uint64_t BRWalletFeeForTx(BRWallet *wallet, const BRTransaction *tx)
 {
+    BRWalletTxAmounts buf;
     uint64_t amount = 0;
     
     assert(wallet != NULL);
     assert(tx != NULL);
     pthread_mutex_lock(&wallet->lock);
-    
-    for (size_t i = 0; tx && i < tx->inCount && amount != UINT64_MAX; i++) {
-        BRTransaction *t = BRSetGet(wallet->allTx, &tx->inputs[i].txHash);
-        uint32_t n = tx->inputs[i].index;
-        
-        if (t && n < t->outCount) {
-            amount += t->outputs[n].amount;
-        }
-        else amount = UINT64_MAX;
-    }
-    
+    if (tx) amount = _BRWalletTxAmounts(wallet, tx, &buf)->fee;
     pthread_mutex_unlock(&wallet->lock);
-    
-    for (size_t i = 0; tx && i < tx->outCount && amount != UINT64_MAX; i++) {
-        amount -= tx->outputs[i].amount;
-    }
-    
     return amount;
 }
 
@@ -1326,6 +1380,11 @@ static void _setApplyFreeTx(void *info, void *tx)
     BRTransactionFree(tx);
 }
 
+static void _setApplyFreeTxAmounts(void *info, void *amounts)
+{
+    free(amounts);
+}
+
 // frees memory allocated for wallet, and calls BRTransactionFree() for all registered transactions
 void BRWalletFree(BRWallet *wallet)
 {
@@ -1337,6 +1396,8 @@ void BRWalletFree(BRWallet *wallet)
     BRSetFree(wallet->pendingTx);
     BRSetApply(wallet->allTx, NULL, _setApplyFreeTx);
     BRSetFree(wallet->allTx);
+    BRSetApply(wallet->txAmounts, NULL, _setApplyFreeTxAmounts);
+    BRSetFree(wallet->txAmounts);
     BRSetFree(wallet->spentOutputs);
     array_free(wallet->internalChain);
     array_free(wallet->externalChain);
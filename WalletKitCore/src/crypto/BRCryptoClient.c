@@ -149,16 +149,55 @@ cryptoClientP2PManagerSetNetworkReachable (BRCryptoClientP2PManager p2p,
 
 // MARK: Client QRY (QueRY)
 
+//
+// A request for transactions or transfers, prepared with `qry->lock` held and made without it; a
+// client may announce synchronously, re-entering the QRY manager and taking `qry->lock`.
+//
+typedef struct {
+    BRCryptoClientCallbackState callbackState;
+    BRArrayOf(char *) addresses;
+    BRCryptoBlockNumber begBlockNumber;
+    BRCryptoBlockNumber endBlockNumber;
+} BRCryptoClientQRYTransRequest;
+
 static void cryptoClientQRYRequestBlockNumber  (BRCryptoClientQRYManager qry);
-static bool cryptoClientQRYRequestTransactionsOrTransfers (BRCryptoClientQRYManager qry,
-                                                           BRCryptoClientCallbackType type,
-                                                           OwnershipKept  BRSetOf(BRCryptoAddress) oldAddresses,
-                                                           OwnershipGiven BRSetOf(BRCryptoAddress) newAddresses,
-                                                           size_t requestId);
+static void cryptoClientQRYAddSyncAddresses    (BRCryptoClientQRYManager qry,
+                                                OwnershipGiven BRSetOf(BRCryptoAddress) addresses);
+static BRArrayOf(BRCryptoClientQRYTransRequest)
+cryptoClientQRYPrepareTransactionsOrTransfers  (BRCryptoClientQRYManager qry,
+                                                size_t requestId);
+static void cryptoClientQRYRequestTransactionsOrTransfers (BRCryptoClientQRYManager qry,
+                                                           OwnershipGiven BRArrayOf(BRCryptoClientQRYTransRequest) requests);
+static bool cryptoClientQRYCompleteRequest     (BRCryptoClientQRYManager qry,
+                                                OwnershipGiven BRSetOf(BRCryptoAddress) addresses,
+                                                size_t requestId,
+                                                bool *syncCompleted,
+                                                bool *syncSuccess);
+static void cryptoClientQRYManagerForgetBundles (BRCryptoClientQRYManager qry,
+                                                BRCryptoBlockNumber blockNumber);
 static void cryptoClientQRYSubmitTransfer      (BRCryptoClientQRYManager qry,
                                                 BRCryptoWallet   wallet,
                                                 BRCryptoTransfer transfer);
 
+// MARK: Client QRY Processed Bundles
+
+typedef struct {
+    UInt256 identifier;
+    BRCryptoBlockNumber blockNumber;
+    bool isFinal;           // processed with at least `finalityDepth` confirmations
+} BRCryptoClientQRYProcessedBundle;
+
+static size_t
+cryptoClientQRYProcessedBundleHash (const void *bundle) {
+    return (size_t) ((const BRCryptoClientQRYProcessedBundle *) bundle)->identifier.u64[0];
+}
+
+static int
+cryptoClientQRYProcessedBundleEq (const void *bundle1, const void *bundle2) {
+    return UInt256Eq (((const BRCryptoClientQRYProcessedBundle *) bundle1)->identifier,
+                      ((const BRCryptoClientQRYProcessedBundle *) bundle2)->identifier);
+}
+
 extern BRCryptoClientQRYManager
 cryptoClientQRYManagerCreate (BRCryptoClient client,
                               BRCryptoWalletManager manager,
@@ -186,9 +225,21 @@ cryptoClientQRYManagerCreate (BRCryptoClient client,
     qry->sync.completed = true;
     qry->sync.success   = false;
     qry->sync.unbounded = CRYPTO_CLIENT_QRY_IS_UNBOUNDED;
+    qry->sync.addresses = cryptoAddressSetCreate (100);
+    array_new (qry->sync.addressesPending, 100);
+    qry->sync.requestsInFlight = 0;
+    qry->sync.requestFailed    = false;
+
+    qry->addressesPerRequest   = CRYPTO_CLIENT_QRY_ADDRESSES_PER_REQUEST;
+    qry->requestsInFlightLimit = CRYPTO_CLIENT_QRY_REQUESTS_IN_FLIGHT_LIMIT;
 
     qry->connected = false;
 
+    qry->processedBundles = BRSetNew (cryptoClientQRYProcessedBundleHash, cryptoClientQRYProcessedBundleEq, 100);
+    qry->finalityDepth    = 0;
+    qry->bundlesProcessed = 0;
+    qry->bundlesSkipped   = 0;
+
     pthread_mutex_init_brd (&qry->lock, PTHREAD_MUTEX_NORMAL);
     return qry;
 }
@@ -201,6 +252,12 @@ cryptoClientQRYManagerRelease (BRCryptoClientQRYManager qry) {
     // Tiny race
     pthread_mutex_destroy (&qry->lock);
 
+    BRSetFreeAll (qry->processedBundles, free);
+
+    // The pending addresses are owned by `sync.addresses`
+    array_free (qry->sync.addressesPending);
+    cryptoAddressSetRelease (qry->sync.addresses);
+
     memset (qry, 0, sizeof(*qry));
     free (qry);
 }
@@ -229,7 +286,10 @@ static void
 cryptoClientQRYManagerSync (BRCryptoClientQRYManager qry,
                             BRCryptoSyncDepth depth,
                             BRCryptoBlockNumber height) {
-
+    // A rescan recovers every bundle again
+    pthread_mutex_lock (&qry->lock);
+    cryptoClientQRYManagerForgetBundles (qry, BLOCK_HEIGHT_UNBOUND);
+    pthread_mutex_unlock (&qry->lock);
 }
 
 static BRCryptoBlockNumber
@@ -307,6 +367,153 @@ cryptoClientQRYManagerUpdateSync (BRCryptoClientQRYManager qry,
     if (needLock) pthread_mutex_unlock(&qry->lock);
 }
 
+extern void
+cryptoClientQRYManagerSetRequestLimits (BRCryptoClientQRYManager qry,
+                                        size_t addressesPerRequest,
+                                        size_t requestsInFlightLimit) {
+    pthread_mutex_lock (&qry->lock);
+    qry->addressesPerRequest   = MAX (1, addressesPerRequest);
+    qry->requestsInFlightLimit = MAX (1, requestsInFlightLimit);
+    pthread_mutex_unlock (&qry->lock);
+}
+
+extern void
+cryptoClientQRYManagerSetFinalityDepth (BRCryptoClientQRYManager qry,
+                                        BRCryptoBlockNumber finalityDepth) {
+    pthread_mutex_lock (&qry->lock);
+    qry->finalityDepth = finalityDepth;
+    pthread_mutex_unlock (&qry->lock);
+}
+
+extern void
+cryptoClientQRYManagerGetBundleCounts (BRCryptoClientQRYManager qry,
+                                       size_t *processed,
+                                       size_t *skipped) {
+    pthread_mutex_lock (&qry->lock);
+    *processed = qry->bundlesProcessed;
+    *skipped   = qry->bundlesSkipped;
+    pthread_mutex_unlock (&qry->lock);
+}
+
+static UInt256
+cryptoClientTransferBundleGetIdentifier (BRCryptoClientTransferBundle bundle) {
+    // As for the file service, only `uids` is unique
+    UInt256 identifier;
+    BRSHA256 (identifier.u8, bundle->uids, strlen (bundle->uids));
+    return identifier;
+}
+
+static UInt256
+cryptoClientTransactionBundleGetIdentifier (BRCryptoClientTransactionBundle bundle) {
+    UInt256 identifier;
+    BRSHA256 (identifier.u8, bundle->serialization, bundle->serializationCount);
+    return identifier;
+}
+
+//
+// Returns `true` if the bundle identified by `identifier` was already applied, in the same block,
+// once that block was final.  Such a bundle can't have changed and is skipped.  Called with
+// `qry->lock`.
+//
+static bool
+cryptoClientQRYManagerSkipBundle (BRCryptoClientQRYManager qry,
+                                  UInt256 identifier,
+                                  BRCryptoBlockNumber blockNumber) {
+    BRCryptoClientQRYProcessedBundle *processed = BRSetGet (qry->processedBundles, &identifier);
+
+    if (NULL != processed && processed->isFinal && processed->blockNumber == blockNumber) {
+        qry->bundlesSkipped += 1;
+        return true;
+    }
+
+    qry->bundlesProcessed += 1;
+    return false;
+}
+
+//
+// Record the bundle identified by `identifier` as applied in `blockNumber`.  Called with
+// `qry->lock`.
+//
+static void
+cryptoClientQRYManagerRecordBundle (BRCryptoClientQRYManager qry,
+                                    UInt256 identifier,
+                                    BRCryptoBlockNumber blockNumber) {
+    BRCryptoBlockNumber finalityDepth = (0 != qry->finalityDepth
+                                         ? qry->finalityDepth
+                                         : qry->manager->network->confirmationsUntilFinal);
+    BRCryptoBlockNumber networkHeight = cryptoClientQRYGetNetworkBlockHeight (qry);
+
+    BRCryptoClientQRYProcessedBundle *processed = BRSetGet (qry->processedBundles, &identifier);
+
+    if (NULL == processed) {
+        processed = calloc (1, sizeof (BRCryptoClientQRYProcessedBundle));
+        processed->identifier = identifier;
+        BRSetAdd (qry->processedBundles, processed);
+    }
+
+    processed->blockNumber = blockNumber;
+    processed->isFinal     = (0 != finalityDepth &&
+                              BLOCK_HEIGHT_UNBOUND != blockNumber &&
+                              networkHeight >= blockNumber &&
+                              networkHeight - blockNumber + 1 >= finalityDepth);
+}
+
+//
+// Forget the bundles in blocks before `blockNumber`; a sync from `blockNumber` can't return them.
+// With `blockNumber` of BLOCK_HEIGHT_UNBOUND forget every bundle.  Called with `qry->lock`.
+//
+static void
+cryptoClientQRYManagerForgetBundles (BRCryptoClientQRYManager qry,
+                                     BRCryptoBlockNumber blockNumber) {
+    BRArrayOf(BRCryptoClientQRYProcessedBundle *) forgotten;
+    array_new (forgotten, BRSetCount (qry->processedBundles));
+
+    FOR_SET (BRCryptoClientQRYProcessedBundle *, processed, qry->processedBundles)
+        if (BLOCK_HEIGHT_UNBOUND == blockNumber || processed->blockNumber < blockNumber)
+            array_add (forgotten, processed);
+
+    for (size_t index = 0; index < array_count (forgotten); index++)
+        BRSetRemove (qry->processedBundles, forgotten[index]);
+
+    array_free_all (forgotten, free);
+}
+
+//
+// A transfer bundle is applied once its currency and that currency's wallet exist; until then
+// it may only have produced a fee transfer and must be recovered again when the wallet is added.
+//
+static bool
+cryptoClientTransferBundleIsApplied (BRCryptoWalletManager manager,
+                                     OwnershipKept BRCryptoClientTransferBundle bundle) {
+    BRCryptoCurrency currency = cryptoNetworkGetCurrencyForUids (manager->network, bundle->currency);
+    if (NULL == currency) return false;
+
+    BRCryptoWallet wallet = cryptoWalletManagerGetWalletForCurrency (manager, currency);
+    cryptoCurrencyGive (currency);
+    if (NULL == wallet) return false;
+
+    cryptoWalletGive (wallet);
+    return true;
+}
+
+private_extern void
+cryptoClientQRYManagerRecordTransferBundle (BRCryptoClientQRYManager qry,
+                                            OwnershipKept BRCryptoClientTransferBundle bundle) {
+    if (!cryptoClientTransferBundleIsApplied (qry->manager, bundle)) return;
+
+    pthread_mutex_lock (&qry->lock);
+    cryptoClientQRYManagerRecordBundle (qry, cryptoClientTransferBundleGetIdentifier (bundle), bundle->blockNumber);
+    pthread_mutex_unlock (&qry->lock);
+}
+
+private_extern void
+cryptoClientQRYManagerRecordTransactionBundle (BRCryptoClientQRYManager qry,
+                                               OwnershipKept BRCryptoClientTransactionBundle bundle) {
+    pthread_mutex_lock (&qry->lock);
+    cryptoClientQRYManagerRecordBundle (qry, cryptoClientTransactionBundleGetIdentifier (bundle), bundle->blockHeight);
+    pthread_mutex_unlock (&qry->lock);
+}
+
 extern void
 cryptoClientQRYManagerTickTock (BRCryptoClientQRYManager qry) {
     pthread_mutex_lock (&qry->lock);
@@ -331,6 +538,8 @@ cryptoClientQRYManagerTickTock (BRCryptoClientQRYManager qry) {
 
 static void
 cryptoClientQRYRequestSync (BRCryptoClientQRYManager qry, bool needLock) {
+    BRArrayOf(BRCryptoClientQRYTransRequest) requests = NULL;
+
     if (needLock) pthread_mutex_lock (&qry->lock);
 
     // If we've successfully completed a sync then update `begBlockNumber` which will always be
@@ -350,37 +559,48 @@ cryptoClientQRYRequestSync (BRCryptoClientQRYManager qry, bool needLock) {
                                     qry->sync.begBlockNumber);
 
     // We'll update transactions if there are more blocks to examine and if the prior sync
-    // completed (successfully or not).
-    if (qry->sync.completed && qry->sync.begBlockNumber != qry->sync.endBlockNumber) {
+    // completed (successfully or not), with none of its requests in flight.
+    if (qry->sync.completed && 0 == qry->sync.requestsInFlight &&
+        qry->sync.begBlockNumber != qry->sync.endBlockNumber) {
 
-        // Save the current requestId and mark the sync as completed successfully.
+        // Each sync has its own requestId; a late response to a prior sync's request, which has
+        // a stale `rid`, is dropped.  See cryptoClientQRYCompleteRequest()
         qry->sync.rid = qry->requestId++;
 
         // Mark the sync as completed, unsucessfully (the initial state)
         cryptoClientQRYManagerUpdateSync (qry, false, false, false);
 
+        // Bundles before `begBlockNumber` won't be returned again.
+        cryptoClientQRYManagerForgetBundles (qry, qry->sync.begBlockNumber);
+
+        // Reset the addresses requested; any from a prior sync are requested again.
+        array_clear (qry->sync.addressesPending);
+        cryptoAddressSetRelease (qry->sync.addresses);
+        qry->sync.addresses = cryptoAddressSetCreate (100);
+        qry->sync.requestsInFlight = 0;
+        qry->sync.requestFailed    = false;
+
         // Get the addresses for the manager's wallet
         BRCryptoWallet wallet = cryptoWalletManagerGetWallet (qry->manager);
         BRSetOf(BRCryptoAddress) addresses = cryptoWalletGetAddressesForRecovery (wallet);
         assert (0 != BRSetCount(addresses));
 
+        cryptoClientQRYAddSyncAddresses (qry, addresses);
+
         // We'll force the 'client' to return all transactions w/o regard to the `endBlockNumber`
         // Doing this ensures that the initial 'full-sync' returns everything.  Thus there is no
         // need to wait for a future 'tick tock' to get the recent and pending transactions'.  For
         // BTC the future 'tick tock' is minutes away; which is a burden on Users as they wait.
 
-        cryptoClientQRYRequestTransactionsOrTransfers (qry,
-                                                       (CRYPTO_CLIENT_REQUEST_USE_TRANSFERS == qry->byType
-                                                        ? CLIENT_CALLBACK_REQUEST_TRANSFERS
-                                                        : CLIENT_CALLBACK_REQUEST_TRANSACTIONS),
-                                                       NULL,
-                                                       addresses,
-                                                       qry->sync.rid);
+        requests = cryptoClientQRYPrepareTransactionsOrTransfers (qry, qry->sync.rid);
 
         cryptoWalletGive (wallet);
     }
 
     if (needLock) pthread_mutex_unlock (&qry->lock);
+
+    if (NULL != requests)
+        cryptoClientQRYRequestTransactionsOrTransfers (qry, requests);
 }
 
 // MARK: - Client Callback State
@@ -606,6 +826,7 @@ cryptoClientHandleTransactions (OwnershipKept BRCryptoWalletManager manager,
     bool matchedRids = (callbackState->rid == qry->sync.rid);
     pthread_mutex_unlock (&qry->lock);
 
+    bool syncCurrent   = false;
     bool syncCompleted = false;
     bool syncSuccess   = false;
 
@@ -613,6 +834,17 @@ cryptoClientHandleTransactions (OwnershipKept BRCryptoWalletManager manager,
     if (matchedRids) {
         switch (success) {
             case CRYPTO_TRUE: {
+                // Drop the bundles already applied in a final block
+                pthread_mutex_lock (&qry->lock);
+                for (size_t index = array_count(bundles); index > 0; index--)
+                    if (cryptoClientQRYManagerSkipBundle (qry,
+                                                          cryptoClientTransactionBundleGetIdentifier (bundles[index - 1]),
+                                                          bundles[index - 1]->blockHeight)) {
+                        cryptoClientTransactionBundleRelease (bundles[index - 1]);
+                        array_rm (bundles, index - 1);
+                    }
+                pthread_mutex_unlock (&qry->lock);
+
                 size_t bundlesCount = array_count(bundles);
 
                 // Save the transaction bundles immediately
@@ -629,8 +861,10 @@ cryptoClientHandleTransactions (OwnershipKept BRCryptoWalletManager manager,
                                cryptoClientTransactionBundleCompareForSort);
 
                 // Recover transfers from each bundle
-                for (size_t index = 0; index < bundlesCount; index++)
-                   cryptoWalletManagerRecoverTransfersFromTransactionBundle (manager, bundles[index]);
+                for (size_t index = 0; index < bundlesCount; index++) {
+                    cryptoWalletManagerRecoverTransfersFromTransactionBundle (manager, bundles[index]);
+                    cryptoClientQRYManagerRecordTransactionBundle (qry, bundles[index]);
+                }
 
                 // The following assumes `bundles` has produced transfers which may have
                 // impacted the wallet's addresses.  Thus the recovery must be *serial w.r.t. the
@@ -638,34 +872,27 @@ cryptoClientHandleTransactions (OwnershipKept BRCryptoWalletManager manager,
 
                 BRCryptoWallet wallet = cryptoWalletManagerGetWallet(manager);
 
-                // We've completed a query for `oldAddresses`
-                BRSetOf(BRCryptoAddress) oldAddresses = callbackState->u.getTransactions.addresses;
-
-                // We'll need another query if `newAddresses` is now larger then `oldAddresses`
-                BRSetOf(BRCryptoAddress) newAddresses = cryptoWalletGetAddressesForRecovery (wallet);
-
-                // Make the actual request; if none is needed, then we are done
-                if (!cryptoClientQRYRequestTransactionsOrTransfers (qry,
-                                                                    CLIENT_CALLBACK_REQUEST_TRANSACTIONS,
-                                                                    oldAddresses,
-                                                                    newAddresses,
-                                                                    callbackState->rid)) {
-                    syncCompleted = true;
-                    syncSuccess   = true;
-                }
+                // Request any addresses that this chunk's recovery added, without waiting on
+                // the chunks still in flight.
+                syncCurrent = cryptoClientQRYCompleteRequest (qry,
+                                                              cryptoWalletGetAddressesForRecovery (wallet),
+                                                              callbackState->rid,
+                                                              &syncCompleted,
+                                                              &syncSuccess);
 
                 cryptoWalletGive (wallet);
                 break;
 
             case CRYPTO_FALSE:
-                syncCompleted = true;
-                syncSuccess   = false;
+                syncCurrent = cryptoClientQRYCompleteRequest (qry, NULL, callbackState->rid, &syncCompleted, &syncSuccess);
                 break;
             }
         }
     }
 
-    cryptoClientQRYManagerUpdateSync (qry, syncCompleted, syncSuccess, true);
+    // A response to a prior sync's request leaves the current sync as is.
+    if (syncCurrent)
+        cryptoClientQRYManagerUpdateSync (qry, syncCompleted, syncSuccess, true);
 
     array_free_all (bundles, cryptoClientTransactionBundleRelease);
     cryptoClientCallbackStateRelease(callbackState);
@@ -744,13 +971,30 @@ cryptoClientHandleTransfers (OwnershipKept BRCryptoWalletManager manager,
     bool matchedRids = (callbackState->rid == qry->sync.rid);
     pthread_mutex_unlock (&qry->lock);
 
+    bool syncCurrent   = false;
     bool syncCompleted = false;
     bool syncSuccess   = false;
 
+    // Bundles that the manager cannot recover, such as binary bundles on a non-ETH network, fail
+    // the request.
+    if (matchedRids && CRYPTO_TRUE == success)
+        success = cryptoWalletManagerCanRecoverTransferBundles (manager, bundles, array_count (bundles));
+
     // Process the results if the bundles are for our rid; otherwise simply discard;
     if (matchedRids) {
         switch (success) {
             case CRYPTO_TRUE: {
+                // Drop the bundles already applied in a final block
+                pthread_mutex_lock (&qry->lock);
+                for (size_t index = array_count(bundles); index > 0; index--)
+                    if (cryptoClientQRYManagerSkipBundle (qry,
+                                                          cryptoClientTransferBundleGetIdentifier (bundles[index - 1]),
+                                                          bundles[index - 1]->blockNumber)) {
+                        cryptoClientTransferBundleRelease (bundles[index - 1]);
+                        array_rm (bundles, index - 1);
+                    }
+                pthread_mutex_unlock (&qry->lock);
+
                 size_t bundlesCount = array_count(bundles);
 
                 for (size_t index = 0; index < bundlesCount; index++)
@@ -763,41 +1007,36 @@ cryptoClientHandleTransfers (OwnershipKept BRCryptoWalletManager manager,
                 mergesort_brd (bundles, bundlesCount, sizeof (BRCryptoClientTransferBundle),
                                cryptoClientTransferBundleCompareForSort);
 
-                // Recover transfers from each bundle
+                // Recover transfers from each bundle; wallets are recovered concurrently.
+                cryptoWalletManagerRecoverTransfersFromTransferBundles (manager, bundles, bundlesCount);
+
+                // Record the bundles applied; those without a wallet yet are recovered again.
                 for (size_t index = 0; index < bundlesCount; index++)
-                   cryptoWalletManagerRecoverTransferFromTransferBundle (manager, bundles[index]);
+                    cryptoClientQRYManagerRecordTransferBundle (qry, bundles[index]);
 
                 BRCryptoWallet wallet = cryptoWalletManagerGetWallet(manager);
 
-                // We've completed a query for `oldAddresses`
-                BRSetOf(BRCryptoAddress) oldAddresses = callbackState->u.getTransactions.addresses;
-
-                // We'll need another query if `newAddresses` is now larger then `oldAddresses`
-                BRSetOf(BRCryptoAddress) newAddresses = cryptoWalletGetAddressesForRecovery (wallet);
-
-                // Make the actual request; if none is needed, then we are done.  Use the
-                // same `rid` as we are in the same sync.
-                if (!cryptoClientQRYRequestTransactionsOrTransfers (qry,
-                                                                    CLIENT_CALLBACK_REQUEST_TRANSFERS,
-                                                                    oldAddresses,
-                                                                    newAddresses,
-                                                                    callbackState->rid)) {
-                    syncCompleted = true;
-                    syncSuccess   = true;
-                }
+                // Request any addresses that this chunk's recovery added.  Use the same `rid` as
+                // we are in the same sync.
+                syncCurrent = cryptoClientQRYCompleteRequest (qry,
+                                                              cryptoWalletGetAddressesForRecovery (wallet),
+                                                              callbackState->rid,
+                                                              &syncCompleted,
+                                                              &syncSuccess);
 
                 cryptoWalletGive (wallet);
                 break;
 
             case CRYPTO_FALSE:
-                syncCompleted = true;
-                syncSuccess   = false;
+                syncCurrent = cryptoClientQRYCompleteRequest (qry, NULL, callbackState->rid, &syncCompleted, &syncSuccess);
                 break;
             }
         }
     }
 
-    cryptoClientQRYManagerUpdateSync (qry, syncCompleted, syncSuccess, true);
+    // A response to a prior sync's request leaves the current sync as is.
+    if (syncCurrent)
+        cryptoClientQRYManagerUpdateSync (qry, syncCompleted, syncSuccess, true);
 
     array_free_all (bundles, cryptoClientTransferBundleRelease);
     cryptoClientCallbackStateRelease(callbackState);
@@ -869,82 +1108,165 @@ cryptoClientQRYReleaseAddresses (BRArrayOf(char *) addresses) {
     array_free (addresses);
 }
 
-static bool
-cryptoClientQRYRequestTransactionsOrTransfers (BRCryptoClientQRYManager qry,
-                                               BRCryptoClientCallbackType type,
-                                               OwnershipKept  BRSetOf(BRCryptoAddress) oldAddresses,
-                                               OwnershipGiven BRSetOf(BRCryptoAddress) newAddresses,
+//
+// Add `addresses` to the sync; those not already requested, or pending a request, are appended to
+// the pending addresses.  Called with `qry->lock`.
+//
+static void
+cryptoClientQRYAddSyncAddresses (BRCryptoClientQRYManager qry,
+                                 OwnershipGiven BRSetOf(BRCryptoAddress) addresses) {
+    FOR_SET (BRCryptoAddress, address, addresses) {
+        if (NULL == BRSetGet (qry->sync.addresses, address)) {
+            BRSetAdd  (qry->sync.addresses, cryptoAddressTake (address));
+            array_add (qry->sync.addressesPending, address);
+        }
+    }
+    cryptoAddressSetRelease (addresses);
+}
+
+//
+// Prepare requests for the pending addresses, in chunks of `addressesPerRequest`, until either no
+// addresses are pending or `requestsInFlightLimit` requests are outstanding.  Each request uses
+// `requestId` so that its results merge into the one sync.  Called with `qry->lock`; the requests
+// are made by `cryptoClientQRYRequestTransactionsOrTransfers()`.
+//
+static BRArrayOf(BRCryptoClientQRYTransRequest)
+cryptoClientQRYPrepareTransactionsOrTransfers (BRCryptoClientQRYManager qry,
                                                size_t requestId) {
+    BRArrayOf(BRCryptoClientQRYTransRequest) requests;
+    array_new (requests, 1);
 
-    BRCryptoWalletManager manager = cryptoWalletManagerTakeWeak(qry->manager);
-    if (NULL == manager) {
-        cryptoAddressSetRelease(newAddresses);
-        return false;
-    }
+    BRCryptoClientCallbackType type = (CRYPTO_CLIENT_REQUEST_USE_TRANSFERS == qry->byType
+                                       ? CLIENT_CALLBACK_REQUEST_TRANSFERS
+                                       : CLIENT_CALLBACK_REQUEST_TRANSACTIONS);
 
-    // Determine the set of addresses needed as `newAddresses - oldAddresses`.  The elements in
-    // `addresses` ARE NOT owned by `addresses`; they remain owned by `newAddresses`
-    BRSetOf(BRCryptoAddress) addresses = BRSetCopy (newAddresses, NULL);
+    while (array_count (qry->sync.addressesPending) > 0 &&
+           qry->sync.requestsInFlight < qry->requestsInFlightLimit) {
 
-    if (NULL != oldAddresses)
-        BRSetMinus (addresses, oldAddresses);
+        // Take the next chunk of pending addresses
+        size_t addressesCount = MIN (array_count (qry->sync.addressesPending), qry->addressesPerRequest);
 
-    // If there are `addresses` then a reqeust is needed.
-    bool needRequest = BRSetCount (addresses) > 0;
+        BRSetOf(BRCryptoAddress) addresses = cryptoAddressSetCreate (addressesCount);
+        for (size_t index = 0; index < addressesCount; index++)
+            BRSetAdd (addresses, cryptoAddressTake (qry->sync.addressesPending[index]));
+        array_rm_range (qry->sync.addressesPending, 0, addressesCount);
 
-    if (needRequest) {
-        // Get an array of the remaining, needed `addresses`
         BRArrayOf(char *) addressesEncoded = cryptoClientQRYGetAddresses (qry, addresses);
 
-        // Create a `calllbackState`; importantly, report `newAddress` as the accumulated addresses
-        // that have been requested.  Note, this specific request will be for `addresses` only.
-        // The elements in `newAddresses` are now owned by `callbackState`.
+        // The elements in `addresses` are now owned by `callbackState`.
         BRCryptoClientCallbackState callbackState = cryptoClientCallbackStateCreateGetTrans (type,
-                                                                                             newAddresses,
+                                                                                             addresses,
                                                                                              requestId);
 
-        switch (type) {
+        qry->sync.requestsInFlight += 1;
+
+        array_add (requests, ((BRCryptoClientQRYTransRequest) {
+            callbackState,
+            addressesEncoded,
+            qry->sync.begBlockNumber,
+            (qry->sync.unbounded
+             ? BLOCK_HEIGHT_UNBOUND_VALUE
+             : qry->sync.endBlockNumber)
+        }));
+    }
+
+    return requests;
+}
+
+//
+// Make the `requests` prepared by `cryptoClientQRYPrepareTransactionsOrTransfers()`.  Called
+// without `qry->lock`, unless a caller already holds it.
+//
+static void
+cryptoClientQRYRequestTransactionsOrTransfers (BRCryptoClientQRYManager qry,
+                                               OwnershipGiven BRArrayOf(BRCryptoClientQRYTransRequest) requests) {
+    BRCryptoWalletManager manager = cryptoWalletManagerTakeWeak(qry->manager);
+
+    for (size_t index = 0; index < array_count (requests); index++) {
+        BRCryptoClientQRYTransRequest *request = &requests[index];
+
+        if (NULL == manager)
+            cryptoClientCallbackStateRelease (request->callbackState);
+
+        else switch (request->callbackState->type) {
             case CLIENT_CALLBACK_REQUEST_TRANSFERS:
                 qry->client.funcGetTransfers (qry->client.context,
                                               cryptoWalletManagerTake(manager),
-                                              callbackState,
-                                              (const char **) addressesEncoded,
-                                              array_count(addressesEncoded),
-                                              qry->sync.begBlockNumber,
-                                              (qry->sync.unbounded
-                                               ? BLOCK_HEIGHT_UNBOUND_VALUE
-                                               : qry->sync.endBlockNumber));
+                                              request->callbackState,
+                                              (const char **) request->addresses,
+                                              array_count(request->addresses),
+                                              request->begBlockNumber,
+                                              request->endBlockNumber);
                 break;
 
             case CLIENT_CALLBACK_REQUEST_TRANSACTIONS:
                 qry->client.funcGetTransactions (qry->client.context,
                                                  cryptoWalletManagerTake(manager),
-                                                 callbackState,
-                                                 (const char **) addressesEncoded,
-                                                 array_count(addressesEncoded),
-                                                 qry->sync.begBlockNumber,
-                                                 (qry->sync.unbounded
-                                                  ? BLOCK_HEIGHT_UNBOUND_VALUE
-                                                  : qry->sync.endBlockNumber));
+                                                 request->callbackState,
+                                                 (const char **) request->addresses,
+                                                 array_count(request->addresses),
+                                                 request->begBlockNumber,
+                                                 request->endBlockNumber);
                 break;
 
             default:
                 assert (false);
         }
 
-        cryptoClientQRYReleaseAddresses (addressesEncoded);
+        cryptoClientQRYReleaseAddresses (request->addresses);
     }
+
+    array_free (requests);
+    cryptoWalletManagerGive (manager);
+}
+
+//
+// Complete one request of the sync identified by `requestId`.  If `addresses` is NULL the request
+// failed; no further requests are made and the sync fails once every request in flight completes.
+// Otherwise `addresses`, the wallet's recovery addresses after processing the request's results,
+// may hold addresses not yet requested; those are requested now.  The sync completes once no
+// request is in flight and no address is pending.  Returns false, changing nothing, if
+// `requestId` is not the current sync's; the request is from a prior sync.
+//
+static bool
+cryptoClientQRYCompleteRequest (BRCryptoClientQRYManager qry,
+                                OwnershipGiven BRSetOf(BRCryptoAddress) addresses,
+                                size_t requestId,
+                                bool *syncCompleted,
+                                bool *syncSuccess) {
+    BRArrayOf(BRCryptoClientQRYTransRequest) requests = NULL;
+
+    pthread_mutex_lock (&qry->lock);
+
+    if (requestId != qry->sync.rid) {
+        pthread_mutex_unlock (&qry->lock);
+        if (NULL != addresses) cryptoAddressSetRelease (addresses);
+        return false;
+    }
+
+    assert (qry->sync.requestsInFlight > 0);
+    qry->sync.requestsInFlight -= 1;
+
+    if (NULL == addresses)
+        qry->sync.requestFailed = true;
     else {
-        // If `newAddresses` ownership was not transfered to `callbackState`, then release everything.
-        cryptoAddressSetRelease (newAddresses);
+        cryptoClientQRYAddSyncAddresses (qry, addresses);
+
+        if (!qry->sync.requestFailed)
+            requests = cryptoClientQRYPrepareTransactionsOrTransfers (qry, requestId);
     }
 
-    cryptoWalletManagerGive (manager);
-    BRSetFree (addresses);
+    *syncCompleted = (0 == qry->sync.requestsInFlight &&
+                      (qry->sync.requestFailed || 0 == array_count (qry->sync.addressesPending)));
+    *syncSuccess   = !qry->sync.requestFailed;
 
-    return needRequest;
-}
+    pthread_mutex_unlock (&qry->lock);
 
+    if (NULL != requests)
+        cryptoClientQRYRequestTransactionsOrTransfers (qry, requests);
+
+    return true;
+}
 
 // MARK: Announce Submit Transfer
 
@@ -1229,6 +1551,24 @@ cryptoClientQRYEstimateTransferFee (BRCryptoClientQRYManager qry,
 
 // MARK: - Transfer Bundle
 
+static void
+cryptoClientTransferBundleSetAttributes (BRCryptoClientTransferBundle bundle,
+                                         size_t attributesCount,
+                                         OwnershipKept const char **attributeKeys,
+                                         OwnershipKept const char **attributeVals) {
+    bundle->attributesCount = attributesCount;
+    bundle->attributeKeys = bundle->attributeVals = NULL;
+
+    if (bundle->attributesCount > 0) {
+        bundle->attributeKeys = calloc (bundle->attributesCount, sizeof (char*));
+        bundle->attributeVals = calloc (bundle->attributesCount, sizeof (char*));
+        for (size_t index = 0; index < bundle->attributesCount; index++) {
+            bundle->attributeKeys[index] = strdup (attributeKeys[index]);
+            bundle->attributeVals[index] = strdup (attributeVals[index]);
+        }
+    }
+}
+
 extern BRCryptoClientTransferBundle
 cryptoClientTransferBundleCreate (BRCryptoTransferStateType status,
                                   OwnershipKept const char *uids,
@@ -1271,18 +1611,55 @@ cryptoClientTransferBundleCreate (BRCryptoTransferStateType status,
     bundle->blockTransactionIndex = blockTransactionIndex;
     bundle->blockHash = strdup (blockHash);
 
-    // attributes
-    bundle->attributesCount = attributesCount;
-    bundle->attributeKeys = bundle->attributeVals = NULL;
+    cryptoClientTransferBundleSetAttributes (bundle, attributesCount, attributeKeys, attributeVals);
 
-    if (bundle->attributesCount > 0) {
-        bundle->attributeKeys = calloc (bundle->attributesCount, sizeof (char*));
-        bundle->attributeVals = calloc (bundle->attributesCount, sizeof (char*));
-        for (size_t index = 0; index < bundle->attributesCount; index++) {
-            bundle->attributeKeys[index] = strdup (attributeKeys[index]);
-            bundle->attributeVals[index] = strdup (attributeVals[index]);
-        }
-    }
+    return bundle;
+}
+
+static UInt256
+cryptoClientTransferBundleUInt256FromBigEndian (const BRCryptoData32 *data) {
+    UInt256 value;
+    for (size_t index = 0; index < 4; index++)
+        value.u64[3 - index] = UInt64GetBE (&data->data[8 * index]);
+    return value;
+}
+
+extern BRCryptoClientTransferBundle
+cryptoClientTransferBundleCreateBinary (BRCryptoTransferStateType status,
+                                        OwnershipKept const char *uids,
+                                        OwnershipKept const char *identifier,
+                                        OwnershipKept const char *currency,
+                                        OwnershipKept const BRCryptoClientTransferBundleBinary *binary,
+                                        BRCryptoTimestamp blockTimestamp,
+                                        BRCryptoBlockNumber blockNumber,
+                                        BRCryptoBlockNumber blockConfirmations,
+                                        uint64_t blockTransactionIndex,
+                                        size_t attributesCount,
+                                        OwnershipKept const char **attributeKeys,
+                                        OwnershipKept const char **attributeVals) {
+    BRCryptoClientTransferBundle bundle = calloc (1, sizeof (struct BRCryptoClientTransferBundleRecord));
+
+    bundle->status     = status;
+    bundle->uids       = strdup (uids);
+    bundle->identifier = strdup (identifier);
+    bundle->currency   = strdup (currency);
+
+    // The {hash, from, to, amount, fee, blockHash} strings remain NULL
+    bundle->isBinary = true;
+    bundle->binary.hash = binary->hash;
+    memcpy (bundle->binary.from, binary->from, sizeof (bundle->binary.from));
+    memcpy (bundle->binary.to,   binary->to,   sizeof (bundle->binary.to));
+    bundle->binary.amount = cryptoClientTransferBundleUInt256FromBigEndian (&binary->amount);
+    bundle->binary.fee    = cryptoClientTransferBundleUInt256FromBigEndian (&binary->fee);
+    bundle->binary.hasFee = CRYPTO_TRUE == binary->hasFee;
+    bundle->binary.blockHash = binary->blockHash;
+
+    bundle->blockTimestamp = blockTimestamp;
+    bundle->blockNumber    = blockNumber;
+    bundle->blockConfirmations    = blockConfirmations;
+    bundle->blockTransactionIndex = blockTransactionIndex;
+
+    cryptoClientTransferBundleSetAttributes (bundle, attributesCount, attributeKeys, attributeVals);
 
     return bundle;
 }
@@ -1383,7 +1760,7 @@ cryptoClientTransferBundleRlpDecodeAttributes (BRRlpItem item,
     for (size_t index = 0; index < itemsCount; index++) {
         size_t count;
         const BRRlpItem *pair = rlpDecodeList (coder, items[index], &count);
-        assert (2 == count);
+        if (2 != count) continue;
 
         array_add (keys, rlpDecodeString (coder, pair[0]));
         array_add (vals, rlpDecodeString (coder, pair[1]));
@@ -1392,9 +1769,103 @@ cryptoClientTransferBundleRlpDecodeAttributes (BRRlpItem item,
     return (BRCryptoTransferBundleRlpDecodeAttributesResult) { keys, vals };
 }
 
+// A binary bundle encodes as 16 items: the 15 items of a string bundle, with the hashes and
+// addresses as bytes and the amount and fee as UInt256 values, followed by a format marker.
+#define CRYPTO_CLIENT_TRANSFER_BUNDLE_RLP_FORMAT_BINARY     (1)
+
+static BRRlpItem
+cryptoClientTransferBundleRlpEncodeBinary (BRCryptoClientTransferBundle bundle,
+                                           BRRlpCoder coder) {
+    BRRlpItem feeItem = (bundle->binary.hasFee
+                         ? rlpEncodeUInt256 (coder, bundle->binary.fee, 0)
+                         : NULL);
+
+    return rlpEncodeList (coder, 16,
+                          rlpEncodeUInt64 (coder, bundle->status, 0),
+                          rlpEncodeString (coder, bundle->uids),
+                          rlpEncodeBytes  (coder, bundle->binary.hash.data, sizeof (bundle->binary.hash.data)),
+                          rlpEncodeString (coder, bundle->identifier),
+                          rlpEncodeBytes  (coder, bundle->binary.from, sizeof (bundle->binary.from)),
+                          rlpEncodeBytes  (coder, bundle->binary.to,   sizeof (bundle->binary.to)),
+                          rlpEncodeUInt256 (coder, bundle->binary.amount, 0),
+                          rlpEncodeString (coder, bundle->currency),
+                          rlpEncodeListItems (coder, &feeItem, (NULL == feeItem ? 0 : 1)),
+                          rlpEncodeUInt64 (coder, bundle->blockTimestamp,        0),
+                          rlpEncodeUInt64 (coder, bundle->blockNumber,           0),
+                          rlpEncodeUInt64 (coder, bundle->blockConfirmations,    0),
+                          rlpEncodeUInt64 (coder, bundle->blockTransactionIndex, 0),
+                          rlpEncodeBytes  (coder, bundle->binary.blockHash.data, sizeof (bundle->binary.blockHash.data)),
+                          cryptoClientTransferBundleRlpEncodeAttributes (bundle->attributesCount,
+                                                                         (const char **) bundle->attributeKeys,
+                                                                         (const char **) bundle->attributeVals,
+                                                                         coder),
+                          rlpEncodeUInt64 (coder, CRYPTO_CLIENT_TRANSFER_BUNDLE_RLP_FORMAT_BINARY, 0));
+}
+
+static bool
+cryptoClientTransferBundleRlpDecodeBytes (BRRlpItem item,
+                                          BRRlpCoder coder,
+                                          uint8_t *bytes,
+                                          size_t bytesCount) {
+    BRRlpData data = rlpDecodeBytesSharedDontRelease (coder, item);
+    if (bytesCount != data.bytesCount) return false;
+
+    memcpy (bytes, data.bytes, bytesCount);
+    return true;
+}
+
+static BRCryptoClientTransferBundle
+cryptoClientTransferBundleRlpDecodeBinary (const BRRlpItem *items,
+                                           BRRlpCoder coder) {
+    BRCryptoClientTransferBundle bundle = calloc (1, sizeof (struct BRCryptoClientTransferBundleRecord));
+
+    size_t feeItemsCount;
+    const BRRlpItem *feeItems = rlpDecodeList (coder, items[8], &feeItemsCount);
+
+    // Malformed hashes, addresses or fee fail the decode.
+    if (!cryptoClientTransferBundleRlpDecodeBytes (items[ 2], coder, bundle->binary.hash.data, sizeof (bundle->binary.hash.data)) ||
+        !cryptoClientTransferBundleRlpDecodeBytes (items[ 4], coder, bundle->binary.from, sizeof (bundle->binary.from)) ||
+        !cryptoClientTransferBundleRlpDecodeBytes (items[ 5], coder, bundle->binary.to,   sizeof (bundle->binary.to))   ||
+        !cryptoClientTransferBundleRlpDecodeBytes (items[13], coder, bundle->binary.blockHash.data, sizeof (bundle->binary.blockHash.data)) ||
+        feeItemsCount > 1) {
+        free (bundle);
+        return NULL;
+    }
+
+    bundle->status     = (BRCryptoTransferStateType) rlpDecodeUInt64 (coder, items[ 0], 0);
+    bundle->uids       = rlpDecodeString (coder, items[ 1]);
+    bundle->identifier = rlpDecodeString (coder, items[ 3]);
+    bundle->currency   = rlpDecodeString (coder, items[ 7]);
+
+    bundle->isBinary = true;
+    bundle->binary.amount = rlpDecodeUInt256 (coder, items[ 6], 0);
+    bundle->binary.hasFee = (1 == feeItemsCount);
+    bundle->binary.fee    = (bundle->binary.hasFee ? rlpDecodeUInt256 (coder, feeItems[0], 0) : UINT256_ZERO);
+
+    bundle->blockTimestamp        = rlpDecodeUInt64 (coder, items[ 9], 0);
+    bundle->blockNumber           = rlpDecodeUInt64 (coder, items[10], 0);
+    bundle->blockConfirmations    = rlpDecodeUInt64 (coder, items[11], 0);
+    bundle->blockTransactionIndex = rlpDecodeUInt64 (coder, items[12], 0);
+
+    BRCryptoTransferBundleRlpDecodeAttributesResult attributesResult =
+    cryptoClientTransferBundleRlpDecodeAttributes (items[14], coder);
+
+    cryptoClientTransferBundleSetAttributes (bundle,
+                                             array_count(attributesResult.keys),
+                                             (const char **) attributesResult.keys,
+                                             (const char **) attributesResult.vals);
+
+    array_free_all (attributesResult.keys, free);
+    array_free_all (attributesResult.vals, free);
+
+    return bundle;
+}
+
 private_extern BRRlpItem
 cryptoClientTransferBundleRlpEncode (BRCryptoClientTransferBundle bundle,
                                      BRRlpCoder coder) {
+    if (bundle->isBinary)
+        return cryptoClientTransferBundleRlpEncodeBinary (bundle, coder);
 
     return rlpEncodeList (coder, 15,
                           rlpEncodeUInt64 (coder, bundle->status, 0),
@@ -1422,7 +1893,14 @@ cryptoClientTransferBundleRlpDecode (BRRlpItem item,
                                      BRRlpCoder coder) {
     size_t itemsCount;
     const BRRlpItem *items = rlpDecodeList (coder, item, &itemsCount);
-    assert (15 == itemsCount);
+
+    // A bundle of neither format fails the decode; the file service then drops the load.
+    if (15 != itemsCount && 16 != itemsCount) return NULL;
+
+    if (16 == itemsCount)
+        return (CRYPTO_CLIENT_TRANSFER_BUNDLE_RLP_FORMAT_BINARY == rlpDecodeUInt64 (coder, items[15], 0)
+                ? cryptoClientTransferBundleRlpDecodeBinary (items, coder)
+                : NULL);
 
     char *uids     = rlpDecodeString (coder, items[ 1]);
     char *hash     = rlpDecodeString (coder, items[ 2]);
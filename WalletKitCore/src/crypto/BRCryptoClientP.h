@@ -14,6 +14,7 @@
 #include <pthread.h>
 
 #include "support/BRArray.h"
+#include "support/BRInt.h"
 #include "support/BRSet.h"
 #include "support/rlp/BRRlp.h"
 #include "support/event/BREvent.h"
@@ -92,6 +93,19 @@ struct BRCryptoClientTransferBundleRecord {
     size_t attributesCount;
     char **attributeKeys;
     char **attributeVals;
+
+    // Set for a bundle created by cryptoClientTransferBundleCreateBinary(); then {hash, from, to,
+    // amount, fee, blockHash} above are NULL and the values are held here, already parsed.
+    bool isBinary;
+    struct {
+        BRCryptoData32 hash;
+        uint8_t from[20];
+        uint8_t to[20];
+        UInt256 amount;
+        UInt256 fee;
+        bool hasFee;
+        BRCryptoData32 blockHash;
+    } binary;
 };
 
 private_extern BRRlpItem
@@ -347,16 +361,37 @@ struct BRCryptoClientQRYManagerRecord {
         BRCryptoBlockNumber begBlockNumber;
         BRCryptoBlockNumber endBlockNumber;
         size_t rid;
+
+        // Every address requested, or pending a request, in this sync.  The pending addresses
+        // are requested in chunks of `addressesPerRequest`, with at most `requestsInFlightLimit`
+        // requests outstanding.
+        BRSetOf(BRCryptoAddress) addresses;
+        BRArrayOf(BRCryptoAddress) addressesPending;
+        size_t requestsInFlight;
+        bool   requestFailed;
     } sync;
 
+    size_t addressesPerRequest;
+    size_t requestsInFlightLimit;
+
     bool connected;
     size_t requestId;
 
+    // Bundles already saved and recovered, keyed by identifier.  A bundle processed once its
+    // block had `finalityDepth` confirmations is dropped when a later sync returns it again.
+    BRSet *processedBundles;
+    BRCryptoBlockNumber finalityDepth;   // if 0, use the network's `confirmationsUntilFinal`
+    size_t bundlesProcessed;
+    size_t bundlesSkipped;
+
     pthread_mutex_t lock;
 };
 
 #define CRYPTO_CLIENT_QRY_IS_UNBOUNDED            (true)
 
+#define CRYPTO_CLIENT_QRY_ADDRESSES_PER_REQUEST      (25)
+#define CRYPTO_CLIENT_QRY_REQUESTS_IN_FLIGHT_LIMIT   (4)
+
 extern BRCryptoClientQRYManager
 cryptoClientQRYManagerCreate (BRCryptoClient client,
                               BRCryptoWalletManager manager,
@@ -376,6 +411,30 @@ cryptoClientQRYManagerDisconnect (BRCryptoClientQRYManager qry);
 extern void
 cryptoClientQRYManagerTickTock (BRCryptoClientQRYManager qry);
 
+extern void
+cryptoClientQRYManagerSetRequestLimits (BRCryptoClientQRYManager qry,
+                                        size_t addressesPerRequest,
+                                        size_t requestsInFlightLimit);
+
+extern void
+cryptoClientQRYManagerSetFinalityDepth (BRCryptoClientQRYManager qry,
+                                        BRCryptoBlockNumber finalityDepth);
+
+extern void
+cryptoClientQRYManagerGetBundleCounts (BRCryptoClientQRYManager qry,
+                                       size_t *processed,
+                                       size_t *skipped);
+
+// Record a bundle as applied, once recovered; a transfer bundle is recorded only if its currency's
+// wallet exists.  Used for bundles loaded from the file service and for announced bundles.
+private_extern void
+cryptoClientQRYManagerRecordTransferBundle (BRCryptoClientQRYManager qry,
+                                            OwnershipKept BRCryptoClientTransferBundle bundle);
+
+private_extern void
+cryptoClientQRYManagerRecordTransactionBundle (BRCryptoClientQRYManager qry,
+                                               OwnershipKept BRCryptoClientTransactionBundle bundle);
+
 extern void
 cryptoClientQRYEstimateTransferFee (BRCryptoClientQRYManager qry,
                                     BRCryptoCookie   cookie,
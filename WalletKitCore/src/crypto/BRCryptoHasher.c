@@ -17,10 +17,69 @@
 struct BRCryptoHasherRecord {
     BRCryptoHasherType type;
     BRCryptoRef ref;
+
+    // The incremental state used by cryptoHasherUpdate() and cryptoHasherFinalize()
+    union {
+        BRSHA1Context sha1;
+        BRSHA256Context sha256;     // SHA224, SHA256, SHA256_2 and HASH160
+        BRSHA512Context sha512;     // SHA384 and SHA512
+        BRRMD160Context rmd160;
+        BRMD5Context md5;
+        BRKeccakContext keccak;     // SHA3 and KECCAK256
+    } context;
 };
 
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoHasher, cryptoHasher);
 
+static void
+cryptoHasherReset (BRCryptoHasher hasher) {
+    switch (hasher->type) {
+        case CRYPTO_HASHER_SHA1: {
+            BRSHA1Init (&hasher->context.sha1);
+            break;
+        }
+        case CRYPTO_HASHER_SHA224: {
+            BRSHA224Init (&hasher->context.sha256);
+            break;
+        }
+        case CRYPTO_HASHER_SHA256:
+        case CRYPTO_HASHER_SHA256_2:
+        case CRYPTO_HASHER_HASH160: {
+            BRSHA256Init (&hasher->context.sha256);
+            break;
+        }
+        case CRYPTO_HASHER_SHA384: {
+            BRSHA384Init (&hasher->context.sha512);
+            break;
+        }
+        case CRYPTO_HASHER_SHA512: {
+            BRSHA512Init (&hasher->context.sha512);
+            break;
+        }
+        case CRYPTO_HASHER_SHA3: {
+            BRSHA3_256Init (&hasher->context.keccak);
+            break;
+        }
+        case CRYPTO_HASHER_RMD160: {
+            BRRMD160Init (&hasher->context.rmd160);
+            break;
+        }
+        case CRYPTO_HASHER_KECCAK256: {
+            BRKeccak256Init (&hasher->context.keccak);
+            break;
+        }
+        case CRYPTO_HASHER_MD5: {
+            BRMD5Init (&hasher->context.md5);
+            break;
+        }
+        default: {
+            // for an unsupported algorithm, assert
+            assert (0);
+            break;
+        }
+    }
+}
+
 extern BRCryptoHasher
 cryptoHasherCreate(BRCryptoHasherType type) {
     BRCryptoHasher hasher = NULL;
@@ -40,6 +99,7 @@ cryptoHasherCreate(BRCryptoHasherType type) {
             hasher = calloc (1, sizeof(struct BRCryptoHasherRecord));
             hasher->type = type;
             hasher->ref = CRYPTO_REF_ASSIGN(cryptoHasherRelease);
+            cryptoHasherReset (hasher);
             break;
         }
         default: {
@@ -54,7 +114,7 @@ cryptoHasherCreate(BRCryptoHasherType type) {
 
 static void
 cryptoHasherRelease (BRCryptoHasher hasher) {
-    memset (hasher, 0, sizeof(*hasher));
+    mem_clean (hasher, sizeof(*hasher));
     free (hasher);
 }
 
@@ -190,3 +250,134 @@ cryptoHasherHash (BRCryptoHasher hasher,
 
     return result;
 }
+
+extern BRCryptoBoolean
+cryptoHasherUpdate (BRCryptoHasher hasher,
+                    const uint8_t *src,
+                    size_t srcLen) {
+    // - src CAN be NULL, if srcLen is 0
+    if (NULL == src && 0 != srcLen) {
+        assert (0);
+        return CRYPTO_FALSE;
+    }
+
+    switch (hasher->type) {
+        case CRYPTO_HASHER_SHA1: {
+            BRSHA1Update (&hasher->context.sha1, src, srcLen);
+            break;
+        }
+        case CRYPTO_HASHER_SHA224:
+        case CRYPTO_HASHER_SHA256:
+        case CRYPTO_HASHER_SHA256_2:
+        case CRYPTO_HASHER_HASH160: {
+            BRSHA256Update (&hasher->context.sha256, src, srcLen);
+            break;
+        }
+        case CRYPTO_HASHER_SHA384:
+        case CRYPTO_HASHER_SHA512: {
+            BRSHA512Update (&hasher->context.sha512, src, srcLen);
+            break;
+        }
+        case CRYPTO_HASHER_SHA3:
+        case CRYPTO_HASHER_KECCAK256: {
+            BRKeccakUpdate (&hasher->context.keccak, src, srcLen);
+            break;
+        }
+        case CRYPTO_HASHER_RMD160: {
+            BRRMD160Update (&hasher->context.rmd160, src, srcLen);
+            break;
+        }
+        case CRYPTO_HASHER_MD5: {
+            BRMD5Update (&hasher->context.md5, src, srcLen);
+            break;
+        }
+        default: {
+            // for an unsupported algorithm, assert
+            assert (0);
+            return CRYPTO_FALSE;
+        }
+    }
+
+    return CRYPTO_TRUE;
+}
+
+extern BRCryptoBoolean
+cryptoHasherFinalize (BRCryptoHasher hasher,
+                      uint8_t *dst,
+                      size_t dstLen) {
+    // - dst MUST be non-NULL and sufficiently sized
+    if (NULL == dst || dstLen < cryptoHasherLength (hasher)) {
+        assert (0);
+        return CRYPTO_FALSE;
+    }
+
+    uint8_t md[32];
+
+    switch (hasher->type) {
+        case CRYPTO_HASHER_SHA1: {
+            BRSHA1Final (dst, &hasher->context.sha1);
+            break;
+        }
+        case CRYPTO_HASHER_SHA224: {
+            BRSHA224Final (dst, &hasher->context.sha256);
+            break;
+        }
+        case CRYPTO_HASHER_SHA256: {
+            BRSHA256Final (dst, &hasher->context.sha256);
+            break;
+        }
+        case CRYPTO_HASHER_SHA256_2: {
+            BRSHA256Final (md, &hasher->context.sha256);
+            BRSHA256 (dst, md, sizeof(md));
+            break;
+        }
+        case CRYPTO_HASHER_SHA384: {
+            BRSHA384Final (dst, &hasher->context.sha512);
+            break;
+        }
+        case CRYPTO_HASHER_SHA512: {
+            BRSHA512Final (dst, &hasher->context.sha512);
+            break;
+        }
+        case CRYPTO_HASHER_SHA3:
+        case CRYPTO_HASHER_KECCAK256: {
+            BRKeccakFinal (dst, &hasher->context.keccak);
+            break;
+        }
+        case CRYPTO_HASHER_RMD160: {
+            BRRMD160Final (dst, &hasher->context.rmd160);
+            break;
+        }
+        case CRYPTO_HASHER_HASH160: {
+            BRSHA256Final (md, &hasher->context.sha256);
+            BRRMD160 (dst, md, sizeof(md));
+            break;
+        }
+        case CRYPTO_HASHER_MD5: {
+            BRMD5Final (dst, &hasher->context.md5);
+            break;
+        }
+        default: {
+            // for an unsupported algorithm, assert
+            assert (0);
+            return CRYPTO_FALSE;
+        }
+    }
+
+    mem_clean (md, sizeof(md));
+
+    // ready for the next message
+    cryptoHasherReset (hasher);
+    return CRYPTO_TRUE;
+}
+
+extern BRCryptoHasher
+cryptoHasherClone (BRCryptoHasher hasher) {
+    BRCryptoHasher clone = calloc (1, sizeof(struct BRCryptoHasherRecord));
+
+    clone->type    = hasher->type;
+    clone->ref     = CRYPTO_REF_ASSIGN(cryptoHasherRelease);
+    clone->context = hasher->context;
+
+    return clone;
+}
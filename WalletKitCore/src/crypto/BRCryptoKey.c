@@ -10,12 +10,15 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 
 #include "BRCryptoKey.h"
 #include "support/BRKey.h"
 #include "support/BRBIP39Mnemonic.h"
 #include "support/BRBIP32Sequence.h"
 #include "support/BRKeyECIES.h"
+#include "support/BROSCompat.h"
 #include "ethereum/util/BRUtil.h"
 #include "bitcoin/BRBIP38Key.h"
 
@@ -117,24 +120,143 @@ cryptoKeyFindAddressParams (const char *string) {
     return EMPTY_ADDRESS_PARAMS;
 }
 
-extern BRCryptoKey
-cryptoKeyCreateFromStringProtectedPrivate (const char *privateKey, const char * passphrase) {
+static BRCryptoKey
+cryptoKeyCreateFromStringProtectedPrivateWithScratch (const char *privateKey,
+                                                      const char * passphrase,
+                                                      void *scratch,
+                                                      size_t scratchLen) {
     if (!BRBIP38KeyIsValid (privateKey)) return NULL;
 
+    // Decrypt once, with scrypt, then find the first params matching the key's address hash
+    BRAddressParams params[] = {
+        BITCOIN_ADDRESS_PARAMS,
+        BITCOIN_TEST_ADDRESS_PARAMS,
+        CRYPTO_ADDRESS_PARAMS
+    };
+
     BRKey core;
-    BRCryptoKey result = (1 == BRKeySetBIP38Key(&core, privateKey, passphrase, BITCOIN_ADDRESS_PARAMS)
-                          ? cryptoKeyCreateInternal (core, BITCOIN_ADDRESS_PARAMS)
-                          : (1 == BRKeySetBIP38Key(&core, privateKey, passphrase, BITCOIN_TEST_ADDRESS_PARAMS)
-                             ? cryptoKeyCreateInternal (core, BITCOIN_TEST_ADDRESS_PARAMS)
-                             : (1 == BRKeySetBIP38Key(&core, privateKey, passphrase, CRYPTO_ADDRESS_PARAMS)
-                                ? cryptoKeyCreateInternal (core, CRYPTO_ADDRESS_PARAMS)
-                                : NULL)));
+    size_t index = BRKeySetBIP38KeyWithParams (&core, privateKey, passphrase,
+                                               params, sizeof (params) / sizeof (BRAddressParams),
+                                               scratch, scratchLen);
+    BRCryptoKey result = (0 != index
+                          ? cryptoKeyCreateInternal (core, params[index - 1])
+                          : NULL);
 
     BRKeyClean (&core);
 
     return result;
 }
 
+extern BRCryptoKey
+cryptoKeyCreateFromStringProtectedPrivate (const char *privateKey, const char * passphrase) {
+    return cryptoKeyCreateFromStringProtectedPrivateWithScratch (privateKey, passphrase, NULL, 0);
+}
+
+/// MARK: - Protected Private Async
+///
+/// Decryption requests queue for a single thread, started on demand and exiting once the queue is
+/// empty.  One at a time, each decryption gets all the parallelism scrypt will use, and the thread
+/// reuses one scrypt scratch buffer for the whole queue rather than allocating per key.
+
+#define CRYPTO_KEY_DECRYPT_THREAD_NAME          "Core Key, BIP38"
+#define CRYPTO_KEY_DECRYPT_PTHREAD_STACK_SIZE   (512 * 1024)
+
+typedef struct BRCryptoKeyDecryptRecord {
+    struct BRCryptoKeyDecryptRecord *next;
+    char *privateKey;
+    char *passphrase;
+    BRCryptoKeyCreateContext context;
+    BRCryptoKeyCreateCallback callback;
+} *BRCryptoKeyDecrypt;
+
+static pthread_mutex_t cryptoKeyDecryptLock = PTHREAD_MUTEX_INITIALIZER;
+static BRCryptoKeyDecrypt cryptoKeyDecryptHead = NULL;
+static BRCryptoKeyDecrypt cryptoKeyDecryptTail = NULL;
+static bool cryptoKeyDecryptRunning = false;
+
+static void
+cryptoKeyDecryptRelease (BRCryptoKeyDecrypt decrypt) {
+    mem_clean (decrypt->passphrase, strlen (decrypt->passphrase));
+    free (decrypt->passphrase);
+    free (decrypt->privateKey);
+    free (decrypt);
+}
+
+static void *
+cryptoKeyDecryptThread (void *ignore) {
+    pthread_setname_brd (pthread_self (), CRYPTO_KEY_DECRYPT_THREAD_NAME);
+
+    // Without the scratch buffer, scrypt allocates its own on each decryption
+    size_t scratchLen = BRBIP38ScratchSize ();
+    void  *scratch    = malloc (scratchLen);
+    if (NULL == scratch) scratchLen = 0;
+
+    pthread_mutex_lock (&cryptoKeyDecryptLock);
+    while (NULL != cryptoKeyDecryptHead) {
+        BRCryptoKeyDecrypt decrypt = cryptoKeyDecryptHead;
+        cryptoKeyDecryptHead = decrypt->next;
+        if (NULL == cryptoKeyDecryptHead) cryptoKeyDecryptTail = NULL;
+        pthread_mutex_unlock (&cryptoKeyDecryptLock);
+
+        BRCryptoKey key = cryptoKeyCreateFromStringProtectedPrivateWithScratch (decrypt->privateKey,
+                                                                                decrypt->passphrase,
+                                                                                scratch,
+                                                                                scratchLen);
+        decrypt->callback (decrypt->context, key);
+        cryptoKeyDecryptRelease (decrypt);
+
+        pthread_mutex_lock (&cryptoKeyDecryptLock);
+    }
+    cryptoKeyDecryptRunning = false;
+    pthread_mutex_unlock (&cryptoKeyDecryptLock);
+
+    free (scratch); // scrypt leaves it zeroed
+    return NULL;
+}
+
+extern BRCryptoBoolean
+cryptoKeyCreateFromStringProtectedPrivateAsync (const char *privateKey,
+                                                const char * passphrase,
+                                                BRCryptoKeyCreateContext context,
+                                                BRCryptoKeyCreateCallback callback) {
+    assert (NULL != callback);
+    if (!BRBIP38KeyIsValid (privateKey)) return CRYPTO_FALSE;
+
+    BRCryptoKeyDecrypt decrypt = calloc (1, sizeof (struct BRCryptoKeyDecryptRecord));
+    decrypt->privateKey = strdup (privateKey);
+    decrypt->passphrase = strdup (passphrase);
+    decrypt->context    = context;
+    decrypt->callback   = callback;
+
+    BRCryptoBoolean queued = CRYPTO_TRUE;
+
+    pthread_mutex_lock (&cryptoKeyDecryptLock);
+    if (NULL != cryptoKeyDecryptTail) cryptoKeyDecryptTail->next = decrypt;
+    else cryptoKeyDecryptHead = decrypt;
+    cryptoKeyDecryptTail = decrypt;
+
+    if (!cryptoKeyDecryptRunning) {
+        pthread_t thread;
+        pthread_attr_t attr;
+        pthread_attr_init (&attr);
+        pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+        pthread_attr_setstacksize (&attr, CRYPTO_KEY_DECRYPT_PTHREAD_STACK_SIZE);
+
+        if (0 == pthread_create (&thread, &attr, cryptoKeyDecryptThread, NULL))
+            cryptoKeyDecryptRunning = true;
+        else {
+            // Nothing else is queued; no thread is running to have taken anything
+            cryptoKeyDecryptHead = cryptoKeyDecryptTail = NULL;
+            cryptoKeyDecryptRelease (decrypt);
+            queued = CRYPTO_FALSE;
+        }
+        pthread_attr_destroy (&attr);
+    }
+    pthread_mutex_unlock (&cryptoKeyDecryptLock);
+
+    return queued;
+}
+
 extern BRCryptoKey
 cryptoKeyCreateFromStringPrivate (const char *string) {
     BRAddressParams params = cryptoKeyFindAddressParams(string);
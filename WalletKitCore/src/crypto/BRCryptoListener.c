@@ -10,6 +10,7 @@
 
 #include "BRCryptoListenerP.h"
 #include "support/BROSCompat.h"
+#include "support/BRArray.h"
 
 #include "BRCryptoNetwork.h"
 #include "BRCryptoTransfer.h"
@@ -19,6 +20,10 @@
 
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoListener, cryptoListener)
 
+static void
+cryptoListenerSignalEvent (BREventHandler handler,
+                           BREvent *event);
+
 // MARK: - Generate Transfer Event
 
 typedef struct {
@@ -60,7 +65,7 @@ cryptoListenerGenerateTransferEvent (const BRCryptoTransferListener *listener,
         cryptoTransferTakeWeak (transfer),
         event };
 
-    eventHandlerSignalEvent(listener->listener->handler, (BREvent *) &listenerEvent);
+    cryptoListenerSignalEvent (listener->listener->handler, (BREvent *) &listenerEvent);
 }
 
 // MARK: - Generate Wallet Event
@@ -101,7 +106,7 @@ cryptoListenerGenerateWalletEvent (const BRCryptoWalletListener *listener,
         cryptoWalletTakeWeak (wallet),
         event };
 
-    eventHandlerSignalEvent(listener->listener->handler, (BREvent *) &listenerEvent);
+    cryptoListenerSignalEvent (listener->listener->handler, (BREvent *) &listenerEvent);
 }
 
 // MARK: - Generate Manager Event
@@ -139,7 +144,7 @@ cryptoListenerGenerateManagerEvent (const BRCryptoWalletManagerListener *listene
         cryptoWalletManagerTakeWeak (manager),
         event };
 
-    eventHandlerSignalEvent (listener->listener->handler, (BREvent *) &listenerEvent);
+    cryptoListenerSignalEvent (listener->listener->handler, (BREvent *) &listenerEvent);
 }
 
 // MARK: - Generate Network Event
@@ -177,7 +182,7 @@ cryptoListenerGenerateNetworkEvent (const BRCryptoNetworkListener *listener,
         cryptoNetworkTakeWeak (network),
         event };
 
-    eventHandlerSignalEvent (listener->listener->handler, (BREvent *) &listenerEvent);
+    cryptoListenerSignalEvent (listener->listener->handler, (BREvent *) &listenerEvent);
 }
 
 // MARK: - Generate System Event
@@ -215,7 +220,84 @@ cryptoListenerGenerateSystemEvent (BRCryptoListener listener,
         cryptoSystemTakeWeak (system),
         event };
 
-    eventHandlerSignalEvent (listener->handler, (BREvent *) &listenerEvent);
+    cryptoListenerSignalEvent (listener->handler, (BREvent *) &listenerEvent);
+}
+
+// MARK: - Deferred Events
+
+typedef struct {
+    BREventHandler handler;
+    union {
+        BREvent base;
+        BRListenerSignalTransferEvent transfer;
+        BRListenerSignalWalletEvent   wallet;
+        BRListenerSignalManagerEvent  manager;
+        BRListenerSignalNetworkEvent  network;
+        BRListenerSignalSystemEvent   system;
+    } u;
+} BRCryptoListenerDeferredEvent;
+
+struct BRCryptoListenerDeferredEventsRecord {
+    BRArrayOf(BRCryptoListenerDeferredEvent) events;
+};
+
+static pthread_once_t cryptoListenerDeferredEventsKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t  cryptoListenerDeferredEventsKey;
+
+static void
+cryptoListenerDeferredEventsKeyCreate (void) {
+    pthread_key_create (&cryptoListenerDeferredEventsKey, NULL);
+}
+
+extern BRCryptoListenerDeferredEvents
+cryptoListenerDeferredEventsCreate (void) {
+    BRCryptoListenerDeferredEvents events = calloc (1, sizeof (struct BRCryptoListenerDeferredEventsRecord));
+    array_new (events->events, 10);
+    return events;
+}
+
+extern void
+cryptoListenerDeferredEventsRelease (BRCryptoListenerDeferredEvents events) {
+    array_free (events->events);
+    free (events);
+}
+
+extern size_t
+cryptoListenerDeferredEventsCount (BRCryptoListenerDeferredEvents events) {
+    return array_count (events->events);
+}
+
+extern void
+cryptoListenerDeferredEventsSignal (BRCryptoListenerDeferredEvents events,
+                                    size_t beg,
+                                    size_t end) {
+    assert (beg <= end && end <= array_count (events->events));
+    for (size_t index = beg; index < end; index++)
+        eventHandlerSignalEvent (events->events[index].handler, &events->events[index].u.base);
+}
+
+extern void
+cryptoListenerDeferEvents (BRCryptoListenerDeferredEvents events) {
+    pthread_once (&cryptoListenerDeferredEventsKeyOnce, cryptoListenerDeferredEventsKeyCreate);
+    pthread_setspecific (cryptoListenerDeferredEventsKey, events);
+}
+
+static void
+cryptoListenerSignalEvent (BREventHandler handler,
+                           BREvent *event) {
+    BRCryptoListenerDeferredEvents events = NULL;
+
+    pthread_once (&cryptoListenerDeferredEventsKeyOnce, cryptoListenerDeferredEventsKeyCreate);
+    events = pthread_getspecific (cryptoListenerDeferredEventsKey);
+
+    if (NULL == events)
+        eventHandlerSignalEvent (handler, event);
+    else {
+        BRCryptoListenerDeferredEvent deferred = { handler };
+        assert (event->type->eventSize <= sizeof (deferred.u));
+        memcpy (&deferred.u, event, event->type->eventSize);
+        array_add (events->events, deferred);
+    }
 }
 
 // MARK: - Event Type
@@ -42,6 +42,38 @@ cryptoListenerStart (BRCryptoListener listener);
 extern void
 cryptoListenerStop (BRCryptoListener listener);
 
+// MARK: Deferred Events
+
+/**
+ * Events generated, for any listener, on a thread deferring events are held in order rather than
+ * signalled.  They are signalled later, in any grouping, with cryptoListenerDeferredEventsSignal().
+ * Every held event must be signalled before the deferred events are released.
+ */
+typedef struct BRCryptoListenerDeferredEventsRecord *BRCryptoListenerDeferredEvents;
+
+extern BRCryptoListenerDeferredEvents
+cryptoListenerDeferredEventsCreate (void);
+
+extern void
+cryptoListenerDeferredEventsRelease (BRCryptoListenerDeferredEvents events);
+
+extern size_t
+cryptoListenerDeferredEventsCount (BRCryptoListenerDeferredEvents events);
+
+/**
+ * Signal the held events in [beg, end), in the order generated.
+ */
+extern void
+cryptoListenerDeferredEventsSignal (BRCryptoListenerDeferredEvents events,
+                                    size_t beg,
+                                    size_t end);
+
+/**
+ * Hold events generated on the calling thread in `events`; NULL stops deferring.
+ */
+extern void
+cryptoListenerDeferEvents (BRCryptoListenerDeferredEvents events);
+
 #ifdef __cplusplus
 }
 #endif
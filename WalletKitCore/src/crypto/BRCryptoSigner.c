@@ -169,3 +169,169 @@ cryptoSignerRecover (BRCryptoSigner signer,
 
     return key;
 }
+
+/// MARK: - Batch
+
+typedef struct {
+    size_t count;     // items passed on to the BRKey batch
+    size_t *indices;  // the caller's index for each item
+    BRKey *cores;
+    UInt256 *mds;
+    const void **sigs;
+    size_t *sigLens;
+    int *results;
+} BRCryptoSignerBatch;
+
+/// Collect the items with a signature of an acceptable length; the rest simply fail, without hitting
+/// the length asserts in the BRKey calls.  If `keys` is non-NULL, their cores are copied so that the
+/// threads never touch a shared BRCryptoKey.
+static BRCryptoSignerBatch
+cryptoSignerBatchCreate (BRCryptoSigner signer,
+                         BRCryptoKey *keys,
+                         const uint8_t **digests,
+                         const uint8_t **signatures,
+                         const size_t *signatureLens,
+                         size_t count) {
+    BRCryptoSignerBatch batch = {
+        0,
+        calloc (count, sizeof (size_t)),
+        calloc (count, sizeof (BRKey)),
+        calloc (count, sizeof (UInt256)),
+        calloc (count, sizeof (const void *)),
+        calloc (count, sizeof (size_t)),
+        calloc (count, sizeof (int))
+    };
+
+    for (size_t index = 0; index < count; index++) {
+        size_t length = signatureLens[index];
+
+        if (NULL == digests[index] || NULL == signatures[index] || (NULL != keys && NULL == keys[index])) continue;
+
+        switch (signer->type) {
+            case CRYPTO_SIGNER_BASIC_DER:  if (0  == length) continue; break;
+            case CRYPTO_SIGNER_BASIC_JOSE: if (64 != length) continue; break;
+            case CRYPTO_SIGNER_COMPACT:    if (65 != length) continue; break;
+        }
+
+        batch.indices[batch.count] = index;
+        if (NULL != keys) batch.cores[batch.count] = *cryptoKeyGetCore (keys[index]);
+        batch.mds[batch.count]     = UInt256Get (digests[index]);
+        batch.sigs[batch.count]    = signatures[index];
+        batch.sigLens[batch.count] = length;
+        batch.count += 1;
+    }
+
+    return batch;
+}
+
+static void
+cryptoSignerBatchRelease (BRCryptoSignerBatch *batch, size_t count) {
+    memset (batch->cores, 0, count * sizeof (BRKey));
+
+    free (batch->indices);
+    free (batch->cores);
+    free (batch->mds);
+    free (batch->sigs);
+    free (batch->sigLens);
+    free (batch->results);
+}
+
+extern size_t
+cryptoSignerVerifyBatch (BRCryptoSigner signer,
+                         BRCryptoKey *keys,
+                         const uint8_t **digests,
+                         const uint8_t **signatures,
+                         const size_t *signatureLens,
+                         BRCryptoBoolean *results,
+                         size_t count) {
+    if (0 == count) return 0;
+    assert (NULL != keys && NULL != digests && NULL != signatures && NULL != signatureLens && NULL != results);
+
+    BRCryptoSignerBatch batch = cryptoSignerBatchCreate (signer, keys, digests, signatures, signatureLens, count);
+    size_t verified = 0;
+
+    for (size_t index = 0; index < count; index++)
+        results[index] = CRYPTO_FALSE;
+
+    switch (signer->type) {
+        case CRYPTO_SIGNER_BASIC_DER: {
+            BRKeyVerifyBatch (batch.results, batch.cores, batch.mds, batch.sigs, batch.sigLens, batch.count);
+            break;
+        }
+        case CRYPTO_SIGNER_BASIC_JOSE: {
+            BRKeyVerifyJOSEBatch (batch.results, batch.cores, batch.mds, batch.sigs, batch.count);
+            break;
+        }
+        case CRYPTO_SIGNER_COMPACT: {
+            // a compact signature verifies if the key recovered from it is the signer's key; the point
+            // is compared, as the signature's compressed flag need not match the key's
+            BRKey *recovered = calloc (batch.count, sizeof (BRKey));
+
+            BRKeyRecoverPubKeyBatch (batch.results, recovered, batch.mds, batch.sigs, batch.count);
+
+            for (size_t index = 0; index < batch.count; index++)
+                if (batch.results[index])
+                    batch.results[index] = BRKeyPubKeyMatch (&batch.cores[index], &recovered[index]);
+
+            free (recovered);
+            break;
+        }
+        default: {
+            // for an unsupported algorithm, assert
+            assert (0);
+            break;
+        }
+    }
+
+    for (size_t index = 0; index < batch.count; index++)
+        if (batch.results[index]) {
+            results[batch.indices[index]] = CRYPTO_TRUE;
+            verified += 1;
+        }
+
+    cryptoSignerBatchRelease (&batch, count);
+    return verified;
+}
+
+extern size_t
+cryptoSignerRecoverBatch (BRCryptoSigner signer,
+                          BRCryptoKey *keys,
+                          const uint8_t **digests,
+                          const uint8_t **signatures,
+                          const size_t *signatureLens,
+                          size_t count) {
+    if (0 == count) return 0;
+    assert (NULL != keys && NULL != digests && NULL != signatures && NULL != signatureLens);
+
+    BRCryptoSignerBatch batch = cryptoSignerBatchCreate (signer, NULL, digests, signatures, signatureLens, count);
+    size_t recovered = 0;
+
+    for (size_t index = 0; index < count; index++)
+        keys[index] = NULL;
+
+    switch (signer->type) {
+        case CRYPTO_SIGNER_BASIC_DER:
+        case CRYPTO_SIGNER_BASIC_JOSE: {
+            // not supported, but not necessarily worth an assert
+            break;
+        }
+        case CRYPTO_SIGNER_COMPACT: {
+            BRKeyRecoverPubKeyBatch (batch.results, batch.cores, batch.mds, batch.sigs, batch.count);
+
+            for (size_t index = 0; index < batch.count; index++)
+                if (batch.results[index]) {
+                    keys[batch.indices[index]] = cryptoKeyCreateFromKey (&batch.cores[index]);
+                    recovered += 1;
+                }
+            break;
+        }
+        default: {
+            // for an unsupported algorithm, assert
+            assert (0);
+            break;
+        }
+    }
+
+    cryptoSignerBatchRelease (&batch, count);
+    return recovered;
+}
@@ -24,6 +24,7 @@
 #include "BRCryptoWalletP.h"
 #include "BRCryptoPaymentP.h"
 #include "BRCryptoClientP.h"
+#include "BRCryptoListenerP.h"
 #include "BRCryptoFileService.h"
 
 #include "BRCryptoWalletManager.h"
@@ -34,6 +35,9 @@
 #include "bitcoin/BRMerkleBlock.h"
 #include "bitcoin/BRPeer.h"
 #include "support/event/BREventAlarm.h"
+#include "support/BRCrypto.h"
+#include "support/BROSCompat.h"
+#include "support/util/BRHex.h"
 
 // We'll do a period QRY 'tick-tock' CWM_CONFIRMATION_PERIOD_FACTOR times in
 // each network's ConfirmationPeriod.  Thus, for example, the Bitcoin confirmation period is
@@ -56,6 +60,10 @@
 #define CWM_MAXIMUM_SAMPLING_PERIOD_IN_MILLISECONDS   (1 * 60 * 1000)    //  1 minute
 #define CWM_MINIMUM_SAMPLING_PERIOD_IN_MILLISECONDS   (    10 * 1000)    // 10 seconds
 
+// Recover transfer bundles on multiple threads only if there are at least this many bundles.  For
+// fewer the threads aren't worth their creation; an incremental sync recovers a handful.
+#define CWM_RECOVER_IN_PARALLEL_MINIMUM_BUNDLES       (64)
+
 static unsigned int
 cryptoWalletManagerBoundSamplingPeriod (unsigned int milliseconds) {
     return (milliseconds > CWM_MAXIMUM_SAMPLING_PERIOD_IN_MILLISECONDS
@@ -155,7 +163,6 @@ cryptoWalletManagerInitialTransferBundlesLoad (BRCryptoWalletManager manager) {
 
     if (fileServiceHasType (manager->fileService, CRYPTO_FILE_SERVICE_TYPE_TRANSFER) &&
         1 != fileServiceLoad (manager->fileService, bundles, CRYPTO_FILE_SERVICE_TYPE_TRANSFER, 1)) {
-        cryptoClientTransferBundleSetRelease (bundles);
         printf ("CRY: %4s: failed to load transfer bundles",
                 cryptoBlockChainTypeGetCurrencyCode (manager->type));
         cryptoClientTransferBundleSetRelease(bundles);
@@ -184,6 +191,7 @@ cryptoWalletManagerInitialTransferBundlesRecover (BRCryptoWalletManager manager)
     if (NULL != manager->bundleTransfers) {
         for (size_t index = 0; index < array_count(manager->bundleTransfers); index++) {
             cryptoWalletManagerRecoverTransferFromTransferBundle (manager, manager->bundleTransfers[index]);
+            cryptoClientQRYManagerRecordTransferBundle (manager->qryManager, manager->bundleTransfers[index]);
         }
 
         array_free_all (manager->bundleTransfers, cryptoClientTransferBundleRelease);
@@ -240,6 +248,7 @@ cryptoWalletManagerInitialTransactionBundlesRecover (BRCryptoWalletManager manag
     if (NULL != manager->bundleTransactions) {
         for (size_t index = 0; index < array_count(manager->bundleTransactions); index++) {
             cryptoWalletManagerRecoverTransfersFromTransactionBundle (manager, manager->bundleTransactions[index]);
+            cryptoClientQRYManagerRecordTransactionBundle (manager->qryManager, manager->bundleTransactions[index]);
         }
 
         array_free_all (manager->bundleTransactions, cryptoClientTransactionBundleRelease);
@@ -1210,12 +1219,274 @@ cryptoWalletManagerRecoverTransfersFromTransactionBundle (BRCryptoWalletManager
     cwm->handlers->recoverTransfersFromTransactionBundle (cwm, bundle);
 }
 
+private_extern BRCryptoBoolean
+cryptoWalletManagerCanRecoverTransferBundles (BRCryptoWalletManager cwm,
+                                              OwnershipKept BRCryptoClientTransferBundle *bundles,
+                                              size_t bundlesCount) {
+    if (CRYPTO_NETWORK_TYPE_ETH == cwm->type) return CRYPTO_TRUE;
+
+    for (size_t index = 0; index < bundlesCount; index++)
+        if (bundles[index]->isBinary) {
+            _peer_log ("CRY: %4s: binary transfer bundle not supported: %s\n",
+                       cryptoBlockChainTypeGetCurrencyCode (cwm->type), bundles[index]->uids);
+            return CRYPTO_FALSE;
+        }
+
+    return CRYPTO_TRUE;
+}
+
 private_extern void
 cryptoWalletManagerRecoverTransferFromTransferBundle (BRCryptoWalletManager cwm,
                                                       OwnershipKept BRCryptoClientTransferBundle bundle) {
+    if (CRYPTO_FALSE == cryptoWalletManagerCanRecoverTransferBundles (cwm, &bundle, 1)) return;
+
     cwm->handlers->recoverTransferFromTransferBundle (cwm, bundle);
 }
 
+// MARK: - Recover Transfer Bundles In Parallel
+
+typedef struct {
+    UInt256 key;            // the bundle's transaction hash
+    size_t  partition;
+} BRCryptoWalletManagerRecoverHash;
+
+static size_t
+cryptoWalletManagerRecoverHashHash (const void *hash) {
+    return (size_t) ((const BRCryptoWalletManagerRecoverHash *) hash)->key.u64[0];
+}
+
+static int
+cryptoWalletManagerRecoverHashEq (const void *hash1, const void *hash2) {
+    return UInt256Eq (((const BRCryptoWalletManagerRecoverHash *) hash1)->key,
+                      ((const BRCryptoWalletManagerRecoverHash *) hash2)->key);
+}
+
+static UInt256
+cryptoWalletManagerRecoverHashKey (BRCryptoClientTransferBundle bundle) {
+    UInt256 key;
+    if (bundle->isBinary) memcpy (key.u8, bundle->binary.hash.data, sizeof (key.u8));
+    else BRSHA256 (key.u8, bundle->hash, strlen (bundle->hash));
+    return key;
+}
+
+// A bundle sent from the primary wallet may add a fee transfer to the primary wallet, whatever
+// its currency; it must be recovered with the network currency's bundles.  The primary wallet's
+// `addresses` are found once, by the caller.  An unparsable source is taken as the primary
+// wallet's.
+static bool
+cryptoWalletManagerRecoverIsFromPrimaryWallet (BRCryptoWalletManager cwm,
+                                               BRSetOf(BRCryptoAddress) addresses,
+                                               BRCryptoClientTransferBundle bundle) {
+    char fromBinary[2 + 2 * sizeof (bundle->binary.from) + 1] = "0x";
+    if (bundle->isBinary)
+        hexEncode (&fromBinary[2], sizeof (fromBinary) - 2, bundle->binary.from, sizeof (bundle->binary.from));
+
+    const char *from = (bundle->isBinary ? fromBinary : bundle->from);
+    BRCryptoAddress address = (NULL == from ? NULL : cryptoNetworkCreateAddress (cwm->network, from));
+    if (NULL == address) return true;
+
+    bool isFromPrimaryWallet = BRSetContains (addresses, address);
+    cryptoAddressGive (address);
+
+    return isFromPrimaryWallet;
+}
+
+static size_t
+cryptoWalletManagerRecoverPartitionFind (size_t *parents, size_t partition) {
+    while (parents[partition] != partition)
+        partition = parents[partition] = parents[parents[partition]];
+    return partition;
+}
+
+static void
+cryptoWalletManagerRecoverPartitionUnion (size_t *parents, size_t partition1, size_t partition2) {
+    size_t root1 = cryptoWalletManagerRecoverPartitionFind (parents, partition1);
+    size_t root2 = cryptoWalletManagerRecoverPartitionFind (parents, partition2);
+    if (root1 != root2) parents[MAX (root1, root2)] = MIN (root1, root2);
+}
+
+typedef struct {
+    BRArrayOf(BRCryptoClientTransferBundle) bundles;
+    BRCryptoListenerDeferredEvents events;      // the events of recovering `bundles`
+    BRArrayOf(size_t) eventsEnds;               // the count of `events` after each of `bundles`
+    size_t eventsNext;                          // the next of `bundles` whose events to signal
+} BRCryptoWalletManagerRecoverPartition;
+
+typedef struct {
+    BRCryptoWalletManager cwm;
+    BRArrayOf(BRCryptoWalletManagerRecoverPartition *) order;
+} BRCryptoWalletManagerRecoverContext;
+
+static void
+cryptoWalletManagerRecoverPartition (BRCryptoWalletManagerRecoverContext *context,
+                                     size_t index) {
+    BRCryptoWalletManagerRecoverPartition *partition = context->order[index];
+
+    // Hold the events; they are signalled in the order of the bundles once every partition is
+    // recovered.
+    cryptoListenerDeferEvents (partition->events);
+    for (size_t bundleIndex = 0; bundleIndex < array_count(partition->bundles); bundleIndex++) {
+        cryptoWalletManagerRecoverTransferFromTransferBundle (context->cwm, partition->bundles[bundleIndex]);
+        array_add (partition->eventsEnds, cryptoListenerDeferredEventsCount (partition->events));
+    }
+    cryptoListenerDeferEvents (NULL);
+}
+
+static int
+cryptoWalletManagerRecoverPartitionCompareBySize (const void *v1, const void *v2) {
+    size_t c1 = array_count ((* (BRCryptoWalletManagerRecoverPartition * const *) v1)->bundles);
+    size_t c2 = array_count ((* (BRCryptoWalletManagerRecoverPartition * const *) v2)->bundles);
+    return (c1 > c2 ? -1 : (c1 < c2 ? +1 : 0));
+}
+
+private_extern void
+cryptoWalletManagerRecoverTransfersFromTransferBundles (BRCryptoWalletManager cwm,
+                                                        OwnershipKept BRCryptoClientTransferBundle *bundles,
+                                                        size_t bundlesCount) {
+    if (bundlesCount < CWM_RECOVER_IN_PARALLEL_MINIMUM_BUNDLES) {
+        for (size_t index = 0; index < bundlesCount; index++)
+            cryptoWalletManagerRecoverTransferFromTransferBundle (cwm, bundles[index]);
+        return;
+    }
+
+    BRCryptoNetwork network = cwm->network;
+
+    // Partition the bundles by currency; a bundle with a currency unknown to `network` can only
+    // produce a fee transfer, held by the primary wallet, and is in the network currency's partition.
+    BRArrayOf(BRCryptoCurrency) currencies;
+    array_new (currencies, 10);
+    array_add (currencies, cryptoCurrencyTake (network->currency));
+
+    size_t *bundlePartitions   = calloc (bundlesCount, sizeof (size_t));
+    bool   *bundlesFromPrimary = calloc (bundlesCount, sizeof (bool));
+
+    BRSetOf(BRCryptoAddress) primaryAddresses = NULL;
+
+    for (size_t index = 0; index < bundlesCount; index++) {
+        BRCryptoCurrency currency = cryptoNetworkGetCurrencyForUids (network, bundles[index]->currency);
+        size_t partition = 0;
+
+        if (NULL != currency) {
+            for (partition = 0; partition < array_count(currencies); partition++)
+                if (currency == currencies[partition]) break;
+
+            if (partition == array_count(currencies))
+                array_add (currencies, cryptoCurrencyTake (currency));
+
+            cryptoCurrencyGive (currency);
+
+            if (0 != partition) {
+                if (NULL == primaryAddresses)
+                    primaryAddresses = cryptoWalletGetAddressesForRecovery (cwm->wallet);
+
+                bundlesFromPrimary[index] = cryptoWalletManagerRecoverIsFromPrimaryWallet (cwm, primaryAddresses, bundles[index]);
+            }
+        }
+
+        bundlePartitions[index] = partition;
+    }
+
+    if (NULL != primaryAddresses) cryptoAddressSetRelease (primaryAddresses);
+
+    size_t partitionsCount = array_count (currencies);
+
+    size_t *parents = calloc (partitionsCount, sizeof (size_t));
+    for (size_t partition = 0; partition < partitionsCount; partition++)
+        parents[partition] = partition;
+
+    // Only the network currency's partition touches the primary wallet.  A currency having any
+    // bundle sent from the primary wallet has all its bundles recovered with the network
+    // currency's; its wallet is then only ever touched by one thread.
+    for (size_t index = 0; index < bundlesCount; index++)
+        if (bundlesFromPrimary[index])
+            cryptoWalletManagerRecoverPartitionUnion (parents, 0, bundlePartitions[index]);
+
+    // Bundles sharing a transaction hash, such as a token transfer and the fee paid for it, may
+    // find or create one another's transfers.  Their partitions are merged so that the bundles are
+    // recovered, in order, by one thread.
+    BRSet *hashes = BRSetNew (cryptoWalletManagerRecoverHashHash, cryptoWalletManagerRecoverHashEq, bundlesCount);
+    BRCryptoWalletManagerRecoverHash *hashesStorage = calloc (bundlesCount, sizeof (BRCryptoWalletManagerRecoverHash));
+
+    for (size_t index = 0; index < bundlesCount; index++) {
+        BRCryptoWalletManagerRecoverHash *hash = &hashesStorage[index];
+        hash->key       = cryptoWalletManagerRecoverHashKey (bundles[index]);
+        hash->partition = bundlePartitions[index];
+
+        BRCryptoWalletManagerRecoverHash *existing = BRSetGet (hashes, hash);
+        if (NULL == existing)
+            BRSetAdd (hashes, hash);
+        else
+            cryptoWalletManagerRecoverPartitionUnion (parents, existing->partition, hash->partition);
+    }
+
+    BRSetFree (hashes);
+    free (hashesStorage);
+
+    // Fill each partition with its bundles, preserving the order of `bundles`.
+    BRCryptoWalletManagerRecoverPartition *partitions = calloc (partitionsCount, sizeof (BRCryptoWalletManagerRecoverPartition));
+    BRArrayOf(BRCryptoWalletManagerRecoverPartition *) order;
+    array_new (order, partitionsCount);
+
+    for (size_t index = 0; index < bundlesCount; index++) {
+        size_t root = cryptoWalletManagerRecoverPartitionFind (parents, bundlePartitions[index]);
+        bundlePartitions[index] = root;
+
+        if (NULL == partitions[root].bundles) {
+            array_new (partitions[root].bundles, 10);
+            array_add (order, &partitions[root]);
+        }
+        array_add (partitions[root].bundles, bundles[index]);
+    }
+
+    if (1 == array_count (order))
+        for (size_t index = 0; index < bundlesCount; index++)
+            cryptoWalletManagerRecoverTransferFromTransferBundle (cwm, bundles[index]);
+
+    else {
+        // Create every wallet beforehand; the threads then only find them.
+        for (size_t index = 1; index < array_count(currencies); index++)
+            cryptoWalletGive (cryptoWalletManagerCreateWallet (cwm, currencies[index]));
+
+        for (size_t index = 0; index < array_count(order); index++) {
+            BRCryptoWalletManagerRecoverPartition *partition = order[index];
+            partition->events = cryptoListenerDeferredEventsCreate ();
+            array_new (partition->eventsEnds, array_count (partition->bundles));
+        }
+
+        // Hand out the largest partitions first so that the threads finish together.
+        qsort (order, array_count(order), sizeof (BRCryptoWalletManagerRecoverPartition *),
+               cryptoWalletManagerRecoverPartitionCompareBySize);
+
+        BRCryptoWalletManagerRecoverContext context = { cwm, order };
+        pthread_apply_brd (array_count (order), 0, &context,
+                           (void (*) (void *, size_t)) cryptoWalletManagerRecoverPartition);
+
+        // Signal the events bundle by bundle, in the order of `bundles`, as if recovered serially.
+        for (size_t index = 0; index < bundlesCount; index++) {
+            BRCryptoWalletManagerRecoverPartition *partition = &partitions[bundlePartitions[index]];
+            size_t eventsBeg = (0 == partition->eventsNext ? 0 : partition->eventsEnds[partition->eventsNext - 1]);
+            size_t eventsEnd = partition->eventsEnds[partition->eventsNext];
+
+            cryptoListenerDeferredEventsSignal (partition->events, eventsBeg, eventsEnd);
+            partition->eventsNext += 1;
+        }
+    }
+
+    for (size_t index = 0; index < array_count(order); index++) {
+        BRCryptoWalletManagerRecoverPartition *partition = order[index];
+        if (NULL != partition->events)     cryptoListenerDeferredEventsRelease (partition->events);
+        if (NULL != partition->eventsEnds) array_free (partition->eventsEnds);
+        array_free (partition->bundles);
+    }
+    array_free (order);
+    free (partitions);
+
+    free (parents);
+    free (bundlesFromPrimary);
+    free (bundlePartitions);
+    array_free_all (currencies, cryptoCurrencyGive);
+}
+
 private_extern void
 cryptoWalletManagerRecoverTransferAttributesFromTransferBundle (BRCryptoWallet wallet,
                                                                 BRCryptoTransfer transfer,
@@ -261,12 +261,28 @@ private_extern void
 cryptoWalletManagerRecoverTransfersFromTransactionBundle (BRCryptoWalletManager cwm,
                                                           OwnershipKept BRCryptoClientTransactionBundle bundle);
 
+// Only ETH recovers transfers from binary bundles; other networks require the string values.
+// Returns CRYPTO_FALSE, and logs, if any of `bundles` cannot be recovered by `cwm`.
+private_extern BRCryptoBoolean
+cryptoWalletManagerCanRecoverTransferBundles (BRCryptoWalletManager cwm,
+                                              OwnershipKept BRCryptoClientTransferBundle *bundles,
+                                              size_t bundlesCount);
+
 // Is it possible that the transfers do not have the 'submitted' state?  In some race between
 // the submit call and the included call?  Highly, highly unlikely but possible?
 private_extern void
 cryptoWalletManagerRecoverTransferFromTransferBundle (BRCryptoWalletManager cwm,
                                                       OwnershipKept BRCryptoClientTransferBundle bundle);
 
+// Recover transfers from `bundles`, which are sorted.  The bundles are partitioned by currency,
+// merging partitions that share a transaction hash, and the partitions are recovered on multiple
+// threads.  Within a partition the bundles are recovered in order.  Must not be called with
+// `cwm->lock` held.
+private_extern void
+cryptoWalletManagerRecoverTransfersFromTransferBundles (BRCryptoWalletManager cwm,
+                                                        OwnershipKept BRCryptoClientTransferBundle *bundles,
+                                                        size_t bundlesCount);
+
 private_extern void
 cryptoWalletManagerRecoverTransferAttributesFromTransferBundle (BRCryptoWallet wallet,
                                                                 BRCryptoTransfer transfer,
@@ -154,6 +154,11 @@ typedef struct BRCryptoWalletManagerETHRecord {
 
     BRSetOf(BREthereumToken) tokens;
 
+    // The currencies, each with an ensured token, of recovered transfer bundles; avoids a
+    // network-wide currency lookup and a token lookup for every ERC20 bundle.  Protected by
+    // `base.lock`.
+    BRArrayOf(BRCryptoCurrency) bundleCurrencies;
+
     BRRlpCoder coder;
 
 } *BRCryptoWalletManagerETH;
@@ -166,6 +171,33 @@ cryptoWalletManagerEnsureWalletForToken (BRCryptoWalletManagerETH managerETH,
                                          BREthereumToken token);
 
 
+// MARK: - Transfer Bundle
+
+/**
+ * The values of an ETH or ERC20 transfer bundle, each parsed once.  For a binary bundle the hash,
+ * addresses and amount are copied, not parsed.  A `source` or `target` that is not an address,
+ * such as the empty target of a contract creation, is not valid.
+ */
+typedef struct {
+    BREthereumHash hash;
+    BREthereumAddress source;
+    BREthereumAddress target;
+    bool sourceIsValid;
+    bool targetIsValid;
+    UInt256  amount;
+    uint64_t gasLimit;
+    uint64_t gasUsed;
+    UInt256  gasPrice;
+    uint64_t nonce;
+} BRCryptoTransferBundleETH;
+
+/**
+ * Extract the values of `bundle`; returns true if a value does not parse.
+ */
+private_extern bool
+cryptoClientTransferBundleExtractETH (OwnershipKept BRCryptoClientTransferBundle bundle,
+                                      BRCryptoTransferBundleETH *values);
+
 // MARK: - Support
 
 private_extern BRCryptoCurrency
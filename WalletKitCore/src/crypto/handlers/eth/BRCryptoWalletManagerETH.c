@@ -115,6 +115,7 @@ cryptoWalletManagerCreateETH (BRCryptoWalletManagerListener listener,
 
     // Save the recovered tokens
     managerETH->tokens = ethTokenSetCreate (EWM_INITIAL_SET_SIZE_DEFAULT);
+    array_new (managerETH->bundleCurrencies, 10);
 
     // Ensure a token (but not a wallet) for each currency
     cryptoWalletManagerCreateTokensForNetwork (managerETH, network);
@@ -134,6 +135,8 @@ cryptoWalletManagerReleaseETH (BRCryptoWalletManager manager) {
     rlpCoderRelease (managerETH->coder);
     if (NULL != managerETH->tokens)
         BRSetFreeAll(managerETH->tokens, (void (*) (void*)) ethTokenRelease);
+    if (NULL != managerETH->bundleCurrencies)
+        array_free_all (managerETH->bundleCurrencies, cryptoCurrencyGive);
 }
 
 static BRFileService
@@ -331,10 +334,15 @@ cryptoWalletManagerCreateTokenForCurrencyInternal (BRCryptoWalletManagerETH mana
 
     BREthereumAddress addr = ethAddressCreate(address);
 
-    // Check for an existing token
+    // Check for an existing token and add one, atomically; transfer bundles for different
+    // currencies may be recovered concurrently.  The lock is recursive.
+    pthread_mutex_lock (&managerETH->base.lock);
     BREthereumToken token = cryptoWalletManagerGetTokenETH(managerETH, &addr);
 
-    if (NULL != token && !updateIfNeeded) return;
+    if (NULL != token && !updateIfNeeded) {
+        pthread_mutex_unlock (&managerETH->base.lock);
+        return;
+    }
 
     const char *code = cryptoCurrencyGetCode (currency);
     const char *name = cryptoCurrencyGetName (currency);
@@ -358,7 +366,6 @@ cryptoWalletManagerCreateTokenForCurrencyInternal (BRCryptoWalletManagerETH mana
         cryptoWalletManagerAddTokenETH (managerETH, token);
     }
     else {
-        pthread_mutex_lock (&managerETH->base.lock);
         ethTokenUpdate (token,
                         code,
                         name,
@@ -366,8 +373,8 @@ cryptoWalletManagerCreateTokenForCurrencyInternal (BRCryptoWalletManagerETH mana
                         decimals,
                         defaultGasLimit,
                         defaultGasPrice);
-        pthread_mutex_unlock (&managerETH->base.lock);
     }
+    pthread_mutex_unlock (&managerETH->base.lock);
 }
 
 static void
@@ -560,14 +567,6 @@ cryptoWalletManagerEnsureWalletForToken (BRCryptoWalletManagerETH managerETH,
     return (BRCryptoWalletETH) wallet;
 }
 
-static const char *
-cwmLookupAttributeValueForKey (const char *key, size_t count, const char **keys, const char **vals) {
-    for (size_t index = 0; index < count; index++)
-        if (0 == strcasecmp (key, keys[index]))
-            return vals[index];
-    return NULL;
-}
-
 static uint64_t
 cwmParseUInt64 (const char *string, bool *error) {
     if (!string || 0 == strlen(string)) { *error = true; return 0; }
@@ -599,20 +598,73 @@ cwmExtractAttributes (OwnershipKept BRCryptoClientTransferBundle bundle,
                       UInt256  *gasPrice,
                       uint64_t *nonce,
                       bool     *error) {
-    *amount = cwmParseUInt256 (bundle->amount, error);
-
-    size_t attributesCount = bundle->attributesCount;
-    const char **attributeKeys   = (const char **) bundle->attributeKeys;
-    const char **attributeVals   = (const char **) bundle->attributeVals;
+    *amount = (bundle->isBinary
+               ? bundle->binary.amount
+               : cwmParseUInt256 (bundle->amount, error));
+
+    // Find each attribute in one pass; the first of a repeated key is used.
+    const char *gasLimitVal = NULL, *gasUsedVal = NULL, *gasPriceVal = NULL, *nonceVal = NULL;
+    for (size_t index = 0; index < bundle->attributesCount; index++) {
+        const char *key = bundle->attributeKeys[index];
+        const char *val = bundle->attributeVals[index];
+
+        if      (NULL == gasLimitVal && 0 == strcasecmp ("gasLimit", key)) gasLimitVal = val;
+        else if (NULL == gasUsedVal  && 0 == strcasecmp ("gasUsed",  key)) gasUsedVal  = val;
+        else if (NULL == gasPriceVal && 0 == strcasecmp ("gasPrice", key)) gasPriceVal = val;
+        else if (NULL == nonceVal    && 0 == strcasecmp ("nonce",    key)) nonceVal    = val;
+    }
 
-    *gasLimit = cwmParseUInt64 (cwmLookupAttributeValueForKey ("gasLimit", attributesCount, attributeKeys, attributeVals), error);
-    *gasUsed  = cwmParseUInt64 (cwmLookupAttributeValueForKey ("gasUsed",  attributesCount, attributeKeys, attributeVals), error);
-    *gasPrice = cwmParseUInt256(cwmLookupAttributeValueForKey ("gasPrice", attributesCount, attributeKeys, attributeVals), error);
-    *nonce    = cwmParseUInt64 (cwmLookupAttributeValueForKey ("nonce",    attributesCount, attributeKeys, attributeVals), error);
+    *gasLimit = cwmParseUInt64 (gasLimitVal, error);
+    *gasUsed  = cwmParseUInt64 (gasUsedVal,  error);
+    *gasPrice = cwmParseUInt256(gasPriceVal, error);
+    *nonce    = cwmParseUInt64 (nonceVal,    error);
 
     if (*gasLimit == 21000 && *gasUsed == 0x21000) *gasUsed = 21000;
 }
 
+// A binary bundle holds the hash and addresses as bytes; otherwise they are parsed from strings.
+static BREthereumHash
+cwmBundleGetHash (OwnershipKept BRCryptoClientTransferBundle bundle) {
+    if (!bundle->isBinary) return ethHashCreate (bundle->hash);
+
+    BREthereumHash hash;
+    memcpy (hash.bytes, bundle->binary.hash.data, sizeof (hash.bytes));
+    return hash;
+}
+
+static BREthereumAddress
+cwmBundleGetAddress (OwnershipKept BRCryptoClientTransferBundle bundle,
+                     bool isSource) {
+    if (!bundle->isBinary) return ethAddressCreate (isSource ? bundle->from : bundle->to);
+
+    BREthereumAddress address;
+    memcpy (address.bytes, (isSource ? bundle->binary.from : bundle->binary.to), sizeof (address.bytes));
+    return address;
+}
+
+private_extern bool
+cryptoClientTransferBundleExtractETH (OwnershipKept BRCryptoClientTransferBundle bundle,
+                                      BRCryptoTransferBundleETH *values) {
+    bool error = false;
+    cwmExtractAttributes (bundle,
+                          &values->amount,
+                          &values->gasLimit,
+                          &values->gasUsed,
+                          &values->gasPrice,
+                          &values->nonce,
+                          &error);
+
+    values->hash = cwmBundleGetHash (bundle);
+
+    values->sourceIsValid = bundle->isBinary || ETHEREUM_BOOLEAN_IS_TRUE (ethAddressValidateString (bundle->from));
+    values->targetIsValid = bundle->isBinary || ETHEREUM_BOOLEAN_IS_TRUE (ethAddressValidateString (bundle->to));
+
+    values->source = (values->sourceIsValid ? cwmBundleGetAddress (bundle, true)  : EMPTY_ADDRESS_INIT);
+    values->target = (values->targetIsValid ? cwmBundleGetAddress (bundle, false) : EMPTY_ADDRESS_INIT);
+
+    return error;
+}
+
 #if defined (INCLUDE_UNUSED_RecoverTransaction)
 static bool // true if error
 cryptoWalletManagerRecoverTransaction (BRCryptoWalletManager manager,
@@ -847,6 +899,31 @@ bool strPrefix(const char *pre, const char *str)
     return strncmp (pre, str, strlen(pre)) == 0;
 }
 
+// Find the currency for `bundle->currency`, with its token ensured.  Each currency is found, and
+// its token ensured, once; see `bundleCurrencies`.
+static BRCryptoCurrency
+cryptoWalletManagerGetCurrencyForBundleETH (BRCryptoWalletManagerETH managerETH,
+                                            OwnershipKept BRCryptoClientTransferBundle bundle) {
+    BRCryptoCurrency currency = NULL;
+
+    pthread_mutex_lock (&managerETH->base.lock);
+    for (size_t index = 0; NULL == currency && index < array_count (managerETH->bundleCurrencies); index++)
+        if (0 == strcasecmp (bundle->currency, cryptoCurrencyGetUids (managerETH->bundleCurrencies[index])))
+            currency = cryptoCurrencyTake (managerETH->bundleCurrencies[index]);
+
+    // An unknown currency is not held; the network might later add it.
+    if (NULL == currency) {
+        currency = cryptoNetworkGetCurrencyForUids (managerETH->base.network, bundle->currency);
+        if (NULL != currency) {
+            cryptoWalletManagerEnsureTokenForCurrency (managerETH, currency);
+            array_add (managerETH->bundleCurrencies, cryptoCurrencyTake (currency));
+        }
+    }
+    pthread_mutex_unlock (&managerETH->base.lock);
+
+    return currency;
+}
+
 static void
 cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager manager,
                                                          OwnershipKept BRCryptoClientTransferBundle bundle) {
@@ -858,20 +935,12 @@ cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager m
     // We'll only have a `walletCurrency` if the bundle->currency is for ETH or from an ERC20 token
     // that is known by `network`.  If `bundle` indicates a `transfer` that we sent and we do not
     // know about the ERC20 token we STILL MUST process the fee and the nonce.
-    BRCryptoCurrency currency = cryptoNetworkGetCurrencyForUids (network, bundle->currency);
-
-    // If we have a currency, ensure that we also have an ERC20 token
-    if (NULL != currency)
-        cryptoWalletManagerEnsureTokenForCurrency (managerETH, currency);
-
-    UInt256  amountETH;
-    uint64_t gasLimit;
-    uint64_t gasUsed;
-    UInt256  gasPrice;
-    uint64_t nonce;
+    // If we have a currency, we also have an ERC20 token.
+    BRCryptoCurrency currency = cryptoWalletManagerGetCurrencyForBundleETH (managerETH, bundle);
 
-    bool error = false;
-    cwmExtractAttributes (bundle, &amountETH, &gasLimit, &gasUsed, &gasPrice, &nonce, &error);
+    // Parse each of the bundle's values once; a binary bundle's values are already parsed.
+    BRCryptoTransferBundleETH values;
+    bool error = cryptoClientTransferBundleExtractETH (bundle, &values);
 
     if (error) {
         printf ("SYS: ETH: Bundle Attribute Error - Want to FATAL: %s\n", bundle->uids);
@@ -891,14 +960,14 @@ cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager m
     BRCryptoWallet wallet = (NULL == currency ? NULL : cryptoWalletManagerCreateWallet (manager, currency));
 
     // Get the confirmed feeBasis which we'll use even if the transfer is already known.
-    BREthereumFeeBasis feeBasisConfirmedETH = ethFeeBasisCreate (ethGasCreate(gasUsed), ethGasPriceCreate(ethEtherCreate(gasPrice)));
+    BREthereumFeeBasis feeBasisConfirmedETH = ethFeeBasisCreate (ethGasCreate(values.gasUsed), ethGasPriceCreate(ethEtherCreate(values.gasPrice)));
     BRCryptoFeeBasis   feeBasisConfirmed    = cryptoFeeBasisCreateAsETH (primaryWallet->unitForFee, feeBasisConfirmedETH);
 
     // Derive the transfer's state
     BRCryptoTransferState state = cryptoClientTransferBundleGetTransferState (bundle, feeBasisConfirmed);
 
     // Get the hash; we'll use it to find a pre-existing transfer in wallet or primaryWallet
-    BRCryptoHash hash = cryptoNetworkCreateHashFromString (network, bundle->hash);
+    BRCryptoHash hash = cryptoHashCreateAsETH (values.hash);
 
     // We'll create or find a transfer for the bundle
     BRCryptoTransfer transfer = NULL;
@@ -917,20 +986,20 @@ cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager m
         BRCryptoTransferETH transeferETH = cryptoTransferCoerceETH(transfer);
 
         // Compare the current nonce with the transfer's.
-        bool nonceChanged = (nonce != cryptoTransferGetNonceETH(transeferETH));
+        bool nonceChanged = (values.nonce != cryptoTransferGetNonceETH(transeferETH));
 
         // Update the nonce if it has chanaged
-        if (nonceChanged) cryptoTransferSetNonceETH (transeferETH, nonce);
+        if (nonceChanged) cryptoTransferSetNonceETH (transeferETH, values.nonce);
 
         // On a state change the wallet will be updated.
         cryptoTransferSetStateForced (transfer, state, nonceChanged);
     }
 
     else {
-        BRCryptoAddress source = cryptoNetworkCreateAddress (network, bundle->from);
-        BRCryptoAddress target = cryptoNetworkCreateAddress (network, bundle->to);
+        BRCryptoAddress source = (values.sourceIsValid ? cryptoAddressCreateAsETH (values.source) : NULL);
+        BRCryptoAddress target = (values.targetIsValid ? cryptoAddressCreateAsETH (values.target) : NULL);
 
-        BREthereumFeeBasis feeBasisEstimatedETH = ethFeeBasisCreate (ethGasCreate(gasLimit), ethGasPriceCreate(ethEtherCreate(gasPrice)));
+        BREthereumFeeBasis feeBasisEstimatedETH = ethFeeBasisCreate (ethGasCreate(values.gasLimit), ethGasPriceCreate(ethEtherCreate(values.gasPrice)));
         BRCryptoFeeBasis   feeBasisEstimated = cryptoFeeBasisCreateAsETH (primaryWallet->unitForFee, feeBasisEstimatedETH);
 
         BRCryptoAmount amount = NULL;
@@ -938,12 +1007,12 @@ cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager m
         // If we have a currency, then create an amount
         if (NULL != currency) {
             BRCryptoUnit   amountUnit = cryptoNetworkGetUnitAsDefault (network, currency);
-            amount = cryptoAmountCreate (amountUnit, CRYPTO_FALSE, amountETH);
+            amount = cryptoAmountCreate (amountUnit, CRYPTO_FALSE, values.amount);
             cryptoUnitGive(amountUnit);
         }
 
         // We pay the fee
-        bool paysFee = (ETHEREUM_BOOLEAN_TRUE == ethAccountHasAddress (accountETH, ethAddressCreate(bundle->from)));
+        bool paysFee = (ETHEREUM_BOOLEAN_TRUE == ethAccountHasAddress (accountETH, values.source));
 
         // If we pay the fee but don't have a currency, then we'll need a transfer with a zero amount.
         if (NULL == amount && paysFee)
@@ -964,7 +1033,7 @@ cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager m
                                                   target,
                                                   state,
                                                   accountETH,
-                                                  nonce,
+                                                  values.nonce,
                                                   NULL);
 
             // The transfer's primaryWallet holds the transfer
@@ -979,9 +1048,9 @@ cryptoWalletManagerRecoverTransferFromTransferBundleETH (BRCryptoWalletManager m
             if (paysFee) {
                 ethAccountSetAddressNonce (accountETH,
                                            ethAccountGetPrimaryAddress(accountETH),
-                                           nonce + 1, // next Nonce
+                                           values.nonce + 1, // next Nonce
                                            ETHEREUM_BOOLEAN_FALSE);
-                printf ("DBG: Nonce: try: %llu, now: %llu\n", nonce + 1, ethAccountGetAddressNonce(accountETH, ethAccountGetPrimaryAddress(accountETH)));
+                printf ("DBG: Nonce: try: %llu, now: %llu\n", values.nonce + 1, ethAccountGetAddressNonce(accountETH, ethAccountGetPrimaryAddress(accountETH)));
             }
 #endif
         }
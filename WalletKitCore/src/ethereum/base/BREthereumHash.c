@@ -51,6 +51,29 @@ ethHashCreateFromData (BRRlpData data) {
     return hash;
 }
 
+#define HASH_BATCH_COUNT       (16)
+
+extern void
+ethHashCreateFromDataBatch (BREthereumHash *hashes,
+                            const BRRlpData *data,
+                            size_t count) {
+    assert (ETHEREUM_HASH_BYTES == sizeof (BREthereumHash));
+
+    const void *bytes [HASH_BATCH_COUNT];
+    size_t bytesCount [HASH_BATCH_COUNT];
+
+    for (size_t index = 0; index < count; index += HASH_BATCH_COUNT) {
+        size_t batchCount = (count - index < HASH_BATCH_COUNT ? count - index : HASH_BATCH_COUNT);
+
+        for (size_t item = 0; item < batchCount; item++) {
+            bytes[item]      = data[index + item].bytes;
+            bytesCount[item] = data[index + item].bytesCount;
+        }
+
+        BRKeccak256Batch (hashes[index].bytes, bytes, bytesCount, batchCount);
+    }
+}
+
 /**
  * Return the hex-encoded string
  */
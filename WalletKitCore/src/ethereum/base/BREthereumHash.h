@@ -73,6 +73,15 @@ ethHashCreateEmpty (void);
 extern BREthereumHash
 ethHashCreateFromData (BRRlpData data);
 
+/**
+ * Fill `hashes` with the Keccak256 hash of each of `count` data sets; several are hashed at
+ * once (see BRKeccak256Batch()), when the CPU supports it.
+ */
+extern void
+ethHashCreateFromDataBatch (BREthereumHash *hashes,
+                            const BRRlpData *data,
+                            size_t count);
+
 /**
  * Return the hex-encoded string
  */
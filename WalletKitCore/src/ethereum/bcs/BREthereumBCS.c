@@ -20,6 +20,7 @@
 #define BCS_ORPHAN_BLOCKS_INITIAL_CAPACITY (10)
 #define BCS_PENDING_TRANSACTION_INITIAL_CAPACITY  (10)
 #define BCS_PENDING_LOGS_INITIAL_CAPACITY  (10)
+#define BCS_PENDING_BLOCKS_INITIAL_CAPACITY  (10)
 
 #define BCS_TRANSACTIONS_INITIAL_CAPACITY (50)
 #define BCS_LOGS_INITIAL_CAPACITY (50)
@@ -30,7 +31,8 @@
 #define BCS_ORPHAN_AGE_OFFSET  (10)
 
 // We'll save every 500 blocks.  On restart we'll expect these blocks to be passed to bcsCreate()
-// so as to initialize the chain.
+// so as to initialize the chain.  With a header store, blocks are stored as they age past
+// BCS_REORG_LIMIT and, on restart, this many are restored from the store.
 #define BCS_SAVE_BLOCKS_COUNT  (500)
 
 // We really can't set this limit; we've seen 15 before.  But, what about a rogue node?
@@ -55,6 +57,12 @@ bcsExtendChain (BREthereumBCS bcs,
                 BREthereumBlock block,
                 const char *message);
 
+static void
+bcsStoreBlocks (BREthereumBCS bcs);
+
+static void
+bcsExtendChainWithPendingBlocks (BREthereumBCS bcs);
+
 static void
 bcsUnwindChain (BREthereumBCS bcs,
                 uint64_t depth,
@@ -134,6 +142,58 @@ bcsCreateInitializeBlocks (BREthereumBCS bcs,
     BRSetFree (blocks);
 }
 
+/**
+ * Restore `chain` from the header store - the most recent BCS_SAVE_BLOCKS_COUNT blocks, or fewer
+ * if the store has a gap.  Older headers stay in the store.
+ */
+static void
+bcsCreateInitializeBlocksFromStore (BREthereumBCS bcs) {
+    uint64_t numberBase = bcsHeaderStoreGetNumberBase (bcs->headerStore);
+    uint64_t numberHead = bcsHeaderStoreGetNumberHead (bcs->headerStore);
+
+    // Read descending from the head; each header must be the parent of the prior one.  Never
+    // read the genesis block; we have it already.
+    BRArrayOf(BREthereumBlock) blocks;
+    array_new (blocks, BCS_SAVE_BLOCKS_COUNT);
+
+    BREthereumHash parentHash;
+    for (uint64_t number = numberHead;
+         number >= numberBase && number > 0 && array_count (blocks) < BCS_SAVE_BLOCKS_COUNT;
+         number--) {
+        UInt256 totalDifficulty;
+        BREthereumBlockHeader header = bcsHeaderStoreGet (bcs->headerStore, number, &totalDifficulty);
+        if (NULL == header) break;
+
+        if (array_count (blocks) > 0 &&
+            ETHEREUM_BOOLEAN_IS_FALSE (ethHashEqual (parentHash, blockHeaderGetHash (header)))) {
+            blockHeaderRelease (header);
+            break;
+        }
+        parentHash = blockHeaderGetParentHash (header);
+
+        BREthereumBlock block = blockCreate (header);
+        if (!uint256EQL (totalDifficulty, UINT256_ZERO))
+            blockSetTotalDifficulty (block, totalDifficulty);
+        array_add (blocks, block);
+    }
+
+    if (0 == array_count (blocks)) { array_free (blocks); return; }
+
+    bcs->chain = bcs->chainTail = NULL;
+
+    for (size_t index = array_count (blocks); index > 0; index--) {
+        BREthereumBlock block = blocks[index - 1];
+
+        BRSetAdd (bcs->blocks, block);
+        bcsExtendChain (bcs, block, "Chained (from Store)");
+
+        if (NULL == bcs->chainTail)
+            bcs->chainTail = bcs->chain;
+    }
+
+    array_free (blocks);
+}
+
 static void
 bcsCreateInitializeTransactions (BREthereumBCS bcs,
                                  BRSetOf(BREthereumTransaction) transactions) {
@@ -177,6 +237,7 @@ bcsCreate (BREthereumNetwork network,
            BREthereumAddress address,
            BREthereumBCSListener listener,
            BRCryptoSyncMode mode,
+           const char *storagePath,
            OwnershipGiven BRSetOf(BREthereumNodeConfig) peers,
            OwnershipGiven BRSetOf(BREthereumBlock) blocks,
            OwnershipGiven BRSetOf(BREthereumTransaction) transactions,
@@ -222,6 +283,7 @@ bcsCreate (BREthereumNetwork network,
     //
     array_new (bcs->pendingTransactions, BCS_PENDING_TRANSACTION_INITIAL_CAPACITY);
     array_new (bcs->pendingLogs, BCS_PENDING_LOGS_INITIAL_CAPACITY);
+    array_new (bcs->pendingBlocks, BCS_PENDING_BLOCKS_INITIAL_CAPACITY);
 
     // Our genesis block.
     bcs->genesis = networkGetGenesisBlock(network);
@@ -242,11 +304,29 @@ bcsCreate (BREthereumNetwork network,
                                       (BREventDispatcher)bcsPeriodicDispatcher,
                                       (void*) bcs);
 
+    // Create the proof-of-work before `chain`; extending `chain` sets the proof-of-work's head.
+    bcs->pow = proofOfWorkCreate (storagePath);
+
     // Initialize `chain` - will be modified based on `blocks`
     bcs->chain = bcs->chainTail = bcs->genesis;
 
-    // Initialize blocks, transactions and logs from saved state.
-    bcsCreateInitializeBlocks(bcs, blocks);
+    // Open the header store, if we have a `storagePath`.
+    bcs->headerStore = (NULL == storagePath ? NULL : bcsHeaderStoreCreate (storagePath, network));
+    if (NULL != storagePath && NULL == bcs->headerStore)
+        eth_log ("BCS", "Header Store: %s Failed", storagePath);
+
+    int bootstrapFromCheckpoint = (NULL != bcs->headerStore &&
+                                   ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStoreIsEmpty (bcs->headerStore)));
+
+    // Initialize blocks from the header store, if not empty; the store supersedes saved blocks.
+    // Otherwise, initialize from saved blocks.
+    if (NULL != bcs->headerStore && !bootstrapFromCheckpoint) {
+        if (NULL != blocks) BRSetFreeAll (blocks, (void (*) (void*)) blockRelease);
+        bcsCreateInitializeBlocksFromStore (bcs);
+    }
+    else bcsCreateInitializeBlocks(bcs, blocks);
+
+    // Initialize transactions and logs from saved state.
     bcsCreateInitializeTransactions(bcs, transactions);
     bcsCreateInitializeLogs(bcs, logs);
 
@@ -256,10 +336,15 @@ bcsCreate (BREthereumNetwork network,
     UInt256 totalDifficulty = blockRecursivelyPropagateTotalDifficulty (bcs->chain);
     BREthereumBlockHeader chainHeader = blockGetHeader (bcs->chain);
 
-    // Okay, we tried to get totalDifficulty - if it failed, fallback to a checkpoint.
-    if (ETHEREUM_BOOLEAN_IS_FALSE (blockHasTotalDifficulty(bcs->chain))) {
+    // Okay, we tried to get totalDifficulty - if it failed, fallback to a checkpoint.  With an
+    // empty header store, bootstrap from the latest checkpoint, at the store's base, unless the
+    // saved blocks already reach it; then they'll be stored as they age.
+    if (ETHEREUM_BOOLEAN_IS_FALSE (blockHasTotalDifficulty(bcs->chain)) ||
+        (bootstrapFromCheckpoint && blockGetNumber(bcs->chain) < bcsHeaderStoreGetNumberBase (bcs->headerStore))) {
         const BREthereumBlockCheckpoint *checkpoint =
-        blockCheckpointLookupByNumber (bcs->network, blockGetNumber(bcs->chain));
+        blockCheckpointLookupByNumber (bcs->network, (bootstrapFromCheckpoint
+                                                      ? bcsHeaderStoreGetNumberBase (bcs->headerStore)
+                                                      : blockGetNumber(bcs->chain)));
 
         totalDifficulty = checkpoint->u.td;
         chainHeader = blockCheckpointCreatePartialBlockHeader(checkpoint);
@@ -288,6 +373,8 @@ bcsCreate (BREthereumNetwork network,
                           discoverNodes,
                           handleSync);
 
+    proofOfWorkSetHead (bcs->pow, blockHeaderGetNumber(chainHeader));
+
     if (chainHeader != blockGetHeader(bcs->chain))
         blockHeaderRelease(chainHeader);
 
@@ -298,8 +385,6 @@ bcsCreate (BREthereumNetwork network,
                                bcs->les,
                                bcs->handler);
 
-    bcs->pow = proofOfWorkCreate();
-
     return bcs;
 }
 
@@ -335,6 +420,13 @@ bcsDestroy (BREthereumBCS bcs) {
     bcsSyncRelease(bcs->sync);
     proofOfWorkRelease(bcs->pow);
 
+    // Store what we can of `chain`; then close the store.
+    if (NULL != bcs->headerStore) {
+        bcsStoreBlocks (bcs);
+        bcsHeaderStoreRelease (bcs->headerStore);
+        bcs->headerStore = NULL;
+    }
+
     // TODO: We'll need to announce things to our `listener`
 
     // Headers
@@ -343,6 +435,9 @@ bcsDestroy (BREthereumBCS bcs) {
     // Orphans (All are in 'blocks') so don't release the block.
     BRSetFree (bcs->orphans);
 
+    // Pending blocks are in 'blocks' too.
+    array_free (bcs->pendingBlocks);
+
     // Transaction
     BRSetFreeAll (bcs->transactions, (void (*) (void*)) transactionRelease);
 
@@ -365,6 +460,14 @@ bcsClean (BREthereumBCS bcs) {
     if (NULL != bcs->les) lesClean (bcs->les);
 }
 
+extern BREthereumBlockHeader
+bcsGetStoredBlockHeader (BREthereumBCS bcs,
+                         uint64_t blockNumber) {
+    return (NULL == bcs->headerStore
+            ? NULL
+            : bcsHeaderStoreGet (bcs->headerStore, blockNumber, NULL));
+}
+
 static void
 bcsSyncRange (BREthereumBCS bcs,
               BREthereumNodeReference node,
@@ -736,8 +839,56 @@ bcsSaveBlocks (BREthereumBCS bcs) {
             blockGetNumber(blockGetNext(bcs->chain)));
 }
 
+/**
+ * Put `chain` blocks, at least BCS_REORG_LIMIT deep, to the header store.  Walk `chain` from its
+ * head only until reaching blocks already stored.
+ */
+static void
+bcsStoreBlocks (BREthereumBCS bcs) {
+    if (NULL == bcs->headerStore || NULL == bcs->chain) return;
+
+    uint64_t chainBlockNumber = blockGetNumber (bcs->chain);
+    if (chainBlockNumber < BCS_REORG_LIMIT) return;
+
+    uint64_t storeNumberLimit = chainBlockNumber - BCS_REORG_LIMIT;
+    uint64_t storeNumberHead  = (ETHEREUM_BOOLEAN_IS_TRUE (bcsHeaderStoreIsEmpty (bcs->headerStore))
+                                 ? 0
+                                 : bcsHeaderStoreGetNumberHead (bcs->headerStore));
+
+    BRArrayOf(BREthereumBlock) blocks;
+    array_new (blocks, 2 * BCS_REORG_LIMIT);
+
+    for (BREthereumBlock block = bcs->chain; NULL != block; block = blockGetNext (block)) {
+        uint64_t blockNumber = blockGetNumber (block);
+        if (0 != storeNumberHead && blockNumber <= storeNumberHead) break;
+
+        if (blockNumber <= storeNumberLimit) array_add (blocks, block);
+        if (block == bcs->chainTail) break;
+    }
+
+    // Store ascending, so that the store's head only advances.
+    for (size_t index = array_count (blocks); index > 0; index--) {
+        BREthereumBlock block = blocks[index - 1];
+        bcsHeaderStorePut (bcs->headerStore,
+                           blockGetHeader (block),
+                           (ETHEREUM_BOOLEAN_IS_TRUE (blockHasTotalDifficulty (block))
+                            ? blockGetTotalDifficulty (block)
+                            : UINT256_ZERO));
+    }
+
+    if (array_count (blocks) > 1)
+        eth_log("BCS", "Blocks {%" PRIu64 ", %" PRIu64 "} Stored",
+                blockGetNumber (blocks[array_count (blocks) - 1]),
+                blockGetNumber (blocks[0]));
+
+    array_free (blocks);
+}
+
 static void
 bcsReclaimAndSaveBlocksIfAppropriate (BREthereumBCS bcs) {
+    // With a header store, store blocks now, as they age, so that reclaimed blocks are stored.
+    bcsStoreBlocks (bcs);
+
     uint64_t chainBlockNumber = blockGetNumber(bcs->chain);
     uint64_t chainBlockLength = chainBlockNumber - blockGetNumber(bcs->chainTail);
 
@@ -766,7 +917,9 @@ bcsReclaimAndSaveBlocksIfAppropriate (BREthereumBCS bcs) {
                 thisBlockNumber,
                 reclaimFromBlockNumber - 1);
 
-        bcsSaveBlocks(bcs);
+        // Without a header store, save the remaining `chain` blocks with our `listener`.
+        if (NULL == bcs->headerStore)
+            bcsSaveBlocks(bcs);
     }
 }
 
@@ -782,6 +935,7 @@ bcsExtendChain (BREthereumBCS bcs,
 
     blockSetNext(block, bcs->chain);
     bcs->chain = block;
+    proofOfWorkSetHead (bcs->pow, blockGetNumber(block));
 
     eth_log("BCS", "Block %" PRIu64 " %s", blockGetNumber(block), message);
 
@@ -1059,6 +1213,14 @@ bcsIsBlockValid (BREthereumBCS bcs,
     return ETHEREUM_BOOLEAN_IS_TRUE (blockIsValid (block));
 }
 
+static int
+bcsIsBlockPending (BREthereumBCS bcs,
+                   BREthereumBlock block) {
+    for (size_t index = 0; index < array_count (bcs->pendingBlocks); index++)
+        if (block == bcs->pendingBlocks[index].block) return 1;
+    return 0;
+}
+
 /**
  * Extends `bcs->transactions` and `bcs->logs` with the tranactions and logs within `block`.
  * Requires `block` to be in 'complete' and in `bcs->chain`.
@@ -1085,8 +1247,9 @@ bcsExtendTransactionsAndLogsForBlock (BREthereumBCS bcs,
     // above calls to bcsHandle{Transaction,Log}()).
     blockReleaseStatus (block, ETHEREUM_BOOLEAN_FALSE, ETHEREUM_BOOLEAN_FALSE);
 
-    // If not in chain and not an orphan, then reclaim
-    if (bcs->chainTail != block && NULL == blockGetNext(block) && NULL == BRSetGet(bcs->orphans, block))
+    // If not in chain, not an orphan and not pending, then reclaim
+    if (bcs->chainTail != block && NULL == blockGetNext(block) && NULL == BRSetGet(bcs->orphans, block) &&
+        !bcsIsBlockPending (bcs, block))
         bcsReclaimBlock(bcs, block, 0);
 }
 
@@ -1124,17 +1287,32 @@ bcsExtendChainIfPossible (BREthereumBCS bcs,
     BREthereumHash blockParentHash = blockHeaderGetParentHash(blockGetHeader(block));
     BREthereumBlock blockParent = BRSetGet(bcs->blocks, &blockParentHash);
 
-    // If we have a parent, but `header` is inconsistent with its parent, then ignore `header`
-    if (NULL != blockParent &&
-        ETHEREUM_BOOLEAN_IS_FALSE (blockHeaderIsValid (blockGetHeader(block),
-                                                       blockGetHeader(blockParent),
-                                                       blockGetOmmersCount(blockParent),
-                                                       blockGetHeader(bcs->genesis),
-                                                       bcs->pow))) {
+    if (NULL != blockParent) {
+        // If the parent is pending, then `block` is too; it is validated once its parent is chained.
+        BREthereumBlockHeaderValidity validity = (bcsIsBlockPending (bcs, blockParent)
+                                                  ? BLOCK_HEADER_PENDING
+                                                  : blockHeaderValidate (blockGetHeader(block),
+                                                                         blockGetHeader(blockParent),
+                                                                         blockGetOmmersCount(blockParent),
+                                                                         blockGetHeader(bcs->genesis),
+                                                                         bcs->pow));
+        switch (validity) {
+            case BLOCK_HEADER_VALID:
+                break;
+
+            // If `header` awaits its proof-of-work, then hold `header` until the PoW cache is ready.
+            case BLOCK_HEADER_PENDING: {
+                BREthereumBCSPendingBlock pending = { block, node, isFromSync };
+                array_add (bcs->pendingBlocks, pending);
+                return;
+            }
 
-        eth_log("BCS", "Block %" PRIu64 " Inconsistent", blockGetNumber(block));
-        // TODO: Can we release `block`?
-        return;
+            // If we have a parent, but `header` is inconsistent with its parent, then ignore `header`
+            case BLOCK_HEADER_INVALID:
+                eth_log("BCS", "Block %" PRIu64 " Inconsistent", blockGetNumber(block));
+                // TODO: Can we release `block`?
+                return;
+        }
     }
 
     // Put `header` in the `chain` - HANDLE 3 CASES:
@@ -1198,6 +1376,7 @@ bcsExtendChainIfPossible (BREthereumBCS bcs,
             // Adopt `block` as `chain`
             bcs->chain = bcs->chainTail = block;
             blockClrNext(block);
+            proofOfWorkSetHead (bcs->pow, blockGetNumber(block));
             eth_log("BCS", "Block %" PRIu64 " Chained (Sync)", blockGetNumber(block));
         }
     }
@@ -1248,6 +1427,26 @@ bcsExtendChainIfPossible (BREthereumBCS bcs,
     bcsReclaimAndSaveBlocksIfAppropriate (bcs);
 }
 
+/**
+ * Extend the chain with the pending blocks, in arrival order.  A block whose proof-of-work cache
+ * is still not ready, or whose parent is still pending, is pending again.
+ */
+static void
+bcsExtendChainWithPendingBlocks (BREthereumBCS bcs) {
+    if (0 == array_count (bcs->pendingBlocks)) return;
+
+    BRArrayOf(BREthereumBCSPendingBlock) pendingBlocks = bcs->pendingBlocks;
+    array_new (bcs->pendingBlocks, array_count (pendingBlocks));
+
+    for (size_t index = 0; index < array_count (pendingBlocks); index++)
+        bcsExtendChainIfPossible (bcs,
+                                  pendingBlocks[index].node,
+                                  pendingBlocks[index].block,
+                                  pendingBlocks[index].isFromSync);
+
+    array_free (pendingBlocks);
+}
+
 /// MARK: - Block Header
 
 static BREthereumBoolean
@@ -1257,10 +1456,23 @@ bcsBlockHasMatchingTransactions (BREthereumBCS bcs,
     // return ETHEREUM_BOOLEAN_FALSE;
 }
 
-static BREthereumBoolean
-bcsBlockHasMatchingLogs (BREthereumBCS bcs,
-                         BREthereumBlock block) {
-    return blockHeaderMatch (blockGetHeader (block), bcs->filterForAddressOnLogs);
+/**
+ * Check a batch of headers for logs of interest, filling `matches` with 1 for each header whose
+ * logsBloom matches.  All headers are checked at once, ahead of handling each header.
+ */
+static void
+bcsBlockHeadersHaveMatchingLogs (BREthereumBCS bcs,
+                                 BRArrayOf(BREthereumBlockHeader) headers,
+                                 uint8_t *matches) {
+    size_t count = array_count (headers);
+    if (0 == count) return;
+
+    BREthereumBloomFilter *filters = malloc (count * sizeof (BREthereumBloomFilter));
+    for (size_t index = 0; index < count; index++)
+        filters[index] = blockHeaderGetLogsBloom (headers[index]);
+
+    bloomFilterMatchAny (filters, count, &bcs->filterForAddressOnLogs, 1, matches);
+    free (filters);
 }
 
 static BREthereumBoolean
@@ -1283,6 +1495,7 @@ bcsHandleBlockHeaderInternal (BREthereumBCS bcs,
                               BREthereumNodeReference node,
                               OwnershipGiven BREthereumBlockHeader header,
                               int isFromSync,
+                              BREthereumBoolean hasMatchingLogs,
                               BRArrayOf(BREthereumHash) *bodiesHashes,
                               BRArrayOf(BREthereumHash) *receiptsHashes,
                               BRArrayOf(BREthereumHash) *accountsHashes,
@@ -1312,7 +1525,7 @@ bcsHandleBlockHeaderInternal (BREthereumBCS bcs,
     BRSetAdd(bcs->blocks, block);
 
     // Check if we need 'transaction receipts', 'block bodies', 'account state' or a 'header proof'.
-    // We'll use the header's logsBloom for the recipts check; we've got nothing in the header to
+    // We've used the header's logsBloom for the recipts check, as `hasMatchingLogs`; we've got nothing in the header to
     // check for needing bodies nor for needing account state.  We'll get block bodies by default
     // and avoid account state (getting account state might allow us to avoid getting block bodies;
     // however, the client cost to get the account state is ~2.5 times more then getting block
@@ -1320,7 +1533,7 @@ bcsHandleBlockHeaderInternal (BREthereumBCS bcs,
     // proof' occassionally so that we can build on the block chain's total difficulty and
     // ultimately our Proof-of-Work validations.
     BREthereumBoolean needBodies   = bcsBlockHasMatchingTransactions(bcs, block);
-    BREthereumBoolean needReceipts = bcsBlockHasMatchingLogs(bcs, block);
+    BREthereumBoolean needReceipts = hasMatchingLogs;
     BREthereumBoolean needAccount  = bcsBlockNeedsAccountState(bcs, block);
     BREthereumBoolean needProof    = bcsBlockNeedsHeaderProof(bcs, block);
 
@@ -1363,6 +1576,9 @@ bcsHandleBlockHeaderInternal (BREthereumBCS bcs,
     //
     // TODO: What if the header is well into the past - like during a sync?
     bcsExtendChainIfPossible(bcs, node, block, isFromSync);
+
+    if (bcsIsBlockPending (bcs, block))
+        eth_log("BCS", "Block %" PRIu64 " Pending PoW", blockGetNumber(block));
 }
 
 static void
@@ -1375,16 +1591,25 @@ bcsHandleBlockHeaders (BREthereumBCS bcs,
     BRArrayOf(BREthereumHash) accountsHashes = NULL;
     BRArrayOf(uint64_t) proofNumbers = NULL;
 
+    // Chain any pending blocks whose proof-of-work is now ready, ahead of their descendants.
+    bcsExtendChainWithPendingBlocks (bcs);
+
+    // Match all the headers' logsBloom at once; a sync can deliver thousands of headers.
+    uint8_t *hasMatchingLogs = calloc (array_count(headers) > 0 ? array_count(headers) : 1, sizeof (uint8_t));
+    bcsBlockHeadersHaveMatchingLogs (bcs, headers, hasMatchingLogs);
+
     for (size_t index = 0; index < array_count(headers); index++)
         // Each `headers[index]` has 'OwnershipGiven'
         bcsHandleBlockHeaderInternal (bcs, node,
                                       headers[index],
                                       isFromSync,
+                                      AS_ETHEREUM_BOOLEAN (hasMatchingLogs[index]),
                                       &bodiesHashes,
                                       &receiptsHashes,
                                       &accountsHashes,
                                       &proofNumbers);
 
+    free (hasMatchingLogs);
     array_free(headers);
 
     if (NULL != bodiesHashes && array_count(bodiesHashes) > 0)
@@ -2037,6 +2262,9 @@ bcsPeriodicDispatcher (BREventHandler handler,
     // TODO: Avoid-ish a race condition on bcsRelease. This is the wrong approach.
     if (NULL == bcs->les) return;
 
+    // Chain any pending blocks whose proof-of-work is now ready.
+    bcsExtendChainWithPendingBlocks (bcs);
+
     // If nothing to do; simply skip out.
     if ((NULL == bcs->pendingTransactions || 0 == array_count (bcs->pendingTransactions)) &&
         (NULL == bcs->pendingLogs         || 0 == array_count (bcs->pendingLogs)))
@@ -163,6 +163,10 @@ typedef struct {
  * focused on the `account` primary address.  Initialize the synchronization with the previously
  * saved `headers`.  Provide `listener` to anounce BCS 'events'.
  *
+ * If `storagePath` is not NULL, BCS keeps a header store in that directory.  Chained blocks are
+ * stored as they age and the chain is initialized from the store, superseding `blocks`; the
+ * `saveBlocksCallback` is not used.  An empty store starts from the network's latest checkpoint.
+ *
  * @parameters
  * @parameter headers - is this a BRArray; assume so for now.
  */
@@ -171,6 +175,7 @@ bcsCreate (BREthereumNetwork network,
            BREthereumAddress address,
            BREthereumBCSListener listener,
            BRCryptoSyncMode syncMode,
+           const char *storagePath,
            BRSetOf(BREthereumNodeConfig) peers,
            BRSetOf(BREthereumBlock) blocks,
            BRSetOf(BREthereumTransaction) transactions,
@@ -194,6 +199,15 @@ bcsDestroy (BREthereumBCS bcs);
 extern void
 bcsClean (BREthereumBCS bcs);
 
+/**
+ * Get the header at `blockNumber` from the header store, reading it from disk.  Returns NULL if
+ * there is no header store or no stored header at `blockNumber`; recent headers are not stored
+ * until they are BCS_REORG_LIMIT deep in the chain.
+ */
+extern OwnershipGiven BREthereumBlockHeader
+bcsGetStoredBlockHeader (BREthereumBCS bcs,
+                         uint64_t blockNumber);
+
 
 /**
  * Start a sync from block number.  If a sync is in progress, then it is stopped.  This function
@@ -0,0 +1,348 @@
+//
+//  BREthereumBCSHeaderStore.c
+//  Core
+//
+//  Copyright © 2026 Breadwinner AG.  All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "support/BRInt.h"
+#include "BREthereumBCSPrivate.h"
+
+/**
+ * The Header Store holds block headers, with their total difficulty, indexed by block number.
+ * There are two files in the store's directory:
+ *
+ *   'headers' - the records; each record is a 4 byte (LE) length followed by the RLP encoding of
+ *      a list of {header, totalDifficulty}.  Records are only ever appended; a header that is
+ *      put again (at the same number) is appended and the prior record is abandoned.
+ *
+ *   'index' - a 32 byte preamble of {magic, chainId, base number, 'headers' size} and then, for
+ *      each number from the base number, an 8 byte (LE) record offset plus one.  An offset of zero
+ *      marks a missing header; a sync can leave gaps in the chain.
+ *
+ * The base number is the network's latest checkpoint when the store is created; headers before
+ * the base are never stored.  Thus the store size is bounded by the blocks since the checkpoint,
+ * not by the blocks since genesis.
+ *
+ * A put writes the record, syncs 'headers' to storage, then writes the 'headers' size in the
+ * preamble and then the index entry.  Thus a stored size never covers a record that is not in
+ * storage.  On open, 'headers' is truncated to the preamble's size, dropping any torn record, and
+ * index entries are only ever read if they reference a complete record.
+ */
+#define HEADER_STORE_MAGIC                "BRDETHHS"
+#define HEADER_STORE_PREAMBLE_SIZE        (32)
+#define HEADER_STORE_INDEX_ENTRY_SIZE     (8)
+#define HEADER_STORE_RECORD_LENGTH_SIZE   (4)
+
+#define HEADER_STORE_RECORD_LENGTH_LIMIT  (4 * 1024)
+
+struct BREthereumBCSHeaderStoreStruct {
+    BREthereumNetwork network;
+
+    int headersFile;
+    int indexFile;
+
+    /// The committed size of `headersFile`; the offset for the next record
+    uint64_t headersSize;
+
+    /// The first number in the index; the number of index entries.  The last entry is never
+    /// missing; it is the highest number stored.
+    uint64_t numberBase;
+    uint64_t numberCount;
+
+    BRRlpCoder coder;
+    pthread_mutex_t lock;
+};
+
+static int
+headerStoreReadFully (int file, void *bytes, size_t bytesCount, uint64_t offset) {
+    while (bytesCount > 0) {
+        ssize_t count = pread (file, bytes, bytesCount, (off_t) offset);
+        if (count <= 0) return 0;
+        bytes = (uint8_t *) bytes + count;
+        bytesCount -= (size_t) count;
+        offset += (uint64_t) count;
+    }
+    return 1;
+}
+
+static int
+headerStoreWriteFully (int file, const void *bytes, size_t bytesCount, uint64_t offset) {
+    while (bytesCount > 0) {
+        ssize_t count = pwrite (file, bytes, bytesCount, (off_t) offset);
+        if (count <= 0) return 0;
+        bytes = (const uint8_t *) bytes + count;
+        bytesCount -= (size_t) count;
+        offset += (uint64_t) count;
+    }
+    return 1;
+}
+
+// Sync the file's data to storage; the file's metadata is only needed for its size, which is
+// committed in the preamble.
+static int
+headerStoreSync (int file) {
+#if defined (__APPLE__)
+    return 0 == fsync (file);
+#else
+    return 0 == fdatasync (file);
+#endif
+}
+
+static uint64_t
+headerStoreReadIndexEntry (BREthereumBCSHeaderStore store,
+                           uint64_t number) {
+    uint8_t entry[HEADER_STORE_INDEX_ENTRY_SIZE];
+    return (headerStoreReadFully (store->indexFile, entry, sizeof (entry),
+                                  HEADER_STORE_PREAMBLE_SIZE + HEADER_STORE_INDEX_ENTRY_SIZE * (number - store->numberBase))
+            ? UInt64GetLE (entry)
+            : 0);
+}
+
+static int
+headerStoreWriteHeadersSize (BREthereumBCSHeaderStore store,
+                             uint64_t headersSize) {
+    uint8_t size[8];
+    UInt64SetLE (size, headersSize);
+    return headerStoreWriteFully (store->indexFile, size, sizeof (size), 24);
+}
+
+static int
+headerStoreWriteIndexEntry (BREthereumBCSHeaderStore store,
+                            uint64_t number,
+                            uint64_t value) {
+    uint8_t entry[HEADER_STORE_INDEX_ENTRY_SIZE];
+    UInt64SetLE (entry, value);
+    return headerStoreWriteFully (store->indexFile, entry, sizeof (entry),
+                                  HEADER_STORE_PREAMBLE_SIZE + HEADER_STORE_INDEX_ENTRY_SIZE * (number - store->numberBase));
+}
+
+// Check that the index entry references a complete record.
+static int
+headerStoreIndexEntryIsValid (BREthereumBCSHeaderStore store,
+                              uint64_t entry) {
+    if (0 == entry) return 0;
+
+    uint64_t offset = entry - 1;
+    uint8_t length[HEADER_STORE_RECORD_LENGTH_SIZE];
+
+    return (offset + HEADER_STORE_RECORD_LENGTH_SIZE <= store->headersSize &&
+            headerStoreReadFully (store->headersFile, length, sizeof (length), offset) &&
+            offset + HEADER_STORE_RECORD_LENGTH_SIZE + UInt32GetLE (length) <= store->headersSize);
+}
+
+static int
+headerStoreOpenFile (const char *path, const char *name) {
+    char filename[strlen (path) + 1 + strlen (name) + 1];
+    sprintf (filename, "%s/%s", path, name);
+    return open (filename, O_RDWR | O_CREAT, 0644);
+}
+
+extern BREthereumBCSHeaderStore
+bcsHeaderStoreCreate (const char *path,
+                      BREthereumNetwork network) {
+    // Ensure the directory exists.
+    if (0 != mkdir (path, 0700) && EEXIST != errno) return NULL;
+
+    int headersFile = headerStoreOpenFile (path, "headers");
+    int indexFile   = headerStoreOpenFile (path, "index");
+    if (-1 == headersFile || -1 == indexFile) {
+        if (-1 != headersFile) close (headersFile);
+        if (-1 != indexFile)   close (indexFile);
+        return NULL;
+    }
+
+    BREthereumBCSHeaderStore store = calloc (1, sizeof (struct BREthereumBCSHeaderStoreStruct));
+
+    store->network     = network;
+    store->headersFile = headersFile;
+    store->indexFile   = indexFile;
+    store->coder       = rlpCoderCreate();
+
+    pthread_mutex_init (&store->lock, NULL);
+
+    struct stat indexStat;
+    fstat (indexFile, &indexStat);
+
+    uint8_t preamble[HEADER_STORE_PREAMBLE_SIZE];
+    uint64_t chainId = (uint64_t) ethNetworkGetChainId (network);
+
+    // An existing index must be for `network`; otherwise start over.
+    int isValid = (indexStat.st_size >= HEADER_STORE_PREAMBLE_SIZE &&
+                   headerStoreReadFully (indexFile, preamble, sizeof (preamble), 0) &&
+                   0 == memcmp (preamble, HEADER_STORE_MAGIC, 8) &&
+                   chainId == UInt64GetLE (&preamble[8]));
+
+    if (isValid) {
+        store->numberBase  = UInt64GetLE (&preamble[16]);
+        store->headersSize = UInt64GetLE (&preamble[24]);
+        store->numberCount = ((uint64_t) indexStat.st_size - HEADER_STORE_PREAMBLE_SIZE) / HEADER_STORE_INDEX_ENTRY_SIZE;
+
+        // Drop head entries that are missing or torn.
+        while (store->numberCount > 0 &&
+               !headerStoreIndexEntryIsValid (store, headerStoreReadIndexEntry (store, store->numberBase + store->numberCount - 1)))
+            store->numberCount--;
+
+        if (0 != ftruncate (headersFile, (off_t) store->headersSize) ||
+            0 != ftruncate (indexFile,   (off_t) (HEADER_STORE_PREAMBLE_SIZE + HEADER_STORE_INDEX_ENTRY_SIZE * store->numberCount))) {
+            bcsHeaderStoreRelease (store);
+            return NULL;
+        }
+    }
+    else {
+        // Bootstrap the store at the latest checkpoint; some networks have none.
+        const BREthereumBlockCheckpoint *checkpoint = blockCheckpointLookupByNumber (network, UINT64_MAX);
+
+        store->headersSize = 0;
+        store->numberBase  = (NULL == checkpoint ? 0 : checkpoint->number);
+        store->numberCount = 0;
+
+        memcpy (preamble, HEADER_STORE_MAGIC, 8);
+        UInt64SetLE (&preamble[ 8], chainId);
+        UInt64SetLE (&preamble[16], store->numberBase);
+        UInt64SetLE (&preamble[24], store->headersSize);
+
+        if (0 != ftruncate (headersFile, 0) ||
+            0 != ftruncate (indexFile,   0) ||
+            !headerStoreWriteFully (indexFile, preamble, sizeof (preamble), 0)) {
+            bcsHeaderStoreRelease (store);
+            return NULL;
+        }
+    }
+
+    eth_log ("BCS", "Header Store: {%" PRIu64 ", %" PRIu64 "} Opened",
+             store->numberBase,
+             store->numberBase + store->numberCount);
+
+    return store;
+}
+
+extern void
+bcsHeaderStoreRelease (BREthereumBCSHeaderStore store) {
+    pthread_mutex_lock (&store->lock);
+    close (store->headersFile);
+    close (store->indexFile);
+    rlpCoderRelease (store->coder);
+    pthread_mutex_unlock (&store->lock);
+
+    pthread_mutex_destroy (&store->lock);
+
+    memset (store, 0, sizeof (struct BREthereumBCSHeaderStoreStruct));
+    free (store);
+}
+
+extern BREthereumBoolean
+bcsHeaderStoreIsEmpty (BREthereumBCSHeaderStore store) {
+    pthread_mutex_lock (&store->lock);
+    BREthereumBoolean isEmpty = AS_ETHEREUM_BOOLEAN (0 == store->numberCount);
+    pthread_mutex_unlock (&store->lock);
+    return isEmpty;
+}
+
+extern uint64_t
+bcsHeaderStoreGetNumberBase (BREthereumBCSHeaderStore store) {
+    return store->numberBase;
+}
+
+extern uint64_t
+bcsHeaderStoreGetNumberHead (BREthereumBCSHeaderStore store) {
+    pthread_mutex_lock (&store->lock);
+    uint64_t numberHead = (0 == store->numberCount ? 0 : store->numberBase + store->numberCount - 1);
+    pthread_mutex_unlock (&store->lock);
+    return numberHead;
+}
+
+extern BREthereumBoolean
+bcsHeaderStorePut (BREthereumBCSHeaderStore store,
+                   BREthereumBlockHeader header,
+                   UInt256 totalDifficulty) {
+    uint64_t number = blockHeaderGetNumber (header);
+    if (number < store->numberBase) return ETHEREUM_BOOLEAN_FALSE;
+
+    pthread_mutex_lock (&store->lock);
+
+    BRRlpItem item = rlpEncodeList2 (store->coder,
+                                     blockHeaderRlpEncode (header, ETHEREUM_BOOLEAN_TRUE, RLP_TYPE_ARCHIVE, store->coder),
+                                     rlpEncodeUInt256 (store->coder, totalDifficulty, 0));
+    BRRlpData data = rlpItemGetDataSharedDontRelease (store->coder, item);
+
+    uint64_t offset = store->headersSize;
+    uint8_t length[HEADER_STORE_RECORD_LENGTH_SIZE];
+    UInt32SetLE (length, (uint32_t) data.bytesCount);
+
+    uint64_t headersSize = offset + sizeof (length) + data.bytesCount;
+
+    // Write the record, sync it, commit it, then index it.
+    int success = (headerStoreWriteFully (store->headersFile, length, sizeof (length), offset) &&
+                   headerStoreWriteFully (store->headersFile, data.bytes, data.bytesCount, offset + sizeof (length)) &&
+                   headerStoreSync (store->headersFile) &&
+                   headerStoreWriteHeadersSize (store, headersSize));
+    if (success) store->headersSize = headersSize;
+
+    success = success && headerStoreWriteIndexEntry (store, number, offset + 1);
+
+    rlpItemRelease (store->coder, item);
+
+    if (success) {
+        if (number >= store->numberBase + store->numberCount)
+            store->numberCount = number - store->numberBase + 1;
+    }
+
+    pthread_mutex_unlock (&store->lock);
+    return AS_ETHEREUM_BOOLEAN (success);
+}
+
+extern BREthereumBlockHeader
+bcsHeaderStoreGet (BREthereumBCSHeaderStore store,
+                   uint64_t number,
+                   UInt256 *totalDifficulty) {
+    BREthereumBlockHeader header = NULL;
+
+    pthread_mutex_lock (&store->lock);
+
+    if (number >= store->numberBase && number < store->numberBase + store->numberCount) {
+        uint64_t entry = headerStoreReadIndexEntry (store, number);
+
+        uint8_t length[HEADER_STORE_RECORD_LENGTH_SIZE];
+        if (headerStoreIndexEntryIsValid (store, entry) &&
+            headerStoreReadFully (store->headersFile, length, sizeof (length), entry - 1) &&
+            UInt32GetLE (length) <= HEADER_STORE_RECORD_LENGTH_LIMIT) {
+
+            uint8_t bytes[HEADER_STORE_RECORD_LENGTH_LIMIT];
+            BRRlpData data = { UInt32GetLE (length), bytes };
+
+            if (headerStoreReadFully (store->headersFile, data.bytes, data.bytesCount, entry - 1 + sizeof (length))) {
+                BRRlpItem item = rlpDataGetItem (store->coder, data);
+
+                size_t itemsCount;
+                const BRRlpItem *items = rlpDecodeList (store->coder, item, &itemsCount);
+
+                if (2 == itemsCount) {
+                    header = blockHeaderRlpDecode (items[0], RLP_TYPE_ARCHIVE, store->coder);
+                    if (NULL != totalDifficulty) *totalDifficulty = rlpDecodeUInt256 (store->coder, items[1], 0);
+                }
+                rlpItemRelease (store->coder, item);
+            }
+        }
+    }
+
+    pthread_mutex_unlock (&store->lock);
+
+    // Never return a header from some other number.
+    if (NULL != header && number != blockHeaderGetNumber (header)) {
+        blockHeaderRelease (header);
+        header = NULL;
+    }
+
+    return header;
+}
@@ -62,6 +62,20 @@ extern "C" {
  */
 typedef struct BREthereumBCSSyncStruct *BREthereumBCSSync;
 
+/**
+ * A persistent store of block headers, indexed by block number.
+ */
+typedef struct BREthereumBCSHeaderStoreStruct *BREthereumBCSHeaderStore;
+
+/**
+ * A block awaiting its proof-of-work, along with what is needed to extend the chain with it.
+ */
+typedef struct {
+    BREthereumBlock block;
+    BREthereumNodeReference node;
+    int isFromSync;
+} BREthereumBCSPendingBlock;
+
 /// MARK: - typedef BCS
 
 //
@@ -142,6 +156,13 @@ struct BREthereumBCSStruct {
      */
     BREthereumBlock chainTail;
 
+    /**
+     * The store of chained block headers, or NULL if BCS was created w/o a storage path.  Blocks
+     * are put to the store once they are BCS_REORG_LIMIT deep in `chain`; `chain` itself holds
+     * only a window of recent blocks.  On create, the window is restored from the store.
+     */
+    BREthereumBCSHeaderStore headerStore;
+
     /**
      * A BRSet of orphaned block headers.  These are block headers that 'conflict' with
      * chained headers.  An orphan is a previously chained header that was replaced by a
@@ -151,6 +172,14 @@ struct BREthereumBCSStruct {
      */
     BRSetOf(BREthereumBlock) orphans;
 
+    /**
+     * A BRArray of blocks, in arrival order, consistent with their parent but with a
+     * proof-of-work that awaits the cache for the block's epoch, and of blocks descending from
+     * those.  They are in `blocks` but neither chained nor orphaned.  Once the cache is ready,
+     * see bcsExtendChainWithPendingBlocks(), each is validated again and the chain extended.
+     */
+    BRArrayOf(BREthereumBCSPendingBlock) pendingBlocks;
+
     /**
      * A BRArray of hashes for pending transactions.  A transaction is 'pending' if it's
      * status is not 'INCLUDED' nor 'ERRORED'.  When pending, BCS will periodically (see
@@ -375,6 +404,46 @@ bcsSyncSignalProvision (BREthereumBCSSyncRange range,
                         BREthereumNodeReference node,
                         BREthereumProvisionResult result);
 
+//
+// Header Store
+//
+extern BREthereumBCSHeaderStore
+bcsHeaderStoreCreate (const char *path,
+                      BREthereumNetwork network);
+
+extern void
+bcsHeaderStoreRelease (BREthereumBCSHeaderStore store);
+
+extern BREthereumBoolean
+bcsHeaderStoreIsEmpty (BREthereumBCSHeaderStore store);
+
+extern uint64_t
+bcsHeaderStoreGetNumberBase (BREthereumBCSHeaderStore store);
+
+/**
+ * The highest block number stored.  Only meaningful if the store is not empty.
+ */
+extern uint64_t
+bcsHeaderStoreGetNumberHead (BREthereumBCSHeaderStore store);
+
+/**
+ * Put `header`, replacing any header already stored at its number.  Returns FALSE if `header`
+ * precedes the store's base number or if the write failed.
+ */
+extern BREthereumBoolean
+bcsHeaderStorePut (BREthereumBCSHeaderStore store,
+                   BREthereumBlockHeader header,
+                   UInt256 totalDifficulty);
+
+/**
+ * Get the header stored at `number`, reading it from disk, and fill `totalDifficulty`.  Returns
+ * NULL if there is no header at `number`.
+ */
+extern OwnershipGiven BREthereumBlockHeader
+bcsHeaderStoreGet (BREthereumBCSHeaderStore store,
+                   uint64_t number,
+                   UInt256 *totalDifficulty);
+
 #ifdef __cplusplus
 }
 #endif
@@ -270,6 +270,11 @@ blockHeaderGetMixHash (BREthereumBlockHeader header) {
     return header->mixHash;
 }
 
+extern BREthereumBloomFilter
+blockHeaderGetLogsBloom (BREthereumBlockHeader header) {
+    return header->logsBloom;
+}
+
 extern uint64_t
 blockHeaderGetNonce (BREthereumBlockHeader header) {
     return header->nonce;
@@ -480,7 +485,7 @@ blockHeaderValidatePoWNFactor (BREthereumBlockHeader this,
     return 0 == overflow; /* || result == 2^256 */
 }
 
-static int
+static BREthereumBlockHeaderValidity
 blockHeaderValidateAll (BREthereumBlockHeader this,
                         BREthereumBlockHeader parent,
                         size_t parentOmmersCount,
@@ -491,18 +496,29 @@ blockHeaderValidateAll (BREthereumBlockHeader this,
     UInt256 n = UINT256_ZERO;
     BREthereumHash m = EMPTY_HASH_INIT;
 
-    if (NULL != pow)
-        proofOfWorkCompute (pow, this, &n, &m);
+    if (!(blockHeaderValidateTimestamp  (this, parent) &&
+          blockHeaderValidateNumber     (this, parent) &&
+          blockHeaderValidateGasLimit   (this, parent) &&
+          blockHeaderValidateGasUsed    (this, parent) &&
+          // TODO: Disabled, see CORE-203 (parentOmmersCount isn't correct if non-zero).
+          // blockHeaderValidateDifficulty (this, parent, parentOmmersCount, genesis) &&
+          blockHeaderValidateExtraData  (this, parent)))
+        return BLOCK_HEADER_INVALID;
+
+    if (NULL == pow) return BLOCK_HEADER_VALID;
+
+    // The proof-of-work is computed last, only for a header otherwise consistent with `parent`;
+    // if it can't be computed yet (no cache), the header is pending.
+    switch (proofOfWorkCompute (pow, this, &n, &m)) {
+        case PROOF_OF_WORK_PENDING:     return BLOCK_HEADER_PENDING;
+        case PROOF_OF_WORK_UNAVAILABLE: return BLOCK_HEADER_INVALID;
+        case PROOF_OF_WORK_COMPUTED:    break;
+    }
 
-    return (blockHeaderValidateTimestamp  (this, parent) &&
-            blockHeaderValidateNumber     (this, parent) &&
-            blockHeaderValidateGasLimit   (this, parent) &&
-            blockHeaderValidateGasUsed    (this, parent) &&
-            blockHeaderValidateExtraData  (this, parent) &&
-            // TODO: Disabled, see CORE-203 (parentOmmersCount isn't correct if non-zero).
-            // blockHeaderValidateDifficulty (this, parent, parentOmmersCount, genesis) &&
-            (NULL == pow || blockHeaderValidatePoWMixHash (this, m)) &&
-            (NULL == pow || blockHeaderValidatePoWNFactor (this, n)));
+    return (blockHeaderValidatePoWMixHash (this, m) &&
+            blockHeaderValidatePoWNFactor (this, n)
+            ? BLOCK_HEADER_VALID
+            : BLOCK_HEADER_INVALID);
 }
 
 extern BREthereumBoolean
@@ -510,20 +526,30 @@ blockHeaderIsInternallyValid (BREthereumBlockHeader header) {
     return ETHEREUM_BOOLEAN_TRUE;
 }
 
+extern BREthereumBlockHeaderValidity
+blockHeaderValidate (BREthereumBlockHeader header,
+                     BREthereumBlockHeader parent,
+                     size_t parentOmmersCount,
+                     BREthereumBlockHeader genesis,
+                     BREthereumProofOfWork pow) {
+
+//    // Hah! See CORE-203
+//    while (BLOCK_HEADER_INVALID == blockHeaderValidateAll (header, parent, parentOmmersCount, genesis, pow))
+//        parentOmmersCount += 1;
+
+    // See https://ethereum.github.io/yellowpaper/paper.pdf Section 4.3.3 'Block Header Validity
+    return (NULL == parent
+            ? BLOCK_HEADER_VALID
+            : blockHeaderValidateAll (header, parent, parentOmmersCount, genesis, pow));
+}
+
 extern BREthereumBoolean
 blockHeaderIsValid (BREthereumBlockHeader header,
                     BREthereumBlockHeader parent,
                     size_t parentOmmersCount,
                     BREthereumBlockHeader genesis,
                     BREthereumProofOfWork pow) {
-
-//    // Hah! See CORE-203
-//    while (0 == blockHeaderValidateAll (header, parent, parentOmmersCount, genesis, pow))
-//        parentOmmersCount += 1;
-
-    // See https://ethereum.github.io/yellowpaper/paper.pdf Section 4.3.3 'Block Header Validity
-    return AS_ETHEREUM_BOOLEAN (NULL == parent ||
-                                blockHeaderValidateAll (header, parent, parentOmmersCount, genesis, pow));
+    return AS_ETHEREUM_BOOLEAN (BLOCK_HEADER_VALID == blockHeaderValidate (header, parent, parentOmmersCount, genesis, pow));
 }
 
 //
@@ -560,10 +586,10 @@ blockHeaderRlpEncode (BREthereumBlockHeader header,
     return rlpEncodeListItems(coder, items, itemsCount);
 }
 
-extern BREthereumBlockHeader
-blockHeaderRlpDecode (BRRlpItem item,
-                      BREthereumRlpType type,
-                      BRRlpCoder coder) {
+static BREthereumBlockHeader
+blockHeaderRlpDecodeUnhashed (BRRlpItem item,
+                              BREthereumRlpType type,
+                              BRRlpCoder coder) {
     BREthereumBlockHeader header = (BREthereumBlockHeader) calloc (1, sizeof(struct BREthereumBlockHeaderRecord));
 
     size_t itemsCount = 0;
@@ -600,6 +626,15 @@ blockHeaderRlpDecode (BRRlpItem item,
     eth_log ("MEM", "Block Header Create RLP: %d", ++blockHeaderAllocCount);
 #endif
 
+    return header;
+}
+
+extern BREthereumBlockHeader
+blockHeaderRlpDecode (BRRlpItem item,
+                      BREthereumRlpType type,
+                      BRRlpCoder coder) {
+    BREthereumBlockHeader header = blockHeaderRlpDecodeUnhashed (item, type, coder);
+
     BRRlpData data = rlpItemGetDataSharedDontRelease(coder, item);
     header->hash = ethHashCreateFromData(data);
     // Safe to ignore data release.
@@ -608,6 +643,35 @@ blockHeaderRlpDecode (BRRlpItem item,
 
 }
 
+extern BRArrayOf (BREthereumBlockHeader)
+blockHeadersRlpDecode (BRRlpItem item,
+                       BREthereumRlpType type,
+                       BRRlpCoder coder) {
+    size_t itemsCount = 0;
+    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+
+    BRArrayOf (BREthereumBlockHeader) headers;
+    array_new (headers, itemsCount);
+
+    BRRlpData      *data   = calloc (itemsCount, sizeof (BRRlpData));
+    BREthereumHash *hashes = calloc (itemsCount, sizeof (BREthereumHash));
+
+    for (size_t index = 0; index < itemsCount; index++) {
+        array_add (headers, blockHeaderRlpDecodeUnhashed (items[index], type, coder));
+        data[index] = rlpItemGetDataSharedDontRelease (coder, items[index]);
+    }
+
+    // Hash all the headers together; shared data is safe to ignore.
+    ethHashCreateFromDataBatch (hashes, data, itemsCount);
+    for (size_t index = 0; index < itemsCount; index++)
+        headers[index]->hash = hashes[index];
+
+    free (hashes);
+    free (data);
+
+    return headers;
+}
+
 /// MARK: - Block
 
 //
@@ -943,21 +1007,7 @@ blockTransactionsRlpDecode (BRRlpItem item,
                             BREthereumNetwork network,
                             BREthereumRlpType type,
                             BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
-
-    BRArrayOf(BREthereumTransaction) transactions;
-    array_new(transactions, itemsCount);
-
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumTransaction transaction = transactionRlpDecode(items[i],
-                                                                     network,
-                                                                     type,
-                                                                     coder);
-        array_add (transactions, transaction);
-    }
-
-    return transactions;
+    return transactionsRlpDecode (item, network, type, coder);
 }
 
 static BRRlpItem
@@ -985,18 +1035,7 @@ blockOmmersRlpDecode (BRRlpItem item,
                       BREthereumNetwork network,
                       BREthereumRlpType type,
                       BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
-
-    BRArrayOf (BREthereumBlockHeader) headers;
-    array_new(headers, itemsCount);
-
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumBlockHeader header = blockHeaderRlpDecode(items[i], type, coder);
-        array_add (headers, header);
-    }
-
-    return headers;
+    return blockHeadersRlpDecode (item, type, coder);
 }
 
 //
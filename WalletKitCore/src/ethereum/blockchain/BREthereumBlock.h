@@ -67,6 +67,16 @@ blockHeaderRelease (BREthereumBlockHeader header);
 extern BREthereumBoolean
 blockHeaderIsInternallyValid (BREthereumBlockHeader header);
 
+/**
+ * The validity of a block header.  A header is PENDING if it is consistent with its parent but
+ * its ProofOfWork awaits the cache for its epoch; validate it again once the cache is ready.
+ */
+typedef enum {
+    BLOCK_HEADER_VALID,
+    BLOCK_HEADER_INVALID,
+    BLOCK_HEADER_PENDING
+} BREthereumBlockHeaderValidity;
+
 /**
  * Check if the block header is valid.  If `parent` is NULL, then `header` is consisder
  * consistent (we'll check again at some point once we have the parent).  If `pow` is provided
@@ -80,6 +90,18 @@ blockHeaderIsInternallyValid (BREthereumBlockHeader header);
  * @parem genesis
  * @param pow
  *
+ * @return the validity; BLOCK_HEADER_PENDING only if `pow` is provided
+ */
+extern BREthereumBlockHeaderValidity
+blockHeaderValidate (BREthereumBlockHeader header,
+                     BREthereumBlockHeader parent,
+                     size_t parentOmmersCount,
+                     BREthereumBlockHeader genesis,
+                     BREthereumProofOfWork pow);
+
+/**
+ * Check if the block header is valid, as blockHeaderValidate(); a PENDING header is not valid.
+ *
  * @return ETHEREUM_BOOLEAN_TRUE if consistent
  */
 extern BREthereumBoolean
@@ -94,6 +116,16 @@ blockHeaderRlpDecode (BRRlpItem item,
                       BREthereumRlpType type,
                       BRRlpCoder coder);
 
+/**
+ * Decode a list of headers, hashing them together (see ethHashCreateFromDataBatch()).
+ *
+ * Return BRArrayOf(BREthereumBlockHeader) w/ array owned by caller
+ */
+extern BRArrayOf (BREthereumBlockHeader)
+blockHeadersRlpDecode (BRRlpItem item,
+                       BREthereumRlpType type,
+                       BRRlpCoder coder);
+
 extern BRRlpItem
 blockHeaderRlpEncode (BREthereumBlockHeader header,
                       BREthereumBoolean withNonce,
@@ -121,6 +153,9 @@ blockHeaderGetParentHash (BREthereumBlockHeader header);
 extern BREthereumHash
 blockHeaderGetMixHash (BREthereumBlockHeader header);
 
+extern BREthereumBloomFilter
+blockHeaderGetLogsBloom (BREthereumBlockHeader header);
+
 extern BREthereumBoolean
 blockHeaderIsCHTRoot (BREthereumBlockHeader header);
 
@@ -569,17 +604,46 @@ blockFree (BREthereumBlock block);
 
 /// MARK: - Proof of Work
 
+/**
+ * Create a ProofOfWork for ethash verification.  If `storagePath` is not NULL, the per-epoch
+ * caches are stored, as 'ethash-<epoch>' files, in that directory.
+ */
 extern BREthereumProofOfWork
-proofOfWorkCreate (void);
+proofOfWorkCreate (const char *storagePath);
 
 extern void
 proofOfWorkRelease (BREthereumProofOfWork pow);
 
+/**
+ * Set the chain head's block number.  Headers are verified only within an epoch of the head's; a
+ * peer's header naming any other epoch is never verified, and so never evicts or queues a cache.
+ * The head's cache, and then the next epoch's, is queued for generation.
+ */
+extern void
+proofOfWorkSetHead (BREthereumProofOfWork pow,
+                    uint64_t number);
+
+/**
+ * Generate (or load) the cache for `header`'s epoch; blocks until the cache is ready.
+ */
 extern void
 proofOfWorkGenerate (BREthereumProofOfWork pow,
                      BREthereumBlockHeader header);
 
-extern void
+typedef enum {
+    PROOF_OF_WORK_COMPUTED,
+    PROOF_OF_WORK_PENDING,          // the epoch's cache is not ready; it is queued
+    PROOF_OF_WORK_UNAVAILABLE       // the epoch is not near the head's
+} BREthereumProofOfWorkResult;
+
+/**
+ * Compute the ethash result `n` and mix hash `m` for `header`.  Never blocks on a cache: if the
+ * cache for `header`'s epoch is not ready, it is queued for generation and PENDING is returned -
+ * compute again once it is ready.  Returns UNAVAILABLE for an epoch not near the head's; such a
+ * header is never verified.  For a proof-of-stake (zero difficulty) header, `n` is zero and `m`
+ * is empty and COMPUTED is returned.
+ */
+extern BREthereumProofOfWorkResult
 proofOfWorkCompute (BREthereumProofOfWork pow,
                     BREthereumBlockHeader header,
                     UInt256 *n,
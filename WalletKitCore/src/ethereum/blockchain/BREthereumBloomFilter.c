@@ -9,6 +9,7 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 #include "BREthereumBloomFilter.h"
 
@@ -89,9 +90,81 @@ bloomFilterEqual (const BREthereumBloomFilter filter1, const BREthereumBloomFilt
             : ETHEREUM_BOOLEAN_FALSE);
 }
 
+#define BLOOM_FILTER_WORDS   (ETHEREUM_BLOOM_FILTER_BYTES / sizeof (uint64_t))
+
+static inline uint64_t
+bloomFilterGetWord (const BREthereumBloomFilter *filter, size_t index) {
+    uint64_t word;
+    memcpy (&word, &filter->bytes[index * sizeof (uint64_t)], sizeof (uint64_t));
+    return word;
+}
+
 extern BREthereumBoolean
 bloomFilterMatch (const BREthereumBloomFilter filter, const BREthereumBloomFilter other) {
-    return bloomFilterEqual(filter, bloomFilterOr(filter, other));
+    // `other` is contained in `filter` if every bit of `other` is set in `filter`
+    uint64_t missing = 0;
+    for (size_t i = 0; i < BLOOM_FILTER_WORDS; i++)
+        missing |= bloomFilterGetWord (&other, i) & ~bloomFilterGetWord (&filter, i);
+    return AS_ETHEREUM_BOOLEAN (0 == missing);
+}
+
+/**
+ * A non-zero word from a bloom filter.  A filter for a hash has at most three bits set and thus
+ * at most three non-zero words; matching those words alone avoids scanning the full filter.
+ */
+typedef struct {
+    uint32_t index;
+    uint32_t other;
+    uint64_t mask;
+} BREthereumBloomFilterWord;
+
+extern size_t
+bloomFilterMatchAny (const BREthereumBloomFilter *filters,
+                     size_t filtersCount,
+                     const BREthereumBloomFilter *others,
+                     size_t othersCount,
+                     uint8_t *matches) {
+    // Reduce `others` to their non-zero words, in `others` order.  An empty `other` matches
+    // every filter; mark it with a zero mask.
+    size_t wordsCount = 0;
+    BREthereumBloomFilterWord *words = malloc ((0 == othersCount ? 1 : othersCount * BLOOM_FILTER_WORDS) * sizeof (BREthereumBloomFilterWord));
+
+    for (size_t oi = 0; oi < othersCount; oi++) {
+        size_t wordsCountForOther = 0;
+        for (size_t wi = 0; wi < BLOOM_FILTER_WORDS; wi++) {
+            uint64_t mask = bloomFilterGetWord (&others[oi], wi);
+            if (0 != mask) {
+                words[wordsCount++] = (BREthereumBloomFilterWord) { (uint32_t) wi, (uint32_t) oi, mask };
+                wordsCountForOther++;
+            }
+        }
+        if (0 == wordsCountForOther)
+            words[wordsCount++] = (BREthereumBloomFilterWord) { 0, (uint32_t) oi, 0 };
+    }
+
+    size_t matchesCount = 0;
+    for (size_t fi = 0; fi < filtersCount; fi++) {
+        const BREthereumBloomFilter *filter = &filters[fi];
+        uint8_t match = 0;
+
+        // Walk the words, one `other` at a time; an `other` matches if none of its bits are
+        // missing from `filter`.
+        for (size_t wi = 0; wi < wordsCount && !match; ) {
+            uint32_t other = words[wi].other;
+            uint64_t missing = 0;
+
+            for (; wi < wordsCount && other == words[wi].other; wi++)
+                missing |= words[wi].mask & ~bloomFilterGetWord (filter, words[wi].index);
+
+            match = (0 == missing);
+        }
+
+        matches[fi] = match;
+        matchesCount += match;
+    }
+
+    free (words);
+    return matchesCount;
 }
 
 //
@@ -99,6 +99,28 @@ bloomFilterEqual (const BREthereumBloomFilter filter1, const BREthereumBloomFilt
 extern BREthereumBoolean
 bloomFilterMatch (const BREthereumBloomFilter filter, const BREthereumBloomFilter other);
 
+/**
+ * Check each of `filters` for a match with any of `others`.  Typically `filters` would be the
+ * bloom filters for a batch of block headers and `others` would be addresses and contracts of
+ * interest.  The `others` are reduced once, to their non-zero words, and then each of `filters`
+ * is checked against those words only.
+ *
+ * @parameter filters
+ * @parameter filtersCount
+ * @parameter others
+ * @parameter othersCount
+ * @parameter matches an array of `filtersCount` values; each is filled with 1 if the corresponding
+ *    filter matches any of `others`, otherwise 0.
+ *
+ * @returns the number of `filters` that match
+ */
+extern size_t
+bloomFilterMatchAny (const BREthereumBloomFilter *filters,
+                     size_t filtersCount,
+                     const BREthereumBloomFilter *others,
+                     size_t othersCount,
+                     uint8_t *matches);
+
 extern BRRlpItem
 bloomFilterRlpEncode(BREthereumBloomFilter filter, BRRlpCoder coder);
 
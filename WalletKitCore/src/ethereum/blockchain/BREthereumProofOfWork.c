@@ -8,13 +8,40 @@
 //  See the LICENSE file at the project root for license information.
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
+#include <stdio.h>
 #include <stdlib.h>
-#include <stdarg.h>
-#include "support/BRArray.h"
-#include "support/BRSet.h"
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "support/BRInt.h"
+#include "support/BRCrypto.h"
+#include "support/BROSCompat.h"
 #include "support/rlp/BRRlp.h"
 #include "BREthereumBlock.h"
 
+/**
+ * Ethash, as a light client.  See https://eth.wiki/en/concepts/ethash/ethash
+ *
+ * A light client never builds the (1 GB and up) dataset; it builds the per-epoch cache (16 MB
+ * and up) and derives each of the 128 dataset items needed to verify a header from 256 cache
+ * items.  The cache for an epoch costs seconds to generate; a header's verification then costs
+ * under a millisecond.
+ *
+ * We hold the caches for the POW_CACHE_LRU_COUNT most recently used epochs.  With a storage path,
+ * each cache is also written to '<path>/ethash-<epoch>' and memory-mapped, so that a restart does
+ * not regenerate the cache.  The file holds a 32 byte preamble of {magic, epoch, cache size} and
+ * then the cache items as 32-bit words, in host byte order.
+ *
+ * Generating a cache is too slow for `proofOfWorkCompute()` - headers are validated as they are
+ * announced.  Instead, `proofOfWorkCompute()` queues the cache for the POW thread and, until the
+ * cache is ready, reports the header's proof-of-work as pending; the caller validates the header
+ * again once the cache is ready.  `proofOfWorkGenerate()`
+ * generates a cache synchronously.
+ */
 #define POW_WORD_BYTES            (4)
 #define POW_DATA_SET_INIT         (1 << 30)
 #define POW_DATA_SET_GROWTH       (1 << 23)
@@ -27,141 +54,655 @@
 #define POW_CACHE_ROUNDS          (3)
 #define POW_ACCESSES              (64)
 
+#define POW_HASH_WORDS            (POW_HASH_BYTES / POW_WORD_BYTES)  // 16
+#define POW_MIX_WORDS             (POW_MIX_BYTES  / POW_WORD_BYTES)  // 32
+#define POW_MIX_HASHES            (POW_MIX_BYTES  / POW_HASH_BYTES)  //  2
+
+#define POW_FNV_PRIME             (0x01000193)
+
+#define POW_CACHE_LRU_COUNT       (3)
+
+// An epoch's cache and dataset sizes fit 32-bit item counts well beyond this epoch (~block 61M)
+#define POW_EPOCH_MAX             (2048)
+
+// Headers are verified only within this many epochs of the chain head, so that no epoch a peer
+// names can evict caches in use or queue a cache no chain will ever need.
+#define POW_EPOCH_RANGE           (1)
+
+#define POW_EPOCH_UNKNOWN         (UINT64_MAX)
+
+// While computing a seed hash, check for quit every so many hashes
+#define POW_QUIT_CHECK_SEEDS      (256)
+
+// While generating a cache, check for quit every so many items
+#define POW_QUIT_CHECK_ITEMS      (16 * 1024)
+
+#define POW_STORE_MAGIC           "BRDETHPW"
+#define POW_STORE_PREAMBLE_SIZE   (32)
+
+#define POW_THREAD_NAME           "Core ETH, PoW"
+#define POW_PTHREAD_STACK_SIZE    (512 * 1024)
+
+typedef enum {
+    POW_CACHE_EMPTY,
+    POW_CACHE_PENDING,          // queued for the POW thread
+    POW_CACHE_GENERATING,
+    POW_CACHE_READY
+} BREthereumProofOfWorkCacheState;
+
+typedef struct {
+    uint64_t epoch;
+    BREthereumProofOfWorkCacheState state;
+
+    /// The cache items, as `itemsCount` items of POW_HASH_WORDS words.  Either allocated or within
+    /// `mapping` (when `mappingSize` is non-zero).
+    uint32_t *words;
+    uint32_t itemsCount;
+
+    /// The dataset size, in POW_HASH_BYTES items.
+    uint32_t datasetItemsCount;
+
+    void  *mapping;
+    size_t mappingSize;
+
+    /// The LRU tick of the last use; the count of `proofOfWorkCompute()` calls using `words`
+    uint64_t lastUsed;
+    unsigned int users;
+} BREthereumProofOfWorkCache;
+
 //
 // Proof Of Work
 //
 struct BREthereumProofOfWorkStruct {
-    int foo;
+    /// The directory for the cache files; NULL for memory only
+    char *path;
+
+    BREthereumProofOfWorkCache caches[POW_CACHE_LRU_COUNT];
+    uint64_t tick;
+
+    /// The epoch of the chain head; POW_EPOCH_UNKNOWN until `proofOfWorkSetHead()`
+    uint64_t headEpoch;
+
+    int quit;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
 };
 
+static void *
+proofOfWorkThread (BREthereumProofOfWork pow);
+
 extern BREthereumProofOfWork
-proofOfWorkCreate (void) {
+proofOfWorkCreate (const char *storagePath) {
     BREthereumProofOfWork pow = calloc (1, sizeof (struct BREthereumProofOfWorkStruct));
 
-    pow->foo = 0;
+    if (NULL != storagePath && (0 == mkdir (storagePath, 0700) || EEXIST == errno))
+        pow->path = strdup (storagePath);
+
+    pow->tick = 0;
+    pow->headEpoch = POW_EPOCH_UNKNOWN;
+    pow->quit = 0;
+
+    pthread_mutex_init_brd (&pow->lock, PTHREAD_MUTEX_NORMAL);
+    pthread_cond_init (&pow->cond, NULL);
+
+    {
+        pthread_attr_t attr;
+        pthread_attr_init (&attr);
+        pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+        pthread_attr_setstacksize (&attr, POW_PTHREAD_STACK_SIZE);
+
+        pthread_create (&pow->thread, &attr, (ThreadRoutine) proofOfWorkThread, pow);
+        pthread_attr_destroy (&attr);
+    }
 
     return pow;
 }
 
+static void
+powCacheRelease (BREthereumProofOfWork pow,
+                 BREthereumProofOfWorkCache *cache,
+                 int unlinkFile);
+
 extern void
 proofOfWorkRelease (BREthereumProofOfWork pow) {
+    pthread_mutex_lock (&pow->lock);
+    pow->quit = 1;
+    pthread_cond_broadcast (&pow->cond);
+    pthread_mutex_unlock (&pow->lock);
+
+    pthread_join (pow->thread, NULL);
+
+    // Keep the files; a later `proofOfWorkCreate()` will map them.
+    for (size_t index = 0; index < POW_CACHE_LRU_COUNT; index++)
+        powCacheRelease (pow, &pow->caches[index], 0);
+
+    pthread_cond_destroy (&pow->cond);
+    pthread_mutex_destroy (&pow->lock);
+
+    if (NULL != pow->path) free (pow->path);
     free (pow);
 }
 
-#if defined (INCLUDE_UNUSED_FUNCTIONS)
-static uint64_t
-powEpoch (BREthereumBlockHeader header) {
-    return blockHeaderGetNonce(header) / POW_EPOCH;
+/// MARK: - Sizes and Seed
+
+static int
+powIsPrime (uint64_t x) {
+    if (x < 2) return 0;
+    if (0 == x % 2) return 2 == x;
+    for (uint64_t d = 3; d * d <= x; d += 2)
+        if (0 == x % d) return 0;
+    return 1;
 }
 
 static uint64_t
-powPrime (uint64_t x, uint64_t y) {
-    return (0 == x % y
-            ? x
-            : powPrime (x - 2 * y, y));
+powEpoch (uint64_t number) {
+    return number / POW_EPOCH;
 }
 
 static uint64_t
-powDatasetSize (BREthereumBlockHeader header) {
-    return powPrime (POW_DATA_SET_INIT + POW_DATA_SET_GROWTH * powEpoch(header) - POW_MIX_BYTES,
-                     POW_MIX_BYTES);
+powDatasetSize (uint64_t epoch) {
+    uint64_t size = POW_DATA_SET_INIT + POW_DATA_SET_GROWTH * epoch - POW_MIX_BYTES;
+    while (!powIsPrime (size / POW_MIX_BYTES))
+        size -= 2 * POW_MIX_BYTES;
+    return size;
 }
 
 static uint64_t
-powCacheSize (BREthereumBlockHeader header) {
-    return powPrime (POW_CACHE_INIT + POW_CACHE_GROWTH * powEpoch(header) - POW_HASH_BYTES,
-                     POW_HASH_BYTES);
+powCacheSize (uint64_t epoch) {
+    uint64_t size = POW_CACHE_INIT + POW_CACHE_GROWTH * epoch - POW_HASH_BYTES;
+    while (!powIsPrime (size / POW_HASH_BYTES))
+        size -= 2 * POW_HASH_BYTES;
+    return size;
+}
+
+static int
+powShouldQuit (BREthereumProofOfWork pow) {
+    pthread_mutex_lock (&pow->lock);
+    int quit = pow->quit;
+    pthread_mutex_unlock (&pow->lock);
+    return quit;
+}
+
+/// MARK: - Hashing
+
+static inline uint32_t
+powFNV (uint32_t x, uint32_t y) {
+    return x * POW_FNV_PRIME ^ y;
+}
+
+// The words, of any count, as Keccak-512 input
+static void
+powKeccak512Words (uint32_t result[POW_HASH_WORDS], const uint32_t *words, size_t wordsCount) {
+    uint8_t bytes[wordsCount * POW_WORD_BYTES];
+    uint8_t md64[POW_HASH_BYTES];
+
+    for (size_t index = 0; index < wordsCount; index++)
+        UInt32SetLE (&bytes[index * POW_WORD_BYTES], words[index]);
+
+    BRKeccak512 (md64, bytes, sizeof (bytes));
+
+    for (size_t index = 0; index < POW_HASH_WORDS; index++)
+        result[index] = UInt32GetLE (&md64[index * POW_WORD_BYTES]);
+}
+
+static void
+powKeccak512Bytes (uint32_t result[POW_HASH_WORDS], const uint8_t *bytes, size_t bytesCount) {
+    uint8_t md64[POW_HASH_BYTES];
+
+    BRKeccak512 (md64, bytes, bytesCount);
+
+    for (size_t index = 0; index < POW_HASH_WORDS; index++)
+        result[index] = UInt32GetLE (&md64[index * POW_WORD_BYTES]);
+}
+
+// Fill `seed` with the seed hash for `epoch`; return 0 if `pow` quit before it was complete.
+static int
+powSeedHash (BREthereumProofOfWork pow,
+             uint64_t epoch,
+             uint8_t seed[32]) {
+    memset (seed, 0, 32);
+    for (uint64_t index = 0; index < epoch; index++) {
+        if (0 == (index + 1) % POW_QUIT_CHECK_SEEDS && powShouldQuit (pow)) return 0;
+        BRKeccak256 (seed, seed, 32);
+    }
+    return 1;
+}
+
+// Fill `words` with the cache for `epoch`; return 0 if `pow` quit before the cache was complete.
+static int
+powCacheFill (BREthereumProofOfWork pow,
+              uint64_t epoch,
+              uint32_t *words,
+              uint32_t itemsCount) {
+    uint8_t seed[32];
+    if (!powSeedHash (pow, epoch, seed)) return 0;
+
+    // Sequentially, Keccak-512 from the seed
+    powKeccak512Bytes (&words[0], seed, sizeof (seed));
+    for (uint32_t index = 1; index < itemsCount; index++) {
+        if (0 == index % POW_QUIT_CHECK_ITEMS && powShouldQuit (pow)) return 0;
+        powKeccak512Words (&words[index * POW_HASH_WORDS], &words[(index - 1) * POW_HASH_WORDS], POW_HASH_WORDS);
+    }
+
+    // Then POW_CACHE_ROUNDS of RandMemoHash
+    for (size_t round = 0; round < POW_CACHE_ROUNDS; round++) {
+        for (uint32_t index = 0; index < itemsCount; index++) {
+            if (0 == index % POW_QUIT_CHECK_ITEMS && powShouldQuit (pow)) return 0;
+
+            uint32_t *item = &words[index * POW_HASH_WORDS];
+            const uint32_t *prev = &words[((index + itemsCount - 1) % itemsCount) * POW_HASH_WORDS];
+            const uint32_t *rand = &words[(item[0] % itemsCount) * POW_HASH_WORDS];
+
+            uint32_t mix[POW_HASH_WORDS];
+            for (size_t w = 0; w < POW_HASH_WORDS; w++)
+                mix[w] = prev[w] ^ rand[w];
+
+            powKeccak512Words (item, mix, POW_HASH_WORDS);
+        }
+    }
+    return 1;
+}
+
+// Compute the POW_MIX_HASHES dataset items from `index` (one page) from the cache.  Each item
+// needs POW_PARENTS dependent, random reads of the cache; we interleave the items so that their
+// reads overlap.  The FNV loops are over independent words; the compiler vectorizes them.
+static void
+powDatasetItems (const BREthereumProofOfWorkCache *cache,
+                 uint32_t index,
+                 uint32_t items[POW_MIX_WORDS]) {
+    const uint32_t *words = cache->words;
+    uint32_t count = cache->itemsCount;
+
+    uint32_t mix[POW_MIX_HASHES][POW_HASH_WORDS];
+    for (uint32_t hash = 0; hash < POW_MIX_HASHES; hash++) {
+        memcpy (mix[hash], &words[((index + hash) % count) * POW_HASH_WORDS], sizeof (mix[hash]));
+        mix[hash][0] ^= index + hash;
+        powKeccak512Words (mix[hash], mix[hash], POW_HASH_WORDS);
+    }
+
+    for (uint32_t parent = 0; parent < POW_PARENTS; parent++) {
+        const uint32_t *parentItem[POW_MIX_HASHES];
+        for (uint32_t hash = 0; hash < POW_MIX_HASHES; hash++)
+            parentItem[hash] = &words[(powFNV ((index + hash) ^ parent, mix[hash][parent % POW_HASH_WORDS]) % count) * POW_HASH_WORDS];
+
+        for (uint32_t hash = 0; hash < POW_MIX_HASHES; hash++)
+            for (size_t w = 0; w < POW_HASH_WORDS; w++)
+                mix[hash][w] = powFNV (mix[hash][w], parentItem[hash][w]);
+    }
+
+    for (uint32_t hash = 0; hash < POW_MIX_HASHES; hash++)
+        powKeccak512Words (&items[hash * POW_HASH_WORDS], mix[hash], POW_HASH_WORDS);
 }
 
-static BREthereumHash
-powSeedHashInternal (uint64_t number) {
-    BREthereumHash bytes;
+// Hashimoto, with dataset items computed from the cache.  Fills `result` as the big-endian
+// Keccak-256 output and `mixDigest` as the compressed mix.
+static void
+powHashimotoLight (const BREthereumProofOfWorkCache *cache,
+                   const uint8_t sealHash[32],
+                   uint64_t nonce,
+                   uint8_t result[32],
+                   uint8_t mixDigest[32]) {
+    uint8_t seedBytes[32 + 8];
+    memcpy (seedBytes, sealHash, 32);
+    UInt64SetLE (&seedBytes[32], nonce);
+
+    uint32_t seed[POW_HASH_WORDS];
+    powKeccak512Bytes (seed, seedBytes, sizeof (seedBytes));
+
+    uint32_t mix[POW_MIX_WORDS];
+    for (size_t w = 0; w < POW_MIX_WORDS; w++)
+        mix[w] = seed[w % POW_HASH_WORDS];
+
+    uint32_t pages = cache->datasetItemsCount / POW_MIX_HASHES;
+
+    for (uint32_t access = 0; access < POW_ACCESSES; access++) {
+        uint32_t page = powFNV (access ^ seed[0], mix[access % POW_MIX_WORDS]) % pages;
+
+        uint32_t data[POW_MIX_WORDS];
+        powDatasetItems (cache, page * POW_MIX_HASHES, data);
+
+        for (size_t w = 0; w < POW_MIX_WORDS; w++)
+            mix[w] = powFNV (mix[w], data[w]);
+    }
+
+    // Compress the mix, four words to one
+    for (size_t w = 0; w < POW_MIX_WORDS / 4; w++)
+        UInt32SetLE (&mixDigest[w * POW_WORD_BYTES],
+                     powFNV (powFNV (powFNV (mix[4 * w], mix[4 * w + 1]), mix[4 * w + 2]), mix[4 * w + 3]));
 
-    if (0 == number)
-        memset (bytes.bytes, 0, 32);
-    else
-        bytes = powSeedHashInternal(number - POW_EPOCH);
+    uint8_t finalBytes[POW_HASH_BYTES + 32];
+    for (size_t w = 0; w < POW_HASH_WORDS; w++)
+        UInt32SetLE (&finalBytes[w * POW_WORD_BYTES], seed[w]);
+    memcpy (&finalBytes[POW_HASH_BYTES], mixDigest, 32);
 
-    return hashCreateFromData ((BRRlpData) { 32, bytes.bytes });
+    BRKeccak256 (result, finalBytes, sizeof (finalBytes));
 }
 
-static BREthereumHash
-powSeedHash (BREthereumBlockHeader header) {
-    return powSeedHashInternal(blockHeaderGetNumber(header));
+/// MARK: - Cache Store
+
+static char *
+powCacheFilename (BREthereumProofOfWork pow, uint64_t epoch, const char *suffix) {
+    char *filename = malloc (strlen (pow->path) + 48);
+    sprintf (filename, "%s/ethash-%llu%s", pow->path, (unsigned long long) epoch, suffix);
+    return filename;
 }
 
-static BREthereumData
-powLittleRMH (BREthereumData x, uint64_t i, uint64_t n) {
-    return x;
+static int
+powCacheWriteFully (int file, const void *bytes, size_t bytesCount) {
+    while (bytesCount > 0) {
+        ssize_t count = write (file, bytes, bytesCount);
+        if (count <= 0) return 0;
+        bytes = (const uint8_t *) bytes + count;
+        bytesCount -= (size_t) count;
+    }
+    return 1;
 }
 
-static BREthereumData
-powBigRMH (BREthereumData x, uint64_t n) {
-    for (uint64_t i = 0; i < n; i++)
-        powLittleRMH(x, i, n);
-    return x;
+// Map the cache file for `cache->epoch`, if it exists and is complete.
+static int
+powCacheLoad (BREthereumProofOfWork pow,
+              BREthereumProofOfWorkCache *cache) {
+    if (NULL == pow->path) return 0;
+
+    char *filename = powCacheFilename (pow, cache->epoch, "");
+    int file = open (filename, O_RDONLY);
+    free (filename);
+    if (-1 == file) return 0;
+
+    size_t mappingSize = POW_STORE_PREAMBLE_SIZE + (size_t) cache->itemsCount * POW_HASH_BYTES;
+    uint8_t preamble[POW_STORE_PREAMBLE_SIZE];
+    struct stat fileStat;
+
+    if (0 != fstat (file, &fileStat) || (size_t) fileStat.st_size != mappingSize ||
+        sizeof (preamble) != read (file, preamble, sizeof (preamble)) ||
+        0 != memcmp (preamble, POW_STORE_MAGIC, 8) ||
+        cache->epoch != UInt64GetLE (&preamble[8]) ||
+        cache->itemsCount != UInt64GetLE (&preamble[16])) {
+        close (file);
+        return 0;
+    }
+
+    void *mapping = mmap (NULL, mappingSize, PROT_READ, MAP_SHARED, file, 0);
+    close (file);
+    if (MAP_FAILED == mapping) return 0;
+
+    cache->mapping     = mapping;
+    cache->mappingSize = mappingSize;
+    cache->words       = (uint32_t *) ((uint8_t *) mapping + POW_STORE_PREAMBLE_SIZE);
+    return 1;
 }
 
-static BREthereumData
-powCacheRounds (BREthereumData x, uint64_t y, uint64_t n) {
-    return (0 == y
-            ? x
-            : (1 == y
-               ? powBigRMH (x, n)
-               : powCacheRounds (powBigRMH (x, n), y - 1, n)));
+// Write the (allocated) cache to its file and then map it.  On any failure, the cache remains
+// allocated; on success, the allocation is freed.
+static void
+powCacheStore (BREthereumProofOfWork pow,
+               BREthereumProofOfWorkCache *cache) {
+    if (NULL == pow->path) return;
+
+    char *filename    = powCacheFilename (pow, cache->epoch, "");
+    char *filenameTmp = powCacheFilename (pow, cache->epoch, ".tmp");
+
+    uint8_t preamble[POW_STORE_PREAMBLE_SIZE];
+    memset (preamble, 0, sizeof (preamble));
+    memcpy (preamble, POW_STORE_MAGIC, 8);
+    UInt64SetLE (&preamble[ 8], cache->epoch);
+    UInt64SetLE (&preamble[16], cache->itemsCount);
+
+    int file = open (filenameTmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int success = (-1 != file &&
+                   powCacheWriteFully (file, preamble, sizeof (preamble)) &&
+                   powCacheWriteFully (file, cache->words, (size_t) cache->itemsCount * POW_HASH_BYTES));
+    if (-1 != file) close (file);
+
+    success = success && 0 == rename (filenameTmp, filename);
+    if (!success) unlink (filenameTmp);
+
+    free (filenameTmp);
+    free (filename);
+
+    if (success) {
+        uint32_t *words = cache->words;
+        if (powCacheLoad (pow, cache)) free (words);
+    }
 }
 
 static void
-powBigFNV (BREthereumData x,
-           BREthereumData y) {
+powCacheRelease (BREthereumProofOfWork pow,
+                 BREthereumProofOfWorkCache *cache,
+                 int unlinkFile) {
+    if (NULL != cache->words) {
+        if (0 != cache->mappingSize) munmap (cache->mapping, cache->mappingSize);
+        else free (cache->words);
+    }
+
+    if (unlinkFile && NULL != pow->path && POW_CACHE_EMPTY != cache->state) {
+        char *filename = powCacheFilename (pow, cache->epoch, "");
+        unlink (filename);
+        free (filename);
+    }
+
+    memset (cache, 0, sizeof (BREthereumProofOfWorkCache));
+    cache->state = POW_CACHE_EMPTY;
+}
+
+// Load or generate the cache; called, without the lock, on a GENERATING cache.  Returns 0 if
+// `pow` quit before the cache was complete.
+static int
+powCacheBuild (BREthereumProofOfWork pow,
+               BREthereumProofOfWorkCache *cache) {
+    assert (cache->epoch <= POW_EPOCH_MAX);
+    cache->itemsCount        = (uint32_t) (powCacheSize   (cache->epoch) / POW_HASH_BYTES);
+    cache->datasetItemsCount = (uint32_t) (powDatasetSize (cache->epoch) / POW_HASH_BYTES);
+
+    if (powCacheLoad (pow, cache)) return 1;
+
+    cache->words = malloc ((size_t) cache->itemsCount * POW_HASH_BYTES);
+    if (NULL == cache->words) return 0;
+    if (!powCacheFill (pow, cache->epoch, cache->words, cache->itemsCount)) {
+        free (cache->words);
+        cache->words = NULL;
+        return 0;
+    }
+
+    powCacheStore (pow, cache);
+    return 1;
+}
+
+/// MARK: - Cache LRU
+
+// Find the cache for `epoch` or claim an EMPTY cache, evicting the least recently used READY
+// cache if needed.  Returns NULL if every cache is in use.  Requires the lock.
+static BREthereumProofOfWorkCache *
+powCacheFind (BREthereumProofOfWork pow,
+              uint64_t epoch) {
+    BREthereumProofOfWorkCache *empty = NULL;
+    BREthereumProofOfWorkCache *oldest = NULL;
+
+    for (size_t index = 0; index < POW_CACHE_LRU_COUNT; index++) {
+        BREthereumProofOfWorkCache *cache = &pow->caches[index];
+
+        if (POW_CACHE_EMPTY == cache->state) {
+            if (NULL == empty) empty = cache;
+        }
+        else if (epoch == cache->epoch) return cache;
+        else if (POW_CACHE_READY == cache->state && 0 == cache->users &&
+                 (NULL == oldest || cache->lastUsed < oldest->lastUsed))
+            oldest = cache;
+    }
+
+    if (NULL == empty && NULL != oldest) {
+        powCacheRelease (pow, oldest, 1);
+        empty = oldest;
+    }
+
+    if (NULL != empty) {
+        empty->epoch = epoch;
+        empty->lastUsed = ++pow->tick;
+    }
+    return empty;
 }
 
-static BREthereumData
-powMix (BREthereumData m,
-        BREthereumData c,
-        uint64_t i,
-        uint64_t p) {
-    return (0 == p
-            ? m
-            : m);
+// Build the GENERATING cache, without the lock; requires the lock on entry and on exit.
+static void
+powCacheBuildLocked (BREthereumProofOfWork pow,
+                     BREthereumProofOfWorkCache *cache) {
+    uint64_t epoch = cache->epoch;
+
+    pthread_mutex_unlock (&pow->lock);
+    int success = powCacheBuild (pow, cache);
+    pthread_mutex_lock (&pow->lock);
+
+    if (success) {
+        cache->state = POW_CACHE_READY;
+        eth_log ("PoW", "Cache: %llu Ready", (unsigned long long) epoch);
+    }
+    else powCacheRelease (pow, cache, 0);
+
+    pthread_cond_broadcast (&pow->cond);
 }
 
-static BREthereumData
-powParents (BREthereumData c,
-            uint64_t i,
-            uint64_t p,
-            BREthereumData m) {
-    return (p < POW_PARENTS - 1
-            ? powParents(c, i, p + 1, powMix (m, c, i, p + 1))
-            : powMix (m, c, i, p + 1));
+static void *
+proofOfWorkThread (BREthereumProofOfWork pow) {
+    pthread_setname_brd (pthread_self (), POW_THREAD_NAME);
+
+    pthread_mutex_lock (&pow->lock);
+    while (!pow->quit) {
+        // Generate in the order queued; the head's cache before the next epoch's.
+        BREthereumProofOfWorkCache *pending = NULL;
+        for (size_t index = 0; index < POW_CACHE_LRU_COUNT; index++)
+            if (POW_CACHE_PENDING == pow->caches[index].state &&
+                (NULL == pending || pow->caches[index].lastUsed < pending->lastUsed))
+                pending = &pow->caches[index];
+
+        if (NULL == pending) {
+            pthread_cond_wait (&pow->cond, &pow->lock);
+            continue;
+        }
+
+        pending->state = POW_CACHE_GENERATING;
+        powCacheBuildLocked (pow, pending);
+    }
+    pthread_mutex_unlock (&pow->lock);
+    return NULL;
 }
 
-static BREthereumData
-powDatasetItem (BREthereumData c,
-                uint64_t i) {
-    return powParents(c, i, -i, (BREthereumData) { 0, NULL });
+/// MARK: - Generate / Compute
+
+// Is `epoch` one that `proofOfWorkCompute()` may find, and so evict, a cache for?  Requires the lock.
+static int
+powEpochInRange (BREthereumProofOfWork pow,
+                 uint64_t epoch) {
+    return (POW_EPOCH_UNKNOWN != pow->headEpoch &&
+            epoch <= POW_EPOCH_MAX &&
+            epoch + POW_EPOCH_RANGE >= pow->headEpoch &&
+            epoch <= pow->headEpoch + POW_EPOCH_RANGE);
 }
-// On and On and On....
-#endif
 
 extern void
-proofOfWorkGenerate(BREthereumProofOfWork pow,
-                       BREthereumBlockHeader header) {
-    //
+proofOfWorkSetHead (BREthereumProofOfWork pow,
+                    uint64_t number) {
+    uint64_t epoch = powEpoch (number);
+
+    pthread_mutex_lock (&pow->lock);
+    if (epoch != pow->headEpoch) {
+        pow->headEpoch = epoch;
+
+        // Queue the head's cache ahead of the headers that will need it, and then the next
+        // epoch's so that the boundary does not stall.
+        for (uint64_t next = epoch; next <= epoch + 1 && next <= POW_EPOCH_MAX; next++) {
+            BREthereumProofOfWorkCache *cache = powCacheFind (pow, next);
+            if (NULL != cache && POW_CACHE_EMPTY == cache->state) {
+                cache->state = POW_CACHE_PENDING;
+                pthread_cond_broadcast (&pow->cond);
+            }
+        }
+    }
+    pthread_mutex_unlock (&pow->lock);
 }
 
 extern void
+proofOfWorkGenerate (BREthereumProofOfWork pow,
+                     BREthereumBlockHeader header) {
+    uint64_t epoch = powEpoch (blockHeaderGetNumber (header));
+    if (epoch > POW_EPOCH_MAX) return;
+
+    pthread_mutex_lock (&pow->lock);
+    while (!pow->quit) {
+        BREthereumProofOfWorkCache *cache = powCacheFind (pow, epoch);
+        if (NULL == cache) break;
+
+        if (POW_CACHE_READY == cache->state) break;
+
+        if (POW_CACHE_GENERATING == cache->state) {
+            // Another thread is generating; await it and then look again.
+            pthread_cond_wait (&pow->cond, &pow->lock);
+            continue;
+        }
+
+        cache->state = POW_CACHE_GENERATING;
+        powCacheBuildLocked (pow, cache);
+    }
+    pthread_mutex_unlock (&pow->lock);
+}
+
+extern BREthereumProofOfWorkResult
 proofOfWorkCompute (BREthereumProofOfWork pow,
-                       BREthereumBlockHeader header,
-                       UInt256 *n,
-                       BREthereumHash *m) {
+                    BREthereumBlockHeader header,
+                    UInt256 *n,
+                    BREthereumHash *m) {
     assert (NULL != n && NULL != m);
 
-    // On and on and on
+    // For a proof-of-stake header, there is no proof-of-work.
+    *n = UINT256_ZERO;
+    *m = ethHashCreateEmpty ();
+
+    if (UInt256Eq (UINT256_ZERO, blockHeaderGetDifficulty (header))) return PROOF_OF_WORK_COMPUTED;
 
-    // TODO: Actually compute something.
+    uint64_t epoch = powEpoch (blockHeaderGetNumber (header));
 
-    // For now, return values that allow subsequent use to succeed
-    *n = UINT256_ZERO;
-    *m = blockHeaderGetMixHash (header);
+    pthread_mutex_lock (&pow->lock);
+    if (!powEpochInRange (pow, epoch)) {
+        pthread_mutex_unlock (&pow->lock);
+        return PROOF_OF_WORK_UNAVAILABLE;
+    }
+
+    BREthereumProofOfWorkCache *cache = powCacheFind (pow, epoch);
+
+    if (NULL == cache || POW_CACHE_READY != cache->state) {
+        if (NULL != cache && POW_CACHE_EMPTY == cache->state) {
+            cache->state = POW_CACHE_PENDING;
+            pthread_cond_broadcast (&pow->cond);
+        }
+        pthread_mutex_unlock (&pow->lock);
+        return PROOF_OF_WORK_PENDING;
+    }
+
+    cache->users += 1;
+    cache->lastUsed = ++pow->tick;
+    pthread_mutex_unlock (&pow->lock);
+
+    // The seal hash excludes the mixHash and nonce
+    BRRlpCoder coder = rlpCoderCreate ();
+    BRRlpItem item = blockHeaderRlpEncode (header, ETHEREUM_BOOLEAN_FALSE, RLP_TYPE_NETWORK, coder);
+    BRRlpData data = rlpItemGetDataSharedDontRelease (coder, item);
+
+    uint8_t sealHash[32];
+    BRKeccak256 (sealHash, data.bytes, data.bytesCount);
+
+    rlpItemRelease (coder, item);
+    rlpCoderRelease (coder);
+
+    uint8_t result[32];
+    powHashimotoLight (cache, sealHash, blockHeaderGetNonce (header), result, m->bytes);
+
+    // `result` is big-endian; UInt256 is little-endian
+    for (size_t index = 0; index < 32; index++)
+        n->u8[index] = result[31 - index];
+
+    pthread_mutex_lock (&pow->lock);
+    cache->users -= 1;
+    pthread_mutex_unlock (&pow->lock);
+
+    return PROOF_OF_WORK_COMPUTED;
 }
@@ -404,11 +404,12 @@ transactionRlpEncode(BREthereumTransaction transaction,
 //
 // Tranaction RLP Decode
 //
-extern BREthereumTransaction
-transactionRlpDecode (BRRlpItem item,
-                      BREthereumNetwork network,
-                      BREthereumRlpType type,
-                      BRRlpCoder coder) {
+static BREthereumTransaction
+transactionRlpDecodeInternal (BRRlpItem item,
+                              BREthereumNetwork network,
+                              BREthereumRlpType type,
+                              BREthereumBoolean computeHash,
+                              BRRlpCoder coder) {
     
     BREthereumTransaction transaction = calloc (1, sizeof(struct BREthereumTransactionRecord));
     
@@ -473,8 +474,11 @@ transactionRlpDecode (BRRlpItem item,
 
         case RLP_TYPE_TRANSACTION_SIGNED: {
             // With a SIGNED RLP encoding, we can extract the source address and compute the hash.
-            BRRlpData result = rlpItemGetDataSharedDontRelease(coder, item);
-            transaction->hash = ethHashCreateFromData(result);
+            // The hash might be computed later, together with others.
+            if (ETHEREUM_BOOLEAN_IS_TRUE (computeHash)) {
+                BRRlpData result = rlpItemGetDataSharedDontRelease(coder, item);
+                transaction->hash = ethHashCreateFromData(result);
+            }
 
             // :fingers-crossed:
             transaction->sourceAddress = transactionExtractAddress (transaction, network, coder);
@@ -490,6 +494,48 @@ transactionRlpDecode (BRRlpItem item,
     return transaction;
 }
 
+extern BREthereumTransaction
+transactionRlpDecode (BRRlpItem item,
+                      BREthereumNetwork network,
+                      BREthereumRlpType type,
+                      BRRlpCoder coder) {
+    return transactionRlpDecodeInternal (item, network, type, ETHEREUM_BOOLEAN_TRUE, coder);
+}
+
+extern BRArrayOf(BREthereumTransaction)
+transactionsRlpDecode (BRRlpItem item,
+                       BREthereumNetwork network,
+                       BREthereumRlpType type,
+                       BRRlpCoder coder) {
+    size_t itemsCount = 0;
+    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+
+    BRArrayOf(BREthereumTransaction) transactions;
+    array_new (transactions, itemsCount);
+
+    for (size_t index = 0; index < itemsCount; index++)
+        array_add (transactions, transactionRlpDecodeInternal (items[index], network, type,
+                                                               ETHEREUM_BOOLEAN_FALSE, coder));
+
+    // With a SIGNED RLP encoding, hash all the transactions together
+    if (RLP_TYPE_TRANSACTION_SIGNED == type) {
+        BRRlpData      *data   = calloc (itemsCount, sizeof (BRRlpData));
+        BREthereumHash *hashes = calloc (itemsCount, sizeof (BREthereumHash));
+
+        for (size_t index = 0; index < itemsCount; index++)
+            data[index] = rlpItemGetDataSharedDontRelease (coder, items[index]);
+
+        ethHashCreateFromDataBatch (hashes, data, itemsCount);
+        for (size_t index = 0; index < itemsCount; index++)
+            transactions[index]->hash = hashes[index];
+
+        free (hashes);
+        free (data);
+    }
+
+    return transactions;
+}
+
 extern BRRlpData
 transactionGetRlpData (BREthereumTransaction transaction,
                        BREthereumNetwork network,
@@ -184,6 +184,18 @@ transactionRlpDecode (BRRlpItem item,
                       BREthereumRlpType type,
                       BRRlpCoder coder);
 
+/**
+ * Decode a list of transactions.  For a SIGNED encoding the transaction hashes are computed
+ * together (see ethHashCreateFromDataBatch()).
+ *
+ * Return BRArrayOf(BREthereumTransaction) w/ array owned by caller
+ */
+extern BRArrayOf(BREthereumTransaction)
+transactionsRlpDecode (BRRlpItem item,
+                       BREthereumNetwork network,
+                       BREthereumRlpType type,
+                       BRRlpCoder coder);
+
 /**
  * RLP encode transaction for the provided network with the specified type.  Different networks
  * have different RLP encodings - notably the network's chainId is part of the encoding.
@@ -1019,6 +1019,19 @@ lesDeactivateNodes (BREthereumLES les,
         lesDeactivateNode (les, route, nodesToDeactivate[ri], explain);
 }
 
+/**
+ * Select the connected, active node expected to complete a request first.  Each node estimates
+ * a delay from its measured latency, its provisions in flight and its flow control credits; thus
+ * requests spread across nodes, several in flight per node, as the nodes allow.
+ *
+ * @return the node, or NULL if there are no connected nodes or none can take another request.
+ */
+static BREthereumNode
+lesSelectNodeForRequest (BREthereumLES les) {
+    BRArrayOf(BREthereumNode) nodes = les->activeNodesByRoute[NODE_ROUTE_TCP];
+    return nodeSelectForProvision (nodes, array_count(nodes));
+}
+
 static void
 lesHandleSelectError (BREthereumLES les,
                       int error) {
@@ -1202,28 +1215,32 @@ lesThread (BREthereumLES les) {
             if (NULL == les->requests[index].node) {
                 BREthereumNodeReference nodeRef = les->requests[index].nodeReference;
 
-                // We require all arbitary references to have been resolved when the
-                // provision was added as a request.  An `arbitary` reference is something like
-                // NODE_REFERENCE_{ANY,ALL} where the request did not specify a specific node
-                assert (!NODE_REFERENCE_IS_ARBITRARY(nodeRef));
+                // We require all arbitary references, other than NODE_REFERENCE_ANY, to have
+                // been resolved when the provision was added as a request.  An `arbitary`
+                // reference is something like NODE_REFERENCE_{NIL,ALL} where the request did not
+                // specify a specific node
+                assert (NODE_REFERENCE_ANY == nodeRef || !NODE_REFERENCE_IS_ARBITRARY(nodeRef));
 
                 // The request will be handled based on the `nodeReference` - if the reference is
-                // 'generic' we'll get a node from `activeNodesByRoute`; otherwise we'll use the
-                // specific node.
+                // NODE_REFERENCE_ANY we'll schedule the request on the active node expected to
+                // complete it first; if the reference is 'generic' we'll get a node from
+                // `activeNodesByRoute`; otherwise we'll use the specific node.
 
 #define ACTIVE_NODE(ref)                                                 \
     (((int)(ref)) < array_count(les->activeNodesByRoute[NODE_ROUTE_TCP]) \
      ? les->activeNodesByRoute[NODE_ROUTE_TCP][(int)(ref)]               \
      : NULL)
 
-                BREthereumNode nodeToUse = (NODE_REFERENCE_IS_GENERIC (nodeRef)
-                                            ? ACTIVE_NODE (nodeRef)
-                                            : (BREthereumNode) les->requests[index].nodeReference);
+                BREthereumNode nodeToUse = (NODE_REFERENCE_ANY == nodeRef
+                                            ? lesSelectNodeForRequest (les)
+                                            : (NODE_REFERENCE_IS_GENERIC (nodeRef)
+                                               ? ACTIVE_NODE (nodeRef)
+                                               : (BREthereumNode) les->requests[index].nodeReference));
 #undef ACTIVE_NODE
 
-                // If `nodeToUse` is NULL, then there may be no active nodes.  We'll leave the
-                // request unchanged and thus will come back to handling the request once we have
-                // some active nodes.
+                // If `nodeToUse` is NULL, then there may be no active nodes or all active nodes
+                // are busy.  We'll leave the request unchanged and thus will come back to handling
+                // the request once we have some active nodes.
                 //
                 // TODO: Consider a timeout on a request beging handled?
 
@@ -1578,8 +1595,8 @@ lesAddRequest (BREthereumLES les,
                OwnershipGiven BREthereumProvision provision) {
     assert (PROVISION_IDENTIFIER_UNDEFINED == provision.identifier);
 
-    if (NODE_REFERENCE_NIL == node) node = NODE_REFERENCE_0;
-    if (NODE_REFERENCE_ANY == node) node = NODE_REFERENCE_0;
+    // Any node will do; the request is scheduled, when handled, with the best available node.
+    if (NODE_REFERENCE_NIL == node) node = NODE_REFERENCE_ANY;
 
     pthread_mutex_lock (&les->lock);
     if (NODE_REFERENCE_ALL != node)
@@ -1873,6 +1890,10 @@ lesRetryProvision (BREthereumLES les,
  * Conclusion: It seems that since 'b' must be handled anyways... we'll send off all requests and
  * if we get disconnected - due to credits - we'll handle that with all the other disconnect cases.
  *
+ * Update: Nodes now do 'c' - see `nodeGetCreditsAvailable()` - tracking the remote's buffer limit,
+ * recharge rate and cost table from the remote status.  Requests for NODE_REFERENCE_ANY are
+ * scheduled with `lesSelectNodeForRequest()`.
+ *
  */
 
 //static void
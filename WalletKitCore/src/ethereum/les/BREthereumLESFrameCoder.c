@@ -303,7 +303,6 @@ BREthereumBoolean frameCoderInit(BREthereumLESFrameCoder fcoder,
     
     uint8_t* egressCipher, *ingressCipher;
     size_t egressCipherLen, ingressCipherLen;
-    uint8_t* gressBytes;
     
     
     if(ETHEREUM_BOOLEAN_IS_TRUE(didOriginate))
@@ -321,26 +320,18 @@ BREthereumBoolean frameCoderInit(BREthereumLESFrameCoder fcoder,
         ingressCipherLen = authCipherLen;
     }
     
-    size_t egressBytesLen = 32 + egressCipherLen;
-    array_new(gressBytes, egressBytesLen);
-    array_add_array(gressBytes, xORMacNonceEgress.u8, 32);
-    array_add_array(gressBytes, egressCipher, egressCipherLen);
-    
     // egress-mac = sha3.update(mac-secret ^ initiator-nonce || auth-sent-ack)
     fcoder->egressMac = keccak_create256();
-    keccak_update(fcoder->egressMac, gressBytes, egressBytesLen);
-    
-    size_t ingressBytesLen = 32 + ingressCipherLen;
-    array_insert_array(gressBytes, 0, xORMacNonceIngress.u8, 32);
-    array_insert_array(gressBytes, 32, ingressCipher, ingressCipherLen);
+    keccak_update(fcoder->egressMac, xORMacNonceEgress.u8, 32);
+    keccak_update(fcoder->egressMac, egressCipher, egressCipherLen);
     
     // ingress-mac = sha3.update(mac-secret ^ recipient-nonce || auth-recvd-init)
     fcoder->ingressMac = keccak_create256();
-    keccak_update(fcoder->ingressMac, gressBytes, ingressBytesLen);
+    keccak_update(fcoder->ingressMac, xORMacNonceIngress.u8, 32);
+    keccak_update(fcoder->ingressMac, ingressCipher, ingressCipherLen);
     
     //Destroy secrets & nonces.
     var_clean(localNonce->u8,remoteNonce->u8, keyMaterial);
-    array_free(gressBytes);
     
     return ETHEREUM_BOOLEAN_TRUE; 
 }
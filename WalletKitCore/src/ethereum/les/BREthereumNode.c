@@ -11,6 +11,7 @@
 #include <unistd.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/time.h>
 #include <pthread.h>
 #include <arpa/inet.h>
 #include <errno.h>
@@ -62,12 +63,39 @@ nodeSend (BREthereumNode node,
           BREthereumNodeEndpointRoute route,
           BREthereumMessage message);   // BRRlpData/BRRlpItem *optionalMessageData/Item
 
+static uint64_t
+nodeEstimateCredits (BREthereumNode node,
+                     BREthereumMessage message);
+
+static uint64_t
+nodeGetCreditsAvailable (BREthereumNode node,
+                         uint64_t now);
+
+static int
+nodeHasCreditsFor (BREthereumNode node,
+                   uint64_t credits,
+                   uint64_t now);
+
+static uint64_t
+nodeGetTimeInMilliseconds (void) {
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return 1000 * (uint64_t) tv.tv_sec + (uint64_t) tv.tv_usec / 1000;
+}
+
 #define DEFAULT_SEND_DATA_BUFFER_SIZE    (16 * 1024)
 #define DEFAULT_RECV_DATA_BUFFER_SIZE    (64 * 1024)
 
 #define DEFAULT_NODE_TIMEOUT_IN_SECONDS       (10)
 #define DEFAULT_NODE_TIMEOUT_IN_SECONDS_RECV  (60)      // 1 minute
 
+// The number of provisions a node will accept before LES schedules provisions elsewhere.  Each
+// provision's messages are sent as the node's flow control credits allow.
+#define NODE_PROVISIONS_IN_FLIGHT_LIMIT       (8)
+
+// The assumed provision latency, in milliseconds, until one is measured.
+#define DEFAULT_NODE_PROVISION_LATENCY        (500)
+
 //
 // Frame Coder Stuff
 //
@@ -311,6 +339,12 @@ typedef struct {
     /** Time of creation */
     long timestamp;
 
+    /** Time, in milliseconds, the first message was sent; zero if not yet sent */
+    uint64_t sendTimestamp;
+
+    /** The estimated credits for messages sent but not yet answered */
+    uint64_t creditsPending;
+
     BREthereumProvisionStatus status;
 
     /** The messages needed to complete the provision.  These may be LES (for GETH) or PIP (for
@@ -336,10 +370,15 @@ provisionerMessageOfInterest (BREthereumNodeProvisioner *provisioner,
             messageIdentifier < (provisioner->messageIdentifier + provisioner->messagesCount));
 }
 
+static BREthereumMessage
+provisionerGetMessageToSend (BREthereumNodeProvisioner *provisioner) {
+    return provisioner->messages [provisioner->messagesCount -
+                                  provisioner->messagesRemainingCount];
+}
+
 static BREthereumNodeStatus
 provisionerMessageSend (BREthereumNodeProvisioner *provisioner) {
-    BREthereumMessage message = provisioner->messages [provisioner->messagesCount -
-                                                       provisioner->messagesRemainingCount];
+    BREthereumMessage message = provisionerGetMessageToSend (provisioner);
     BREthereumNodeStatus status = nodeSend (provisioner->node, NODE_ROUTE_TCP, message);
     provisioner->messagesRemainingCount--;
 
@@ -485,8 +524,21 @@ struct BREthereumNodeRecord {
     // TODO: This should not be LES specific; applies to PIP too.
     BREthereumLESMessageSpec specs [NUMBER_OF_LES_MESSAGE_IDENTIFIERS];
 
-    /** Credit remaining (if not zero) */
+    /** Flow control.  The remote's buffer limit (BL) and minimum rate of recharge (MRR), in
+     * credits per millisecond, from the remote's status.  A zero limit is 'no flow control'. */
+    uint64_t creditsLimit;
+    uint64_t creditsRecharge;
+
+    /** Credits remaining, as last reported by the remote at `creditsTimestamp` (in milliseconds) */
     uint64_t credits;
+    uint64_t creditsTimestamp;
+
+    /** The estimated credits for all messages sent but not yet answered */
+    uint64_t creditsPending;
+
+    /** Smoothed time, in milliseconds, from sending a provision's first message until the
+     * provision completes; zero if not yet measured */
+    uint64_t latency;
 
     /** Callbacks */
     BREthereumNodeContext callbackContext;
@@ -538,7 +590,9 @@ nodeShow (BREthereumNode node) {
     eth_log (LES_LOG_TOPIC, "   UDP       : %s", nodeStateDescribe (&node->states[NODE_ROUTE_UDP], descUDP));
     eth_log (LES_LOG_TOPIC, "   TCP       : %s", nodeStateDescribe (&node->states[NODE_ROUTE_TCP], descTCP));
     eth_log (LES_LOG_TOPIC, "   Discovered: %s", (ETHEREUM_BOOLEAN_IS_TRUE(node->discovered) ? "Yes" : "No"));
-    eth_log (LES_LOG_TOPIC, "   Credits   : %" PRIu64, node->credits);
+    eth_log (LES_LOG_TOPIC, "   Credits   : %" PRIu64 " of %" PRIu64 " (%" PRIu64 " pending)",
+             node->credits, node->creditsLimit, node->creditsPending);
+    eth_log (LES_LOG_TOPIC, "   Latency   : %" PRIu64 " ms", node->latency);
 }
 
 extern const BREthereumNodeEndpoint
@@ -683,8 +737,15 @@ nodeCreate (BREthereumNodePriority priority,
     for (int i = 0; i < NUMBER_OF_LES_MESSAGE_IDENTIFIERS; i++)
         node->specs[i] = messageLESSpecs[i];
 
-    // No credits, yet.
+    // No credits, yet.  Flow control is defined with the remote's status.
+    node->creditsLimit = 0;
+    node->creditsRecharge = 0;
     node->credits = 0;
+    node->creditsTimestamp = 0;
+    node->creditsPending = 0;
+
+    // No latency, yet.
+    node->latency = 0;
 
     node->sendDataBuffer = (BRRlpData) { DEFAULT_SEND_DATA_BUFFER_SIZE, malloc (DEFAULT_SEND_DATA_BUFFER_SIZE) };
     node->recvDataBuffer = (BRRlpData) { DEFAULT_RECV_DATA_BUFFER_SIZE, malloc (DEFAULT_RECV_DATA_BUFFER_SIZE) };
@@ -888,9 +949,94 @@ nodeUnhandleProvisions (BREthereumNode node) {
     for (size_t index = 0; index < array_count(node->provisioners); index++)
         array_add (provisions, node->provisioners[index].provision);
     array_clear(node->provisioners);
+
+    // With no provisioners, nothing is pending.
+    node->creditsPending = 0;
     return provisions;
 }
 
+extern uint64_t
+nodeEstimateProvisionDelay (BREthereumNode node) {
+    size_t provisionsCount = array_count (node->provisioners);
+    if (provisionsCount >= NODE_PROVISIONS_IN_FLIGHT_LIMIT) return UINT64_MAX;
+
+    // Another provision waits, roughly, on the provisions already in flight.
+    uint64_t latency = (0 != node->latency ? node->latency : DEFAULT_NODE_PROVISION_LATENCY);
+    uint64_t delay   = latency * (1 + provisionsCount);
+
+    // Add the time for the remote to recharge the credits needed by the messages not yet sent.
+    if (0 != node->creditsLimit && 0 != node->creditsRecharge) {
+        uint64_t credits = 0;
+        for (size_t index = 0; index < provisionsCount; index++) {
+            BREthereumNodeProvisioner *provisioner = &node->provisioners[index];
+            for (size_t mi = provisioner->messagesCount - provisioner->messagesRemainingCount; mi < provisioner->messagesCount; mi++)
+                credits += nodeEstimateCredits (node, provisioner->messages[mi]);
+        }
+
+        uint64_t available = nodeGetCreditsAvailable (node, nodeGetTimeInMilliseconds());
+        if (credits > available)
+            delay += (credits - available) / node->creditsRecharge;
+    }
+
+    return delay;
+}
+
+extern BREthereumNode
+nodeSelectForProvision (OwnershipKept BREthereumNode *nodes,
+                        size_t nodesCount) {
+    BREthereumNode nodeToUse = NULL;
+    uint64_t nodeToUseDelay  = UINT64_MAX;
+
+    for (size_t index = 0; index < nodesCount; index++)
+        if (nodeHasState (nodes[index], NODE_ROUTE_TCP, NODE_CONNECTED)) {
+            uint64_t delay = nodeEstimateProvisionDelay (nodes[index]);
+            if (delay < nodeToUseDelay) {
+                nodeToUse      = nodes[index];
+                nodeToUseDelay = delay;
+            }
+        }
+
+    return nodeToUse;
+}
+
+/**
+ * Hold the credits for `message`, sent by `provisioner`, as pending until the message is answered.
+ */
+static void
+nodeCreditsSent (BREthereumNode node,
+                 BREthereumNodeProvisioner *provisioner,
+                 BREthereumMessage message) {
+    uint64_t credits = nodeEstimateCredits (node, message);
+    provisioner->creditsPending += credits;
+    node->creditsPending += credits;
+}
+
+/**
+ * Release the pending credits for `provisioner`'s message with `messageIdentifier`; the message has
+ * been answered and its credits are accounted for in the remote's reported credits.
+ */
+static void
+nodeCreditsAnswered (BREthereumNode node,
+                     BREthereumNodeProvisioner *provisioner,
+                     uint64_t messageIdentifier) {
+    uint64_t credits = nodeEstimateCredits (node, provisioner->messages [messageIdentifier - provisioner->messageIdentifier]);
+    credits = (credits < provisioner->creditsPending ? credits : provisioner->creditsPending);
+    provisioner->creditsPending -= credits;
+    node->creditsPending -= (credits < node->creditsPending ? credits : node->creditsPending);
+}
+
+/**
+ * Release all of `provisioner`'s pending credits, for messages that won't be answered (e.g. SEND_TX2)
+ */
+static void
+nodeCreditsReleased (BREthereumNode node,
+                     BREthereumNodeProvisioner *provisioner) {
+    node->creditsPending -= (provisioner->creditsPending < node->creditsPending
+                             ? provisioner->creditsPending
+                             : node->creditsPending);
+    provisioner->creditsPending = 0;
+}
+
 static void
 nodeHandleProvisionerMessage (BREthereumNode node,
                               BREthereumNodeProvisioner *provisioner,
@@ -917,6 +1063,16 @@ nodeHandleProvisionerMessage (BREthereumNode node,
                      nodeEndpointGetHostname(node->remote));
         }
 
+        // ... update the latency, on success, as a moving average,
+        if (PROVISION_SUCCESS == provisioner->status && 0 != provisioner->sendTimestamp) {
+            uint64_t now = nodeGetTimeInMilliseconds();
+            uint64_t latency = (now > provisioner->sendTimestamp ? now - provisioner->sendTimestamp : 0);
+            node->latency = (0 == node->latency ? latency : (7 * node->latency + latency) / 8);
+        }
+
+        // ... release credits for messages that won't be answered (e.g. SEND_TX2)
+        nodeCreditsReleased (node, provisioner);
+
         node->callbackProvide (node->callbackContext, node, result);
 
         // ... and remove the provisioner
@@ -1071,6 +1227,10 @@ nodeProcessRecvLES (BREthereumNode node,
                 // ... using the message's requestId
                 if (provisionerMessageOfInterest (provisioner, messageLESGetRequestId (&message))) {
                     mustReleaseMessage = 0;
+
+                    // The request has been answered; its credits are no longer pending.
+                    nodeCreditsAnswered (node, provisioner, messageLESGetRequestId (&message));
+
                     // When found, handle it.
                     nodeHandleProvisionerMessage (node, provisioner,
                                                   (BREthereumMessage) {
@@ -1239,6 +1399,46 @@ nodeDefineRemoteStatus (BREthereumNode node,
     }
 
     nodeEndpointSetStatus (node->remote, messageP2PStatusCopy (&status));
+
+    // Define flow control from the status: the message costs, the buffer limit and the recharge
+    // rate.  We start with a full buffer.
+    if (NODE_TYPE_GETH == node->type) {
+        BREthereumP2PMessageStatusValue value;
+        BREthereumLESMessageStatus *lesStatus = &message.u.les.u.status;
+
+        for (int i = 0; i < NUMBER_OF_LES_MESSAGE_IDENTIFIERS; i++)
+            if (LES_MESSAGE_USE_REQUEST == node->specs[i].use && i == lesStatus->costs[i].msgCode &&
+                (0 != lesStatus->costs[i].baseCost || 0 != lesStatus->costs[i].reqCost)) {
+                node->specs[i].baseCost = lesStatus->costs[i].baseCost;
+                node->specs[i].reqCost  = lesStatus->costs[i].reqCost;
+            }
+
+        node->creditsLimit = (messageP2PStatusExtractValue (&status, P2P_MESSAGE_STATUS_FLOW_CONTROL_BL, &value)
+                              ? value.u.integer
+                              : 0);
+        node->creditsRecharge = (messageP2PStatusExtractValue (&status, P2P_MESSAGE_STATUS_FLOW_CONTROL_MRR, &value)
+                                 ? value.u.integer
+                                 : 0);
+        node->credits = node->creditsLimit;
+        node->creditsTimestamp = nodeGetTimeInMilliseconds();
+        node->creditsPending = 0;
+    }
+}
+
+/**
+ * Find the provisioner with the next message to send.  Provisioners are handled in order; if the
+ * remote's estimated credits won't cover the next message, then nothing is sent until the remote
+ * either recharges or answers pending requests.
+ */
+static BREthereumNodeProvisioner *
+nodeGetProvisionerToSend (BREthereumNode node,
+                          uint64_t now) {
+    for (size_t index = 0; index < array_count (node->provisioners); index++)
+        if (provisionerSendMessagesPending (&node->provisioners[index]))
+            return (nodeHasCreditsFor (node, nodeEstimateCredits (node, provisionerGetMessageToSend (&node->provisioners[index])), now)
+                    ? &node->provisioners[index]
+                    : NULL);
+    return NULL;
 }
 
 static int
@@ -1360,21 +1560,23 @@ nodeProcess (BREthereumNode node,
                     case NODE_ROUTE_UDP:
                         break;
 
-                    case NODE_ROUTE_TCP:
-                        // Look for the pending message in some provisioner
-                        for (size_t index = 0; index < array_count (node->provisioners); index++)
-                            if (provisionerSendMessagesPending (&node->provisioners[index])) {
-                                BREthereumNodeStatus status = provisionerMessageSend(&node->provisioners[index]);
-                                switch (status) {
-                                    case NODE_STATUS_SUCCESS:
-                                        break;
-                                    case NODE_STATUS_ERROR:
-                                        break;
-                                }
-                                // Only send one at a time - socket might be blocked
-                                break; // from for node->provisioners
-                            }
+                    case NODE_ROUTE_TCP: {
+                        // Look for the pending message in some provisioner; the message is sent
+                        // only if the remote has the credits for it.  Multiple messages, from
+                        // multiple provisioners, might be in flight at once.
+                        uint64_t nowInMilliseconds = nodeGetTimeInMilliseconds();
+                        BREthereumNodeProvisioner *provisioner = nodeGetProvisionerToSend (node, nowInMilliseconds);
+                        if (NULL != provisioner) {
+                            nodeCreditsSent (node, provisioner, provisionerGetMessageToSend (provisioner));
+
+                            if (0 == provisioner->sendTimestamp)
+                                provisioner->sendTimestamp = nowInMilliseconds;
+
+                            // Only send one at a time - socket might be blocked
+                            provisionerMessageSend (provisioner);
+                        }
                         break;
+                    }
                 }
             }
 
@@ -1835,12 +2037,10 @@ nodeUpdateDescriptors (BREthereumNode node,
             if (NULL != recv)
                 FD_SET (socket, recv);
 
-            // If we have any provisioner with a pending message, we are willing to send
-            for (size_t index = 0; index < array_count (node->provisioners); index++)
-                if (provisionerSendMessagesPending (&node->provisioners[index])) {
-                    if (NULL != send) FD_SET (socket, send);
-                    break;
-                }
+            // If we have any provisioner with a pending message, and the credits to send it, we
+            // are willing to send.  Otherwise, we'll check again as credits are recharged.
+            if (NULL != send && NULL != nodeGetProvisionerToSend (node, nodeGetTimeInMilliseconds()))
+                FD_SET (socket, send);
 
             break;
 
@@ -2173,8 +2373,10 @@ nodeRecv (BREthereumNode node,
             // If this is a LES response message, then it has credit information.
             if (!rlpCoderHasFailed(node->coder.rlp) &&
                 MESSAGE_LES == message.identifier &&
-                messageLESHasUse (&message.u.les, LES_MESSAGE_USE_RESPONSE))
+                messageLESHasUse (&message.u.les, LES_MESSAGE_USE_RESPONSE)) {
                 node->credits = messageLESGetCredits (&message.u.les);
+                node->creditsTimestamp = nodeGetTimeInMilliseconds();
+            }
             
             rlpItemRelease (node->coder.rlp, item);
             rlpItemRelease (node->coder.rlp, identifierItem);
@@ -2209,10 +2411,6 @@ nodeRecv (BREthereumNode node,
 }
 
 
-#pragma clang diagnostic push
-#pragma GCC diagnostic push
-#pragma clang diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-function"
 static uint64_t
 nodeEstimateCredits (BREthereumNode node,
                      BREthereumMessage message) {
@@ -2227,12 +2425,112 @@ nodeEstimateCredits (BREthereumNode node,
     }
 }
 
+/**
+ * Estimate the remote's credits available to us at `now`: the last reported credits recharged,
+ * up to the buffer limit, since then and less the credits for messages not yet answered.
+ */
 static uint64_t
-nodeGetCredits (BREthereumNode node) {
-    return node->credits;
+nodeGetCreditsAvailable (BREthereumNode node,
+                         uint64_t now) {
+    if (0 == node->creditsLimit) return UINT64_MAX;
+
+    uint64_t credits = (node->credits < node->creditsLimit ? node->credits : node->creditsLimit);
+    uint64_t elapsed = (now > node->creditsTimestamp ? now - node->creditsTimestamp : 0);
+
+    if (0 != node->creditsRecharge)
+        credits = (elapsed >= (node->creditsLimit - credits) / node->creditsRecharge
+                   ? node->creditsLimit
+                   : credits + elapsed * node->creditsRecharge);
+
+    return (credits > node->creditsPending ? credits - node->creditsPending : 0);
+}
+
+static int
+nodeHasCreditsFor (BREthereumNode node,
+                   uint64_t credits,
+                   uint64_t now) {
+    uint64_t available = nodeGetCreditsAvailable (node, now);
+
+    // With a full buffer and nothing pending, send anyway.  Otherwise a message costing more than
+    // the buffer limit would never be sent; the remote might disconnect but that is handled.
+    return (credits <= available ||
+            (0 == node->creditsPending && available == node->creditsLimit));
+}
+
+/// MARK: - Testing
+
+extern void
+nodeSetStatusForTest (BREthereumNode node,
+                      uint64_t creditsLimit,
+                      uint64_t creditsRecharge,
+                      uint64_t baseCost,
+                      uint64_t reqCost,
+                      uint64_t now) {
+    // As if connected to a GETH remote, with flow control from its status.
+    node->type = NODE_TYPE_GETH;
+    node->states[NODE_ROUTE_TCP] = nodeStateCreate (NODE_CONNECTED);
+
+    for (int i = 0; i < NUMBER_OF_LES_MESSAGE_IDENTIFIERS; i++)
+        if (LES_MESSAGE_USE_REQUEST == node->specs[i].use) {
+            node->specs[i].baseCost = baseCost;
+            node->specs[i].reqCost  = reqCost;
+        }
+
+    node->creditsLimit = creditsLimit;
+    node->creditsRecharge = creditsRecharge;
+    node->credits = creditsLimit;
+    node->creditsTimestamp = now;
+    node->creditsPending = 0;
+}
+
+extern uint64_t
+nodeGetCreditsAvailableForTest (BREthereumNode node,
+                                uint64_t now) {
+    return nodeGetCreditsAvailable (node, now);
+}
+
+extern uint64_t
+nodeGetCreditsPendingForTest (BREthereumNode node) {
+    return node->creditsPending;
+}
+
+extern int
+nodeHasCreditsForTest (BREthereumNode node,
+                       uint64_t credits,
+                       uint64_t now) {
+    return nodeHasCreditsFor (node, credits, now);
+}
+
+extern uint64_t
+nodeSendProvisionForTest (BREthereumNode node,
+                          uint64_t now) {
+    // As for NODE_ROUTE_TCP in nodeProcess(), but the message is not actually sent.
+    BREthereumNodeProvisioner *provisioner = nodeGetProvisionerToSend (node, now);
+    if (NULL == provisioner) return UINT64_MAX;
+
+    uint64_t messageIdentifier = (provisioner->messageIdentifier +
+                                  provisioner->messagesCount - provisioner->messagesRemainingCount);
+    nodeCreditsSent (node, provisioner, provisionerGetMessageToSend (provisioner));
+    provisioner->messagesRemainingCount--;
+
+    return messageIdentifier;
+}
+
+extern void
+nodeAnswerProvisionForTest (BREthereumNode node,
+                            uint64_t messageIdentifier,
+                            uint64_t credits,
+                            uint64_t now) {
+    // As for a LES response in nodeProcess(), but the response is not handled.
+    for (size_t index = 0; index < array_count (node->provisioners); index++)
+        if (provisionerMessageOfInterest (&node->provisioners[index], messageIdentifier)) {
+            nodeCreditsAnswered (node, &node->provisioners[index], messageIdentifier);
+            break;
+        }
+
+    node->credits = credits;
+    node->creditsTimestamp = now;
 }
-#pragma clang diagnostic pop
-#pragma GCC diagnostic pop
 
 /// MARK: - Discovered
 
@@ -271,6 +271,24 @@ nodeHandleProvision (BREthereumNode node,
 extern BRArrayOf(BREthereumProvision)
 nodeUnhandleProvisions (BREthereumNode node);
 
+/**
+ * Estimate the time, in milliseconds, for `node` to complete another provision given the node's
+ * measured latency, its provisions in flight and its flow control credits.  If `node` should not
+ * take on another provision now, return UINT64_MAX.
+ */
+extern uint64_t
+nodeEstimateProvisionDelay (BREthereumNode node);
+
+/**
+ * Select, from `nodes`, the node connected on TCP that is expected to complete another provision
+ * first; see nodeEstimateProvisionDelay().
+ *
+ * @return the node, or NULL if no node is connected or none can take another provision.
+ */
+extern BREthereumNode
+nodeSelectForProvision (OwnershipKept BREthereumNode *nodes,
+                        size_t nodesCount);
+
 extern const BREthereumNodeEndpoint
 nodeGetRemoteEndpoint (BREthereumNode node);
 
@@ -342,6 +360,41 @@ typedef struct {
 extern void
 nodeShow (BREthereumNode node);
 
+///////
+/**
+ * TODO: These really should be private functions for testing flow control
+ */
+extern void
+nodeSetStatusForTest (BREthereumNode node,
+                      uint64_t creditsLimit,
+                      uint64_t creditsRecharge,
+                      uint64_t baseCost,
+                      uint64_t reqCost,
+                      uint64_t now);
+
+extern uint64_t
+nodeGetCreditsAvailableForTest (BREthereumNode node,
+                                uint64_t now);
+
+extern uint64_t
+nodeGetCreditsPendingForTest (BREthereumNode node);
+
+extern int
+nodeHasCreditsForTest (BREthereumNode node,
+                       uint64_t credits,
+                       uint64_t now);
+
+extern uint64_t
+nodeSendProvisionForTest (BREthereumNode node,
+                          uint64_t now);
+
+extern void
+nodeAnswerProvisionForTest (BREthereumNode node,
+                            uint64_t messageIdentifier,
+                            uint64_t credits,
+                            uint64_t now);
+///////
+
 #ifdef __cplusplus
 }
 #endif
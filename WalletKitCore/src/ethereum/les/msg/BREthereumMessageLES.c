@@ -258,13 +258,7 @@ messageLESBlockHeadersDecode (BRRlpItem item,
     uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
     uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
 
-    size_t headerItemsCount = 0;
-    const BRRlpItem *headerItems = rlpDecodeList (coder.rlp, items[2], &headerItemsCount);
-
-    BRArrayOf(BREthereumBlockHeader) headers;
-    array_new (headers, headerItemsCount);
-    for (size_t index = 0; index < headerItemsCount; index++)
-        array_add (headers, blockHeaderRlpDecode (headerItems[index], RLP_TYPE_NETWORK, coder.rlp));
+    BRArrayOf(BREthereumBlockHeader) headers = blockHeadersRlpDecode (items[2], RLP_TYPE_NETWORK, coder.rlp);
 
     return (BREthereumLESMessageBlockHeaders) {
         reqId,
@@ -16,6 +16,38 @@
 
 #define AS_UINT64(x)  ((uint64_t) (x))
 
+//
+// The arithmetic kernels operate on a UInt256 as four 64-bit limbs, least significant first.  A
+// 64 x 64 -> 128 bit product, and a 128 / 64 bit quotient, use `unsigned __int128` if the compiler
+// provides it; otherwise the product is formed from 32-bit halves and division is in 32-bit limbs.
+//
+static inline uint64_t
+uint64MulFull (uint64_t x, uint64_t y, uint64_t *hi) {
+#if defined (__SIZEOF_INT128__)
+    unsigned __int128 z = (unsigned __int128) x * y;
+    *hi = (uint64_t) (z >> 64);
+    return (uint64_t) z;
+#else
+    uint64_t x0 = (uint32_t) x, x1 = x >> 32;
+    uint64_t y0 = (uint32_t) y, y1 = y >> 32;
+
+    uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    uint64_t mid = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t) p00;
+#endif
+}
+
+// Return x * y + a + b, as the low 64 bits, with the high 64 bits in `hi`.  Never overflows.
+static inline uint64_t
+uint64MulAddAdd (uint64_t x, uint64_t y, uint64_t a, uint64_t b, uint64_t *hi) {
+    uint64_t lo = uint64MulFull (x, y, hi);
+    lo += a; *hi += (lo < a);
+    lo += b; *hi += (lo < b);
+    return lo;
+}
+
 extern UInt256
 uint256Create (uint64_t value) {
     UInt256 result = { .u64 = { value, 0, 0, 0}};
@@ -69,16 +101,16 @@ uint256Add_Overflow (const UInt256 y, const UInt256 x, int *overflow) {
     assert (overflow != NULL);
     
     UInt256 z = UINT256_ZERO;
-    unsigned int count = sizeof (UInt256) / sizeof(uint32_t);
-    
-    // x = xa*2^0 + xb*2^32 + ...
-    // y = ya*2^0 + yb*2^32 + ...
-    // z = (xa + ya)*2^0 + (xb + yb)*2^32 + ...
+
+    // x = xa*2^0 + xb*2^64 + ...
+    // y = ya*2^0 + yb*2^64 + ...
+    // z = (xa + ya)*2^0 + (xb + yb)*2^64 + ...
     uint64_t carry = 0;
-    for (int i = 0; i < count; i++) {
-        uint64_t sum = AS_UINT64(x.u32[i]) + AS_UINT64(y.u32[i]) + carry;
-        carry = sum >> 32;
-        z.u32[i] = (uint32_t) sum;
+    for (int i = 0; i < 4; i++) {
+        uint64_t sum = x.u64[i] + carry;
+        carry = (sum < carry);
+        z.u64[i] = sum + y.u64[i];
+        carry += (z.u64[i] < sum);
     }
     
     *overflow = (int) carry;
@@ -149,33 +181,53 @@ uint256Mul (const UInt256 x, const UInt256 y) {
     //  assert (__LITTLE_ENDIAN__ == BYTE_ORDER);
     UInt512 z = UINT512_ZERO;
     
-    size_t count = sizeof (UInt256) / sizeof(uint32_t);
-    
-    // Use 'grade school' long multiplication in base 32.  For UInt256 we'll have 8 32-bit value
-    // and perform 64 32-bit multiplications.  A more sophisticated algorith, e.g. Katasuba, can
-    // perform just 27 32-bit multiplications.  For our application, not a big enough savings for
-    // the added complexity.
-    for (size_t xi = 0; xi < count; xi++) {
+    // Use 'grade school' long multiplication in base 64.  For UInt256 we'll have 4 64-bit values
+    // and perform 16 64 x 64 -> 128 bit multiplications.  A more sophisticated algorith, e.g.
+    // Katasuba, performs fewer.  For our application, not a big enough savings for the added
+    // complexity.
+    for (size_t xi = 0; xi < 4; xi++) {
         uint64_t carry = 0;
-        if (x.u32[xi] == 0) continue;
-        for (size_t yi = 0; yi < count; yi++) {
-            uint64_t total = z.u32[yi + xi] + carry + AS_UINT64 (y.u32[yi]) * AS_UINT64 (x.u32[xi]);
-            carry = total >> 32;
-            z.u32[yi + xi] = (uint32_t) total;
-        }
-        z.u32[xi + count] += carry;
+        if (x.u64[xi] == 0) continue;
+        for (size_t yi = 0; yi < 4; yi++)
+            z.u64[yi + xi] = uint64MulAddAdd (x.u64[xi], y.u64[yi], z.u64[yi + xi], carry, &carry);
+        z.u64[xi + 4] = carry;
     }
     return z;
 }
 
 extern UInt256
 uint256Mul_Overflow (UInt256 x, UInt256 y, int *overflow) {
-    return uint256Coerce (uint256Mul (x, y), overflow);
+    assert (NULL != overflow);
+    UInt256 z = UINT256_ZERO;
+    int over = 0;
+
+    // As `uint256Mul()` but only the low four limbs of the product are formed.  The product
+    // overflows if any x[i] * y[j] lands at or above limb 4, or if a carry leaves limb 3.
+    for (size_t xi = 0; xi < 4; xi++) {
+        uint64_t carry = 0;
+        if (x.u64[xi] == 0) continue;
+        for (size_t yi = 0; yi < 4 - xi; yi++)
+            z.u64[yi + xi] = uint64MulAddAdd (x.u64[xi], y.u64[yi], z.u64[yi + xi], carry, &carry);
+        for (size_t yi = 4 - xi; yi < 4; yi++)
+            carry |= y.u64[yi];
+        over |= (0 != carry);
+    }
+
+    *overflow = over;
+    return over ? UINT256_ZERO : z;
 }
 
 extern UInt256
 uint256Mul_Small (UInt256 x, uint32_t y, int *overflow) {
-    return uint256Mul_Overflow(x, uint256Create (y), overflow);
+    assert (NULL != overflow);
+    UInt256 z;
+
+    uint64_t carry = 0;
+    for (size_t xi = 0; xi < 4; xi++)
+        z.u64[xi] = uint64MulAddAdd (x.u64[xi], y, 0, carry, &carry);
+
+    *overflow = (0 != carry);
+    return *overflow ? UINT256_ZERO : z;
 }
 
 extern UInt256
@@ -239,14 +291,36 @@ uint256Mul_Double (UInt256 x, double y, int *overflow, int *negative, double *re
 extern UInt256
 uint256Div_Small (UInt256 x, uint32_t y, uint32_t *rem) {
     assert (NULL != rem);
+    uint64_t remainder;
+    UInt256 z = uint256Div_Small64 (x, y, &remainder);
+    *rem = (uint32_t) remainder;
+    return z;
+}
+
+extern UInt256
+uint256Div_Small64 (UInt256 x, uint64_t y, uint64_t *rem) {
+    assert (NULL != rem && 0 != y);
     UInt256 z = UINT256_ZERO;
     uint64_t remainder = 0;
-    for (int i = 7; i >= 0; i--) {
-        uint64_t value = AS_UINT64(x.u32[i]) + remainder * (AS_UINT64(1) << 32);
-        z.u32[i] = (uint32_t) (value / y);
-        remainder = value % y;
+#if defined (__SIZEOF_INT128__)
+    for (int i = 3; i >= 0; i--) {
+        unsigned __int128 value = ((unsigned __int128) remainder << 64) | x.u64[i];
+        z.u64[i]  = (uint64_t) (value / y);
+        remainder = (uint64_t) (value % y);
     }
-    *rem = (uint32_t) remainder;
+#else
+    // Without a 128-bit dividend, long division one bit at a time.  The remainder stays below
+    // `y` and thus below 2^64, once shifted, but for the top bit of a `y` above 2^63.
+    for (int i = 255; i >= 0; i--) {
+        uint64_t top = remainder >> 63;
+        remainder = (remainder << 1) | ((x.u64[i / 64] >> (i % 64)) & 1);
+        if (top || remainder >= y) {
+            remainder -= y;
+            z.u64[i / 64] |= (AS_UINT64(1) << (i % 64));
+        }
+    }
+#endif
+    *rem = remainder;
     return z;
 }
 
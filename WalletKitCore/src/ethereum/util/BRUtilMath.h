@@ -138,6 +138,12 @@ uint256Mul_Double (UInt256 x, double y, int *overflow, int *negative, double *re
 extern UInt256
 uint256Div_Small (UInt256 x, uint32_t y, uint32_t *rem);
 
+/**
+ * Divide `x` by `y`, a non-zero uint64_t, filling `rem` with the remainder.
+ */
+extern UInt256
+uint256Div_Small64 (UInt256 x, uint64_t y, uint64_t *rem);
+
 /**
  * Coerce `x`, a UInt512, to a UInt256.  If `x` is too big then overflow is set to 1 and
  * zero is returned.
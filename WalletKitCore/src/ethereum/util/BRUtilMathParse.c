@@ -65,6 +65,9 @@ stringParseIsDecimal(const char *number) {
 
 #define SURELY_ENOUGH_CHARS 100     // No more than ~78 in UInt256
 
+#define UINT256_DECIMAL_CHUNK           (10000000000000000000u)    // 10^19
+#define UINT256_DECIMAL_CHUNK_DIGITS    (19)
+
 extern UInt256
 uint256CreateParseDecimal (const char *string, int decimals, BRCoreParseStatus *status) {
     // Check basic `string` content.
@@ -192,20 +195,17 @@ parseUInt256ScaleByPower (UInt256 value, int base, int power, int *overflow) {
             : uint256Mul_Overflow(value, scale, overflow));
 }
 
+// Parse at most `digits` digits from `string`.  The digits have been validated for `base` by
+// `parseInIntegerInBase()` and `digits` won't overflow a uint64_t.
 static UInt256
 parseUInt64 (const char *string, int digits, int base) {
     size_t maxDigits = parseMaximumDigitsForUInt64InBase(base);
     assert (digits <= maxDigits );
-    
-    //
-    char number[1 + maxDigits], *numberEnd;
-    strncpy (number, string, maxDigits);
-    number[maxDigits] = '\0';
-
-    errno = 0;
-    uint64_t value = strtoull (number, &numberEnd, base);
-    if (0 == errno && (*number == '\0' || numberEnd == NULL || *numberEnd != '\0'))
-        errno = EINVAL;
+
+    uint64_t value = 0;
+    for (int index = 0; index < digits && '\0' != string[index]; index++)
+        value = value * (uint64_t) base + _hexu (string[index]);
+
     return uint256Create (value);
 }
 
@@ -262,16 +262,11 @@ uint256CreateParse (const char *string, int base, BRCoreParseStatus *status) {
 
     // For parsing a string like "123.45", the character at index 0 is '1'.  So by parsing chunks
     // with ascending index, we naturally treat `string` as big endian - no matter the base.
-    // Eventually, when `parseUInt64()` calls `strtoull` we'll still be using big endian.
+    // And `parseUInt64()` accumulates each chunk's digits most significant first.
     for (size_t index = 0; index < length; index += stringChunks) {
         // On the first time through, get an initial value
-        if (index == 0) {
+        if (index == 0)
             value = parseUInt64(string, (int) stringChunks, base);
-            if (errno != 0) {
-                *status = CORE_PARSE_STRANGE_DIGITS;
-                return UINT256_ZERO;
-            }
-        }
         
         // Otherwise, we'll scale value and add in the next chunk.
         else {
@@ -296,18 +291,6 @@ uint256CreateParse (const char *string, int base, BRCoreParseStatus *status) {
     return value;
 }
 
-//
-//
-//
-static char *
-coerceReverseString (const char *s) {
-    size_t len = strlen(s);
-    char *t = calloc (1 + len, 1);
-    for (size_t i = 0; i < len; i++)
-        t[len - i - 1] = s[i];
-    return t;
-}
-
 extern char *
 uint256CoerceString (UInt256 x, int base) {
     // Handle 0 explicitly, rather than in each case
@@ -333,16 +316,25 @@ uint256CoerceString (UInt256 x, int base) {
             return hexEncodeCreate (NULL, &xr.u8[xrIndex], sizeof (xr.u8) - xrIndex);
         }
             
-            // Repeatedly divide by 10; append the result with the remainder.
+            // Repeatedly divide by 10^19, the largest power of 10 in a uint64_t; prepend the
+            // remainder's 19 digits to the result.  The last, most significant, remainder is
+            // prepended without leading zeros.
         case 10: {
-            char r[257];
-            memset (r, 0, 257);
-            for (int i = 0; i < 256 && !uint256EQL(x, UINT256_ZERO); i++) {
-                uint32_t rem;
-                x = uint256Div_Small(x, (uint32_t) base, &rem);
-                r[i] = '0' + rem;
+            char r[SURELY_ENOUGH_CHARS];
+            size_t rIndex = sizeof (r) - 1;
+            r[rIndex] = '\0';
+
+            while (!uint256EQL(x, UINT256_ZERO)) {
+                uint64_t rem;
+                x = uint256Div_Small64 (x, UINT256_DECIMAL_CHUNK, &rem);
+
+                int isLast = uint256EQL(x, UINT256_ZERO);
+                for (int i = 0; i < UINT256_DECIMAL_CHUNK_DIGITS && (!isLast || 0 != rem); i++) {
+                    r[--rIndex] = (char) ('0' + rem % 10);
+                    rem /= 10;
+                }
             }
-            return coerceReverseString(r);
+            return strdup (&r[rIndex]);
         }
             
             // Get the base 16 result and then swap hex values for binary strings.
@@ -353,20 +353,26 @@ hederaTransactionSignTransaction (BRHederaTransaction transaction,
         transaction->serializedSize = 0;
     }
 
-    // Generate the private key from the seed
+    // Generate the private key from the seed; only the expanded secret is needed since the public
+    // key is sent in, which skips recomputing it for every signing.  The expanded secret is then
+    // shared by every serialization signed below.
     BRKey key = hederaKeyCreate (seed);
     unsigned char privateKey[64] = {0};
-    unsigned char temp[32] = {0}; // Use the public key that is sent in instead
-    ed25519_create_keypair (temp, privateKey, key.secret.u8);
+    ed25519_expand_seed (privateKey, key.secret.u8);
     BRHederaUnitTinyBar fee = hederaFeeBasisGetFee(&transaction->feeBasis);
+    size_t size;
 
     if (nodeAddress != NULL) {
         // Create a single sign payload for the specified Hedera node
-        return hederaTransactionSignTransactionV0(transaction, publicKey, privateKey, fee, nodeAddress);
+        size = hederaTransactionSignTransactionV0(transaction, publicKey, privateKey, fee, nodeAddress);
     } else {
         // Create a payload with signed serializations for all the (knonw) nodes
-        return hederaTransactionSignMultipleSerializations(transaction, publicKey, privateKey, fee);
+        size = hederaTransactionSignMultipleSerializations(transaction, publicKey, privateKey, fee);
     }
+
+    mem_clean (privateKey, sizeof (privateKey));
+    BRKeyClean (&key);
+    return size;
 }
 
 extern uint8_t * hederaTransactionSerialize (BRHederaTransaction transaction, size_t *size)
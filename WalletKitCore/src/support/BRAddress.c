@@ -263,6 +263,13 @@ const uint8_t *BRScriptPKH(const uint8_t *script, size_t scriptLen)
     assert(script != NULL || scriptLen == 0);
     if (! script || scriptLen == 0 || scriptLen > MAX_SCRIPT_LENGTH) return NULL;
 
+    // match standard pay-to-pubkey-hash, pay-to-script-hash and pay-to-witness-pubkey-hash scripts without parsing
+    // elements, since wallets check every output script of every transaction
+    if (scriptLen == 25 && script[0] == OP_DUP && script[1] == OP_HASH160 && script[2] == 20 &&
+        script[23] == OP_EQUALVERIFY && script[24] == OP_CHECKSIG) return &script[3];
+    if (scriptLen == 23 && script[0] == OP_HASH160 && script[1] == 20 && script[22] == OP_EQUAL) return &script[2];
+    if (scriptLen == 22 && script[0] == OP_0 && script[1] == 20) return &script[2];
+
     const uint8_t *elems[BRScriptElements(NULL, 0, script, scriptLen)], *r = NULL;
     size_t l, count = BRScriptElements(elems, sizeof(elems)/sizeof(*elems), script, scriptLen);
     
@@ -457,6 +464,43 @@ size_t BRAddressFromHash160(char *addr, size_t addrLen, BRAddressParams params,
     return (! addr || r <= addrLen) ? r : 0;
 }
 
+// writes the addresses for count hash160s (count*20 bytes at md20s) to addrs, as with BRAddressFromHash160(), with
+// the base58check checksums calculated a batch at a time with BRSHA256_2Batch()
+// returns the number of addresses written
+size_t BRAddressFromHash160Batch(BRAddress addrs[], BRAddressParams params, const void *md20s, size_t count)
+{
+    uint8_t data[64*21], md[64*32];
+    size_t i, j, n, r = 0;
+    
+    assert(addrs != NULL || count == 0);
+    assert(md20s != NULL || count == 0);
+    
+    for (i = 0; params.bech32Prefix && i < count; i++) {
+        if (BRAddressFromHash160(addrs[i].s, sizeof(*addrs), params, (const uint8_t *)md20s + i*20) > 0) r++;
+    }
+    
+    for (i = 0; ! params.bech32Prefix && i < count; i += n) {
+        n = (count - i < 64) ? count - i : 64;
+        
+        for (j = 0; j < n; j++) {
+            data[j*21] = params.pubKeyPrefix;
+            memcpy(&data[j*21 + 1], (const uint8_t *)md20s + (i + j)*20, 20);
+        }
+        
+        BRSHA256_2Batch(md, data, 21, 21, n);
+        
+        for (j = 0; j < n; j++) { // base58check is the base58 of data plus the first 4 bytes of its double-sha256
+            uint8_t buf[25];
+            
+            memcpy(buf, &data[j*21], 21);
+            memcpy(&buf[21], &md[j*32], 4);
+            if (BRBase58Encode(addrs[i + j].s, sizeof(*addrs), buf, sizeof(buf)) > 0) r++;
+        }
+    }
+    
+    return r;
+}
+
 // writes the scriptPubKey for addr to script
 // returns the number of bytes written, or scriptLen needed if script is NULL
 size_t BRAddressScriptPubKey(uint8_t *script, size_t scriptLen, BRAddressParams params, const char *addr)
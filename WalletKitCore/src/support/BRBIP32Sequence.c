@@ -154,6 +154,67 @@ size_t BRBIP32PubKey(uint8_t *pubKey, size_t pubKeyLen, BRMasterPubKey mpk, uint
     return (! pubKey || sizeof(BRECPoint) <= pubKeyLen) ? sizeof(BRECPoint) : 0;
 }
 
+#define PUBKEY_LIST_BATCH 64
+
+// writes the public keys for paths N(m/0H/chain/index) through N(m/0H/chain/index + pubKeysCount - 1) to pubKeys
+// returns the number of keys successfully derived
+size_t BRBIP32PubKeyList(BRECPoint pubKeys[], size_t pubKeysCount, BRMasterPubKey mpk, uint32_t chain, uint32_t index)
+{
+    BRSHA512Context ictx, octx, ctx;
+    UInt256 chainCode = mpk.chainCode, tweaks[PUBKEY_LIST_BATCH];
+    BRECPoint K = *(BRECPoint *)mpk.pubKey;
+    uint8_t pad[128], buf[sizeof(K) + sizeof(index)];
+    UInt512 I;
+    size_t i, j, n, r = 0;
+
+    assert(memcmp(&mpk, &BR_MASTER_PUBKEY_NONE, sizeof(mpk)) != 0);
+    assert(pubKeys != NULL || pubKeysCount == 0);
+    if (! pubKeys || pubKeysCount == 0) return 0;
+
+    _CKDpub(&K, &chainCode, chain); // path N(m/0H/chain)
+
+    // every child uses the same hmac key (the chain code), so hash the inner and outer key blocks only once
+    memset(pad, 0x36, sizeof(pad));
+    for (i = 0; i < sizeof(chainCode); i++) pad[i] ^= chainCode.u8[i];
+    BRSHA512Init(&ictx);
+    BRSHA512Update(&ictx, pad, sizeof(pad));
+    for (i = 0; i < sizeof(pad); i++) pad[i] ^= 0x36 ^ 0x5c;
+    BRSHA512Init(&octx);
+    BRSHA512Update(&octx, pad, sizeof(pad));
+    *(BRECPoint *)buf = K;
+
+    for (i = 0; i < pubKeysCount; i += n) {
+        n = (pubKeysCount - i < PUBKEY_LIST_BATCH) ? pubKeysCount - i : PUBKEY_LIST_BATCH;
+
+        for (j = 0; j < n; j++) {
+            if (((index + i + j) & BIP32_HARD) == BIP32_HARD) { // can't derive hardened child, K is left as is
+                tweaks[j] = UINT256_ZERO;
+                continue;
+            }
+
+            UInt32SetBE(&buf[sizeof(K)], (uint32_t)(index + i + j));
+            ctx = ictx;
+            BRSHA512Update(&ctx, buf, sizeof(buf));
+            BRSHA512Final(&I, &ctx); // inner hash
+            ctx = octx;
+            BRSHA512Update(&ctx, &I, sizeof(I));
+            BRSHA512Final(&I, &ctx); // I = HMAC-SHA512(c, P(K) || i)
+            tweaks[j] = *(UInt256 *)&I; // IL
+        }
+
+        r += BRSecp256k1PointAddBatch(&pubKeys[i], &K, tweaks, n); // K = P(IL) + K
+    }
+
+    var_clean(&I);
+    var_clean(&chainCode);
+    mem_clean(tweaks, sizeof(tweaks));
+    mem_clean(pad, sizeof(pad));
+    mem_clean(&ictx, sizeof(ictx));
+    mem_clean(&octx, sizeof(octx));
+    mem_clean(&ctx, sizeof(ctx));
+    return r;
+}
+
 // sets the private key for path m/0H/chain/index to key
 void BRBIP32PrivKey(BRKey *key, const void *seed, size_t seedLen, uint32_t chain, uint32_t index)
 {
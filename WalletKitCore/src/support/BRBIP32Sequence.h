@@ -82,6 +82,11 @@ BRMasterPubKey BRBIP32MasterPubKey(const void *seed, size_t seedLen);
 // returns number of bytes written, or pubKeyLen needed if pubKey is NULL
 size_t BRBIP32PubKey(uint8_t *pubKey, size_t pubKeyLen, BRMasterPubKey mpk, uint32_t chain, uint32_t index);
 
+// writes the public keys for paths N(m/0H/chain/index) through N(m/0H/chain/index + pubKeysCount - 1) to pubKeys
+// N(m/0H/chain) is derived only once, and the child keys are computed together with BRSecp256k1PointAddBatch()
+// returns the number of keys successfully derived
+size_t BRBIP32PubKeyList(BRECPoint pubKeys[], size_t pubKeysCount, BRMasterPubKey mpk, uint32_t chain, uint32_t index);
+
 // sets the private key for path m/0H/chain/index to key
 void BRBIP32PrivKey(BRKey *key, const void *seed, size_t seedLen, uint32_t chain, uint32_t index);
 
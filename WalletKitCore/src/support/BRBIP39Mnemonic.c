@@ -131,7 +131,7 @@ void BRBIP39DeriveKey(void *key64, const char *phrase, const char *passphrase)
     if (phrase) {
         strcpy(salt, "mnemonic");
         if (passphrase) strcpy(salt + strlen("mnemonic"), passphrase);
-        BRPBKDF2(key64, 64, BRSHA512, 512/8, phrase, strlen(phrase), salt, strlen(salt), 2048);
+        BRPBKDF2SHA512(key64, 64, phrase, strlen(phrase), salt, strlen(salt), 2048);
         mem_clean(salt, sizeof(salt));
     }
 }
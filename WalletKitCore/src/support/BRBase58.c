@@ -34,44 +34,79 @@
 // base58 and base58check encoding: https://en.bitcoin.it/wiki/Base58Check_encoding
 static const char * bitcoinAlphabet = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+static const int8_t bitcoinDigits[256] = { // bitcoinAlphabet reverse lookup, -1 for an invalid digit
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8, -1, -1, -1, -1, -1, -1,
+    -1,  9, 10, 11, 12, 13, 14, 15, 16, -1, 17, 18, 19, 20, 21, -1,
+    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1, -1,
+    -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46,
+    47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+// the long division and multiplication below work on 32bit limbs with 64bit intermediates, five base58 digits
+// (58^5 < 2^30) or four bytes at a time, so a limb times 2^32 or 58^5, plus carry, never overflows 64bits
+#define BASE58_LIMB 656356768 // 58^5
+
 // returns the number of characters written to str including NULL terminator, or total strLen needed if str is NULL
 size_t BRBase58EncodeEx(char *str, size_t strLen, const uint8_t *data, size_t dataLen, const char *alphabet)
 {
     const char * chars = alphabet;
     assert(strlen(alphabet) >= 58);
 
-    size_t i, j, len, zcount = 0;
+    size_t i, j, k, len, high, zcount = 0;
     
     assert(data != NULL);
     while (zcount < dataLen && data && data[zcount] == 0) zcount++; // count leading zeroes
 
-    uint8_t buf[(dataLen - zcount)*138/100 + 1]; // log(256)/log(58), rounded up
+    uint32_t limbs[((dataLen - zcount)*138/100 + 1)/5 + 1]; // log(256)/log(58), rounded up, in base 58^5 limbs
+    char buf[sizeof(limbs)/sizeof(*limbs)*5];
+    uint64_t carry, mul;
     
-    memset(buf, 0, sizeof(buf));
+    memset(limbs, 0, sizeof(limbs));
+    high = sizeof(limbs)/sizeof(*limbs); // limbs below high are all zero
     
-    for (i = zcount; data && i < dataLen; i++) {
-        uint32_t carry = data[i];
+    for (i = zcount; data && i < dataLen; i += k) {
+        k = (dataLen - i < 4) ? dataLen - i : 4; // up to 4 bytes at a time
+        for (j = 0, carry = 0; j < k; j++) carry = (carry << 8) | data[i + j];
+        mul = (uint64_t)1 << (k*8);
         
-        for (j = sizeof(buf); j > 0; j--) {
-            carry += (uint32_t)buf[j - 1] << 8;
-            buf[j - 1] = carry % 58;
-            carry /= 58;
+        for (j = sizeof(limbs)/sizeof(*limbs); j > 0 && (j > high || carry != 0); j--) {
+            carry += limbs[j - 1]*mul;
+            limbs[j - 1] = (uint32_t)(carry % BASE58_LIMB);
+            carry /= BASE58_LIMB;
         }
         
+        high = j;
         var_clean(&carry);
     }
     
+    for (i = 0; i < sizeof(limbs)/sizeof(*limbs); i++) { // five digits per limb, most significant first
+        for (j = 5, carry = limbs[i]; j > 0; j--, carry /= 58) buf[i*5 + j - 1] = (char)(carry % 58);
+    }
+    
     i = 0;
     while (i < sizeof(buf) && buf[i] == 0) i++; // skip leading zeroes
     len = (zcount + sizeof(buf) - i) + 1;
 
     if (str && len <= strLen) {
         while (zcount-- > 0) *(str++) = chars[0];
-        while (i < sizeof(buf)) *(str++) = chars[buf[i++]];
+        while (i < sizeof(buf)) *(str++) = chars[(uint8_t)buf[i++]];
         *str = '\0';
     }
     
+    mem_clean(limbs, sizeof(limbs));
     mem_clean(buf, sizeof(buf));
+    var_clean(&carry);
     return (! str || len <= strLen) ? len : 0;
 }
 
@@ -80,64 +115,43 @@ size_t BRBase58Encode(char *str, size_t strLen, const uint8_t *data, size_t data
     return BRBase58EncodeEx(str, strLen, data, dataLen, bitcoinAlphabet);
 }
 
+// decodes str using the digit values in digits, stopping at the first invalid digit, and sets *end to it
 // returns the number of bytes written to data, or total dataLen needed if data is NULL
-size_t BRBase58Decode(uint8_t *data, size_t dataLen, const char *str)
+static size_t _BRBase58Decode(uint8_t *data, size_t dataLen, const char *str, const int8_t *digits, const char **end)
 {
-    size_t i = 0, j, len, zcount = 0;
+    size_t i, j, len, high, zcount = 0;
+    int8_t d = 0;
 
-    assert(str != NULL);
-    while (str && *str == '1') str++, zcount++; // count leading zeroes
+    while (str && *str && digits[(uint8_t)*str] == 0) str++, zcount++; // count leading zeroes
     
-    uint8_t buf[(str) ? strlen(str)*733/1000 + 1 : 0]; // log(58)/log(256), rounded up
+    uint32_t limbs[((str) ? strlen(str)*733/1000 + 1 : 0)/4 + 1]; // log(58)/log(256), rounded up, in 32bit limbs
+    uint8_t buf[sizeof(limbs)];
+    uint64_t carry = 0, mul = 1;
     
-    memset(buf, 0, sizeof(buf));
+    memset(limbs, 0, sizeof(limbs));
+    high = sizeof(limbs)/sizeof(*limbs); // limbs below high are all zero
     
-    while (str && *str) {
-        uint32_t carry = *(const uint8_t *)(str++);
-        
-        switch (carry) {
-            case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
-                carry -= '1';
-                break;
-                
-            case 'A': case 'B': case 'C': case 'D': case 'E': case 'F': case 'G': case 'H':
-                carry += (uint32_t) (9 - 'A');
-                break;
-                
-            case 'J': case 'K': case 'L': case 'M': case 'N':
-                carry += (uint32_t) (17 - 'J');
-                break;
-                
-            case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V': case 'W': case 'X': case 'Y':
-            case 'Z':
-                carry += (uint32_t) (22 - 'P');
-                break;
-                
-            case 'a': case 'b': case 'c': case 'd': case 'e': case 'f': case 'g': case 'h': case 'i': case 'j':
-            case 'k':
-                carry += (uint32_t) (33 - 'a');
-                break;
-                
-            case 'm': case 'n': case 'o': case 'p': case 'q': case 'r': case 's': case 't': case 'u': case 'v':
-            case 'w': case 'x': case 'y': case 'z':
-                carry += (uint32_t) (44 - 'm');
-                break;
-                
-            default:
-                carry = UINT32_MAX;
-        }
-        
-        if (carry >= 58) break; // invalid base58 digit
+    while (str && d >= 0) {
+        d = (*str) ? digits[(uint8_t)*str] : -1;
+        if (d >= 0) carry = carry*58 + (uint64_t)d, mul *= 58, str++;
         
-        for (j = sizeof(buf); j > 0; j--) {
-            carry += (uint32_t)buf[j - 1]*58;
-            buf[j - 1] = carry & 0xff;
-            carry >>= 8;
+        if (mul > 1 && (mul == BASE58_LIMB || d < 0)) { // up to 5 digits at a time
+            for (j = sizeof(limbs)/sizeof(*limbs); j > 0 && (j > high || carry != 0); j--) {
+                carry += limbs[j - 1]*mul;
+                limbs[j - 1] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            
+            high = j, carry = 0, mul = 1;
         }
-        
-        var_clean(&carry);
     }
     
+    for (i = 0; i < sizeof(limbs)/sizeof(*limbs); i++) { // big endian bytes
+        buf[i*4] = (uint8_t)(limbs[i] >> 24), buf[i*4 + 1] = (uint8_t)(limbs[i] >> 16);
+        buf[i*4 + 2] = (uint8_t)(limbs[i] >> 8), buf[i*4 + 3] = (uint8_t)limbs[i];
+    }
+    
+    i = 0;
     while (i < sizeof(buf) && buf[i] == 0) i++; // skip leading zeroes
     len = zcount + sizeof(buf) - i;
 
@@ -146,10 +160,20 @@ size_t BRBase58Decode(uint8_t *data, size_t dataLen, const char *str)
         memcpy(&data[zcount], &buf[i], sizeof(buf) - i);
     }
 
+    if (end) *end = str;
+    mem_clean(limbs, sizeof(limbs));
     mem_clean(buf, sizeof(buf));
+    var_clean(&carry);
     return (! data || len <= dataLen) ? len : 0;
 }
 
+// returns the number of bytes written to data, or total dataLen needed if data is NULL
+size_t BRBase58Decode(uint8_t *data, size_t dataLen, const char *str)
+{
+    assert(str != NULL);
+    return _BRBase58Decode(data, dataLen, str, bitcoinDigits, NULL); // decodes up to any invalid base58 digit
+}
+
 // returns the number of characters written to str including NULL terminator, or total strLen needed if str is NULL
 size_t BRBase58CheckEncode(char *str, size_t strLen, const uint8_t *data, size_t dataLen)
 {
@@ -195,50 +219,13 @@ size_t BRBase58CheckDecode(uint8_t *data, size_t dataLen, const char *str)
 
 size_t BRBase58DecodeEx(uint8_t* data, size_t dataLen, const char *str, const char* alphabet)
 {
-    int reverseLookup[256];
-    memset(&reverseLookup[0], -1, sizeof(reverseLookup));
-    int map_num = 0;
-    for (int i = 0; i < strlen(alphabet); i++) {
-        reverseLookup[(int) alphabet[i]] = map_num++;
-    }
-
-    // Skip and count leading zeroes
-    size_t zcount = 0;
-    while (str && reverseLookup[(int) *str] == 0) str++, zcount++;
-
-    // Create buffer large enough to hold the decode bytes
-    int bufSize = (str) ? (int)(strlen(str)*733/1000 + 1) : 0;
-    uint8_t buf[bufSize];
-    memset(buf, 0, sizeof(buf));
-
-    // Do the decoding
-    while (str && *str)
-    {
-        int carry = reverseLookup[(int) *str];
-        if (carry == -1) return 0;
-
-        for (int i = bufSize - 1; i >= 0; i--)
-        {
-            carry += 58 * buf[i];
-            buf[i] = carry % 256;
-            carry /= 256;
-        }
-        str++;
-    }
+    int8_t digits[256];
+    const char *end = NULL;
+    size_t len;
 
-    // Skip leading zeros in buf
-    size_t i = 0;
-    while(buf[i] == 0) { i++; }
+    memset(digits, -1, sizeof(digits));
+    for (int i = 0; i < 58 && alphabet[i]; i++) digits[(uint8_t)alphabet[i]] = (int8_t)i;
 
-    // Calculate the length
-    size_t len = zcount + sizeof(buf) - i;
-
-    // If the caller has passed in buffer large enough then copy to it
-    if (data && len <= dataLen) {
-        if (zcount > 0) memset(data, 0, zcount);
-        memcpy(&data[zcount], &buf[i], sizeof(buf) - i);
-    }
-
-    // ONLY return 0 if the user passed in a buffer but it was not large enough
-    return (! data || len <= dataLen) ? len : 0;
+    len = _BRBase58Decode(data, dataLen, str, digits, &end);
+    return (end && *end) ? 0 : len; // an invalid digit fails the whole decode
 }
@@ -23,10 +23,26 @@
 //  THE SOFTWARE.
 
 #include "BRCrypto.h"
+#include "BROSCompat.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA256_X86_KERNELS 1 // sha extensions and avx2, selected at runtime
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define SHA256_LANES4_KERNEL 1 // 4 lanes in the baseline 128bit vector unit
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#include <emmintrin.h>
+#define SCRYPT_SSE2_KERNEL 1 // salsa20/8 in the baseline x86 128bit vector unit
+#endif
+
 // endian swapping
 #if __BIG_ENDIAN__ || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
 #define be32(x) (x)
@@ -110,19 +126,19 @@ void BRSHA1(void *md20, const void *data, size_t dataLen)
 #define s2(x) (ror32((x), 7) ^ ror32((x), 18) ^ ((x) >> 3))
 #define s3(x) (ror32((x), 17) ^ ror32((x), 19) ^ ((x) >> 10))
 
-static void _BRSHA256Compress(uint32_t *r, const uint32_t *x)
+static const uint32_t _BRSHA256K[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void _BRSHA256CompressScalar(uint32_t *r, const uint32_t *x)
 {
-    static const uint32_t k[] = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-    };
-    
     int i;
     uint32_t a = r[0], b = r[1], c = r[2], d = r[3], e = r[4], f = r[5], g = r[6], h = r[7], t1, t2, w[64];
     
@@ -130,7 +146,7 @@ static void _BRSHA256Compress(uint32_t *r, const uint32_t *x)
     for (; i < 64; i++) w[i] = s3(w[i - 2]) + w[i - 7] + s2(w[i - 15]) + w[i - 16];
     
     for (i = 0; i < 64; i++) {
-        t1 = h + s1(e) + ch(e, f, g) + k[i] + w[i];
+        t1 = h + s1(e) + ch(e, f, g) + _BRSHA256K[i] + w[i];
         t2 = s0(a) + maj(a, b, c);
         h = g, g = f, f = e, e = d + t1, d = c, c = b, b = a, a = t1 + t2;
     }
@@ -140,6 +156,127 @@ static void _BRSHA256Compress(uint32_t *r, const uint32_t *x)
     mem_clean(w, sizeof(w));
 }
 
+// multi-buffer compression of one block in each of lanes independent messages, with state and message words transposed
+// so that word i of every lane is contiguous: r[i*lanes + lane], x[i*lanes + lane] (x already in host byte order)
+#define SHA256_COMPRESS_LANES(name, lanes, ...) \
+__VA_ARGS__ static void name(uint32_t *r, const uint32_t *x) \
+{ \
+    typedef uint32_t v __attribute__((vector_size(4*(lanes)))); \
+    int i; \
+    v a, b, c, d, e, f, g, h, t1, t2, s[8], w[64]; \
+    \
+    memcpy(s, r, sizeof(s)); \
+    memcpy(w, x, 16*sizeof(*w)); \
+    a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7]; \
+    for (i = 16; i < 64; i++) w[i] = s3(w[i - 2]) + w[i - 7] + s2(w[i - 15]) + w[i - 16]; \
+    \
+    for (i = 0; i < 64; i++) { \
+        t1 = h + s1(e) + ch(e, f, g) + _BRSHA256K[i] + w[i]; \
+        t2 = s0(a) + maj(a, b, c); \
+        h = g, g = f, f = e, e = d + t1, d = c, c = b, b = a, a = t1 + t2; \
+    } \
+    \
+    s[0] += a, s[1] += b, s[2] += c, s[3] += d, s[4] += e, s[5] += f, s[6] += g, s[7] += h; \
+    memcpy(r, s, sizeof(s)); \
+    var_clean(&a, &b, &c, &d, &e, &f, &g, &h, &t1, &t2); \
+    mem_clean(s, sizeof(s)); \
+    mem_clean(w, sizeof(w)); \
+}
+
+#if SHA256_LANES4_KERNEL
+SHA256_COMPRESS_LANES(_BRSHA256Compress4, 4)
+#endif
+
+#if SHA256_X86_KERNELS
+SHA256_COMPRESS_LANES(_BRSHA256Compress8, 8, __attribute__((target("avx2"))))
+
+// one block with the x86 sha extensions, x is the raw message block
+__attribute__((target("sha,ssse3,sse4.1")))
+static void _BRSHA256CompressSHANI(uint32_t *r, const uint32_t *x)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i st0, st1, abef, cdgh, t, k, m[4];
+    int i;
+    
+    t = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&r[0]), 0xb1); // cdab
+    st1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&r[4]), 0x1b); // efgh
+    st0 = abef = _mm_alignr_epi8(t, st1, 8); // abef
+    st1 = cdgh = _mm_blend_epi16(st1, t, 0xf0); // cdgh
+    
+    for (i = 0; i < 16; i++) { // four rounds per iteration, message words 4*i to 4*i + 3 in m[i % 4]
+        if (i < 4) m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)x + i), mask);
+        k = _mm_add_epi32(m[i % 4], _mm_loadu_si128((const __m128i *)&_BRSHA256K[4*i]));
+        st1 = _mm_sha256rnds2_epu32(st1, st0, k);
+        
+        if (i >= 3 && i < 15) { // finish the message schedule for the next four rounds
+            t = _mm_alignr_epi8(m[i % 4], m[(i + 3) % 4], 4);
+            m[(i + 1) % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(m[(i + 1) % 4], t), m[i % 4]);
+        }
+        
+        st0 = _mm_sha256rnds2_epu32(st0, st1, _mm_shuffle_epi32(k, 0x0e));
+        if (i >= 1 && i < 13) m[(i + 3) % 4] = _mm_sha256msg1_epu32(m[(i + 3) % 4], m[i % 4]);
+    }
+    
+    st0 = _mm_add_epi32(st0, abef);
+    st1 = _mm_add_epi32(st1, cdgh);
+    t = _mm_shuffle_epi32(st0, 0x1b); // feba
+    st1 = _mm_shuffle_epi32(st1, 0xb1); // dchg
+    _mm_storeu_si128((__m128i *)&r[0], _mm_blend_epi16(t, st1, 0xf0)); // dcba
+    _mm_storeu_si128((__m128i *)&r[4], _mm_alignr_epi8(st1, t, 8)); // hgfe
+}
+#endif
+
+static unsigned _BRSHA256KernelsDetect(void)
+{
+    unsigned kernels = 0;
+
+#if SHA256_LANES4_KERNEL
+    kernels |= BR_SHA256_LANES4;
+#endif
+#if SHA256_X86_KERNELS
+    unsigned a, b, c, d, ymm = 0;
+    uint32_t xcr0, xcr0hi;
+    
+    if (__get_cpuid(1, &a, &b, &c, &d)) {
+        int ssse3 = (c >> 9) & 1, sse41 = (c >> 19) & 1, osxsave = (c >> 27) & 1, avx = (c >> 28) & 1;
+        
+        if (osxsave && avx) { // the os must save ymm registers for avx2
+            __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0hi) : "c" (0));
+            ymm = ((xcr0 & 0x06) == 0x06);
+        }
+        
+        if (__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+            if (ssse3 && sse41 && ((b >> 29) & 1)) kernels |= BR_SHA256_SHANI;
+            if (ymm && ((b >> 5) & 1)) kernels |= BR_SHA256_AVX2;
+        }
+    }
+#endif
+    return kernels;
+}
+
+static volatile unsigned _BRSHA256KernelsFound = 0, _BRSHA256KernelsEnabled = ~0u;
+
+// sha-256 kernels supported by this build and cpu, and not disabled with BRSHA256SetKernels()
+unsigned BRSHA256Kernels(void)
+{
+    if (_BRSHA256KernelsFound == 0) _BRSHA256KernelsFound = _BRSHA256KernelsDetect() | 0x80000000; // detected flag
+    return _BRSHA256KernelsFound & _BRSHA256KernelsEnabled & ~0x80000000u;
+}
+
+void BRSHA256SetKernels(unsigned kernels)
+{
+    _BRSHA256KernelsEnabled = kernels;
+}
+
+static void _BRSHA256Compress(uint32_t *r, const uint32_t *x)
+{
+#if SHA256_X86_KERNELS
+    if (BRSHA256Kernels() & BR_SHA256_SHANI) _BRSHA256CompressSHANI(r, x);
+    else
+#endif
+    _BRSHA256CompressScalar(r, x);
+}
+
 void BRSHA224(void *md28, const void *data, size_t dataLen) {
     size_t i;
     uint32_t x[16], buf[] = { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511,
@@ -202,6 +339,95 @@ void BRSHA256_2(void *md32, const void *data, size_t dataLen)
     BRSHA256(md32, t, sizeof(t));
 }
 
+// sha-256 of lanes messages of dataLen bytes at data + lane*stride, with a multi-buffer compress function
+static void _BRSHA256Lanes(void (*compress)(uint32_t *, const uint32_t *), size_t lanes, uint8_t *md,
+                           const uint8_t *data, size_t dataLen, size_t stride)
+{
+    static const uint32_t buf[] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                    0x1f83d9ab, 0x5be0cd19 }; // initial buffer values
+    size_t i, l, n, full = dataLen/64, blocks = full + ((dataLen % 64 >= 56) ? 2 : 1);
+    uint32_t r[8*8], w[16*8], tail[8][32], u;
+    const uint8_t *x;
+    
+    assert(lanes <= 8);
+    
+    for (l = 0; l < lanes; l++) { // the one or two padded blocks at the end of each message
+        memset(tail[l], 0, sizeof(tail[l]));
+        memcpy(tail[l], &data[l*stride + full*64], dataLen % 64);
+        ((uint8_t *)tail[l])[dataLen % 64] = 0x80; // append padding
+        tail[l][(blocks - full)*16 - 2] = be32((uint32_t)(dataLen >> 29)); // append length in bits
+        tail[l][(blocks - full)*16 - 1] = be32((uint32_t)(dataLen << 3));
+        for (i = 0; i < 8; i++) r[i*lanes + l] = buf[i];
+    }
+    
+    for (n = 0; n < blocks; n++) {
+        for (l = 0; l < lanes; l++) {
+            x = (n < full) ? &data[l*stride + n*64] : (const uint8_t *)&tail[l][(n - full)*16];
+            
+            for (i = 0; i < 16; i++) {
+                memcpy(&u, &x[i*sizeof(u)], sizeof(u));
+                w[i*lanes + l] = be32(u);
+            }
+        }
+        
+        compress(r, w);
+    }
+    
+    for (l = 0; l < lanes; l++) {
+        for (i = 0; i < 8; i++) {
+            u = be32(r[i*lanes + l]); // endian swap
+            memcpy(&md[l*32 + i*sizeof(u)], &u, sizeof(u)); // write to md
+        }
+    }
+    
+    mem_clean(r, sizeof(r));
+    mem_clean(w, sizeof(w));
+    mem_clean(tail, sizeof(tail));
+}
+
+void BRSHA256Batch(void *md32s, const void *data, size_t dataLen, size_t stride, size_t count)
+{
+    uint8_t *md = md32s;
+    const uint8_t *d = data;
+    unsigned kernels = BRSHA256Kernels();
+    size_t i = 0;
+    
+    assert(md32s != NULL || count == 0);
+    assert(data != NULL || dataLen == 0 || count == 0);
+    
+    if (! (kernels & BR_SHA256_SHANI)) { // sha extensions beat the multi-buffer kernels, one message at a time
+#if SHA256_X86_KERNELS
+        if (kernels & BR_SHA256_AVX2) {
+            for (; i + 8 <= count; i += 8) _BRSHA256Lanes(_BRSHA256Compress8, 8, &md[i*32], &d[i*stride], dataLen, stride);
+        }
+#endif
+#if SHA256_LANES4_KERNEL
+        if (kernels & BR_SHA256_LANES4) {
+            for (; i + 4 <= count; i += 4) _BRSHA256Lanes(_BRSHA256Compress4, 4, &md[i*32], &d[i*stride], dataLen, stride);
+        }
+#endif
+    }
+    
+    for (; i < count; i++) BRSHA256(&md[i*32], &d[i*stride], dataLen);
+}
+
+void BRSHA256_2Batch(void *md32s, const void *data, size_t dataLen, size_t stride, size_t count)
+{
+    uint8_t t[8*32];
+    size_t i, n;
+    
+    assert(md32s != NULL || count == 0);
+    assert(data != NULL || dataLen == 0 || count == 0);
+    
+    for (i = 0; i < count; i += n) {
+        n = (count - i < 8) ? count - i : 8;
+        BRSHA256Batch(t, (const uint8_t *)data + i*stride, dataLen, stride, n);
+        BRSHA256Batch((uint8_t *)md32s + i*32, t, sizeof(t)/8, sizeof(t)/8, n);
+    }
+    
+    mem_clean(t, sizeof(t));
+}
+
 // bitwise right rotation
 #define ror64(a, b) (((a) >> (b)) | ((a) << (64 - (b))))
 
@@ -211,41 +437,50 @@ void BRSHA256_2(void *md32, const void *data, size_t dataLen)
 #define S2(x) (ror64((x), 1) ^ ror64((x), 8) ^ ((x) >> 7))
 #define S3(x) (ror64((x), 19) ^ ror64((x), 61) ^ ((x) >> 6))
 
-static void _BRSHA512Compress(uint64_t *r, const uint64_t *x)
+static const uint64_t _BRSHA512K[] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc, 0x3956c25bf348b538,
+    0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242, 0x12835b0145706fbe,
+    0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2, 0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+    0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5, 0x983e5152ee66dfab,
+    0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+    0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed,
+    0x53380d139d95b3df, 0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+    0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8, 0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
+    0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373,
+    0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b, 0xca273eceea26619c,
+    0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba, 0x0a637dc5a2c898a6,
+    0x113f9804bef90dae, 0x1b710b35131c471b, 0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+    0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817
+};
+
+// w[0..15] holds the message block as native words, w[16..79] is scratch for the message schedule
+static void _BRSHA512Rounds(uint64_t *r, uint64_t *w)
 {
-    static const uint64_t k[] = {
-        0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc, 0x3956c25bf348b538,
-        0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242, 0x12835b0145706fbe,
-        0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2, 0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
-        0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
-        0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5, 0x983e5152ee66dfab,
-        0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
-        0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed,
-        0x53380d139d95b3df, 0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
-        0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
-        0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8, 0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
-        0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373,
-        0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
-        0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b, 0xca273eceea26619c,
-        0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba, 0x0a637dc5a2c898a6,
-        0x113f9804bef90dae, 0x1b710b35131c471b, 0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
-        0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817
-    };
-    
     int i;
-    uint64_t a = r[0], b = r[1], c = r[2], d = r[3], e = r[4], f = r[5], g = r[6], h = r[7], t1, t2, w[80];
+    uint64_t a = r[0], b = r[1], c = r[2], d = r[3], e = r[4], f = r[5], g = r[6], h = r[7], t1, t2;
     
-    for (i = 0; i < 16; i++) w[i] = be64(x[i]);
-    for (; i < 80; i++) w[i] = S3(w[i - 2]) + w[i - 7] + S2(w[i - 15]) + w[i - 16];
+    for (i = 16; i < 80; i++) w[i] = S3(w[i - 2]) + w[i - 7] + S2(w[i - 15]) + w[i - 16];
     
     for (i = 0; i < 80; i++) {
-        t1 = h + S1(e) + ch(e, f, g) + k[i] + w[i];
+        t1 = h + S1(e) + ch(e, f, g) + _BRSHA512K[i] + w[i];
         t2 = S0(a) + maj(a, b, c);
         h = g, g = f, f = e, e = d + t1, d = c, c = b, b = a, a = t1 + t2;
     }
     
     r[0] += a, r[1] += b, r[2] += c, r[3] += d, r[4] += e, r[5] += f, r[6] += g, r[7] += h;
     var_clean(&a, &b, &c, &d, &e, &f, &g, &h, &t1, &t2);
+}
+
+static void _BRSHA512Compress(uint64_t *r, const uint64_t *x)
+{
+    int i;
+    uint64_t w[80];
+    
+    for (i = 0; i < 16; i++) w[i] = be64(x[i]);
+    _BRSHA512Rounds(r, w);
     mem_clean(w, sizeof(w));
 }
 
@@ -399,53 +634,84 @@ void BRHash160(void *md20, const void *data, size_t datalen)
 // bitwise left rotation
 #define rol64(a, b) ((a) << (b) ^ ((a) >> (64 - (b))))
 
+static const uint64_t _BRKeccakK[] = { // keccak round constants
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+    0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+    0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+};
+
+// one keccak-f[1600] round from state a to state e, theta, rho, pi, chi and iota unrolled together, with lanes 1, 2,
+// 8, 12, 17 and 20 held complemented so that chi needs only one not per row (lane complementing, see section 2.2 of
+// https://keccak.team/files/Keccak-implementation-3.2.pdf)
+#define _keccak_round(T, a, e, k) do {\
+    T c0 = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20], c1 = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21],\
+      c2 = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22], c3 = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23],\
+      c4 = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];\
+    T d0 = c4 ^ rol64(c1, 1), d1 = c0 ^ rol64(c2, 1), d2 = c1 ^ rol64(c3, 1), d3 = c2 ^ rol64(c4, 1),\
+      d4 = c3 ^ rol64(c0, 1), b0, b1, b2, b3, b4;\
+    b0 = a[0] ^ d0, b1 = rol64(a[6] ^ d1, 44), b2 = rol64(a[12] ^ d2, 43), b3 = rol64(a[18] ^ d3, 21);\
+    b4 = rol64(a[24] ^ d4, 14);\
+    e[0] = b0 ^ (b1 | b2) ^ (k), e[1] = b1 ^ (~b2 | b3), e[2] = b2 ^ (b3 & b4), e[3] = b3 ^ (b4 | b0);\
+    e[4] = b4 ^ (b0 & b1);\
+    b0 = rol64(a[3] ^ d3, 28), b1 = rol64(a[9] ^ d4, 20), b2 = rol64(a[10] ^ d0, 3), b3 = rol64(a[16] ^ d1, 45);\
+    b4 = rol64(a[22] ^ d2, 61);\
+    e[5] = b0 ^ (b1 | b2), e[6] = b1 ^ (b2 & b3), e[7] = b2 ^ (b3 | ~b4), e[8] = b3 ^ (b4 | b0), e[9] = b4 ^ (b0 & b1);\
+    b0 = rol64(a[1] ^ d1, 1), b1 = rol64(a[7] ^ d2, 6), b2 = rol64(a[13] ^ d3, 25), b3 = rol64(a[19] ^ d4, 8);\
+    b4 = rol64(a[20] ^ d0, 18);\
+    e[10] = b0 ^ (b1 | b2), e[11] = b1 ^ (b2 & b3), e[12] = b2 ^ (~b3 & b4), e[13] = ~b3 ^ (b4 | b0);\
+    e[14] = b4 ^ (b0 & b1);\
+    b0 = rol64(a[4] ^ d4, 27), b1 = rol64(a[5] ^ d0, 36), b2 = rol64(a[11] ^ d1, 10), b3 = rol64(a[17] ^ d2, 15);\
+    b4 = rol64(a[23] ^ d3, 56);\
+    e[15] = b0 ^ (b1 & b2), e[16] = b1 ^ (b2 | b3), e[17] = b2 ^ (~b3 | b4), e[18] = ~b3 ^ (b4 & b0);\
+    e[19] = b4 ^ (b0 | b1);\
+    b0 = rol64(a[2] ^ d2, 62), b1 = rol64(a[8] ^ d3, 55), b2 = rol64(a[14] ^ d4, 39), b3 = rol64(a[15] ^ d0, 41);\
+    b4 = rol64(a[21] ^ d1, 2);\
+    e[20] = b0 ^ (~b1 & b2), e[21] = ~b1 ^ (b2 | b3), e[22] = b2 ^ (b3 & b4), e[23] = b3 ^ (b4 | b0);\
+    e[24] = b4 ^ (b0 & b1);\
+} while (0)
+
+// defines a keccak-f[1600] permutation of the state r, where T is uint64_t for one state, or a vector of uint64_t
+// for one state per vector lane (r[i][l] is lane i of state l)
+#define KECCAK_F(name, T, ...)\
+__VA_ARGS__ static void name(T *r)\
+{\
+    T e[25];\
+    int i;\
+    \
+    r[1] = ~r[1], r[2] = ~r[2], r[8] = ~r[8], r[12] = ~r[12], r[17] = ~r[17], r[20] = ~r[20];\
+    \
+    for (i = 0; i < 24; i += 2) {\
+        _keccak_round(T, r, e, _BRKeccakK[i]);\
+        _keccak_round(T, e, r, _BRKeccakK[i + 1]);\
+    }\
+    \
+    r[1] = ~r[1], r[2] = ~r[2], r[8] = ~r[8], r[12] = ~r[12], r[17] = ~r[17], r[20] = ~r[20];\
+    mem_clean(e, sizeof(e));\
+}
+
+KECCAK_F(_BRKeccakF, uint64_t)
+
+#if SHA256_X86_KERNELS
+typedef uint64_t _BRKeccakV4 __attribute__((vector_size(32)));
+
+KECCAK_F(_BRKeccakF4, _BRKeccakV4, __attribute__((target("avx2"))))
+#endif
+
+// keccak-f[1600] permutation of a state of 25 native endian 64bit lanes
+void BRKeccakF1600(uint64_t *state25)
+{
+    assert(state25 != NULL);
+    _BRKeccakF(state25);
+}
+
 static void _BRSHA3Compress(uint64_t *r, const uint64_t *x, size_t blockSize)
 {
-    static const uint64_t k[] = { // keccak round constants
-        0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
-        0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
-        0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
-        0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
-        0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
-    };
-    
-    size_t i, j;
-    uint64_t a[5], b[5], r0, r1;
+    size_t i;
     
     for (i = 0; i < blockSize/sizeof(uint64_t); i++) r[i] ^= le64(x[i]);
-    
-    for (i = 0; i < 24; i++) { // permute r
-        // theta(r)
-        for (j = 0; j < 5; j++) a[j] = r[j] ^ r[j + 5] ^ r[j + 10] ^ r[j + 15] ^ r[j + 20];
-        b[0] = rol64(a[1], 1) ^ a[4], b[1] = rol64(a[2], 1) ^ a[0], b[2] = rol64(a[3], 1) ^ a[1];
-        b[3] = rol64(a[4], 1) ^ a[2], b[4] = rol64(a[0], 1) ^ a[3];
-        for (j = 0; j < 5; j++) r[j] ^= b[j], r[j + 5] ^= b[j], r[j + 10] ^= b[j], r[j + 15] ^= b[j], r[j + 20] ^= b[j];
-        
-        // rho(r)
-        r[1] = rol64(r[1], 1), r[2] = rol64(r[2], 62), r[3] = rol64(r[3], 28), r[4] = rol64(r[4], 27);
-        r[5] = rol64(r[5], 36), r[6] = rol64(r[6], 44), r[7] = rol64(r[7], 6), r[8] = rol64(r[8], 55);
-        r[9] = rol64(r[9], 20), r[10] = rol64(r[10], 3), r[11] = rol64(r[11], 10), r[12] = rol64(r[12], 43);
-        r[13] = rol64(r[13], 25), r[14] = rol64(r[14], 39), r[15] = rol64(r[15], 41), r[16] = rol64(r[16], 45);
-        r[17] = rol64(r[17], 15), r[18] = rol64(r[18], 21), r[19] = rol64(r[19], 8), r[20] = rol64(r[20], 18);
-        r[21] = rol64(r[21], 2), r[22] = rol64(r[22], 61), r[23] = rol64(r[23], 56), r[24] = rol64(r[24], 14);
-        
-        // pi(r)
-        r1 = r[1], r[1] = r[6], r[6] = r[9], r[9] = r[22], r[22] = r[14], r[14] = r[20], r[20] = r[2], r[2] = r[12],
-        r[12] = r[13], r[13] = r[19], r[19] = r[23], r[23] = r[15], r[15] = r[4], r[4] = r[24], r[24] = r[21];
-        r[21] = r[8], r[8] = r[16], r[16] = r[5], r[5] = r[3], r[3] = r[18], r[18] = r[17], r[17] = r[11], r[11] = r[7];
-        r[7] = r[10], r[10] = r1; // r[0] left as is
-        
-        for (j = 0; j < 25; j += 5) { // chi(r)
-            r0 = r[0 + j], r1 = r[1 + j], r[0 + j] ^= ~r1 & r[2 + j], r[1 + j] ^= ~r[2 + j] & r[3 + j];
-            r[2 + j] ^= ~r[3 + j] & r[4 + j], r[3 + j] ^= ~r[4 + j] & r0, r[4 + j] ^= ~r0 & r1;
-        }
-        
-        *r ^= k[i]; // iota(r, i)
-    }
-    
-    mem_clean(a, sizeof(a));
-    mem_clean(b, sizeof(b));
-    var_clean(&r0, &r1);
+    _BRKeccakF(r);
 }
 
 // sha3-256: http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf
@@ -498,6 +764,122 @@ void BRKeccak256(void *md32, const void *data, size_t dataLen)
     mem_clean(buf, sizeof(buf));
 }
 
+// keccak-512: https://keccak.team/files/Keccak-submission-3.pdf
+void BRKeccak512(void *md64, const void *data, size_t dataLen)
+{
+    size_t i;
+    uint64_t x[9], buf[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    
+    assert(md64 != NULL);
+    assert(data != NULL || dataLen == 0);
+    
+    for (i = 0; i <= dataLen; i += 72) { // process data in 72 byte blocks
+        memcpy(x, (const uint8_t *)data + i, (i + 72 < dataLen) ? 72 : dataLen - i);
+        if (i + 72 > dataLen) break;
+        _BRSHA3Compress(buf, x, 72);
+    }
+    
+    memset((uint8_t *)x + (dataLen - i), 0, 72 - (dataLen - i)); // clear remainder of x
+    ((uint8_t *)x)[dataLen - i] |= 0x01; // append padding
+    ((uint8_t *)x)[71] |= 0x80;
+    _BRSHA3Compress(buf, x, 72); // finalize
+    for (i = 0; i < 8; i++) buf[i] = le64(buf[i]); // endian swap
+    memcpy(md64, buf, 64); // write to md
+    mem_clean(x, sizeof(x));
+    mem_clean(buf, sizeof(buf));
+}
+
+static volatile unsigned _BRKeccakKernelsEnabled = ~0u;
+
+// keccak kernels supported by this build and cpu, and not disabled with BRKeccakSetKernels()
+unsigned BRKeccakKernels(void)
+{
+    unsigned kernels = 0;
+    
+#if SHA256_X86_KERNELS
+    BRSHA256Kernels(); // runs cpu detection once
+    if (_BRSHA256KernelsFound & BR_SHA256_AVX2) kernels |= BR_KECCAK_AVX2;
+#endif
+    return kernels & _BRKeccakKernelsEnabled;
+}
+
+void BRKeccakSetKernels(unsigned kernels)
+{
+    _BRKeccakKernelsEnabled = kernels;
+}
+
+#if SHA256_X86_KERNELS
+// keccak-256 of count messages in the 4 state lanes of the avx2 permutation, each lane taking the next message as soon
+// as it has finished its last one, so messages of different lengths keep all lanes busy
+__attribute__((target("avx2")))
+static void _BRKeccak256Lanes4(uint8_t *md, const void *data[], const size_t dataLen[], size_t count)
+{
+    _BRKeccakV4 r[25];
+    uint64_t x[17];
+    size_t i, l, next = 0, msg[4], off[4];
+    int active = 0, done[4] = { 1, 1, 1, 1 }, last[4] = { 0, 0, 0, 0 };
+    
+    memset(r, 0, sizeof(r));
+    
+    do {
+        for (l = 0, active = 0; l < 4; l++) {
+            if (done[l] && next < count) { // start the next message in this lane
+                for (i = 0; i < 25; i++) r[i][l] = 0;
+                msg[l] = next++, off[l] = 0, done[l] = 0;
+            }
+            
+            if (done[l]) continue;
+            active++;
+            
+            if (off[l] + 136 <= dataLen[msg[l]]) { // full 136 byte block
+                memcpy(x, (const uint8_t *)data[msg[l]] + off[l], 136);
+                off[l] += 136;
+            }
+            else { // final padded block
+                memset(x, 0, 136);
+                memcpy(x, (const uint8_t *)data[msg[l]] + off[l], dataLen[msg[l]] - off[l]);
+                ((uint8_t *)x)[dataLen[msg[l]] - off[l]] |= 0x01; // append padding
+                ((uint8_t *)x)[135] |= 0x80;
+                last[l] = 1;
+            }
+            
+            for (i = 0; i < 17; i++) r[i][l] ^= le64(x[i]);
+        }
+        
+        if (active > 0) _BRKeccakF4(r);
+        
+        for (l = 0; l < 4; l++) {
+            if (! last[l]) continue;
+            for (i = 0; i < 4; i++) x[i] = le64(r[i][l]); // endian swap
+            memcpy(&md[msg[l]*32], x, 32); // write to md
+            last[l] = 0, done[l] = 1;
+        }
+    } while (active > 0);
+    
+    mem_clean(r, sizeof(r));
+    mem_clean(x, sizeof(x));
+}
+#endif
+
+// keccak-256 of count messages, the i-th of dataLen[i] bytes at data[i], written to md32s + i*32
+void BRKeccak256Batch(void *md32s, const void *data[], const size_t dataLen[], size_t count)
+{
+    uint8_t *md = md32s;
+    size_t i = 0;
+    
+    assert(md32s != NULL || count == 0);
+    assert(data != NULL || count == 0);
+    assert(dataLen != NULL || count == 0);
+    
+#if SHA256_X86_KERNELS
+    if (count > 1 && (BRKeccakKernels() & BR_KECCAK_AVX2)) {
+        _BRKeccak256Lanes4(md, data, dataLen, count);
+        i = count;
+    }
+#endif
+    for (; i < count; i++) BRKeccak256(&md[i*32], data[i], dataLen[i]);
+}
+
 // basic md5 functions
 #define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
 #define G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
@@ -628,6 +1010,296 @@ uint64_t BRSip64(const void *key16, const void *data, size_t dataLen)
     return le64(x);
 }
 
+// incremental merkle–damgard hashing: x buffers a partial block, len counts all data bytes
+static void _BRMDUpdate(void *r, void *x, uint64_t *len, size_t blockSize, void (*compress)(void *, const void *),
+                        const void *data, size_t dataLen)
+{
+    size_t off = (size_t)(*len % blockSize), n;
+
+    assert(data != NULL || dataLen == 0);
+    *len += dataLen;
+
+    if (off > 0) { // fill the partial block
+        n = (dataLen < blockSize - off) ? dataLen : blockSize - off;
+        memcpy((uint8_t *)x + off, data, n);
+        data = (const uint8_t *)data + n, dataLen -= n;
+        if (off + n < blockSize) return;
+        compress(r, x);
+    }
+
+    for (; dataLen >= blockSize; data = (const uint8_t *)data + blockSize, dataLen -= blockSize) {
+        memcpy(x, data, blockSize); // process data in blockSize byte blocks
+        compress(r, x);
+    }
+
+    memcpy(x, data, dataLen);
+}
+
+// pads, appends the length in bits (big or little endian) and compresses the final block(s)
+static void _BRMDFinal(void *r, void *x, uint64_t len, size_t blockSize, void (*compress)(void *, const void *),
+                       int bigEndian)
+{
+    size_t i, off = (size_t)(len % blockSize), lenOff = blockSize - ((blockSize == 128) ? 16 : 8);
+    uint64_t bits = len << 3;
+
+    ((uint8_t *)x)[off++] = 0x80; // append padding
+    if (off > lenOff) memset((uint8_t *)x + off, 0, blockSize - off), compress(r, x), off = 0; // length to next block
+    memset((uint8_t *)x + off, 0, blockSize - off); // clear remainder of x
+
+    for (i = 0; i < 8; i++) { // append length in bits
+        if (bigEndian) ((uint8_t *)x)[blockSize - 1 - i] = (uint8_t)(bits >> 8*i);
+        else ((uint8_t *)x)[blockSize - 8 + i] = (uint8_t)(bits >> 8*i);
+    }
+
+    compress(r, x); // finalize
+}
+
+static void _BRSHA1Compress64(void *r, const void *x)
+{
+    uint32_t w[80];
+
+    memcpy(w, x, 64); // _BRSHA1Compress() expands x in place
+    _BRSHA1Compress(r, w);
+    mem_clean(w, sizeof(w));
+}
+
+static void _BRSHA256Compress64(void *r, const void *x) { _BRSHA256Compress(r, x); }
+static void _BRSHA512Compress128(void *r, const void *x) { _BRSHA512Compress(r, x); }
+static void _BRRMDCompress64(void *r, const void *x) { _BRRMDCompress(r, x); }
+static void _BRMD5Compress64(void *r, const void *x) { _BRMD5Compress(r, x); }
+
+void BRSHA1Init(BRSHA1Context *ctx)
+{
+    static const uint32_t buf[] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRSHA1Update(BRSHA1Context *ctx, const void *data, size_t dataLen)
+{
+    assert(ctx != NULL);
+    _BRMDUpdate(ctx->buf, ctx->x, &ctx->len, 64, _BRSHA1Compress64, data, dataLen);
+}
+
+void BRSHA1Final(void *md20, BRSHA1Context *ctx)
+{
+    size_t i;
+
+    assert(md20 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 64, _BRSHA1Compress64, 1);
+    for (i = 0; i < 5; i++) ctx->buf[i] = be32(ctx->buf[i]); // endian swap
+    memcpy(md20, ctx->buf, 20); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+void BRSHA224Init(BRSHA256Context *ctx)
+{
+    static const uint32_t buf[] = { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511,
+                                    0x64f98fa7, 0xbefa4fa4 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRSHA224Final(void *md28, BRSHA256Context *ctx)
+{
+    size_t i;
+
+    assert(md28 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 64, _BRSHA256Compress64, 1);
+    for (i = 0; i < 7; i++) ctx->buf[i] = be32(ctx->buf[i]); // endian swap
+    memcpy(md28, ctx->buf, 28); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+void BRSHA256Init(BRSHA256Context *ctx)
+{
+    static const uint32_t buf[] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                    0x1f83d9ab, 0x5be0cd19 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRSHA256Update(BRSHA256Context *ctx, const void *data, size_t dataLen)
+{
+    assert(ctx != NULL);
+    _BRMDUpdate(ctx->buf, ctx->x, &ctx->len, 64, _BRSHA256Compress64, data, dataLen);
+}
+
+void BRSHA256Final(void *md32, BRSHA256Context *ctx)
+{
+    size_t i;
+
+    assert(md32 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 64, _BRSHA256Compress64, 1);
+    for (i = 0; i < 8; i++) ctx->buf[i] = be32(ctx->buf[i]); // endian swap
+    memcpy(md32, ctx->buf, 32); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+void BRSHA384Init(BRSHA512Context *ctx)
+{
+    static const uint64_t buf[] = { 0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17, 0x152fecd8f70e5939,
+                                    0x67332667ffc00b31, 0x8eb44a8768581511, 0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRSHA384Final(void *md48, BRSHA512Context *ctx)
+{
+    size_t i;
+
+    assert(md48 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 128, _BRSHA512Compress128, 1);
+    for (i = 0; i < 6; i++) ctx->buf[i] = be64(ctx->buf[i]); // endian swap
+    memcpy(md48, ctx->buf, 48); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+void BRSHA512Init(BRSHA512Context *ctx)
+{
+    static const uint64_t buf[] = { 0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+                                    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRSHA512Update(BRSHA512Context *ctx, const void *data, size_t dataLen)
+{
+    assert(ctx != NULL);
+    _BRMDUpdate(ctx->buf, ctx->x, &ctx->len, 128, _BRSHA512Compress128, data, dataLen);
+}
+
+void BRSHA512Final(void *md64, BRSHA512Context *ctx)
+{
+    size_t i;
+
+    assert(md64 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 128, _BRSHA512Compress128, 1);
+    for (i = 0; i < 8; i++) ctx->buf[i] = be64(ctx->buf[i]); // endian swap
+    memcpy(md64, ctx->buf, 64); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+void BRRMD160Init(BRRMD160Context *ctx)
+{
+    static const uint32_t buf[] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRRMD160Update(BRRMD160Context *ctx, const void *data, size_t dataLen)
+{
+    assert(ctx != NULL);
+    _BRMDUpdate(ctx->buf, ctx->x, &ctx->len, 64, _BRRMDCompress64, data, dataLen);
+}
+
+void BRRMD160Final(void *md20, BRRMD160Context *ctx)
+{
+    size_t i;
+
+    assert(md20 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 64, _BRRMDCompress64, 0);
+    for (i = 0; i < 5; i++) ctx->buf[i] = le32(ctx->buf[i]); // endian swap
+    memcpy(md20, ctx->buf, 20); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+void BRMD5Init(BRMD5Context *ctx)
+{
+    static const uint32_t buf[] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRMD5Update(BRMD5Context *ctx, const void *data, size_t dataLen)
+{
+    assert(ctx != NULL);
+    _BRMDUpdate(ctx->buf, ctx->x, &ctx->len, 64, _BRMD5Compress64, data, dataLen);
+}
+
+void BRMD5Final(void *md16, BRMD5Context *ctx)
+{
+    size_t i;
+
+    assert(md16 != NULL);
+    assert(ctx != NULL);
+    _BRMDFinal(ctx->buf, ctx->x, ctx->len, 64, _BRMD5Compress64, 0);
+    for (i = 0; i < 4; i++) ctx->buf[i] = le32(ctx->buf[i]); // endian swap
+    memcpy(md16, ctx->buf, 16); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
+static void _BRKeccakInit(BRKeccakContext *ctx, size_t blockSize, size_t mdLen, uint8_t pad)
+{
+    assert(ctx != NULL);
+    memset(ctx->buf, 0, sizeof(ctx->buf));
+    ctx->len = 0, ctx->blockSize = blockSize, ctx->mdLen = mdLen, ctx->pad = pad;
+}
+
+void BRSHA3_256Init(BRKeccakContext *ctx) { _BRKeccakInit(ctx, 136, 32, 0x06); }
+void BRKeccak256Init(BRKeccakContext *ctx) { _BRKeccakInit(ctx, 136, 32, 0x01); }
+void BRKeccak512Init(BRKeccakContext *ctx) { _BRKeccakInit(ctx, 72, 64, 0x01); }
+
+// ctx->len counts the bytes buffered in ctx->x
+void BRKeccakUpdate(BRKeccakContext *ctx, const void *data, size_t dataLen)
+{
+    size_t n;
+
+    assert(ctx != NULL);
+    assert(data != NULL || dataLen == 0);
+
+    if (ctx->len > 0) { // fill the partial block
+        n = (dataLen < ctx->blockSize - ctx->len) ? dataLen : ctx->blockSize - ctx->len;
+        memcpy((uint8_t *)ctx->x + ctx->len, data, n);
+        data = (const uint8_t *)data + n, dataLen -= n, ctx->len += n;
+        if (ctx->len < ctx->blockSize) return;
+        _BRSHA3Compress(ctx->buf, ctx->x, ctx->blockSize);
+    }
+
+    for (; dataLen >= ctx->blockSize; data = (const uint8_t *)data + ctx->blockSize, dataLen -= ctx->blockSize) {
+        memcpy(ctx->x, data, ctx->blockSize); // process data in blockSize byte blocks
+        _BRSHA3Compress(ctx->buf, ctx->x, ctx->blockSize);
+    }
+
+    memcpy(ctx->x, data, dataLen);
+    ctx->len = dataLen;
+}
+
+void BRKeccakFinal(void *md, BRKeccakContext *ctx)
+{
+    size_t i;
+
+    assert(md != NULL);
+    assert(ctx != NULL);
+    memset((uint8_t *)ctx->x + ctx->len, 0, ctx->blockSize - ctx->len); // clear remainder of x
+    ((uint8_t *)ctx->x)[ctx->len] |= ctx->pad; // append padding
+    ((uint8_t *)ctx->x)[ctx->blockSize - 1] |= 0x80;
+    _BRSHA3Compress(ctx->buf, ctx->x, ctx->blockSize); // finalize
+    for (i = 0; i < ctx->mdLen/sizeof(uint64_t); i++) ctx->buf[i] = le64(ctx->buf[i]); // endian swap
+    memcpy(md, ctx->buf, ctx->mdLen); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
 // HMAC(key, data) = hash((key xor opad) || hash((key xor ipad) || data))
 // opad = 0x5c5c5c...5c5c
 // ipad = 0x363636...3636
@@ -1139,6 +1811,88 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
     mem_clean(T, sizeof(T));
 }
 
+// hmac-sha512 ipad and opad key block midstates s, and U1 = hmac-sha512(pw, salt || be32(block)) as native words
+static void _BRPBKDF2SHA512Init(uint64_t s[2][8], uint64_t *U, const void *pw, size_t pwLen, const void *salt,
+                                size_t saltLen, uint32_t block)
+{
+    size_t i;
+    uint64_t k[16], md[8];
+    BRSHA512Context ctx;
+    
+    memset(k, 0, sizeof(k));
+    if (pwLen > sizeof(k)) BRSHA512(k, pw, pwLen);
+    else memcpy(k, pw, pwLen);
+    
+    for (i = 0; i < 16; i++) k[i] ^= 0x3636363636363636;
+    BRSHA512Init(&ctx);
+    BRSHA512Update(&ctx, k, sizeof(k));
+    memcpy(s[0], ctx.buf, sizeof(ctx.buf));
+    BRSHA512Update(&ctx, salt, saltLen);
+    block = be32(block);
+    BRSHA512Update(&ctx, &block, sizeof(block));
+    BRSHA512Final(md, &ctx);
+    
+    for (i = 0; i < 16; i++) k[i] ^= 0x3636363636363636 ^ 0x5c5c5c5c5c5c5c5c;
+    BRSHA512Init(&ctx);
+    BRSHA512Update(&ctx, k, sizeof(k));
+    memcpy(s[1], ctx.buf, sizeof(ctx.buf));
+    BRSHA512Update(&ctx, md, sizeof(md));
+    BRSHA512Final(md, &ctx);
+    
+    for (i = 0; i < 8; i++) U[i] = be64(md[i]);
+    mem_clean(k, sizeof(k));
+    mem_clean(md, sizeof(md));
+}
+
+// T ^= U2 ^ U3 ^ ... ^ Urounds, where Ui = hmac-sha512(pw, Ui-1) is computed from the midstates s by compressing the
+// one padded block of each hmac hash, and U and T are native words
+static void _BRPBKDF2SHA512Rounds(uint64_t *T, uint64_t *U, uint64_t s[2][8], unsigned rounds)
+{
+    size_t j, n;
+    uint64_t r[8], w[80];
+    
+    memset(w, 0, 16*sizeof(uint64_t)); // the message is always 64 bytes after a 128 byte key block
+    w[8] = 0x8000000000000000;
+    w[15] = (128 + 64)*8;
+    
+    for (; rounds > 1; rounds--) {
+        for (n = 0; n < 2; n++) { // inner hash, then outer hash
+            memcpy(w, (n == 0) ? U : r, sizeof(r));
+            memcpy(r, s[n], sizeof(r));
+            _BRSHA512Rounds(r, w);
+        }
+        
+        for (j = 0; j < 8; j++) U[j] = r[j], T[j] ^= r[j];
+    }
+    
+    mem_clean(r, sizeof(r));
+    mem_clean(w, sizeof(w));
+}
+
+void BRPBKDF2SHA512(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                    unsigned rounds)
+{
+    size_t j, off;
+    uint64_t s[2][8], U[8], T[8];
+    
+    assert(dk != NULL || dkLen == 0);
+    assert(pw != NULL || pwLen == 0);
+    assert(salt != NULL || saltLen == 0);
+    assert(rounds > 0);
+    
+    for (off = 0; off < dkLen; off += 64) { // dk = T1 || T2 || ... || Tdklen/hlen
+        _BRPBKDF2SHA512Init(s, U, pw, pwLen, salt, saltLen, (uint32_t)(off/64 + 1));
+        memcpy(T, U, sizeof(U));
+        _BRPBKDF2SHA512Rounds(T, U, s, rounds);
+        for (j = 0; j < 8; j++) T[j] = be64(T[j]);
+        memcpy((uint8_t *)dk + off, T, (off + 64 <= dkLen) ? 64 : dkLen - off);
+    }
+    
+    mem_clean(s, sizeof(s));
+    mem_clean(U, sizeof(U));
+    mem_clean(T, sizeof(T));
+}
+
 // salsa20/8 stream cipher: http://cr.yp.to/snuffle.html
 static void _salsa20_8(uint32_t b[16])
 {
@@ -1177,50 +1931,227 @@ static void _blockmix_salsa8(uint64_t *dest, const uint64_t *src, uint64_t *b, u
     }
 }
 
-// scrypt key derivation: http://www.tarsnap.com/scrypt.html
-void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
-              unsigned n, unsigned r, unsigned p)
+// scrypt romix of one 128*r byte block b of little endian words, x and y are 128*r bytes, z 64, and v 128*r*n
+static void _BRScryptROMix(uint32_t *b, unsigned n, unsigned r, uint64_t *x, uint64_t *y, uint64_t *z, uint64_t *v)
+{
+    uint64_t m;
+    
+    for (unsigned j = 0; j < 32*r; j++) ((uint32_t *)x)[j] = le32(b[j]);
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        memcpy(&v[j*(16*r)], x, 128*r);
+        _blockmix_salsa8(y, x, z, r);
+        memcpy(&v[(j + 1)*(16*r)], y, 128*r);
+        _blockmix_salsa8(x, y, z, r);
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        m = le64(x[(2*r - 1)*8]) & (n - 1);
+        for (unsigned k = 0; k < 16*r; k++) x[k] ^= v[m*(16*r) + k];
+        _blockmix_salsa8(y, x, z, r);
+        m = le64(y[(2*r - 1)*8]) & (n - 1);
+        for (unsigned k = 0; k < 16*r; k++) y[k] ^= v[m*(16*r) + k];
+        _blockmix_salsa8(x, y, z, r);
+    }
+    
+    for (unsigned j = 0; j < 32*r; j++) b[j] = le32(((uint32_t *)x)[j]);
+    var_clean(&m);
+}
+
+#if SCRYPT_SSE2_KERNEL
+// salsa20/8 on the four diagonals of the 4x4 word matrix, one per vector: x[0] = (x0, x5, x10, x15),
+// x[1] = (x4, x9, x14, x3), x[2] = (x8, x13, x2, x7), x[3] = (x12, x1, x6, x11), so each quarter round step of the
+// columns or the rows is a single vector op, with lane rotations between the two
+#define SALSA_SSE2_STEP(a, b, c, k) {\
+    __m128i _t = _mm_add_epi32(b, c);\
+    a = _mm_xor_si128(_mm_xor_si128(a, _mm_slli_epi32(_t, k)), _mm_srli_epi32(_t, 32 - (k)));\
+}
+
+static inline void _salsa20_8_sse2(__m128i *x0, __m128i *x1, __m128i *x2, __m128i *x3)
+{
+    __m128i a = *x0, b = *x1, c = *x2, d = *x3;
+    
+    for (unsigned i = 0; i < 8; i += 2) {
+        // operate on columns
+        SALSA_SSE2_STEP(b, a, d, 7);
+        SALSA_SSE2_STEP(c, b, a, 9);
+        SALSA_SSE2_STEP(d, c, b, 13);
+        SALSA_SSE2_STEP(a, d, c, 18);
+        b = _mm_shuffle_epi32(b, 0x93), c = _mm_shuffle_epi32(c, 0x4e), d = _mm_shuffle_epi32(d, 0x39);
+        
+        // operate on rows
+        SALSA_SSE2_STEP(d, a, b, 7);
+        SALSA_SSE2_STEP(c, d, a, 9);
+        SALSA_SSE2_STEP(b, c, d, 13);
+        SALSA_SSE2_STEP(a, b, c, 18);
+        b = _mm_shuffle_epi32(b, 0x39), c = _mm_shuffle_epi32(c, 0x4e), d = _mm_shuffle_epi32(d, 0x93);
+    }
+    
+    *x0 = _mm_add_epi32(*x0, a), *x1 = _mm_add_epi32(*x1, b), *x2 = _mm_add_epi32(*x2, c), *x3 = _mm_add_epi32(*x3, d);
+}
+
+// blockmix of src xor src2 (if not NULL) into dest, all in diagonal order, returns the first word of the last block
+static inline uint32_t _blockmix_salsa8_sse2(__m128i *dest, const __m128i *src, const __m128i *src2, unsigned r)
+{
+    __m128i x0, x1, x2, x3;
+    
+    #define BLOCKMIX_SSE2_XOR(i) {\
+        x0 = _mm_xor_si128(x0, _mm_loadu_si128(&src[(i)*4])), x1 = _mm_xor_si128(x1, _mm_loadu_si128(&src[(i)*4 + 1]));\
+        x2 = _mm_xor_si128(x2, _mm_loadu_si128(&src[(i)*4 + 2])), x3 = _mm_xor_si128(x3, _mm_loadu_si128(&src[(i)*4 + 3]));\
+        if (src2) {\
+            x0 = _mm_xor_si128(x0, _mm_loadu_si128(&src2[(i)*4])), x1 = _mm_xor_si128(x1, _mm_loadu_si128(&src2[(i)*4 + 1]));\
+            x2 = _mm_xor_si128(x2, _mm_loadu_si128(&src2[(i)*4 + 2])), x3 = _mm_xor_si128(x3, _mm_loadu_si128(&src2[(i)*4 + 3]));\
+        }\
+    }
+    #define BLOCKMIX_SSE2_STORE(i) {\
+        _mm_storeu_si128(&dest[(i)*4], x0), _mm_storeu_si128(&dest[(i)*4 + 1], x1);\
+        _mm_storeu_si128(&dest[(i)*4 + 2], x2), _mm_storeu_si128(&dest[(i)*4 + 3], x3);\
+    }
+    
+    x0 = x1 = x2 = x3 = _mm_setzero_si128();
+    BLOCKMIX_SSE2_XOR(2*r - 1);
+    
+    for (unsigned i = 0; i < 2*r; i += 2) {
+        BLOCKMIX_SSE2_XOR(i);
+        _salsa20_8_sse2(&x0, &x1, &x2, &x3);
+        BLOCKMIX_SSE2_STORE(i/2);
+        BLOCKMIX_SSE2_XOR(i + 1);
+        _salsa20_8_sse2(&x0, &x1, &x2, &x3);
+        BLOCKMIX_SSE2_STORE(r + i/2);
+    }
+    
+    #undef BLOCKMIX_SSE2_XOR
+    #undef BLOCKMIX_SSE2_STORE
+    return (uint32_t)_mm_cvtsi128_si32(x0);
+}
+
+// _BRScryptROMix() with the sse2 salsa20/8, keeping x, y and v in diagonal order, x86 being little endian
+static void _BRScryptROMixSSE2(uint32_t *b, unsigned n, unsigned r, __m128i *x, __m128i *y, __m128i *v)
+{
+    uint32_t *w = (uint32_t *)x, m;
+    
+    for (unsigned i = 0; i < 2*r; i++) {
+        for (unsigned j = 0; j < 16; j++) w[i*16 + j] = b[i*16 + j*5 % 16];
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        memcpy(&v[j*(8*r)], x, 128*r);
+        _blockmix_salsa8_sse2(y, x, NULL, r);
+        memcpy(&v[(j + 1)*(8*r)], y, 128*r);
+        m = _blockmix_salsa8_sse2(x, y, NULL, r);
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        m = _blockmix_salsa8_sse2(y, x, &v[(m & (n - 1))*(8*r)], r);
+        m = _blockmix_salsa8_sse2(x, y, &v[(m & (n - 1))*(8*r)], r);
+    }
+    
+    for (unsigned i = 0; i < 2*r; i++) {
+        for (unsigned j = 0; j < 16; j++) b[i*16 + j*5 % 16] = w[i*16 + j];
+    }
+    
+    var_clean(&m);
+}
+#endif
+
+static volatile unsigned _BRScryptKernelsEnabled = ~0u;
+
+// scrypt kernels supported by this build, and not disabled with BRScryptSetKernels()
+unsigned BRScryptKernels(void)
+{
+    unsigned kernels = 0;
+    
+#if SCRYPT_SSE2_KERNEL
+    kernels |= BR_SCRYPT_SSE2;
+#endif
+    return kernels & _BRScryptKernelsEnabled;
+}
+
+void BRScryptSetKernels(unsigned kernels)
+{
+    _BRScryptKernelsEnabled = kernels;
+}
+
+// scratch memory per lane: v, then x, y and z
+#define SCRYPT_LANE_SIZE(n, r) (128*(size_t)(r)*(n) + 256*(size_t)(r) + 64)
+
+// evaluating more of p in parallel trades memory for time; stop at this much scratch memory
+static volatile size_t _BRScryptParallelMem = BR_SCRYPT_PARALLEL_MEM;
+
+void BRScryptSetParallelMemory(size_t bytes)
+{
+    _BRScryptParallelMem = bytes;
+}
+
+size_t BRScryptScratchSize(unsigned n, unsigned r, unsigned lanes)
+{
+    return SCRYPT_LANE_SIZE(n, r)*lanes;
+}
+
+unsigned BRScryptLanes(unsigned n, unsigned r, unsigned p)
+{
+    size_t lanes = processor_count_brd(), memLanes = _BRScryptParallelMem/SCRYPT_LANE_SIZE(n, r);
+    
+    if (lanes > memLanes) lanes = memLanes;
+    if (lanes > p) lanes = p;
+    return (lanes > 0) ? (unsigned)lanes : 1;
+}
+
+typedef struct {
+    uint32_t *b;
+    uint8_t *scratch;
+    unsigned n, r, p, lanes, kernels;
+} BRScryptWork;
+
+// each lane takes every lanes-th of the p blocks, in its own part of the scratch memory
+static void _BRScryptLane(void *info, size_t lane)
+{
+    BRScryptWork *work = info;
+    unsigned n = work->n, r = work->r;
+    uint64_t *v = (uint64_t *)(work->scratch + lane*SCRYPT_LANE_SIZE(n, r)), *x = &v[16*r*n], *y = &x[16*r], *z = &y[16*r];
+    
+    for (size_t i = lane; i < work->p; i += work->lanes) {
+#if SCRYPT_SSE2_KERNEL
+        if (work->kernels & BR_SCRYPT_SSE2) {
+            _BRScryptROMixSSE2(&work->b[i*32*r], n, r, (__m128i *)x, (__m128i *)y, (__m128i *)v);
+            continue;
+        }
+#endif
+        _BRScryptROMix(&work->b[i*32*r], n, r, x, y, z, v);
+    }
+}
+
+void BRScryptWithScratch(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                         unsigned n, unsigned r, unsigned p, void *scratch, size_t scratchLen)
 {
-    uint64_t x[16*r], y[16*r], z[8], *v = malloc(128*r*n), m;
     uint32_t b[32*r*p];
+    BRScryptWork work = { b, scratch, n, r, p, (unsigned)(scratchLen/SCRYPT_LANE_SIZE(n, r)), BRScryptKernels() };
     
-    assert(v != NULL);
     assert(dk != NULL || dkLen == 0);
     assert(pw != NULL || pwLen == 0);
     assert(salt != NULL || saltLen == 0);
-    assert(n > 0);
+    assert(n > 1 && (n & (n - 1)) == 0);
     assert(r > 0);
     assert(p > 0);
+    assert(scratch != NULL);
+    assert(work.lanes > 0);
+    if (work.lanes > p) work.lanes = p;
     
     BRPBKDF2(b, sizeof(b), BRSHA256, 256/8, pw, pwLen, salt, saltLen, 1);
-    
-    for (int i = 0; i < p; i++) {
-        for (unsigned j = 0; j < 32*r; j++) ((uint32_t *)x)[j] = le32(b[i*32*r + j]);
-        
-        for (unsigned j = 0; j < n; j += 2) {
-            memcpy(&v[j*(16*r)], x, 128*r);
-            _blockmix_salsa8(y, x, z, r);
-            memcpy(&v[(j + 1)*(16*r)], y, 128*r);
-            _blockmix_salsa8(x, y, z, r);
-        }
-        
-        for (unsigned j = 0; j < n; j += 2) {
-            m = le64(x[(2*r - 1)*8]) & (n - 1);
-            for (unsigned k = 0; k < 16*r; k++) x[k] ^= v[m*(16*r) + k];
-            _blockmix_salsa8(y, x, z, r);
-            m = le64(y[(2*r - 1)*8]) & (n - 1);
-            for (unsigned k = 0; k < 16*r; k++) y[k] ^= v[m*(16*r) + k];
-            _blockmix_salsa8(x, y, z, r);
-        }
-        
-        for (unsigned j = 0; j < 32*r; j++) b[i*32*r + j] = le32(((uint32_t *)x)[j]);
-    }
-    
+    pthread_apply_brd(work.lanes, work.lanes, &work, _BRScryptLane);
     BRPBKDF2(dk, dkLen, BRSHA256, 256/8, pw, pwLen, b, sizeof(b), 1);
     mem_clean(b, sizeof(b));
-    mem_clean(x, sizeof(x));
-    mem_clean(y, sizeof(y));
-    mem_clean(z, sizeof(z));
-    mem_clean(v, 128*r*n);
-    free(v);
+    mem_clean(scratch, BRScryptScratchSize(n, r, work.lanes));
+}
+
+// scrypt key derivation: http://www.tarsnap.com/scrypt.html
+void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+              unsigned n, unsigned r, unsigned p)
+{
+    size_t scratchLen = BRScryptScratchSize(n, r, BRScryptLanes(n, r, p));
+    void *scratch = malloc(scratchLen);
+    
+    assert(scratch != NULL);
+    BRScryptWithScratch(dk, dkLen, pw, pwLen, salt, saltLen, n, r, p, scratch, scratchLen);
+    free(scratch);
 }
@@ -44,6 +44,25 @@ void BRSHA224(void *md28, const void *data, size_t dataLen);
 // double-sha-256 = sha-256(sha-256(x))
 void BRSHA256_2(void *md32, const void *data, size_t dataLen);
 
+// sha-256 of count messages of dataLen bytes each, the i-th at data + i*stride, written to md32s + i*32
+// uses the x86 sha extensions, or hashes 8 (avx2) or 4 (sse2/neon) messages at once in vector lanes where available
+// md32s must not overlap data
+void BRSHA256Batch(void *md32s, const void *data, size_t dataLen, size_t stride, size_t count);
+
+// double-sha-256 of count messages, as with BRSHA256Batch()
+void BRSHA256_2Batch(void *md32s, const void *data, size_t dataLen, size_t stride, size_t count);
+
+// sha-256 kernels, chosen at runtime from what the cpu supports
+#define BR_SHA256_SHANI  0x01 // x86 sha extensions
+#define BR_SHA256_AVX2   0x02 // 8 lanes with avx2
+#define BR_SHA256_LANES4 0x04 // 4 lanes with sse2 or neon
+
+// returns the available sha-256 kernels, less any disabled with BRSHA256SetKernels()
+unsigned BRSHA256Kernels(void);
+
+// enables only the given sha-256 kernels (if available), for tests and benchmarks against the scalar code
+void BRSHA256SetKernels(unsigned kernels);
+
 void BRSHA384(void *md48, const void *data, size_t dataLen);
 
 void BRSHA512(void *md64, const void *data, size_t dataLen);
@@ -60,6 +79,25 @@ void BRSHA3_256(void *md32, const void *data, size_t dataLen);
 // keccak-256: https://keccak.team/files/Keccak-submission-3.pdf
 void BRKeccak256(void *md32, const void *data, size_t dataLen);
 
+// keccak-512: https://keccak.team/files/Keccak-submission-3.pdf
+void BRKeccak512(void *md64, const void *data, size_t dataLen);
+
+// keccak-256 of count messages, the i-th of dataLen[i] bytes at data[i], written to md32s + i*32
+// hashes 4 messages at once in avx2 vector lanes where available
+void BRKeccak256Batch(void *md32s, const void *data[], const size_t dataLen[], size_t count);
+
+// keccak kernels, chosen at runtime from what the cpu supports
+#define BR_KECCAK_AVX2 0x01 // 4 lanes with avx2
+
+// returns the available keccak kernels, less any disabled with BRKeccakSetKernels()
+unsigned BRKeccakKernels(void);
+
+// enables only the given keccak kernels (if available), for tests and benchmarks against the scalar code
+void BRKeccakSetKernels(unsigned kernels);
+
+// keccak-f[1600] permutation of a state of 25 native endian 64bit lanes, for sponge constructions built elsewhere
+void BRKeccakF1600(uint64_t *state25);
+
 // md5 - for non-cryptographic use only
 void BRMD5(void *md16, const void *data, size_t dataLen);
 
@@ -68,7 +106,50 @@ uint32_t BRMurmur3_32(const void *data, size_t dataLen, uint32_t seed);
 
 // sipHash-64: https://131002.net/siphash
 uint64_t BRSip64(const void *key16, const void *data, size_t dataLen);
-    
+
+// incremental hashing: init a context, update it with each fragment of data in order, then final writes md and cleans
+// the context; the result is the same as the one-shot hash of the concatenated data
+// a context holds no pointers, so a copy of it (by assignment) is a clone of the midstate
+typedef struct { uint32_t buf[5]; uint32_t x[16]; uint64_t len; } BRSHA1Context;
+typedef struct { uint32_t buf[8]; uint32_t x[16]; uint64_t len; } BRSHA256Context; // sha-256 and sha-224
+typedef struct { uint64_t buf[8]; uint64_t x[16]; uint64_t len; } BRSHA512Context; // sha-512 and sha-384
+typedef struct { uint32_t buf[5]; uint32_t x[16]; uint64_t len; } BRRMD160Context;
+typedef struct { uint32_t buf[4]; uint32_t x[16]; uint64_t len; } BRMD5Context;
+typedef struct { uint64_t buf[25]; uint64_t x[17]; size_t len, blockSize, mdLen; uint8_t pad; } BRKeccakContext;
+
+void BRSHA1Init(BRSHA1Context *ctx);
+void BRSHA1Update(BRSHA1Context *ctx, const void *data, size_t dataLen);
+void BRSHA1Final(void *md20, BRSHA1Context *ctx);
+
+void BRSHA224Init(BRSHA256Context *ctx);
+void BRSHA224Final(void *md28, BRSHA256Context *ctx);
+
+void BRSHA256Init(BRSHA256Context *ctx);
+void BRSHA256Update(BRSHA256Context *ctx, const void *data, size_t dataLen); // also for sha-224
+void BRSHA256Final(void *md32, BRSHA256Context *ctx);
+
+void BRSHA384Init(BRSHA512Context *ctx);
+void BRSHA384Final(void *md48, BRSHA512Context *ctx);
+
+void BRSHA512Init(BRSHA512Context *ctx);
+void BRSHA512Update(BRSHA512Context *ctx, const void *data, size_t dataLen); // also for sha-384
+void BRSHA512Final(void *md64, BRSHA512Context *ctx);
+
+void BRRMD160Init(BRRMD160Context *ctx);
+void BRRMD160Update(BRRMD160Context *ctx, const void *data, size_t dataLen);
+void BRRMD160Final(void *md20, BRRMD160Context *ctx);
+
+void BRMD5Init(BRMD5Context *ctx);
+void BRMD5Update(BRMD5Context *ctx, const void *data, size_t dataLen);
+void BRMD5Final(void *md16, BRMD5Context *ctx);
+
+// sha3-256, keccak-256 and keccak-512 share the keccak context; final writes md32 or md64 per the init
+void BRSHA3_256Init(BRKeccakContext *ctx);
+void BRKeccak256Init(BRKeccakContext *ctx);
+void BRKeccak512Init(BRKeccakContext *ctx);
+void BRKeccakUpdate(BRKeccakContext *ctx, const void *data, size_t dataLen);
+void BRKeccakFinal(void *md, BRKeccakContext *ctx);
+
 void BRHMAC(void *mac, void (*hash)(void *, const void *, size_t), size_t hashLen, const void *key, size_t keyLen,
             const void *data, size_t dataLen);
 
@@ -104,10 +185,42 @@ void BRAESCTR_OFFSET(void *out, size_t outLen, const void *key, size_t keyLen, v
 void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t), size_t hashLen,
               const void *pw, size_t pwLen, const void *salt, size_t saltLen, unsigned rounds);
 
+// pbkdf2-hmac-sha512, same result as BRPBKDF2(dk, dkLen, BRSHA512, 64, ...), but hashes the hmac key blocks only once
+void BRPBKDF2SHA512(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                    unsigned rounds);
+
 // scrypt key derivation: http://www.tarsnap.com/scrypt.html
+// n must be a power of 2, and the p blocks are mixed BRScryptLanes(n, r, p) at a time in parallel threads
 void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
               unsigned n, unsigned r, unsigned p);
 
+// scrypt in caller owned scratch memory, for repeated derivations without allocating it each time
+// scratchLen must be at least BRScryptScratchSize(n, r, 1), and each further multiple mixes one more of p in parallel
+// scratch is zeroed before returning, and may be shared by calls with smaller n or r, but not concurrent ones
+void BRScryptWithScratch(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                         unsigned n, unsigned r, unsigned p, void *scratch, size_t scratchLen);
+
+// bytes of scratch memory for scrypt to mix lanes of p in parallel
+size_t BRScryptScratchSize(unsigned n, unsigned r, unsigned lanes);
+
+// the lanes BRScrypt() uses: one per processor, up to p, within the bound on scratch memory, and at least one
+unsigned BRScryptLanes(unsigned n, unsigned r, unsigned p);
+
+// default bound on scratch memory for scrypt lanes; one lane of bip38 scrypt (n = 16384, r = 8) exceeds it
+#define BR_SCRYPT_PARALLEL_MEM (16*1024*1024)
+
+// sets the bound on scratch memory for scrypt lanes, trading memory for time on devices that can spare it
+void BRScryptSetParallelMemory(size_t bytes);
+
+// scrypt kernels, chosen at build time
+#define BR_SCRYPT_SSE2 0x01 // salsa20/8 with sse2
+
+// returns the available scrypt kernels, less any disabled with BRScryptSetKernels()
+unsigned BRScryptKernels(void);
+
+// enables only the given scrypt kernels (if available), for tests and benchmarks against the scalar code
+void BRScryptSetKernels(unsigned kernels);
+
 // zeros out memory in a way that can't be optimized out by the compiler
 inline static void mem_clean(void *ptr, size_t len)
 {
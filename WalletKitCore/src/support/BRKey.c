@@ -25,6 +25,7 @@
 #include "BRKey.h"
 #include "BRBase.h"
 #include "BRBase58.h"
+#include "BROSCompat.h"
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
@@ -126,6 +127,36 @@ int BRSecp256k1PointAdd(BRECPoint *p, const UInt256 *i)
             secp256k1_ec_pubkey_serialize(_ctx, (unsigned char *)p, &pLen, &pubkey, SECP256K1_EC_COMPRESSED));
 }
 
+// multiplies secp256k1 generator by each 256bit big endian int in i, adds the result to ec-point p, and stores it in
+// the corresponding element of points, leaving p in any element that fails, the same as BRSecp256k1PointAdd()
+// returns the number of points successfully computed
+size_t BRSecp256k1PointAddBatch(BRECPoint points[], const BRECPoint *p, const UInt256 i[], size_t count)
+{
+    secp256k1_pubkey pubkey, pk;
+    size_t j, pLen, r = 0;
+
+    assert(points != NULL || count == 0);
+    assert(p != NULL);
+    assert(i != NULL || count == 0);
+    pthread_once(&_ctx_once, _ctx_init);
+
+    if (! secp256k1_ec_pubkey_parse(_ctx, &pubkey, (const unsigned char *)p, sizeof(*p))) { // parse p only once
+        for (j = 0; j < count; j++) points[j] = *p;
+        return 0;
+    }
+
+    for (j = 0; j < count; j++) {
+        pk = pubkey;
+        pLen = sizeof(points[j]);
+
+        if (secp256k1_ec_pubkey_tweak_add(_ctx, &pk, (const unsigned char *)&i[j]) &&
+            secp256k1_ec_pubkey_serialize(_ctx, (unsigned char *)&points[j], &pLen, &pk, SECP256K1_EC_COMPRESSED)) r++;
+        else points[j] = *p;
+    }
+
+    return r;
+}
+
 // multiplies secp256k1 ec-point p by 256bit big endian int i and stores the result in p
 // returns true on success
 int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
@@ -577,6 +608,97 @@ int BRKeyRecoverPubKeyEthereum(BRKey *key, UInt256 md, const void *compactSig, s
     return r;
 }
 
+// Batches
+
+#define KEY_BATCH_PER_THREAD 64 // items per thread below which spreading a batch over more threads doesn't pay
+
+typedef enum {
+    KEY_BATCH_VERIFY,
+    KEY_BATCH_VERIFY_JOSE,
+    KEY_BATCH_RECOVER
+} BRKeyBatchType;
+
+typedef struct {
+    BRKeyBatchType type;
+    int *results;
+    BRKey *keys;
+    const UInt256 *mds;
+    const void **sigs;
+    const size_t *sigLens;
+} BRKeyBatch;
+
+static void _BRKeyBatchApply(void *info, size_t i)
+{
+    BRKeyBatch *batch = info;
+
+    switch (batch->type) {
+        case KEY_BATCH_VERIFY:
+            batch->results[i] = BRKeyVerify(&batch->keys[i], batch->mds[i], batch->sigs[i], batch->sigLens[i]);
+            break;
+        case KEY_BATCH_VERIFY_JOSE:
+            batch->results[i] = BRKeyVerifyJOSE(&batch->keys[i], batch->mds[i], batch->sigs[i], 64);
+            break;
+        case KEY_BATCH_RECOVER:
+            batch->results[i] = BRKeyRecoverPubKey(&batch->keys[i], batch->mds[i], batch->sigs[i], 65);
+            break;
+    }
+}
+
+// every item only reads the shared context and its precomputed multiplication tables, so items run on as many threads
+// as the batch size warrants
+static size_t _BRKeyBatchRun(BRKeyBatch *batch, size_t count)
+{
+    size_t threadCount = count/KEY_BATCH_PER_THREAD, r = 0;
+
+    pthread_once(&_ctx_once, _ctx_init);
+    if (threadCount > processor_count_brd()) threadCount = processor_count_brd();
+    if (threadCount < 1) threadCount = 1;
+    pthread_apply_brd(count, (unsigned int)threadCount, batch, _BRKeyBatchApply);
+    for (size_t i = 0; i < count; i++) if (batch->results[i]) r++;
+    return r;
+}
+
+// sets results[i] to BRKeyVerify(&keys[i], mds[i], sigs[i], sigLens[i]) for each of count DER-encoded signatures
+// returns the number of signatures verified
+size_t BRKeyVerifyBatch(int results[], BRKey keys[], const UInt256 mds[], const void *sigs[], const size_t sigLens[],
+                        size_t count)
+{
+    BRKeyBatch batch = { KEY_BATCH_VERIFY, results, keys, mds, sigs, sigLens };
+
+    assert(results != NULL || count == 0);
+    assert(keys != NULL || count == 0);
+    assert(mds != NULL || count == 0);
+    assert(sigs != NULL || count == 0);
+    assert(sigLens != NULL || count == 0);
+    return _BRKeyBatchRun(&batch, count);
+}
+
+// sets results[i] to BRKeyVerifyJOSE(&keys[i], mds[i], sigs[i], 64) for each of count compact-serialized signatures
+// returns the number of signatures verified
+size_t BRKeyVerifyJOSEBatch(int results[], BRKey keys[], const UInt256 mds[], const void *sigs[], size_t count)
+{
+    BRKeyBatch batch = { KEY_BATCH_VERIFY_JOSE, results, keys, mds, sigs, NULL };
+
+    assert(results != NULL || count == 0);
+    assert(keys != NULL || count == 0);
+    assert(mds != NULL || count == 0);
+    assert(sigs != NULL || count == 0);
+    return _BRKeyBatchRun(&batch, count);
+}
+
+// sets results[i] to BRKeyRecoverPubKey(&keys[i], mds[i], compactSigs[i], 65) for each of count 65 byte signatures
+// returns the number of pubKeys recovered
+size_t BRKeyRecoverPubKeyBatch(int results[], BRKey keys[], const UInt256 mds[], const void *compactSigs[], size_t count)
+{
+    BRKeyBatch batch = { KEY_BATCH_RECOVER, results, keys, mds, compactSigs, NULL };
+
+    assert(results != NULL || count == 0);
+    assert(keys != NULL || count == 0);
+    assert(mds != NULL || count == 0);
+    assert(compactSigs != NULL || count == 0);
+    return _BRKeyBatchRun(&batch, count);
+}
+
 int BRKeySetCompressed (BRKey *key, int compressed) {
     compressed = (compressed ? 1 : 0); // as 1 or 0
 
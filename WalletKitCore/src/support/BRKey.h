@@ -59,6 +59,11 @@ int BRSecp256k1PointGen(BRECPoint *p, const UInt256 *i);
 // returns true on success
 int BRSecp256k1PointAdd(BRECPoint *p, const UInt256 *i);
 
+// multiplies secp256k1 generator by each of count 256bit big endian ints in i and adds the result to ec-point p, storing
+// the sums in points, parsing p only once
+// elements that fail are set to p, and the number computed successfully is returned
+size_t BRSecp256k1PointAddBatch(BRECPoint points[], const BRECPoint *p, const UInt256 i[], size_t count);
+
 // multiplies secp256k1 ec-point p by 256bit big endian int i and stores the result in p
 // returns true on success
 int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i);
@@ -139,6 +144,14 @@ void BRKeyECDH(const BRKey *privKey, uint8_t *out32, BRKey *pubKey);
 size_t BRKeyCompactSignEthereum(const BRKey *key, void *compactSig, size_t sigLen, UInt256 md);
 int BRKeyRecoverPubKeyEthereum(BRKey *key, UInt256 md, const void *compactSig, size_t sigLen);
 
+// batches of the above, spread over threads for large counts: each sets results[i] to the result of the single item
+// call for keys[i], mds[i] and sigs[i] (and sigLens[i] for DER), and returns the number of items that succeeded
+// JOSE signatures are 64 bytes, and compact signatures 65 bytes
+size_t BRKeyVerifyBatch(int results[], BRKey keys[], const UInt256 mds[], const void *sigs[], const size_t sigLens[],
+                        size_t count);
+size_t BRKeyVerifyJOSEBatch(int results[], BRKey keys[], const UInt256 mds[], const void *sigs[], size_t count);
+size_t BRKeyRecoverPubKeyBatch(int results[], BRKey keys[], const UInt256 mds[], const void *compactSigs[], size_t count);
+
 // Set the compressed flag in `key`; this will clear the `pubKey` to allow regeneration
 // Returns true (1) if the compress flag changed; false (0) otherwise
 int BRKeySetCompressed (BRKey *key, int compressed);
@@ -26,6 +26,7 @@
 #include "BROSCompat.h"
 #include "time.h"
 #include "sys/time.h"
+#include <unistd.h>
 
 #if defined (__APPLE__)
 #include <Security/Security.h>
@@ -117,3 +118,77 @@ mergesort_brd (void *__base, size_t __nel, size_t __width,
 #  error Undefined mergesort_brd()
 #endif
 }
+
+extern unsigned int
+processor_count_brd (void) {
+    long count = sysconf (_SC_NPROCESSORS_ONLN);
+    return (count > 0 ? (unsigned int) count : 1);
+}
+
+/// MARK: - Apply
+
+typedef struct {
+    void *context;
+    void (*apply) (void *context, size_t index);
+    size_t count;
+    size_t chunk;
+    size_t next;
+    pthread_mutex_t lock;
+} BRApplyState;
+
+static void *
+pthread_apply_routine_brd (BRApplyState *state) {
+    while (1) {
+        pthread_mutex_lock (&state->lock);
+        size_t beg = state->next;
+        size_t end = (state->count - beg > state->chunk ? beg + state->chunk : state->count);
+        state->next = end;
+        pthread_mutex_unlock (&state->lock);
+
+        if (beg == end) break;
+
+        for (size_t index = beg; index < end; index++)
+            state->apply (state->context, index);
+    }
+    return NULL;
+}
+
+extern void
+pthread_apply_brd (size_t count,
+                   unsigned int threadCount,
+                   void *context,
+                   void (*apply) (void *context, size_t index)) {
+    if (0 == threadCount) threadCount = processor_count_brd ();
+    if (threadCount > count) threadCount = (unsigned int) count;
+
+    // Not worth a thread; apply inline
+    if (threadCount <= 1) {
+        for (size_t index = 0; index < count; index++)
+            apply (context, index);
+        return;
+    }
+
+    BRApplyState state = {
+        context,
+        apply,
+        count,
+        (count / (4 * threadCount) > 0 ? count / (4 * threadCount) : 1),
+        0
+    };
+    pthread_mutex_init (&state.lock, NULL);
+
+    pthread_t threads[threadCount - 1];
+    unsigned int threadsCreated = 0;
+
+    // A failure to create a thread is not fatal; the remaining threads, including this one, do the work.
+    while (threadsCreated < threadCount - 1 &&
+           0 == pthread_create (&threads[threadsCreated], NULL, (ThreadRoutine) pthread_apply_routine_brd, &state))
+        threadsCreated++;
+
+    pthread_apply_routine_brd (&state);
+
+    for (unsigned int index = 0; index < threadsCreated; index++)
+        pthread_join (threads[index], NULL);
+
+    pthread_mutex_destroy (&state.lock);
+}
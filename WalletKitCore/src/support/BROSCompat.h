@@ -77,6 +77,20 @@ extern int
 mergesort_brd (void *__base, size_t __nel, size_t __width,
                int (*__compar)(const void *, const void *));
 
+/// Return the number of online processors; always at least 1.
+extern unsigned int
+processor_count_brd (void);
+
+/// Invoke `apply (context, index)` for every index in [0, count) using up to `threadCount` threads,
+/// one of which is the calling thread.  If `threadCount` is 0, the processor count is used.  Indices
+/// are handed out in small chunks so uneven work balances across threads; no ordering between
+/// indices is guaranteed.  Returns once every index has been applied.
+extern void
+pthread_apply_brd (size_t count,
+                   unsigned int threadCount,
+                   void *context,
+                   void (*apply) (void *context, size_t index));
+
 #ifdef __cplusplus
 }
 #endif
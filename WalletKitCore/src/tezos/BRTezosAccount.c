@@ -79,27 +79,32 @@ extern BRCryptoData
 tezosAccountSignData (BRTezosAccount account,
                       BRCryptoData data,
                       UInt512 seed) {
+    uint8_t watermark[] = { TEZOS_WATERMARK_OPERATION };
+    
+    uint8_t hash[32];
+    blake2b_ctx ctx;
+    blake2b_init (&ctx, sizeof(hash), NULL, 0);
+    blake2b_update (&ctx, watermark, sizeof(watermark));
+    blake2b_update (&ctx, data.bytes, data.size);
+    blake2b_final (&ctx, hash);
+    
+    return tezosAccountSignHash (account, hash, seed);
+}
+
+extern BRCryptoData
+tezosAccountSignHash (BRTezosAccount account,
+                      const uint8_t * hash32,
+                      UInt512 seed) {
     BRKey publicKey = tezosAccountGetPublicKey ((BRTezosAccount)account);
     BRKey privateKey = deriveTezosPrivateKeyFromSeed(seed, 0);
     uint8_t privateKeyBytes[64];
     tezosKeyGetPrivateKey(privateKey, privateKeyBytes);
     
-    uint8_t watermark[] = { 0x03 };
-    size_t watermarkSize = sizeof(watermark);
-    
-    BRCryptoData watermarkedData = cryptoDataNew(data.size + watermarkSize);
-    
-    memcpy(watermarkedData.bytes, watermark, watermarkSize);
-    memcpy(&watermarkedData.bytes[watermarkSize], data.bytes, data.size);
-    
-    uint8_t hash[32];
-    blake2b(hash, sizeof(hash), NULL, 0, watermarkedData.bytes, watermarkedData.size);
-    
     BRCryptoData signature = cryptoDataNew(64);
-    ed25519_sign(signature.bytes, hash, sizeof(hash), publicKey.pubKey, privateKeyBytes);
+    ed25519_sign(signature.bytes, hash32, 32, publicKey.pubKey, privateKeyBytes);
     
     mem_clean(privateKeyBytes, 64);
-    cryptoDataFree(watermarkedData);
+    BRKeyClean(&privateKey);
     
     return signature;
 }
@@ -244,6 +249,6 @@ tezosKeyGetPublicKey (BRKey key, uint8_t * publicKey) {
 
 static void
 tezosKeyGetPrivateKey (BRKey key, uint8_t * privateKey) {
-    unsigned char publicKey[32] = {0};
-    ed25519_create_keypair(publicKey, privateKey, key.secret.u8);
+    // Signing has the public key at hand, so only expand the secret
+    ed25519_expand_seed(privateKey, key.secret.u8);
 }
@@ -70,6 +70,21 @@ tezosAccountSignData (BRTezosAccount account,
                       BRCryptoData data,
                       UInt512 seed);
 
+/**
+ * Signs a 32 byte blake2b hash of the watermarked message, as computed by tezosAccountSignData(),
+ * for callers that hash the message as they build it.
+ *
+ * @param account
+ * @param hash32 - blake2b-256 of the watermark and message
+ * @param seed - account seed
+ *
+ * @return signature
+*/
+extern BRCryptoData
+tezosAccountSignHash (BRTezosAccount account,
+                      const uint8_t * hash32,
+                      UInt512 seed);
+
 /**
  * Get the public key for this Tezos account
  *
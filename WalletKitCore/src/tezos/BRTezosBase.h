@@ -22,6 +22,7 @@ extern "C" {
 
 #define TEZOS_PUBLIC_KEY_SIZE 32
 #define TEZOS_HASH_BYTES 34
+#define TEZOS_WATERMARK_OPERATION 0x03 // signing watermark for generic operations
 
 typedef struct {
     uint8_t bytes[TEZOS_HASH_BYTES];
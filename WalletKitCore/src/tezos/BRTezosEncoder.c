@@ -98,8 +98,14 @@ encodeBranch (BRTezosHash blockHash) {
     return branchData;
 }
 
-extern BRCryptoData
-tezosSerializeTransaction (BRTezosTransaction tx) {
+static void
+updateHashers (blake2b_ctx * hashers, size_t hashersCount, BRCryptoData data) {
+    for (size_t i = 0; i < hashersCount; i++)
+        blake2b_update (&hashers[i], data.bytes, data.size);
+}
+
+static BRCryptoData
+serializeTransaction (BRTezosTransaction tx, blake2b_ctx * hashers, size_t hashersCount) {
     assert (tx);
     
     BRTezosOperationData opData = tezosTransactionGetOperationData(tx);
@@ -139,6 +145,10 @@ tezosSerializeTransaction (BRTezosTransaction tx) {
         assert(0);
     }
     
+    for (int i=0; i < numFields; i++) {
+        updateHashers (hashers, hashersCount, fields[i]);
+    }
+    
     BRCryptoData serialized = cryptoDataConcat(fields, numFields);
     
     tezosAddressFree (source);
@@ -150,8 +160,22 @@ tezosSerializeTransaction (BRTezosTransaction tx) {
     return serialized;
 }
 
+extern BRCryptoData
+tezosSerializeTransaction (BRTezosTransaction tx) {
+    return serializeTransaction (tx, NULL, 0);
+}
+
 extern BRCryptoData
 tezosSerializeOperationList (BRTezosTransaction * tx, size_t txCount, BRTezosHash blockHash) {
+    return tezosSerializeOperationListHashed (tx, txCount, blockHash, NULL, 0);
+}
+
+extern BRCryptoData
+tezosSerializeOperationListHashed (BRTezosTransaction * tx,
+                                   size_t txCount,
+                                   BRTezosHash blockHash,
+                                   blake2b_ctx * hashers,
+                                   size_t hashersCount) {
     
     BRCryptoData fields[txCount + 1];
     size_t numFields = 0;
@@ -159,9 +183,11 @@ tezosSerializeOperationList (BRTezosTransaction * tx, size_t txCount, BRTezosHas
     // operation list = branch + [reveal op bytes] + transaction/delegation op bytes
     
     fields[numFields++] = encodeBranch(blockHash);
+    updateHashers (hashers, hashersCount, fields[0]);
     
+    // each operation's fields are hashed as they are encoded
     for (int i=0; i < txCount; i++) {
-        fields[numFields++] = tezosSerializeTransaction(tx[i]);
+        fields[numFields++] = serializeTransaction(tx[i], hashers, hashersCount);
     }
     
     BRCryptoData serialized = cryptoDataConcat(fields, numFields);
@@ -15,6 +15,7 @@
 #include <assert.h>
 #include "BRTezosBase.h"
 #include "BRTezosTransaction.h"
+#include "blake2/blake2b.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,6 +30,20 @@ tezosSerializeTransaction (BRTezosTransaction tx);
 extern BRCryptoData
 tezosSerializeOperationList (BRTezosTransaction * tx, size_t txCount, BRTezosHash blockHash);
 
+/**
+ * Serialize the operation list, updating each of `hashers` with the bytes as they are encoded, so
+ * that the hashes of the serialization need no pass over it afterwards.
+ *
+ * @param hashers - initialized blake2b contexts, each updated with the whole serialization
+ * @param hashersCount - the number of `hashers`, may be 0
+ */
+extern BRCryptoData
+tezosSerializeOperationListHashed (BRTezosTransaction * tx,
+                                   size_t txCount,
+                                   BRTezosHash blockHash,
+                                   blake2b_ctx * hashers,
+                                   size_t hashersCount);
+
 
 #ifdef __cplusplus
 }
@@ -132,22 +132,21 @@ extern void tezosTransactionFree (BRTezosTransaction transaction)
 }
 
 static void
-createTransactionHash(BRTezosTransaction tx) {
+createTransactionHash(BRTezosTransaction tx, const uint8_t * hash32) {
     assert(tx->signedBytes.size);
     
-    uint8_t hash[32];
-    blake2b(hash, sizeof(hash), NULL, 0, tx->signedBytes.bytes, tx->signedBytes.size);
-    
     uint8_t prefix[] = { 5, 116 }; // operation prefix
     memcpy(tx->hash.bytes, prefix, sizeof(prefix));
-    memcpy(&(tx->hash.bytes[sizeof(prefix)]), hash, sizeof(hash));
+    memcpy(&(tx->hash.bytes[sizeof(prefix)]), hash32, 32);
 }
 
 static BRCryptoData
 tezosTransactionSerialize (BRTezosTransaction transaction,
                            BRTezosAccount account,
                            BRTezosHash lastBlockHash,
-                           bool needsReveal) {
+                           bool needsReveal,
+                           blake2b_ctx * hashers,
+                           size_t hashersCount) {
     BRTezosTransaction opList[2];
     size_t opCount = 0;
     
@@ -185,7 +184,28 @@ tezosTransactionSerialize (BRTezosTransaction transaction,
     
     opList[opCount++] = transaction;
 
-    return tezosSerializeOperationList(opList, opCount, lastBlockHash);
+    return tezosSerializeOperationListHashed(opList, opCount, lastBlockHash, hashers, hashersCount);
+}
+
+static void
+tezosTransactionSetSignedBytes (BRTezosTransaction transaction,
+                                BRCryptoData unsignedBytes,
+                                BRCryptoData signature,
+                                blake2b_ctx * hasher) {
+    BRCryptoData signedBytes = cryptoDataNew(unsignedBytes.size + signature.size);
+    memcpy(signedBytes.bytes, unsignedBytes.bytes, unsignedBytes.size);
+    memcpy(&signedBytes.bytes[unsignedBytes.size], signature.bytes, signature.size);
+    
+    transaction->signedBytes = signedBytes;
+    
+    // the hasher has seen the unsigned bytes already; finish it with the signature
+    uint8_t hash[32];
+    blake2b_update (hasher, signature.bytes, signature.size);
+    blake2b_final (hasher, hash);
+    
+    if (transaction->signedBytes.size > 0) {
+        createTransactionHash(transaction, hash);
+    }
 }
 
 extern size_t
@@ -198,23 +218,19 @@ tezosTransactionSerializeForFeeEstimation (BRTezosTransaction transaction,
     
     cryptoDataFree(transaction->signedBytes);
     
-    BRCryptoData unsignedBytes = tezosTransactionSerialize(transaction, account, lastBlockHash, needsReveal);
+    blake2b_ctx hasher;
+    blake2b_init (&hasher, 32, NULL, 0);
+    
+    BRCryptoData unsignedBytes = tezosTransactionSerialize(transaction, account, lastBlockHash, needsReveal, &hasher, 1);
     BRCryptoData signature = cryptoDataNew(TEZOS_SIGNATURE_BYTES); // empty signature
     
-    BRCryptoData serializedBytes = cryptoDataNew(unsignedBytes.size + signature.size);
-    memcpy(serializedBytes.bytes, unsignedBytes.bytes, unsignedBytes.size);
-    memcpy(&serializedBytes.bytes[unsignedBytes.size], signature.bytes, signature.size);
+    tezosTransactionSetSignedBytes (transaction, unsignedBytes, signature, &hasher);
 
     cryptoDataFree (unsignedBytes);
     cryptoDataFree (signature);
     
-    transaction->signedBytes = serializedBytes;
     assert (FEE_BASIS_INITIAL == transaction->feeBasis.type);
-    transaction->feeBasis.u.initial.sizeInKBytes = (double) serializedBytes.size / 1000;
-    
-    if (transaction->signedBytes.size > 0) {
-        createTransactionHash(transaction);
-    }
+    transaction->feeBasis.u.initial.sizeInKBytes = (double) transaction->signedBytes.size / 1000;
     
     return transaction->signedBytes.size;
 }
@@ -230,20 +246,25 @@ tezosTransactionSerializeAndSign (BRTezosTransaction transaction,
     
     cryptoDataFree(transaction->signedBytes);
     
-    BRCryptoData unsignedBytes = tezosTransactionSerialize (transaction, account, lastBlockHash, needsReveal);
+    // hashers[0] is the signing hash, of the watermarked unsigned bytes; hashers[1] the
+    // transaction hash, of the unsigned bytes and then the signature
+    uint8_t watermark[] = { TEZOS_WATERMARK_OPERATION };
+    uint8_t signingHash[32];
+    blake2b_ctx hashers[2];
+    blake2b_init (&hashers[0], sizeof(signingHash), NULL, 0);
+    blake2b_init (&hashers[1], 32, NULL, 0);
+    blake2b_update (&hashers[0], watermark, sizeof(watermark));
     
-    BRCryptoData signature = tezosAccountSignData(account, unsignedBytes, seed);
+    BRCryptoData unsignedBytes = tezosTransactionSerialize (transaction, account, lastBlockHash, needsReveal, hashers, 2);
+    
+    blake2b_final (&hashers[0], signingHash);
+    BRCryptoData signature = tezosAccountSignHash(account, signingHash, seed);
     assert(TEZOS_SIGNATURE_BYTES == signature.size);
     
-    BRCryptoData signedBytes = cryptoDataNew(unsignedBytes.size + signature.size);
-    memcpy(signedBytes.bytes, unsignedBytes.bytes, unsignedBytes.size);
-    memcpy(&signedBytes.bytes[unsignedBytes.size], signature.bytes, signature.size);
+    tezosTransactionSetSignedBytes (transaction, unsignedBytes, signature, &hashers[1]);
     
-    transaction->signedBytes = signedBytes;
-
-    if (transaction->signedBytes.size > 0) {
-        createTransactionHash(transaction);
-    }
+    cryptoDataFree (unsignedBytes);
+    cryptoDataFree (signature);
     
     return transaction->signedBytes.size;
 }